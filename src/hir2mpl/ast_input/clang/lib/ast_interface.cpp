@@ -54,8 +54,11 @@ bool LibAstFile::Open(const MapleString &fileName,
   astFileName = fileName;
   index = clang_createIndex(excludeDeclFromPCH, displayDiagnostics);
   translationUnit = clang_createTranslationUnit(index, fileName.c_str());
-  CHECK_FATAL(translationUnit != nullptr, "The astfile %s content format is Non-conformance or astfile"
-              " version is different from hir2mpl version.", fileName.c_str());
+  if (translationUnit == nullptr) {
+    ERR(kLncErr, "The astfile %s content format is Non-conformance or astfile"
+        " version is different from hir2mpl version.", fileName.c_str());
+    return false;
+  }
   clang::ASTUnit *astUnit = translationUnit->TheASTUnit;
   if (astUnit == nullptr) {
     return false;
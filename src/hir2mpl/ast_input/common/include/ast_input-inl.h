@@ -16,6 +16,7 @@
 #include "ast_input.h"
 #include "global_tables.h"
 #include "fe_macros.h"
+#include "thread_env.h"
 
 namespace maple {
 template<class T>
@@ -24,31 +25,50 @@ ASTInput<T>::ASTInput(MIRModule &moduleIn, MapleAllocator &allocatorIn)
       astStructs(allocatorIn.Adapter()), astFuncs(allocatorIn.Adapter()), astVars(allocatorIn.Adapter()),
       astFileScopeAsms(allocatorIn.Adapter()), astEnums(allocatorIn.Adapter()) {}
 
+template<class T>
+int ASTFileLoadTask<T>::RunImpl(MplTaskParam *param) {
+  (void)param;
+  succeeded = parser.OpenFile(allocator) && parser.Verify() && parser.PreProcessAST();
+  return 0;
+}
+
 template<class T>
 bool ASTInput<T>::ReadASTFile(MapleAllocator &allocatorIn, uint32 index, const std::string &fileName) {
   T *parser = allocator.GetMemPool()->New<T>(allocator, index, fileName,
                                              astStructs, astFuncs, astVars,
                                              astFileScopeAsms, astEnums);
-  TRY_DO(parser->OpenFile(allocatorIn));
+  if (!parser->OpenFile(allocatorIn)) {
+    ERR(kLncErr, "failed to open astfile %s", fileName.c_str());
+    return false;
+  }
   TRY_DO(parser->Verify());
   TRY_DO(parser->PreProcessAST());
+  return RetrieveASTFile(*parser, allocatorIn, fileName);
+}
+
+template<class T>
+bool ASTInput<T>::RetrieveASTFile(T &parser, MapleAllocator &allocatorIn, const std::string &fileName) {
   // Some implicit record or enum decl would be retrieved in func body at use,
   // so we put `RetrieveFuncs` before `RetrieveStructs`
-  TRY_DO(parser->RetrieveFuncs(allocatorIn));
-  TRY_DO(parser->RetrieveStructs(allocatorIn));
+  TRY_DO(parser.RetrieveFuncs(allocatorIn));
+  TRY_DO(parser.RetrieveStructs(allocatorIn));
   if (FEOptions::GetInstance().IsDbgFriendly()) {
-    TRY_DO(parser->RetrieveEnums(allocatorIn));
+    TRY_DO(parser.RetrieveEnums(allocatorIn));
   }
-  TRY_DO(parser->RetrieveGlobalTypeDef(allocatorIn));
-  TRY_DO(parser->RetrieveGlobalVars(allocatorIn));
-  TRY_DO(parser->RetrieveFileScopeAsms(allocatorIn));
-  TRY_DO(parser->Release(allocatorIn));
-  parserMap.emplace(fileName, parser);
+  TRY_DO(parser.RetrieveGlobalTypeDef(allocatorIn));
+  TRY_DO(parser.RetrieveGlobalVars(allocatorIn));
+  TRY_DO(parser.RetrieveFileScopeAsms(allocatorIn));
+  TRY_DO(parser.Release(allocatorIn));
+  parserMap.emplace(fileName, &parser);
   return true;
 }
 
 template<class T>
 bool ASTInput<T>::ReadASTFiles(MapleAllocator &allocatorIn, const std::vector<std::string> &fileNames) {
+  uint32 nthreads = FEOptions::GetInstance().GetNThreads();
+  if (nthreads > 1 && fileNames.size() > 1) {
+    return ReadASTFilesParallel(allocatorIn, fileNames, nthreads);
+  }
   bool res = true;
   for (uint32 i = 0; res && i < fileNames.size(); ++i) {
     FETimer timer;
@@ -62,6 +82,56 @@ bool ASTInput<T>::ReadASTFiles(MapleAllocator &allocatorIn, const std::vector<st
   return res;
 }
 
+// Up to nthreads files are opened and pre-processed at a time, each by its own thread and in its own mempool.
+// The decls are then retrieved serially in input order, as they go to the global type tables and the shared
+// ASTDeclsBuilder cache, so the structs, funcs and vars are merged in the same order as the serial reading.
+// The translation units of a round are disposed before the next round starts.
+template<class T>
+bool ASTInput<T>::ReadASTFilesParallel(MapleAllocator &allocatorIn, const std::vector<std::string> &fileNames,
+                                       uint32 nthreads) {
+  for (uint32 begin = 0; begin < fileNames.size(); begin += nthreads) {
+    uint32 end = std::min(begin + nthreads, static_cast<uint32>(fileNames.size()));
+    FETimer timer;
+    std::stringstream ss;
+    ss << "LoadASTFiles[" << (begin + 1) << "-" << end << "/" << fileNames.size() << "]";
+    timer.StartAndDump(ss.str());
+    MplScheduler scheduler(ss.str());
+    scheduler.Init();
+    std::vector<T*> parsers;
+    std::vector<std::unique_ptr<ASTFileLoadTask<T>>> tasks;
+    for (uint32 i = begin; i < end; ++i) {
+      MemPool *fileMp = FEUtils::NewMempool("MemPool for ASTParser", false /* isLcalPool */);
+      fileMemPools.push_back(fileMp);
+      MapleAllocator *fileAllocator = fileMp->New<MapleAllocator>(fileMp);
+      T *parser = fileMp->New<T>(*fileAllocator, i, fileNames[i], astStructs, astFuncs, astVars,
+                                 astFileScopeAsms, astEnums);
+      parsers.push_back(parser);
+      tasks.push_back(std::make_unique<ASTFileLoadTask<T>>(*parser, *fileAllocator));
+      scheduler.AddTask(*tasks.back());
+    }
+    // mempool blocks come from the shared controller, which is locked in parallel mode only
+    bool isParallel = ThreadEnv::IsMeParallel();
+    ThreadEnv::SetMeParallel(true);
+    (void)scheduler.RunTask(end - begin, false);
+    ThreadEnv::SetMeParallel(isParallel);
+    timer.StopAndDumpTimeMS(ss.str());
+    for (uint32 i = begin; i < end; ++i) {
+      if (!tasks[i - begin]->IsSucceeded()) {
+        ERR(kLncErr, "failed to open astfile %s", fileNames[i].c_str());
+        return false;
+      }
+      FETimer retrieveTimer;
+      std::stringstream retrieveSs;
+      retrieveSs << "ReadASTFile[" << (i + 1) << "/" << fileNames.size() << "]: " << fileNames[i];
+      retrieveTimer.StartAndDump(retrieveSs.str());
+      TRY_DO(RetrieveASTFile(*parsers[i - begin], allocatorIn, fileNames[i]));
+      RegisterFileInfo(fileNames[i]);
+      retrieveTimer.StopAndDumpTimeMS(retrieveSs.str());
+    }
+  }
+  return true;
+}
+
 template<class T>
 void ASTInput<T>::RegisterFileInfo(const std::string &fileName) {
   GStrIdx fileNameIdx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName(fileName);
@@ -15,7 +15,10 @@
 #ifndef HIR2MPL_AST_INPUT_INCLUDE_AST_INPUT_H
 #define HIR2MPL_AST_INPUT_INCLUDE_AST_INPUT_H
 #include <string>
+#include <vector>
 #include "mir_module.h"
+#include "mpl_scheduler.h"
+#include "fe_utils.h"
 #include "ast_decl.h"
 #include "ast_parser.h"
 #ifdef ENABLE_MAST
@@ -23,6 +26,26 @@
 #endif
 
 namespace maple {
+// Opens one .ast file and collects its top level decls, which only touches the clang ASTContext of that file.
+template<class T>
+class ASTFileLoadTask : public MplTask {
+ public:
+  ASTFileLoadTask(T &parserIn, MapleAllocator &allocatorIn) : parser(parserIn), allocator(allocatorIn) {}
+  ~ASTFileLoadTask() override = default;
+
+  bool IsSucceeded() const {
+    return succeeded;
+  }
+
+ protected:
+  int RunImpl(MplTaskParam *param) override;
+
+ private:
+  T &parser;
+  MapleAllocator &allocator;
+  bool succeeded = false;
+};
+
 template<class T>
 class ASTInput {
  public:
@@ -30,6 +53,7 @@ class ASTInput {
   ~ASTInput() = default;
   bool ReadASTFile(MapleAllocator &allocatorIn, uint32 index, const std::string &fileName);
   bool ReadASTFiles(MapleAllocator &allocatorIn, const std::vector<std::string> &fileNames);
+  bool ReadASTFilesParallel(MapleAllocator &allocatorIn, const std::vector<std::string> &fileNames, uint32 nthreads);
   const MIRModule &GetModule() const {
     return module;
   }
@@ -81,9 +105,15 @@ class ASTInput {
     astVars.clear();
     astFileScopeAsms.clear();
     astEnums.clear();
+    for (MemPool *fileMp : fileMemPools) {
+      FEUtils::DeleteMempoolPtr(fileMp);
+    }
+    fileMemPools.clear();
   }
 
  private:
+  bool RetrieveASTFile(T &parser, MapleAllocator &allocatorIn, const std::string &fileName);
+
   MIRModule &module;
   MapleAllocator &allocator;
   MapleMap<std::string, T*> parserMap;
@@ -93,6 +123,8 @@ class ASTInput {
   MapleList<ASTVar*> astVars;
   MapleList<ASTFileScopeAsm*> astFileScopeAsms;
   MapleList<ASTEnumDecl*> astEnums;
+  // parsers loaded in parallel are allocated in their own mempools, released with the ast member variables
+  std::vector<MemPool*> fileMemPools;
 };
 }
 #endif  // HIR2MPL_AST_INPUT_INCLUDE_AST_INPUT_H
@@ -21,6 +21,25 @@
 
 namespace maple {
 namespace bc {
+class DexParser;
+// Decodes the class defs [begin, end) of a dex, see DexParser::RetrieveAllClasses.
+class DexClassDecodeTask : public MplTask {
+ public:
+  DexClassDecodeTask(DexParser &parserIn, std::vector<std::unique_ptr<DexClass>> &dexClassesIn,
+                     uint32 beginIn, uint32 endIn)
+      : parser(parserIn), dexClasses(dexClassesIn), begin(beginIn), end(endIn) {}
+  ~DexClassDecodeTask() override = default;
+
+ protected:
+  int RunImpl(MplTaskParam *param) override;
+
+ private:
+  DexParser &parser;
+  std::vector<std::unique_ptr<DexClass>> &dexClasses;
+  uint32 begin;
+  uint32 end;
+};
+
 class DexParser : public BCParser<DexReader> {
  public:
   DexParser(uint32 fileIdxIn, const std::string &fileNameIn, const std::list<std::string> &classNamesIn);
@@ -29,6 +48,7 @@ class DexParser : public BCParser<DexReader> {
                              uint32 index, std::pair<uint32, uint32> &idxPair);
   void SetDexFile(std::unique_ptr<IDexFile> iDexFileIn);
   std::unique_ptr<BCClass> FindClassDef(const std::string &className);
+  std::unique_ptr<DexClass> DecodeDexClass(uint32 classIdx);
 
  protected:
   const BCReader *GetReaderImpl() const override;
@@ -46,7 +66,11 @@ class DexParser : public BCParser<DexReader> {
 
  private:
   std::unique_ptr<DexClass> ProcessDexClass(uint32 classIdx);
+  void DecodeDexClassesParallel(std::vector<std::unique_ptr<DexClass>> &dexClasses, uint32 nthreads);
+  void ProcessDexClassModuleData(const std::unique_ptr<DexClass> &dexClass);
   void ProcessDexClassDef(const std::unique_ptr<DexClass> &dexClass);
+  void ProcessDexClassDefInfo(const std::unique_ptr<DexClass> &dexClass);
+  void ProcessDexClassNames(const std::unique_ptr<DexClass> &dexClass);
   void ProcessDexClassInterfaceParent(const std::unique_ptr<DexClass> &dexClass);
   void ProcessDexClassFields(const std::unique_ptr<DexClass> &dexClass);
   void ProcessDexClassMethods(const std::unique_ptr<DexClass> &dexClass, bool isVirtual);
@@ -19,9 +19,23 @@
 #include "fe_manager.h"
 #include "fe_options.h"
 #include "dex_file_util.h"
+#include "thread_env.h"
 
 namespace maple {
 namespace bc {
+namespace {
+// class defs decoded by one task, and the least number of them worth decoding in parallel
+constexpr uint32 kClassesPerDecodeTask = 64;
+}
+
+int DexClassDecodeTask::RunImpl(MplTaskParam *param) {
+  (void)param;
+  for (uint32 classIdx = begin; classIdx < end; ++classIdx) {
+    dexClasses[classIdx] = parser.DecodeDexClass(classIdx);
+  }
+  return 0;
+}
+
 DexParser::DexParser(uint32 fileIdxIn, const std::string &fileNameIn, const std::list<std::string> &classNamesIn)
     : BCParser<DexReader>(fileIdxIn, fileNameIn, classNamesIn) {}
 
@@ -58,12 +72,43 @@ bool DexParser::RetrieveUserSpecifiedClasses(std::list<std::unique_ptr<BCClass>>
 
 bool DexParser::RetrieveAllClasses(std::list<std::unique_ptr<BCClass>> &klasses) {
   uint32 classItemsSize = reader->GetClassItemsSize();
-  for (uint32 classIdx = 0; classIdx < classItemsSize; ++classIdx) {
-    klasses.push_back(ProcessDexClass(classIdx));
+  uint32 nthreads = FEOptions::GetInstance().GetNThreads();
+  if (nthreads <= 1 || classItemsSize < kClassesPerDecodeTask * 2) {
+    for (uint32 classIdx = 0; classIdx < classItemsSize; ++classIdx) {
+      klasses.push_back(ProcessDexClass(classIdx));
+    }
+    return true;
+  }
+  std::vector<std::unique_ptr<DexClass>> dexClasses(classItemsSize);
+  DecodeDexClassesParallel(dexClasses, nthreads);
+  for (std::unique_ptr<DexClass> &dexClass : dexClasses) {
+    ProcessDexClassModuleData(dexClass);
+    klasses.push_back(std::move(dexClass));
   }
   return true;
 }
 
+// The class def infos, fields and method headers only read the mapped dex file into class-local state, so the
+// classes are decoded by chunks in parallel. Interning the names and registering the source files change the global
+// string table and the module file infos, which are done afterwards in class order with the module data, keeping the
+// string and file indexes the same as a serial run.
+void DexParser::DecodeDexClassesParallel(std::vector<std::unique_ptr<DexClass>> &dexClasses, uint32 nthreads) {
+  MplScheduler scheduler("DexParser::DecodeDexClassesParallel");
+  scheduler.Init();
+  std::vector<std::unique_ptr<DexClassDecodeTask>> tasks;
+  uint32 classItemsSize = static_cast<uint32>(dexClasses.size());
+  for (uint32 begin = 0; begin < classItemsSize; begin += kClassesPerDecodeTask) {
+    uint32 end = std::min(begin + kClassesPerDecodeTask, classItemsSize);
+    tasks.push_back(std::make_unique<DexClassDecodeTask>(*this, dexClasses, begin, end));
+    scheduler.AddTask(*tasks.back());
+  }
+  // the method mempools come from the mempool controller, which is locked in parallel mode only
+  bool isParallel = ThreadEnv::IsMeParallel();
+  ThreadEnv::SetMeParallel(true);
+  (void)scheduler.RunTask(std::min(nthreads, static_cast<uint32>(tasks.size())), false);
+  ThreadEnv::SetMeParallel(isParallel);
+}
+
 bool DexParser::CollectAllDepTypeNamesImpl(std::unordered_set<std::string> &depSet) {
   return reader->ReadAllDepTypeNames(depSet);
 }
@@ -95,32 +140,52 @@ std::unique_ptr<BCClass> DexParser::FindClassDef(const std::string &className) {
 }
 
 std::unique_ptr<DexClass> DexParser::ProcessDexClass(uint32 classIdx) {
+  std::unique_ptr<DexClass> dexClass = DecodeDexClass(classIdx);
+  ProcessDexClassModuleData(dexClass);
+  return dexClass;
+}
+
+std::unique_ptr<DexClass> DexParser::DecodeDexClass(uint32 classIdx) {
   std::unique_ptr<DexClass> dexClass = std::make_unique<DexClass>(classIdx, *this);
-  ProcessDexClassDef(dexClass);
+  ProcessDexClassDefInfo(dexClass);
   ProcessDexClassFields(dexClass);
   // direct methods are ahead of virtual methods in class
   ProcessDexClassMethods(dexClass, false);
   ProcessDexClassMethods(dexClass, true);
+  return dexClass;
+}
+
+void DexParser::ProcessDexClassModuleData(const std::unique_ptr<DexClass> &dexClass) {
+  ProcessDexClassNames(dexClass);
   ProcessDexClassAnnotationDirectory(dexClass);
   if (!FEOptions::GetInstance().IsGenMpltOnly()) {
     ProcessDexClassStaticFieldInitValue(dexClass);
   }
-  return dexClass;
 }
 
 void DexParser::ProcessDexClassDef(const std::unique_ptr<DexClass> &dexClass) {
+  ProcessDexClassDefInfo(dexClass);
+  ProcessDexClassNames(dexClass);
+}
+
+void DexParser::ProcessDexClassDefInfo(const std::unique_ptr<DexClass> &dexClass) {
   uint32 classIdx = dexClass->GetClassIdx();
   dexClass->SetFilePathName(fileName);
+  dexClass->SetAccFlag(reader->GetClassAccFlag(classIdx));
+  dexClass->SetIsInterface(reader->IsInterface(classIdx));
+  dexClass->SetSuperClasses(reader->GetSuperClasses(classIdx));
+  ProcessDexClassInterfaceParent(dexClass);
+}
+
+// interns the class names and registers the source file in the module, not to be run by the decode workers
+void DexParser::ProcessDexClassNames(const std::unique_ptr<DexClass> &dexClass) {
+  uint32 classIdx = dexClass->GetClassIdx();
   const char *srcFileName = reader->GetClassJavaSourceFileName(classIdx);
   dexClass->SetSrcFileInfo(srcFileName == nullptr ? "unknown" : srcFileName);
-  dexClass->SetAccFlag(reader->GetClassAccFlag(classIdx));
   const std::string &className = reader->GetClassName(classIdx);
   dexClass->SetClassName(className);
-  dexClass->SetIsInterface(reader->IsInterface(classIdx));
-  dexClass->SetSuperClasses(reader->GetSuperClasses(classIdx));
   GStrIdx irSrcFileSigIdx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName(reader->GetIRSrcFileSignature());
   dexClass->SetIRSrcFileSigIdx(irSrcFileSigIdx);
-  ProcessDexClassInterfaceParent(dexClass);
 }
 
 void DexParser::ProcessDexClassFields(const std::unique_ptr<DexClass> &dexClass) {
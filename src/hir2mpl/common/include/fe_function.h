@@ -74,6 +74,7 @@ class FEFunction {
   }
 
   void Init() {
+    FEIRNodeArena::Scope scope(nodeArena.get());
     InitImpl();
   }
 
@@ -81,14 +82,17 @@ class FEFunction {
   void InsertFEIRStmtsBefore(FEIRStmt &pos, std::list<UniqueFEIRStmt> &stmts);
 
   void PreProcess() {
+    FEIRNodeArena::Scope scope(nodeArena.get());
     PreProcessImpl();
   }
 
   bool Process() {
+    FEIRNodeArena::Scope scope(nodeArena.get());
     return ProcessImpl();
   }
 
   void Finish() {
+    FEIRNodeArena::Scope scope(nodeArena.get());
     FinishImpl();
   }
 
@@ -179,6 +183,8 @@ class FEFunction {
   void BuildMapLabelIdx();
   bool CheckPhaseResult(const std::string &phaseName);
 
+  // declared first, so it outlives the nodes held by the members below and by the derived classes
+  UniqueFEIRNodeArena nodeArena;
   FEIRStmt *genStmtHead;
   FEIRStmt *genStmtTail;
   std::list<FEIRStmt*> genStmtListRaw;
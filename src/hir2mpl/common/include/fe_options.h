@@ -200,6 +200,14 @@ class FEOptions {
     return isExportInlineMplt;
   }
 
+  void SetInlineDb() {
+    isInlineDb = true;
+  }
+
+  bool IsInlineDb() const {
+    return isInlineDb;
+  }
+
   void EnableDumpInstComment() {
     isDumpInstComment = true;
   }
@@ -558,6 +566,7 @@ class FEOptions {
   bool isDumpInstComment = false;
   bool isNoMplFile = false;
   bool isExportInlineMplt = false;
+  bool isInlineDb = false;
 
   // debug info control options
   int dumpLevel;
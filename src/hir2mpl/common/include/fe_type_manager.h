@@ -239,7 +239,12 @@ class FETypeManager {
   }
 
   void InsertBoundaryLenExprHashMap(uint32 hash, UniqueFEIRExpr expr) {
-    (void)boundaryLenExprHashMap.insert(std::make_pair(hash, std::move(expr)));
+    if (boundaryLenExprHashMap.find(hash) != boundaryLenExprHashMap.end()) {
+      return;
+    }
+    // the cache outlives the functions, keep a heap copy rather than pinning the node arena of the current one
+    FEIRNodeArena::Scope heapScope(nullptr);
+    (void)boundaryLenExprHashMap.insert(std::make_pair(hash, expr->Clone()));
   }
 
   UniqueFEIRExpr GetBoundaryLenExprFromMap(uint32 hash) {
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef HIR2MPL_COMMON_INCLUDE_FEIR_NODE_ARENA_H
+#define HIR2MPL_COMMON_INCLUDE_FEIR_NODE_ARENA_H
+#include <atomic>
+#include <memory>
+#include "mempool.h"
+
+namespace maple {
+// Arena of the FEIRStmt and FEIRExpr nodes of one function.
+// The nodes are still owned by UniqueFEIRStmt/UniqueFEIRExpr, but while a Scope of an arena is active on the thread,
+// their operator new takes them from the arena mempool and their operator delete only runs the destructor.
+// The mempool is released in bulk once its owner released the arena and every node allocated from it was deleted,
+// so a node escaping its function (e.g. into a cache of the type manager) keeps the arena alive instead of dangling.
+// Outside any Scope, nodes are allocated from the heap as usual.
+class FEIRNodeArena {
+ public:
+  static FEIRNodeArena *Create() {
+    return new FEIRNodeArena();
+  }
+
+  // called by the owner instead of delete
+  void Release() {
+    Unref();
+  }
+
+  static void *Allocate(size_t size);
+  static void Deallocate(void *ptr);
+
+  static FEIRNodeArena *GetCurrent() {
+    return current;
+  }
+
+  // only meaningful before Release
+  size_t GetNumLiveNodes() const {
+    return refCount.load() - 1;
+  }
+
+  // makes the arena current for the node allocations of this thread, nullptr allocates from the heap
+  class Scope {
+   public:
+    explicit Scope(FEIRNodeArena *arena) : saved(current) {
+      current = arena;
+    }
+
+    ~Scope() {
+      current = saved;
+    }
+
+   private:
+    FEIRNodeArena *saved;
+  };
+
+ private:
+  FEIRNodeArena();
+  ~FEIRNodeArena();
+  void Unref();
+
+  MemPool *mp;
+  std::atomic<size_t> refCount{1};  // live nodes, plus one for the owner
+  static thread_local FEIRNodeArena *current;
+};
+
+struct FEIRNodeArenaReleaser {
+  void operator()(FEIRNodeArena *arena) const {
+    arena->Release();
+  }
+};
+using UniqueFEIRNodeArena = std::unique_ptr<FEIRNodeArena, FEIRNodeArenaReleaser>;
+}  // namespace maple
+#endif  // HIR2MPL_COMMON_INCLUDE_FEIR_NODE_ARENA_H
@@ -36,6 +36,7 @@
 #include "feir_dfg.h"
 #include "int128_util.h"
 #include "pragma_status.h"
+#include "feir_node_arena.h"
 
 namespace maple {
 class FEIRBuilder;
@@ -111,6 +112,15 @@ class FEIRStmt : public FELinkListNode {
       : kind(kStmt) {} // kStmt as default
 
   ~FEIRStmt() override = default;
+
+  static void *operator new(size_t size) {
+    return FEIRNodeArena::Allocate(size);
+  }
+
+  static void operator delete(void *ptr) {
+    FEIRNodeArena::Deallocate(ptr);
+  }
+
   void RegisterDFGNodes2CheckPoint(FEIRStmtCheckPoint &checkPoint) {
     RegisterDFGNodes2CheckPointImpl(checkPoint);
   }
@@ -386,6 +396,15 @@ class FEIRExpr {
   virtual ~FEIRExpr() = default;
   FEIRExpr(const FEIRExpr&) = delete;
   FEIRExpr& operator=(const FEIRExpr&) = delete;
+
+  static void *operator new(size_t size) {
+    return FEIRNodeArena::Allocate(size);
+  }
+
+  static void operator delete(void *ptr) {
+    FEIRNodeArena::Deallocate(ptr);
+  }
+
   std::string DumpDotString() const;
   std::unique_ptr<FEIRExpr> Clone();
 
@@ -68,6 +68,7 @@ class HIR2MPLOptions {
   bool ProcessOutputName(const maplecl::OptionInterface &outputName) const;
   bool ProcessInlineMpltDir(const maplecl::OptionInterface &inlineMpltDir) const;
   bool ProcessExportInlineMplt(const maplecl::OptionInterface &) const;
+  bool ProcessInlineDb(const maplecl::OptionInterface &) const;
   bool ProcessGenMpltOnly(const maplecl::OptionInterface &) const;
   bool ProcessGenAsciiMplt(const maplecl::OptionInterface &) const;
   bool ProcessDumpInstComment(const maplecl::OptionInterface &) const;
@@ -28,7 +28,8 @@
 
 namespace maple {
 FEFunction::FEFunction(MIRFunction &argMIRFunction, const std::unique_ptr<FEFunctionPhaseResult> &argPhaseResultTotal)
-    : genStmtHead(nullptr),
+    : nodeArena(FEIRNodeArena::Create()),
+      genStmtHead(nullptr),
       genStmtTail(nullptr),
       genBBHead(nullptr),
       genBBTail(nullptr),
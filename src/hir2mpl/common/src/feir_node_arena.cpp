@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "feir_node_arena.h"
+#include "fe_utils.h"
+
+namespace maple {
+namespace {
+// every node is preceded by the arena it comes from, nullptr for the heap; keeps the 8 byte alignment of mempool
+constexpr size_t kNodeHeaderSize = sizeof(FEIRNodeArena*);
+}
+
+thread_local FEIRNodeArena *FEIRNodeArena::current = nullptr;
+
+FEIRNodeArena::FEIRNodeArena()
+    : mp(FEUtils::NewMempool("MemPool for FEIR nodes", false /* isLcalPool */)) {}
+
+FEIRNodeArena::~FEIRNodeArena() {
+  FEUtils::DeleteMempoolPtr(mp);
+  mp = nullptr;
+}
+
+void *FEIRNodeArena::Allocate(size_t size) {
+  FEIRNodeArena *arena = current;
+  void *base = nullptr;
+  if (arena != nullptr) {
+    base = arena->mp->Malloc(size + kNodeHeaderSize);
+    ++arena->refCount;
+  } else {
+    base = ::operator new(size + kNodeHeaderSize);
+  }
+  *static_cast<FEIRNodeArena**>(base) = arena;
+  return static_cast<uint8*>(base) + kNodeHeaderSize;
+}
+
+void FEIRNodeArena::Deallocate(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  void *base = static_cast<uint8*>(ptr) - kNodeHeaderSize;
+  FEIRNodeArena *arena = *static_cast<FEIRNodeArena**>(base);
+  if (arena == nullptr) {
+    ::operator delete(base);
+    return;
+  }
+  arena->Unref();
+}
+
+void FEIRNodeArena::Unref() {
+  if (refCount.fetch_sub(1) == 1) {
+    delete this;
+  }
+}
+}  // namespace maple
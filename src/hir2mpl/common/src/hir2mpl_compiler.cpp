@@ -19,6 +19,7 @@
 #include "fe_manager.h"
 #include "fe_file_type.h"
 #include "fe_timer.h"
+#include "inline_db.h"
 #include "inline_mplt.h"
 #ifndef ONLY_C
 #include "rc_setter.h"
@@ -237,9 +238,13 @@ void HIR2MPLCompiler::ExportMplFile() {
     if (isInlineNeeded) {
       std::string curPath = FileUtils::GetCurDirPath();
       auto fileName = FEFileType::GetName(outNameWithoutType, false);
-      fileName = fileName + "_" +
-                 FileUtils::GetFileNameHashStr(curPath + kFileSeperatorChar + outNameWithoutType) + ".mplt_inline";
-      modInline->DumpInlineCandidateToFile(FEOptions::GetInstance().GetInlineMpltDir() + kFileSeperatorChar + fileName);
+      fileName = fileName + "_" + FileUtils::GetFileNameHashStr(curPath + kFileSeperatorChar + outNameWithoutType);
+      fileName = FEOptions::GetInstance().GetInlineMpltDir() + kFileSeperatorChar + fileName;
+      if (FEOptions::GetInstance().IsInlineDb()) {
+        (void)modInline->DumpInlineCandidateToDB(fileName + InlineDB::kFileSuffix);
+      } else {
+        modInline->DumpInlineCandidateToFile(fileName + ".mplt_inline");
+      }
     }
   }
   timer.StopAndDumpTimeMS("Output mpl");
@@ -83,6 +83,8 @@ bool HIR2MPLOptions::InitFactory() {
                                          &HIR2MPLOptions::ProcessInlineMpltDir);
   RegisterFactoryFunction<OptionFactory>(&opts::exportMpltInline,
                                          &HIR2MPLOptions::ProcessExportInlineMplt);
+  RegisterFactoryFunction<OptionFactory>(&opts::inlineDb,
+                                         &HIR2MPLOptions::ProcessInlineDb);
 
   // debug info control options
   RegisterFactoryFunction<OptionFactory>(&opts::hir2mpl::dumpLevel,
@@ -331,6 +333,11 @@ bool HIR2MPLOptions::ProcessExportInlineMplt(const maplecl::OptionInterface &) c
   return true;
 }
 
+bool HIR2MPLOptions::ProcessInlineDb(const maplecl::OptionInterface &) const {
+  FEOptions::GetInstance().SetInlineDb();
+  return true;
+}
+
 bool HIR2MPLOptions::ProcessGenMpltOnly(const maplecl::OptionInterface &) const {
   FEOptions::GetInstance().SetIsGenMpltOnly(true);
   return true;
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "fe_manager.h"
+#include "fe_options.h"
+#include "ast_input-inl.h"
+
+namespace maple {
+class AstInputTest : public testing::Test {
+ public:
+  static MemPool *mp;
+  MapleAllocator allocator;
+  AstInputTest() : allocator(mp) {}
+  virtual ~AstInputTest() = default;
+
+  static void SetUpTestCase() {
+    mp = FEUtils::NewMempool("MemPool for AstInputTest", false /* isLcalPool */);
+  }
+
+  static void TearDownTestCase() {
+    FEOptions::GetInstance().SetNThreads(1);
+    delete mp;
+    mp = nullptr;
+  }
+
+  bool ReadASTFiles(uint32 nthreads, const std::vector<std::string> &fileNames) {
+    FEOptions::GetInstance().SetNThreads(nthreads);
+    ASTInput<ASTParser> astInput(FEManager::GetManager().GetModule(), allocator);
+    bool res = astInput.ReadASTFiles(allocator, fileNames);
+    astInput.ClearASTMemberVariable();
+    return res;
+  }
+};
+MemPool *AstInputTest::mp = nullptr;
+
+TEST_F(AstInputTest, MissingFileSerial) {
+  EXPECT_FALSE(ReadASTFiles(1, { "ast_input_test_missing0.ast", "ast_input_test_missing1.ast" }));
+}
+
+TEST_F(AstInputTest, MissingFileParallel) {
+  EXPECT_FALSE(ReadASTFiles(2, { "ast_input_test_missing0.ast", "ast_input_test_missing1.ast" }));
+}
+}  // namespace maple
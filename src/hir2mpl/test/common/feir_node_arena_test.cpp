@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <gtest/gtest.h>
+#include <memory>
+#include "feir_test_base.h"
+#include "feir_stmt.h"
+#include "feir_node_arena.h"
+#include "feir_builder.h"
+
+namespace maple {
+class FEIRNodeArenaTest : public FEIRTestBase {
+ public:
+  FEIRNodeArenaTest() = default;
+  virtual ~FEIRNodeArenaTest() = default;
+};
+
+TEST_F(FEIRNodeArenaTest, AllocateInScope) {
+  UniqueFEIRNodeArena arena(FEIRNodeArena::Create());
+  UniqueFEIRExpr heapExpr = FEIRBuilder::CreateExprConstAnyScalar(PTY_i32, 1);
+  EXPECT_EQ(arena->GetNumLiveNodes(), 0U);
+  {
+    FEIRNodeArena::Scope scope(arena.get());
+    EXPECT_EQ(FEIRNodeArena::GetCurrent(), arena.get());
+    UniqueFEIRExpr expr = FEIRBuilder::CreateExprConstAnyScalar(PTY_i32, 2);
+    UniqueFEIRStmt stmt = std::make_unique<FEIRStmt>(FEIRNodeKind::kStmtPesudoFuncStart);
+    EXPECT_EQ(arena->GetNumLiveNodes(), 2U);
+    {
+      FEIRNodeArena::Scope heapScope(nullptr);
+      UniqueFEIRExpr exprClone = expr->Clone();
+      EXPECT_EQ(arena->GetNumLiveNodes(), 2U);
+    }
+    stmt.reset();
+    EXPECT_EQ(arena->GetNumLiveNodes(), 1U);
+  }
+  EXPECT_EQ(FEIRNodeArena::GetCurrent(), nullptr);
+  EXPECT_EQ(arena->GetNumLiveNodes(), 0U);
+}
+
+TEST_F(FEIRNodeArenaTest, NodeOutlivesOwner) {
+  UniqueFEIRNodeArena arena(FEIRNodeArena::Create());
+  UniqueFEIRExpr expr;
+  {
+    FEIRNodeArena::Scope scope(arena.get());
+    expr = FEIRBuilder::CreateExprConstAnyScalar(PTY_i64, 42);
+  }
+  // the mempool stays alive until the escaped node is deleted
+  arena.reset();
+  EXPECT_EQ(expr->GetKind(), kExprConst);
+  EXPECT_EQ(static_cast<FEIRExprConst*>(expr.get())->GetValue().i64, 42);
+  expr.reset();
+}
+}  // namespace maple
@@ -30,6 +30,7 @@ class SwitchLowerer {
         stmt(&stmt),
         cgLowerer(lower),
         switchItems(allocator.Adapter()),
+        bitTestItems(allocator.Adapter()),
         ownAllocator(&allocator) {}
 
   SwitchLowerer(maple::MIRModule &mod, maple::SwitchNode &stmt,
@@ -37,6 +38,7 @@ class SwitchLowerer {
       : mirModule(mod),
         stmt(&stmt),
         switchItems(allocator.Adapter()),
+        bitTestItems(allocator.Adapter()),
         ownAllocator(&allocator) {}
 
   ~SwitchLowerer() = default;
@@ -58,15 +60,31 @@ class SwitchLowerer {
    * gives the upper limit of the dense range)
    */
   maple::MapleVector<SwitchItem> switchItems;  /* uint32 is index in switchTable */
+  /*
+   * switch items whose range is tested with a bit mask per jump target instead of
+   * a rangegoto, keyed by the index in switchTable of their first case
+   */
+  maple::MapleSet<maple::int32> bitTestItems;
   maple::MapleAllocator *ownAllocator;
   const maple::int32 kClusterSwitchCutoff = 5;
   const float kClusterSwitchDensityHigh = 0.4;
   const float kClusterSwitchDensityLow = 0.2;
   const maple::int32 kMaxRangeGotoTableSize = 127;
+  const maple::uint32 kMaxBitTestTargets = 3;
+  /* number of cases a bit test cluster needs to beat the equality checks, indexed by its number of targets */
+  const maple::int32 kBitTestMinCases[4] = { 0, 3, 5, 6 };
+  const maple::uint32 kMaxPeeledCases = 2;
+  /* a case is peeled when it takes at least this share of the executions not peeled yet */
+  const float kPeelCaseRatio = 0.5;
   bool jumpToDefaultBlockGenerated = false;
 
   void FindClusters(MapleVector<Cluster> &clusters) const;
-  void InitSwitchItems(MapleVector<Cluster> &clusters);
+  void FindBitTestClusters(MapleVector<Cluster> &clusters, MapleVector<Cluster> &bitTests) const;
+  void InitSwitchItems(MapleVector<Cluster> &clusters, MapleVector<Cluster> &bitTests);
+  maple::BlockNode *BuildBitTestBlock(int32 startIdx, int32 endIdx, FreqType freqSum);
+  maple::BlockNode *BuildClusterJump(uint32 itemIdx, LabelIdx newLabelIdx, FreqType freqSum);
+  void PeelHotCases(maple::BlockNode &blk);
+  int32 FindWeightedMid(int32 start, int32 end);
   maple::RangeGotoNode *BuildRangeGotoNode(int32 startIdx, int32 endIdx, LabelIdx newLabelIdx);
   maple::CompareNode *BuildCmpNode(Opcode opCode, uint32 idx);
   maple::GotoNode *BuildGotoNode(int32 idx);
@@ -74,6 +92,9 @@ class SwitchLowerer {
   maple::BlockNode *BuildCodeForSwitchItems(int32 start, int32 end, bool lowBlockNodeChecked,
                                             bool highBlockNodeChecked, FreqType freqSum, LabelIdx newLabelIdx = 0);
   FreqType SumFreq(uint32 startIdx, uint32 endIdx);
+  FreqType GetLabelFreq(LabelIdx label);
+  bool HasLabelFreq() const;
+  bool IsBitTestEnabled() const;
 };
 }  /* namespace maplebe */
 
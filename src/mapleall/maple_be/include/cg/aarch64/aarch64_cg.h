@@ -40,6 +40,7 @@
 #include "aarch64_dup.h"
 #include "aarch64_ra_opt.h"
 #include "aarch64_proepilog.h"
+#include "aarch64_outliner.h"
 
 namespace maplebe {
 constexpr int64 kShortBRDistance = (8 * 1024);
@@ -248,6 +249,9 @@ class AArch64CG : public CG {
                                              LoopAnalysis &loop) const override {
     return mp.New<AArch64ProEpilogAnalysis>(f, mp, dom, pdom, loop);
   }
+  MachineOutliner *CreateMachineOutliner(MemPool &mp, MIRModule &mod) const override {
+    return mp.New<AArch64MachineOutliner>(mod, mp);
+  }
 
   /* Return the copy operand id of reg1 if it is an insn who just do copy from reg1 to reg2.
  * i. mov reg2, reg1
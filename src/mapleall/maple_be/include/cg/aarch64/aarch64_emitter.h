@@ -34,6 +34,8 @@ class AArch64AsmEmitter : public AsmEmitter {
   void EmitJavaInsnAddr(FuncEmitInfo &funcEmitInfo) override;
   void RecordRegInfo(FuncEmitInfo &funcEmitInfo) const;
   void Run(FuncEmitInfo &funcEmitInfo) override;
+  /* emit a function created by the machine outliner, body is emitted as is */
+  void EmitOutlinedFunction(const std::string &name, const MapleVector<Insn*> &body, bool isTailCall);
 
  private:
   /* cfi & dbg need target info ? */
@@ -45,6 +47,7 @@ class AArch64AsmEmitter : public AsmEmitter {
   void EmitAdrpLdr(Emitter &emitter, const Insn &insn) const;
   void EmitCounter(Emitter &emitter, const Insn &insn) const;
   void EmitCCounter(Emitter &emitter, const Insn &insn) const;
+  void EmitCCounterAtomic(Emitter &emitter, const Insn &insn) const;
   void EmitInlineAsm(Emitter &emitter, const Insn &insn) const;
   void EmitClinitTail(Emitter &emitter, const Insn &insn) const;
   void EmitLazyLoad(Emitter &emitter, const Insn &insn) const;
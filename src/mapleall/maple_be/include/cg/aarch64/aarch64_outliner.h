@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MAPLEBE_INCLUDE_CG_AARCH64_AARCH64_OUTLINER_H
+#define MAPLEBE_INCLUDE_CG_AARCH64_AARCH64_OUTLINER_H
+
+#include "cg_outliner.h"
+#include "aarch64_cgfunc.h"
+
+namespace maplebe {
+/*
+ * The outlined sequences neither touch the link register nor define sp or the frame pointer, and they do not access
+ * memory relative to sp, so the outlined function needs no frame and is independent of the frames of its callers.
+ * A sequence is replaced by a bl only where the return address is saved on the stack, a sequence ending with ret
+ * is replaced by a b anywhere. The linker may clobber x16/x17 in a veneer for the branch, they must be dead at the
+ * replaced sequence.
+ */
+class AArch64MachineOutliner : public MachineOutliner {
+ public:
+  AArch64MachineOutliner(MIRModule &mod, MemPool &mp)
+      : MachineOutliner(mod, mp), lrSavedBBs(alloc.Adapter()), veneerRegReaders(alloc.Adapter()) {}
+  ~AArch64MachineOutliner() override = default;
+
+  void EmitOutlinedFunctions(Emitter &emitter) const override;
+
+ protected:
+  bool GetInsnKey(const Insn &insn, std::string &key) const override;
+  bool IsReturn(const Insn &insn) const override {
+    return insn.GetMachineOpcode() == MOP_xret;
+  }
+  void AnalyzeFunction(CGFunc &func) override;
+  bool CanOutlineAt(const CGFunc &func, const Insn &first, bool isTailCall) const override;
+  Insn &BuildOutlinedCall(CGFunc &func, const MIRSymbol &symbol, bool isTailCall) const override;
+
+ private:
+  bool GetOperandKey(const Operand &opnd, std::string &key) const;
+  bool IsOutlinableSymbol(const MIRSymbol *symbol) const;
+  bool IsLRSavedAt(const Insn &insn) const;
+  bool IsVeneerRegDeadAt(const CGFunc &func, const Insn &first, regno_t reg, bool isTailCall) const;
+  static bool IsLRSavedAfter(const Insn &insn, bool saved);
+  static void GetRegRef(const Insn &insn, regno_t reg, bool &isUse, bool &isDef);
+
+  MapleSet<const BB*> lrSavedBBs;            // bbs entered with the return address saved on the stack
+  MapleSet<const CGFunc*> veneerRegReaders;  // functions reading x16 or x17
+};
+}  /* namespace maplebe */
+#endif  /* MAPLEBE_INCLUDE_CG_AARCH64_AARCH64_OUTLINER_H */
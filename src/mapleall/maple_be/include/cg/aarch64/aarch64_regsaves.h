@@ -24,70 +24,6 @@
 
 namespace maplebe {
 
-/* Saved callee-save reg info */
-class SavedRegInfo {
- public:
-  bool insertAtLastMinusOne = false;
-  explicit SavedRegInfo(MapleAllocator &alloc)
-      : saveSet(alloc.Adapter()),
-        restoreEntrySet(alloc.Adapter()),
-        restoreExitSet(alloc.Adapter()) {}
-
-  bool ContainSaveReg(regno_t r) {
-    if (saveSet.find(r) != saveSet.end()) {
-      return true;
-    }
-    return false;
-  }
-
-  bool ContainEntryReg(regno_t r) {
-    if (restoreEntrySet.find(r) != restoreEntrySet.end()) {
-      return true;
-    }
-    return false;
-  }
-
-  bool ContainExitReg(regno_t r) {
-    if (restoreExitSet.find(r) != restoreExitSet.end()) {
-      return true;
-    }
-    return false;
-  }
-
-  void InsertSaveReg(regno_t r) {
-    (void)saveSet.insert(r);
-  }
-
-  void InsertEntryReg(regno_t r) {
-    (void)restoreEntrySet.insert(r);
-  }
-
-  void InsertExitReg(regno_t r) {
-    (void)restoreExitSet.insert(r);
-  }
-
-  MapleSet<regno_t> &GetSaveSet() {
-    return saveSet;
-  }
-
-  MapleSet<regno_t> &GetEntrySet() {
-    return restoreEntrySet;
-  }
-
-  MapleSet<regno_t> &GetExitSet() {
-    return restoreExitSet;
-  }
-
-  void RemoveSaveReg(regno_t r) {
-    (void)saveSet.erase(r);
-  }
-
- private:
-  MapleSet<regno_t> saveSet;
-  MapleSet<regno_t> restoreEntrySet;
-  MapleSet<regno_t> restoreExitSet;
-};
-
 /* BBs info for saved callee-saved reg */
 class SavedBBInfo {
  public:
@@ -62,6 +62,7 @@ class LoopAnalysis;
 class DupTailOptimizer;
 class RaOpt;
 class ProEpilogAnalysis;
+class MachineOutliner;
 
 class Globals {
  public:
@@ -357,6 +358,10 @@ class CG {
   virtual ProEpilogAnalysis *CreateProEpilogAnalysis(MemPool &mp, CGFunc &f, DomAnalysis &dom, PostDomAnalysis &pdom,
                                                      LoopAnalysis &loop) const;
 
+  virtual MachineOutliner *CreateMachineOutliner(MemPool &mp, MIRModule &mod) const {
+    return nullptr;
+  }
+
   /* Object map generation helper */
   std::vector<int64> GetReferenceOffsets64(const BECommon &beCommon, MIRStructType &structType) const;
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MAPLEBE_INCLUDE_CG_CG_FUNC_CACHE_H
+#define MAPLEBE_INCLUDE_CG_CG_FUNC_CACHE_H
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "mir_module.h"
+#include "cg_option.h"
+#include "emit.h"
+#include "litepgo_callgraph.h"
+
+namespace maplebe {
+class CGFunc;
+
+/*
+ * Function level cache of the generated assembly, enabled by --cg-func-cache=<dir>.
+ * The key of a function is the digest of the module globals (types, symbols and prototypes), the cg options, the
+ * lite profile and the post-ME MIR of the function. The digest covers every global of the module, not only the
+ * ones the function references, so adding or changing any global misses all the entries of the module.
+ * The ordinal of the function is added to the key only when its assembly contains it (in the short function name,
+ * or in the local labels on x86_64), so most entries are reused wherever the function moves in the module.
+ * On a hit the cached assembly is emitted and lowering and all the CgFuncPM phases are skipped; the lite-pgo call
+ * graph of the function is stored next to the assembly and replayed on a hit.
+ * The assembly of a function is only stored if it is self-contained: its emission queued nothing for the end of
+ * the module, and it neither defines nor references global symbols created by cg (literal pools, string labels)
+ * since those are only emitted when the function creating them is actually compiled.
+ */
+class CgFuncCache {
+ public:
+  CgFuncCache(MIRModule &mod, const CGOptions &cgOptions);
+  ~CgFuncCache() = default;
+
+  bool IsEnabled() const {
+    return !cacheDir.empty();
+  }
+
+  /*
+   * Called before lowering func. Emits the cached assembly and returns true on a hit, the cached call graph of
+   * func is merged into callGraph if it is given.
+   */
+  bool Reuse(MIRFunction &func, uint32 funcId, Emitter &emitter, LitePgoCallGraph *callGraph);
+  /* Bracket the compilation of a function which missed the cache, funcCallGraph is stored with its assembly. */
+  void BeginFunction(Emitter &emitter);
+  void EndFunction(Emitter &emitter, const CGFunc &cgFunc, const LitePgoCallGraph *funcCallGraph);
+
+ private:
+  std::string DumpToString(const std::function<void()> &dumper) const;
+  void CollectCGDefinedSymbols();
+  bool IsSelfContained(const std::string &text, const Emitter &emitter);
+  bool EmitEntry(const std::string &key, Emitter &emitter, LitePgoCallGraph *callGraph) const;
+  std::string GetEntryPath(const std::string &key, const std::string &suffix) const;
+
+  MIRModule &mirModule;
+  std::string cacheDir;
+  std::string moduleDigest;
+  bool keepSrcPos = false;
+  std::string curKey;
+  std::string curOrdinalKey;  // curKey with the ordinal of the function
+  std::stringbuf funcBuf;
+  std::streambuf *savedBuf = nullptr;
+  size_t pendingNumBefore = 0;
+  size_t symNumBefore = 0;
+  size_t scannedSymNum = 0;
+  std::vector<std::string> cgDefinedSymbols;  // names of the global symbols defined by cg so far
+};
+}  /* namespace maplebe */
+#endif  /* MAPLEBE_INCLUDE_CG_CG_FUNC_CACHE_H */
@@ -120,6 +120,12 @@ class CGOptions {
     kNonLeafFP,
     kAllFP,
   };
+
+  enum LitePgoCounterMode : uint8 {
+    kPlainCounter,    // plain load/add/store, counts may be lost by concurrent increments
+    kAtomicCounter,   // exclusive load/store loop
+    kShardedCounter,  // atomic increment of a per-thread row of counters, see litepgo_format.h
+  };
   /*
    * The default CG option values are:
    * Don't BE_QUITE; verbose,
@@ -660,6 +666,18 @@ class CGOptions {
     return doLayoutColdPath;
   }
 
+  static void DisableLayoutExtTsp() {
+    doLayoutExtTsp = false;
+  }
+
+  static void EnableLayoutExtTsp() {
+    doLayoutExtTsp = true;
+  }
+
+  static bool DoLayoutExtTsp() {
+    return doLayoutExtTsp;
+  }
+
   static void DisableGlobalSchedule() {
     doGlobalSchedule = false;
   }
@@ -1504,6 +1522,14 @@ class CGOptions {
     return liteProfile;
   }
 
+  static void SetLitePgoCallGraphDir(const std::string &dir) {
+    litePgoCallGraphDir = dir;
+  }
+
+  static const std::string &GetLitePgoCallGraphDir() {
+    return litePgoCallGraphDir;
+  }
+
   static void SetFunctionPriority(std::string funcPriorityfile) {
     functionProrityFile = funcPriorityfile;
   }
@@ -1512,6 +1538,14 @@ class CGOptions {
     return functionProrityFile;
   }
 
+  static void SetFuncCacheDir(const std::string &dir) {
+    funcCacheDir = dir;
+  }
+
+  static const std::string &GetFuncCacheDir() {
+    return funcCacheDir;
+  }
+
   static void SetFunctionReorderAlgorithm(std::string algorithm) {
     functionReorderAlgorithm = algorithm;
   }
@@ -1536,6 +1570,22 @@ class CGOptions {
     return litePgoOutputFunction;
   }
 
+  static void SetLitePgoCounterMode(const std::string &mode) {
+    if (mode == "plain") {
+      litePgoCounterMode = kPlainCounter;
+    } else if (mode == "atomic") {
+      litePgoCounterMode = kAtomicCounter;
+    } else if (mode == "sharded") {
+      litePgoCounterMode = kShardedCounter;
+    } else {
+      CHECK_FATAL_FALSE("unsupported lite-pgo counter mode.");
+    }
+  }
+
+  static LitePgoCounterMode GetLitePgoCounterMode() {
+    return litePgoCounterMode;
+  }
+
   static void SetLitePgoWhiteList(std::string pgoWhiteList) {
     litePgoWhiteList = pgoWhiteList;
   }
@@ -1556,6 +1606,18 @@ class CGOptions {
     return doAggrOpt;
   }
 
+  static void EnableMachineOutline() {
+    doMachineOutline = true;
+  }
+
+  static void DisableMachineOutline() {
+    doMachineOutline = false;
+  }
+
+  static bool DoMachineOutline() {
+    return doMachineOutline;
+  }
+
   static void SetVisibilityType(const std::string &type) {
     if (type == "hidden" || type == "internal") {
       visibilityType = kHiddenVisibility;
@@ -1685,6 +1747,7 @@ class CGOptions {
   static bool doEBO;
   static bool doCGSSA;
   static bool doLayoutColdPath;
+  static bool doLayoutExtTsp;
   static bool doGlobalSchedule;
   static bool doLocalSchedule;
   static bool doVerifySchedule;
@@ -1776,12 +1839,16 @@ class CGOptions {
   static bool liteProfVerify;
   static std::string litePgoOutputFunction;
   static std::string litePgoWhiteList;
+  static LitePgoCounterMode litePgoCounterMode;
   static std::string instrumentationOutPutPath;
   static std::string liteProfile;
+  static std::string litePgoCallGraphDir;
   static std::string functionProrityFile;
+  static std::string funcCacheDir;
   static std::string functionReorderAlgorithm;
   static std::string functionReorderProfile;
   static bool doAggrOpt;
+  static bool doMachineOutline;
   static VisibilityType visibilityType;
   static TLSModel tlsModel;
   static bool doTlsGlobalWarmUpOpt;
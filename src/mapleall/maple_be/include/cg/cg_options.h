@@ -120,6 +120,7 @@ extern maplecl::Option<bool> tailcall;
 extern maplecl::Option<bool> alignAnalysis;
 extern maplecl::Option<bool> cgSsa;
 extern maplecl::Option<bool> layoutColdPath;
+extern maplecl::Option<bool> layoutExtTsp;
 extern maplecl::Option<bool> globalSchedule;
 extern maplecl::Option<bool> localSchedule;
 extern maplecl::Option<bool> calleeEnsureParam;
@@ -136,8 +137,12 @@ extern maplecl::Option<bool> litePgoGen;
 extern maplecl::Option<std::string> litePgoOutputFunc;
 extern maplecl::Option<std::string> instrumentationDir;
 extern maplecl::Option<std::string> litePgoWhiteList;
+extern maplecl::Option<std::string> litePgoCounterMode;
 extern maplecl::Option<std::string> litePgoFile;
+extern maplecl::Option<std::string> litePgoCallGraphDir;
 extern maplecl::Option<std::string> functionPriority;
+extern maplecl::Option<std::string> funcCache;
+extern maplecl::Option<bool> machineOutline;
 extern maplecl::Option<bool> litePgoVerify;
 extern maplecl::Option<bool> optimizedFrameLayout;
 extern maplecl::Option<bool> pgoCodeAlign;
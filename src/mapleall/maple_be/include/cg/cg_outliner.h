@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MAPLEBE_INCLUDE_CG_CG_OUTLINER_H
+#define MAPLEBE_INCLUDE_CG_CG_OUTLINER_H
+#include <string>
+#include <vector>
+#include "cgfunc.h"
+#include "emit.h"
+
+namespace maplebe {
+/*
+ * Machine outliner, enabled by --machine-outline.
+ * Runs on the final insn streams of all the functions of the module, after register allocation and before emission.
+ * Every outlinable insn is mapped to an integer by its opcode and operands, everything else (and every BB boundary)
+ * to a unique separator, and the repeated substrings found by the suffix array become candidates. The candidates
+ * saving the most code are outlined first: each occurrence is replaced by a call (or a tail call when the sequence
+ * ends with a return) to a local OUTLINED_FUNCTION_<n> holding one copy of the sequence.
+ * With profile data, only BBs in the cold section or executed much less than the hottest BB are outlined.
+ */
+class MachineOutliner {
+ public:
+  MachineOutliner(MIRModule &mod, MemPool &mp)
+      : mirModule(mod), memPool(mp), alloc(&mp), funcs(alloc.Adapter()), outlinedFuncs(alloc.Adapter()) {}
+  virtual ~MachineOutliner() = default;
+
+  void AddFunction(CGFunc &func) {
+    funcs.push_back(&func);
+  }
+
+  void Run();
+  virtual void EmitOutlinedFunctions(Emitter &emitter) const = 0;
+
+  struct OutlinedFunction {
+    OutlinedFunction(const MIRSymbol &sym, MapleAllocator &allocator, bool isTail)
+        : symbol(&sym), body(allocator.Adapter()), isTailCall(isTail) {}
+
+    const MIRSymbol *symbol;
+    MapleVector<Insn*> body;  // insns of the first occurrence, unlinked from its bb
+    bool isTailCall;          // body ends with a return, occurrences are replaced by a tail call
+    uint32 numOccurrences = 0;
+  };
+
+  const MapleVector<OutlinedFunction*> &GetOutlinedFunctions() const {
+    return outlinedFuncs;
+  }
+
+ protected:
+  /* The key identifies insns which are interchangeable, returns false if insn cannot be outlined at all. */
+  virtual bool GetInsnKey(const Insn &insn, std::string &key) const = 0;
+  virtual bool IsReturn(const Insn &insn) const = 0;
+  /* Collects the facts needed by CanOutlineAt once all the functions are known. */
+  virtual void AnalyzeFunction(CGFunc &func) = 0;
+  /* Whether the sequence starting at first may be replaced by a call to the outlined function. */
+  virtual bool CanOutlineAt(const CGFunc &func, const Insn &first, bool isTailCall) const = 0;
+  virtual Insn &BuildOutlinedCall(CGFunc &func, const MIRSymbol &symbol, bool isTailCall) const = 0;
+
+  MIRModule &mirModule;
+  MemPool &memPool;
+  MapleAllocator alloc;
+  MapleVector<CGFunc*> funcs;
+  MapleVector<OutlinedFunction*> outlinedFuncs;
+
+ private:
+  struct InsnPosition {
+    CGFunc *func;
+    Insn *insn;  // nullptr for separators
+  };
+
+  struct Candidate {
+    std::vector<size_t> starts;
+    size_t length;
+    bool isTailCall;
+    int64 benefit;
+  };
+
+  size_t MapInsns(std::vector<size_t> &str, std::vector<InsnPosition> &positions);
+  bool IsOutlinableBB(const BB &bb) const;
+  FreqType GetBBCount(const BB &bb) const;
+  void CollectCandidates(const std::vector<size_t> &str, size_t alphabetSize,
+                         const std::vector<InsnPosition> &positions, std::vector<Candidate> &candidates) const;
+  void Outline(const Candidate &candidate, const std::vector<InsnPosition> &positions);
+  static int64 GetBenefit(size_t numOccurrences, size_t length, bool isTailCall);
+
+  bool useProfile = false;
+  FreqType maxBBCount = 0;
+  uint32 numReplaced = 0;
+  uint32 numSavedInsns = 0;
+};
+}  /* namespace maplebe */
+#endif  /* MAPLEBE_INCLUDE_CG_CG_OUTLINER_H */
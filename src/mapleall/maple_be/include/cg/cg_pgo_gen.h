@@ -36,8 +36,10 @@ class CGProfGen {
   static void CreateProfInitExitFunc(MIRModule &m);
   static void CreateProfFileSym(MIRModule &m, std::string &outputPath, const std::string &symName);
   static void CreateChildTimeSym(MIRModule &m, const std::string &symName);
+  static uint32 GetCounterShards();
  protected:
   CGFunc *f;
+  uint32 shardRowShift = 0;  // log2 of the distance between the rows of sharded counters, 0 if not sharded
  private:
   static uint64 counterIdx;
   PGOInstrumentTemplate<maplebe::BB, maple::BBEdge<maplebe::BB>> instrumenter;
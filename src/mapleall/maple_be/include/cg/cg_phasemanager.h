@@ -14,7 +14,9 @@
  */
 #ifndef MAPLEBE_INCLUDE_CG_CG_PHASEMANAGER_H
 #define MAPLEBE_INCLUDE_CG_CG_PHASEMANAGER_H
+#include <memory>
 #include <string>
+#include <vector>
 #include "mempool.h"
 #include "mempool_allocator.h"
 #include "mir_module.h"
@@ -24,8 +26,10 @@
 #include "cgfunc.h"
 #include "cg_phase.h"
 #include "cg_option.h"
+#include "litepgo_callgraph.h"
 namespace maplebe {
 using CgFuncOptTy = MapleFunctionPhase<CGFunc>;
+class MachineOutliner;
 
 /* =================== new phase manager ===================  */
 class CgFuncPM : public FunctionPM {
@@ -52,7 +56,19 @@ class CgFuncPM : public FunctionPM {
   }
   void SweepUnusedStaticSymbol(MIRModule &m) const;
  private:
-  bool FuncLevelRun(CGFunc &cgFunc, AnalysisDataManager &serialADM);
+  /* function whose emission waits for the machine outliner, with the memory holding its code */
+  struct DeferredFunc {
+    std::unique_ptr<ThreadLocalMemPool> funcMp;
+    std::unique_ptr<StackMemPool> stackMp;
+    std::unique_ptr<MapleAllocator> funcScopeAllocator;
+    MIRFunction *mirFunc;
+    CGFunc *cgFunc;
+  };
+
+  bool FuncLevelRun(CGFunc &cgFunc, AnalysisDataManager &serialADM, size_t beginIdx, size_t endIdx);
+  MachineOutliner *CreateMachineOutliner(MIRModule &m, bool withFuncCache);
+  bool OutlineAndEmit(MIRModule &m, MachineOutliner &outliner, std::vector<DeferredFunc> &deferredFuncs,
+                      AnalysisDataManager &serialADM);
   void GenerateOutPutFile(MIRModule &m) const;
   void CreateCGAndBeCommon(MIRModule &m);
   void PrepareLower(MIRModule &m);
@@ -67,6 +83,9 @@ class CgFuncPM : public FunctionPM {
   void EmitDebugInfo(const MIRModule &m) const;
   void EmitFastFuncs(const MIRModule &m) const;
   bool IsFramework(MIRModule &m) const;
+  /* For function ordering */
+  void RecordLitePgoCallGraph(const CGFunc &f, LitePgoCallGraph &callGraph) const;
+  void WriteLitePgoCallGraph(const MIRModule &m) const;
 
   CG *cg = nullptr;
   BECommon *beCommon = nullptr;
@@ -74,6 +93,8 @@ class CgFuncPM : public FunctionPM {
   CGLowerer *cgLower = nullptr;
   /* module options */
   CGOptions *cgOptions = nullptr;
+  /* call graph weighted by the lite-pgo counts, with --lite-pgo-call-graph-dir */
+  std::unique_ptr<LitePgoCallGraph> litePgoCallGraph;
 };
 }  /* namespace maplebe */
 #endif  /* MAPLEBE_INCLUDE_CG_CG_PHASEMANAGER_H */
@@ -151,6 +151,17 @@ class Emitter {
     return currentMop;
   }
 
+  /* redirect the output to buf and return the previous buffer, used to capture the assembly of a function */
+  std::streambuf *RedirectOutput(std::streambuf *buf) {
+    return static_cast<std::ostream&>(outStream).rdbuf(buf);
+  }
+
+  /* number of entries queued by function emission to be emitted at the end of the module */
+  size_t GetPendingGlobalEntryNum() const {
+    return stringPtr.size() + localStrPtr.size() + hugeSoTargets.size() + labdie2labidxTable.size() +
+           fileMap.size() + globalTlsDataVec.size() + globalTlsBssVec.size();
+  }
+
   void SetCurrentMOP(const MOperator &mOp) {
     currentMop = mOp;
   }
@@ -18,6 +18,7 @@
 #include "cg_phase.h"
 #include "cgbb.h"
 #include "datainfo.h"
+#include "sparse_datainfo.h"
 #include "maple_phase.h"
 
 namespace maplebe {
@@ -56,7 +57,6 @@ class ReachingDefinition : public AnalysisResult {
   void DumpBBCGIR(const BB &bb) const;
   void ClearDefUseInfo();
   void UpdateInOut(BB &changedBB);
-  void UpdateInOut(BB &changedBB, bool isReg);
   void SetAnalysisMode(AnalysisType analysisMode) {
     mode = analysisMode;
   }
@@ -139,10 +139,11 @@ class ReachingDefinition : public AnalysisResult {
   std::vector<DataInfo*> regUse;
   std::vector<DataInfo*> regIn;
   std::vector<DataInfo*> regOut;
-  std::vector<DataInfo*> memGen;
-  std::vector<DataInfo*> memUse;
-  std::vector<DataInfo*> memIn;
-  std::vector<DataInfo*> memOut;
+  /* stack slots are few in each bb while the frame may be big, so they are sparse */
+  std::vector<SparseDataInfo*> memGen;
+  std::vector<SparseDataInfo*> memUse;
+  std::vector<SparseDataInfo*> memIn;
+  std::vector<SparseDataInfo*> memOut;
   const uint32 kMaxBBNum;
   uint32 stackSize = 0;
  private:
@@ -151,6 +152,7 @@ class ReachingDefinition : public AnalysisResult {
   void BuildInOutForFuncBody();
   void BuildInOutForCleanUpBB();
   void BuildInOutForCleanUpBB(bool isReg, const std::set<uint32> &index);
+  void PropagateChangedInfo(const BB &changedBB, const std::set<uint32> &changedInfoIndex, bool isReg);
   void InitRegAndMemInfo(const BB &bb);
   void InitOut(const BB &bb);
   bool GenerateIn(const BB &bb);
@@ -101,6 +101,15 @@ class SparseDataInfo {
     return info == liveInfoBak;
   }
 
+  /* the word index as DataInfo's, for the analysis updating only the words changed */
+  uint64 GetElem(uint32 index) const {
+    return info.GetWord(index);
+  }
+
+  void SetElem(uint32 index, uint64 val) {
+    info.SetWord(index, val);
+  }
+
   void AndBits(const SparseDataInfo &secondInfo) {
     info &= secondInfo.info;
   }
@@ -109,6 +118,33 @@ class SparseDataInfo {
     info |= secondInfo.info;
   }
 
+  bool OrBitsCheck(const SparseDataInfo &secondInfo) {
+    return info |= secondInfo.info;
+  }
+
+  void OrDesignateBits(const SparseDataInfo &secondInfo, uint32 infoIndex) {
+    uint64 word = secondInfo.GetElem(infoIndex);
+    if (word != 0ULL) {
+      SetElem(infoIndex, GetElem(infoIndex) | word);
+    }
+  }
+
+  void EorBits(const SparseDataInfo &secondInfo) {
+    for (auto bitNO : secondInfo.info) {
+      if (info.Test(bitNO)) {
+        info.Reset(bitNO);
+      } else {
+        info.Set(bitNO);
+      }
+    }
+  }
+
+  void GetNonZeroElemsIndex(std::set<uint32> &index) const {
+    for (auto bitNO : info) {
+      (void)index.insert(bitNO / kWordSize);
+    }
+  }
+
   /* if bit in secondElem is 1, bit in current DataInfo is set 0 */
   void Difference(const SparseDataInfo &secondInfo) {
     info.Diff(secondInfo.info);
@@ -128,6 +164,8 @@ class SparseDataInfo {
   }
 
  private:
+  /* same word size as DataInfo */
+  static constexpr uint32 kWordSize = 64;
   MapleAllocator allocator;
   MapleSparseBitVector<> info;
   uint32 maxRegNum;
@@ -28,6 +28,7 @@
 #include "x64_local_opt.h"
 #include "x64_cfgo.h"
 #include "x64_rematerialize.h"
+#include "x64_proepilog.h"
 
 namespace maplebe {
 class X64CG : public CG {
@@ -145,6 +146,10 @@ class X64CG : public CG {
     (void)f;
     return nullptr;
   }
+  ProEpilogAnalysis *CreateProEpilogAnalysis(MemPool &mp, CGFunc &f, DomAnalysis &dom, PostDomAnalysis &pdom,
+                                             LoopAnalysis &loop) const override {
+    return mp.New<X64ProEpilogAnalysis>(f, mp, dom, pdom, loop);
+  }
 
   /* Used for GCTIB pattern merging */
   std::string FindGCTIBPatternName(const std::string &name) const override;
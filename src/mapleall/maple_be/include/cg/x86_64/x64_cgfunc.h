@@ -27,7 +27,8 @@ class X64CGFunc : public CGFunc {
   X64CGFunc(MIRModule &mod, CG &c, MIRFunction &f, BECommon &b,
       MemPool &memPool, StackMemPool &stackMp, MapleAllocator &mallocator, uint32 funcId)
       : CGFunc(mod, c, f, b, memPool, stackMp, mallocator, funcId),
-        calleeSavedRegs(mallocator.Adapter()) { }
+        calleeSavedRegs(mallocator.Adapter()),
+        proEpilogSavedRegs(mallocator.Adapter()) { }
   /* null implementation yet */
   InsnVisitor *NewInsnModifier() override {
     return memPool->New<X64InsnVisitor>(*this);
@@ -251,6 +252,23 @@ class X64CGFunc : public CGFunc {
     return calleeSavedRegs;
   }
 
+  /* once regsaves placed the saves of callee saved registers, the ones left to the prolog/epilog */
+  const MapleSet<x64::X64reg> &GetProEpilogSavedRegs() const {
+    return proEpilogSavedRegs;
+  }
+
+  void AddProEpilogSavedReg(x64::X64reg reg) {
+    (void)proEpilogSavedRegs.insert(reg);
+  }
+
+  bool IsCalleeSavesPlaced() const {
+    return calleeSavesPlaced;
+  }
+
+  void SetCalleeSavesPlaced() {
+    calleeSavesPlaced = true;
+  }
+
   uint32 SizeOfCalleeSaved() const {
     uint32 size = numIntregToCalleeSave * kIntregBytelen + numFpregToCalleeSave * kFpregBytelen;
     return RoundUp(size, GetMemlayout()->GetStackPtrAlignment());
@@ -276,6 +294,8 @@ class X64CGFunc : public CGFunc {
   void FreeSpillRegMem(regno_t vrNum) override;
  private:
   MapleSet<x64::X64reg> calleeSavedRegs;
+  MapleSet<x64::X64reg> proEpilogSavedRegs;
+  bool calleeSavesPlaced = false;
   uint32 numIntregToCalleeSave = 0;
   uint32 numFpregToCalleeSave = 0;
 };
@@ -21,26 +21,43 @@
 namespace maplebe {
 using namespace maple;
 
+class X64ProEpilogAnalysis : public ProEpilogAnalysis {
+ public:
+  X64ProEpilogAnalysis(CGFunc &func, MemPool &pool, DomAnalysis &dom, PostDomAnalysis &pdom, LoopAnalysis &loop)
+      : ProEpilogAnalysis(func, pool, dom, pdom, loop) {}
+  ~X64ProEpilogAnalysis() override = default;
+
+  bool NeedProEpilog() override;
+};
+
 class X64GenProEpilog : public GenProEpilog {
  public:
-  explicit X64GenProEpilog(CGFunc &func) : GenProEpilog(func) {}
+  explicit X64GenProEpilog(CGFunc &func, const ProEpilogSaveInfo *proepiSaveInfo = nullptr)
+      : GenProEpilog(func), saveInfo(proepiSaveInfo) {}
   ~X64GenProEpilog() override = default;
 
   bool NeedProEpilog() override;
   void Run() override;
+
+  /* save/restore of a callee saved register in its frame slot, appended to the current BB of cgFunc */
+  static void AppendCalleeSavedRegInsn(CGFunc &cgFunc, x64::X64reg reg, bool isPush);
  private:
   void GenerateProlog(BB &bb);
   void GenerateEpilog(BB &bb);
+  void AppendBBtoEpilog(BB &epilogBB, BB &newBB) const;
   void GenerateCalleeSavedRegs(bool isPush);
-  void GeneratePushCalleeSavedRegs(RegOperand &regOpnd, MemOperand &memOpnd, uint32 regSize);
-  void GeneratePopCalleeSavedRegs(RegOperand &regOpnd, MemOperand &memOpnd, uint32 regSize);
+  static int64 GetCalleeSavedRegOffset(CGFunc &cgFunc, x64::X64reg reg);
+  static void GeneratePushCalleeSavedRegs(CGFunc &cgFunc, RegOperand &regOpnd, MemOperand &memOpnd, uint32 regSize);
+  static void GeneratePopCalleeSavedRegs(CGFunc &cgFunc, RegOperand &regOpnd, MemOperand &memOpnd, uint32 regSize);
   void GeneratePushUnnamedVarargRegs();
   void GeneratePushRbpInsn();
   void GenerateMovRspToRbpInsn();
   void GenerateSubFrameSizeFromRspInsn();
   void GenerateAddFrameSizeToRspInsn();
   void GeneratePopInsn();
-  void GenerateRetInsn();
+  void GenerateRetInsn(BB &bb);
+
+  const ProEpilogSaveInfo *saveInfo = nullptr;
 };
 }  /* namespace maplebe */
 
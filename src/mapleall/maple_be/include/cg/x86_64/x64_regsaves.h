@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MAPLEBE_INCLUDE_CG_X64_X64_REGSAVES_H
+#define MAPLEBE_INCLUDE_CG_X64_X64_REGSAVES_H
+
+#include "cg.h"
+#include "regsaves.h"
+#include "x64_abi.h"
+#include "x64_cg.h"
+
+namespace maplebe {
+/*
+ * Callee-save registers save/restore placement, following AArch64RegSavesOpt: ssa-pre places the saves of each
+ * register, ssu-pre its restores. The registers it cannot place are saved in the prolog as before. Saves and
+ * restores use the frame slots of the prolog, so X64GenProEpilog sets up the frame before any of them.
+ */
+class X64RegSavesOpt : public RegSavesOpt {
+ public:
+  X64RegSavesOpt(CGFunc &func, MemPool &pool, DomAnalysis &dom, PostDomAnalysis &pdom, LoopAnalysis &loop)
+      : RegSavesOpt(func, pool),
+        domInfo(dom),
+        pDomInfo(pdom),
+        loopInfo(loop),
+        bbSavedRegs(alloc.Adapter()),
+        id2bb(alloc.Adapter()) {
+    bbSavedRegs.resize(func.NumBBs(), nullptr);
+  }
+  ~X64RegSavesOpt() override = default;
+
+  /* x64 register numbers all fit, a callee-saved register is its own bit position */
+  using CalleeBitsType = uint64;
+
+  void Run() override;
+
+ private:
+  void InitData();
+  void CollectLiveInfo(const BB &bb, const Operand &opnd, bool isDef, bool isUse);
+  void ProcessOperands(const Insn &insn, const BB &bb);
+  void GenAccDefs();
+  void GenRegDefUse();
+  bool CheckForUseBeforeDefPath() const;
+  void SaveAllAtProlog();
+  void RevertToRestoreAtEpilog(x64::X64reg reg);
+  void DetermineCalleeSaveLocations();
+  void DetermineCalleeRestoreLocations();
+  void InsertCalleeSaveCode();
+  void InsertCalleeRestoreCode();
+
+  static bool IsCandidateReg(regno_t reg) {
+    return reg != x64::RBP && x64::IsCalleeSavedReg(static_cast<x64::X64reg>(reg));
+  }
+
+  static bool InsnUsesReg(const Insn &insn, regno_t reg);
+
+  CalleeBitsType GetBBCalleeBits(const CalleeBitsType *data, BBID bid) const {
+    return data[bid];
+  }
+
+  void SetCalleeBit(CalleeBitsType *data, BBID bid, regno_t reg) const {
+    data[bid] |= (1ULL << reg);
+  }
+
+  bool IsCalleeBitSet(const CalleeBitsType *data, BBID bid, regno_t reg) const {
+    return (data[bid] & (1ULL << reg)) != 0;
+  }
+
+  bool IsCalleeBitSetDef(BBID bid, regno_t reg) const {
+    return IsCalleeBitSet(calleeBitsDef, bid, reg);
+  }
+
+  bool IsCalleeBitSetUse(BBID bid, regno_t reg) const {
+    return IsCalleeBitSet(calleeBitsUse, bid, reg);
+  }
+
+  SavedRegInfo *GetbbSavedRegsEntry(BBID bid) {
+    if (bbSavedRegs[bid] == nullptr) {
+      bbSavedRegs[bid] = memPool->New<SavedRegInfo>(alloc);
+    }
+    return bbSavedRegs[bid];
+  }
+
+  DomAnalysis &domInfo;
+  PostDomAnalysis &pDomInfo;
+  LoopAnalysis &loopInfo;
+  Bfs *bfs = nullptr;
+  CalleeBitsType *calleeBitsDef = nullptr;
+  CalleeBitsType *calleeBitsUse = nullptr;
+  CalleeBitsType *calleeBitsAcc = nullptr;
+  MapleVector<SavedRegInfo*> bbSavedRegs;  // set of regs to be saved in a BB
+  MapleMap<BBID, BB*> id2bb;               // bbid to bb* mapping
+};
+}  /* namespace maplebe */
+
+#endif  /* MAPLEBE_INCLUDE_CG_X64_X64_REGSAVES_H */
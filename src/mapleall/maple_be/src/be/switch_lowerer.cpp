@@ -40,8 +40,20 @@
  * entry in the original switch table (pair's // second is 0), or to a dense region (pair's second gives the upper limit
  * of the dense range).  The output code is generated based on the switch_items. See BuildCodeForSwitchItems() which is
  * recursive.
+ *
+ * At -O2, a range of tags narrower than a machine word that jumps to at most 3 distinct targets is lowered to bit
+ * tests instead: (1 << (tag - low)) is computed once and and-ed with the mask of the tags of each target.  Such a
+ * bit test cluster is a switch item like a dense region, it can be carved out of the sparse tags as well as replace
+ * a dense region, where it saves the load from the jump table.
+ *
+ * With profile data, the cases taking most of the executions are peeled off into equality checks ahead of
+ * everything else, and the binary search splits the switch items into halves of equal frequency instead of halves
+ * of the tag range, so that the hot cases are found after fewer tests.
 */
 #include "switch_lowerer.h"
+#include <cstdlib>
+#include <set>
+#include <unordered_map>
 #include "mir_nodes.h"
 #include "mir_builder.h"
 #include "mir_lower.h"  /* "../../../maple_ir/include/mir_lower.h" */
@@ -72,7 +84,72 @@ void SwitchLowerer::FindClusters(MapleVector<Cluster> &clusters) const {
   }
 }
 
-void SwitchLowerer::InitSwitchItems(MapleVector<Cluster> &clusters) {
+bool SwitchLowerer::IsBitTestEnabled() const {
+  /* the bit test falls back to the default label, a switch without one must keep its tables complete */
+  return cgLowerer != nullptr && stmt->GetDefaultLabel() != 0 &&
+         CGOptions::GetInstance().GetOptimizeLevel() >= CGOptions::kLevel2;
+}
+
+void SwitchLowerer::FindBitTestClusters(MapleVector<Cluster> &clusters, MapleVector<Cluster> &bitTests) const {
+  if (!IsBitTestEnabled()) {
+    return;
+  }
+  const uint64 wordBits = static_cast<uint64>(GetPointerSize()) * k8BitSize;
+  auto tagDistance = [this](int32 lowIdx, int32 highIdx) {
+    return static_cast<uint64>(stmt->GetCasePair(static_cast<size_t>(highIdx)).first) -
+           static_cast<uint64>(stmt->GetCasePair(static_cast<size_t>(lowIdx)).first);
+  };
+  auto numTargets = [this](int32 lowIdx, int32 highIdx) {
+    std::set<LabelIdx> targets;
+    for (int32 i = lowIdx; i <= highIdx; ++i) {
+      (void)targets.insert(stmt->GetCasePair(static_cast<size_t>(i)).second);
+    }
+    return static_cast<uint32>(targets.size());
+  };
+  /* dense regions with few targets are cheaper to test than to index */
+  for (auto it = clusters.begin(); it != clusters.end();) {
+    if (tagDistance(it->first, it->second) < wordBits && numTargets(it->first, it->second) <= kMaxBitTestTargets) {
+      bitTests.emplace_back(*it);
+      it = clusters.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  /* then grow bit test clusters greedily over the sparse tags left between the dense regions */
+  int32 length = static_cast<int32>(stmt->GetSwitchTable().size());
+  auto cluster = clusters.begin();
+  int32 i = 0;
+  while (i < length) {
+    if (cluster != clusters.end() && i == cluster->first) {
+      i = cluster->second + 1;
+      ++cluster;
+      continue;
+    }
+    int32 limit = (cluster != clusters.end()) ? cluster->first : length;
+    std::set<LabelIdx> targets;
+    int32 j = i;
+    for (; j < limit && tagDistance(i, j) < wordBits; ++j) {
+      LabelIdx target = stmt->GetCasePair(static_cast<size_t>(j)).second;
+      if (targets.count(target) == 0 && targets.size() == kMaxBitTestTargets) {
+        break;
+      }
+      (void)targets.insert(target);
+    }
+    if (j - i >= kBitTestMinCases[targets.size()]) {
+      bitTests.emplace_back(Cluster(i, j - 1));
+      i = j;
+    } else {
+      ++i;
+    }
+  }
+}
+
+void SwitchLowerer::InitSwitchItems(MapleVector<Cluster> &clusters, MapleVector<Cluster> &bitTests) {
+  for (const Cluster &bitTest : bitTests) {
+    clusters.emplace_back(bitTest);
+    (void)bitTestItems.insert(bitTest.first);
+  }
+  std::sort(clusters.begin(), clusters.end());
   if (clusters.empty()) {
     for (int32 i = 0; i < static_cast<int>(stmt->GetSwitchTable().size()); ++i) {
       switchItems.emplace_back(SwitchItem(i, 0));
@@ -129,6 +206,89 @@ RangeGotoNode *SwitchLowerer::BuildRangeGotoNode(int32 startIdx, int32 endIdx, L
   return node;
 }
 
+/* the tag is known to be within the tags of [startIdx, endIdx], everything not matched goes to the default label */
+BlockNode *SwitchLowerer::BuildBitTestBlock(int32 startIdx, int32 endIdx, FreqType freqSum) {
+  BlockNode *blk = mirModule.CurFuncCodeMemPool()->New<BlockNode>();
+  MIRBuilder *mirBuilder = mirModule.GetMIRBuilder();
+  FuncProfInfo *funcProfData = mirModule.CurFunction()->GetFuncProfData();
+  bool hasFreq = Options::profileUse && funcProfData != nullptr && HasLabelFreq();
+  int64 lowestTag = stmt->GetCasePair(static_cast<size_t>(startIdx)).first;
+  uint64 range = static_cast<uint64>(stmt->GetCasePair(static_cast<size_t>(endIdx)).first) -
+                 static_cast<uint64>(lowestTag);
+  PrimType maskType = (range < k32BitSize) ? PTY_u32 : PTY_u64;
+  /* masks are kept in the order of their first case, then the hottest or most populated target is tested first */
+  std::vector<std::pair<LabelIdx, uint64>> masks;
+  for (int32 i = startIdx; i <= endIdx; ++i) {
+    const CasePair &casePair = stmt->GetCasePair(static_cast<size_t>(i));
+    uint64 bit = 1ULL << (static_cast<uint64>(casePair.first) - static_cast<uint64>(lowestTag));
+    auto it = std::find_if(masks.begin(), masks.end(), [&casePair](const std::pair<LabelIdx, uint64> &mask) {
+      return mask.first == casePair.second;
+    });
+    if (it == masks.end()) {
+      masks.emplace_back(casePair.second, bit);
+    } else {
+      it->second |= bit;
+    }
+  }
+  std::stable_sort(masks.begin(), masks.end(), [this, hasFreq](const std::pair<LabelIdx, uint64> &left,
+                                                               const std::pair<LabelIdx, uint64> &right) {
+    if (hasFreq && GetLabelFreq(left.first) != GetLabelFreq(right.first)) {
+      return GetLabelFreq(left.first) > GetLabelFreq(right.first);
+    }
+    return __builtin_popcountll(left.second) > __builtin_popcountll(right.second);
+  });
+
+  PrimType opndType = stmt->GetSwitchOpnd()->GetPrimType();
+  BaseNode *shift = mirBuilder->CreateExprBinary(OP_sub, opndType, stmt->GetSwitchOpnd(),
+                                                 mirBuilder->CreateIntConst(static_cast<uint64>(lowestTag), opndType));
+  BaseNode *bit = mirBuilder->CreateExprBinary(OP_shl, maskType, mirBuilder->CreateIntConst(1, maskType), shift);
+  PregIdx bitPreg = mirModule.CurFunction()->GetPregTab()->CreatePreg(maskType);
+  RegassignNode *regAssign = mirBuilder->CreateStmtRegassign(maskType, bitPreg, bit);
+  blk->AddStatement(regAssign);
+  if (hasFreq) {
+    funcProfData->SetStmtFreq(regAssign->GetStmtID(), freqSum);
+  }
+  FreqType freqLeft = freqSum;
+  for (auto &mask : masks) {
+    BaseNode *test = mirBuilder->CreateExprBinary(OP_band, maskType, mirBuilder->CreateExprRegread(maskType, bitPreg),
+                                                  mirBuilder->CreateIntConst(mask.second, maskType));
+    CompareNode *cond = mirBuilder->CreateExprCompare(OP_ne, *GlobalTables::GetTypeTable().GetUInt32(),
+        *GlobalTables::GetTypeTable().GetPrimType(maskType), test, mirBuilder->CreateIntConst(0, maskType));
+    CondGotoNode *cGoto = mirBuilder->CreateStmtCondGoto(cond, OP_brtrue, mask.first);
+    blk->AddStatement(cGoto);
+    if (hasFreq) {
+      funcProfData->SetStmtFreq(cGoto->GetStmtID(), freqLeft);
+      freqLeft = (freqLeft >= 0) ? std::max<FreqType>(freqLeft - std::max<FreqType>(GetLabelFreq(mask.first), 0), 0)
+                                 : freqLeft;
+    }
+  }
+  GotoNode *gotoDft = BuildGotoNode(-1);
+  CHECK_FATAL(gotoDft != nullptr, "bit test needs a default label");
+  blk->AddStatement(gotoDft);
+  jumpToDefaultBlockGenerated = true;
+  if (hasFreq) {
+    funcProfData->SetStmtFreq(gotoDft->GetStmtID(), freqLeft);
+  }
+  return blk;
+}
+
+/* jump code of a switch item covering a range, the tag is known to be within it */
+BlockNode *SwitchLowerer::BuildClusterJump(uint32 itemIdx, LabelIdx newLabelIdx, FreqType freqSum) {
+  int32 startIdx = switchItems[itemIdx].first;
+  int32 endIdx = switchItems[itemIdx].second;
+  if (bitTestItems.count(startIdx) != 0) {
+    return BuildBitTestBlock(startIdx, endIdx, freqSum);
+  }
+  BlockNode *blk = mirModule.CurFuncCodeMemPool()->New<BlockNode>();
+  RangeGotoNode *rangeGoto = BuildRangeGotoNode(startIdx, endIdx, newLabelIdx);
+  FuncProfInfo *funcProfData = mirModule.CurFunction()->GetFuncProfData();
+  if (Options::profileUse && funcProfData != nullptr) {
+    funcProfData->SetStmtFreq(rangeGoto->GetStmtID(), freqSum);
+  }
+  blk->AddStatement(rangeGoto);
+  return blk;
+}
+
 CompareNode *SwitchLowerer::BuildCmpNode(Opcode opCode, uint32 idx) {
   CompareNode *binaryExpr = mirModule.CurFuncCodeMemPool()->New<CompareNode>(opCode);
   binaryExpr->SetPrimType(PTY_u32);
@@ -173,9 +333,18 @@ CondGotoNode *SwitchLowerer::BuildCondGotoNode(int32 idx, Opcode opCode, BaseNod
   return cGotoStmt;
 }
 
+bool SwitchLowerer::HasLabelFreq() const {
+  return cgLowerer != nullptr && !cgLowerer->GetLabel2Freq().empty();
+}
+
+FreqType SwitchLowerer::GetLabelFreq(LabelIdx label) {
+  auto it = cgLowerer->GetLabel2Freq().find(label);
+  return (it == cgLowerer->GetLabel2Freq().end()) ? -1 : it->second;
+}
+
 FreqType SwitchLowerer::SumFreq(uint32 startIdx, uint32 endIdx) {
   ASSERT(startIdx >= 0 && endIdx >=0 && endIdx >= startIdx, "startIdx or endIdx is invalid");
-  if (Options::profileUse && cgLowerer->GetLabel2Freq().size() > 0 &&
+  if (Options::profileUse && HasLabelFreq() &&
       (startIdx <= switchItems.size() - 1) && (endIdx <= switchItems.size() - 1) &&
       (startIdx <= endIdx)) {
     FreqType freqSum = 0;
@@ -184,14 +353,14 @@ FreqType SwitchLowerer::SumFreq(uint32 startIdx, uint32 endIdx) {
     for (uint32 swIdx = startIdx; swIdx <= endIdx; swIdx++) {
       FreqType freq;
       if (switchItems[swIdx].second == 0) {
-        freq = cgLowerer->GetLabel2Freq()[stmt->GetCasePair(static_cast<uint32>(switchItems[swIdx].first)).second];
+        freq = GetLabelFreq(stmt->GetCasePair(static_cast<uint32>(switchItems[swIdx].first)).second);
         if (freq >= 0) {
           freqSum += freq;
           valid = true;
         }
       } else {
         for (int32 caseIdx = switchItems[swIdx].first; caseIdx <= switchItems[swIdx].second; caseIdx++) {
-          freq = cgLowerer->GetLabel2Freq()[stmt->GetCasePair(static_cast<uint32>(caseIdx)).second];
+          freq = GetLabelFreq(stmt->GetCasePair(static_cast<uint32>(caseIdx)).second);
           if (freq >= 0) {
             freqSum += freq;
             valid = true;
@@ -205,6 +374,36 @@ FreqType SwitchLowerer::SumFreq(uint32 startIdx, uint32 endIdx) {
   }
 }
 
+/*
+ * split point of the binary search between start and end (switchItems indices) leaving the same frequency on both
+ * sides, -1 if there is no frequency to balance
+ */
+int32 SwitchLowerer::FindWeightedMid(int32 start, int32 end) {
+  std::vector<FreqType> weights;
+  FreqType total = 0;
+  for (int32 idx = start; idx <= end; ++idx) {
+    FreqType weight = std::max<FreqType>(SumFreq(static_cast<uint32>(idx), static_cast<uint32>(idx)), 0);
+    weights.push_back(weight);
+    total += weight;
+  }
+  if (total <= 0) {
+    return -1;
+  }
+  /* both halves must keep at least one item */
+  int32 bestMid = start + 1;
+  FreqType prefix = weights[0];
+  FreqType bestDiff = std::abs(2 * prefix - total);
+  for (int32 mid = start + 2; mid <= end; ++mid) {
+    prefix += weights[static_cast<size_t>(mid - 1 - start)];
+    FreqType diff = std::abs(2 * prefix - total);
+    if (diff < bestDiff) {
+      bestDiff = diff;
+      bestMid = mid;
+    }
+  }
+  return bestMid;
+}
+
 /* start and end is with respect to switchItems */
 BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool lowBlockNodeChecked,
                                                   bool highBlockNodeChecked, FreqType freqSum, LabelIdx newLabelIdx) {
@@ -230,7 +429,6 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
     localBlk->AddStatement(cGoto);
     return localBlk;
   }
-  RangeGotoNode *rangeGoto = nullptr;
   IfStmtNode *ifStmt = nullptr;
   CompareNode *cmpNode = nullptr;
   MIRLower mirLowerer(mirModule, mirModule.CurFunction());
@@ -250,18 +448,16 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
         }
       }
     }
-    rangeGoto = BuildRangeGotoNode(switchItems[static_cast<uint32>(start)].first,
-                                   switchItems[static_cast<uint32>(start)].second, newLabelIdx);
+    BlockNode *jumpBlk = BuildClusterJump(static_cast<uint32>(start), newLabelIdx, freqSum - freqSumChecked);
     if (Options::profileUse && funcProfData != nullptr) {
-      funcProfData->SetStmtFreq(rangeGoto->GetStmtID(), freqSum - freqSumChecked);
       freqSumChecked += SumFreq(static_cast<uint32>(start), static_cast<uint32>(start));
     }
     if (stmt->GetDefaultLabel() == 0) {
-      localBlk->AddStatement(rangeGoto);
+      localBlk->AppendStatementsFromBlock(*jumpBlk);
     } else {
       cmpNode = BuildCmpNode(OP_le, static_cast<uint32>(switchItems[static_cast<uint32>(start)].second));
       ifStmt = static_cast<IfStmtNode*>(mirModule.GetMIRBuilder()->CreateStmtIf(cmpNode));
-      ifStmt->GetThenPart()->AddStatement(rangeGoto);
+      ifStmt->GetThenPart()->AppendStatementsFromBlock(*jumpBlk);
       if (Options::profileUse && funcProfData != nullptr) {
         funcProfData->SetStmtFreq(ifStmt->GetThenPart()->GetStmtID(),
                                   freqSum + SumFreq(static_cast<uint32>(start), static_cast<uint32>(start)));
@@ -290,18 +486,16 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
       }
       highBlockNodeChecked = true;
     }
-    rangeGoto = BuildRangeGotoNode(switchItems[static_cast<uint32>(end)].first,
-                                   switchItems[static_cast<uint32>(end)].second, newLabelIdx);
+    BlockNode *jumpBlk = BuildClusterJump(static_cast<uint32>(end), newLabelIdx, freqSum - freqSumChecked);
     if (Options::profileUse && funcProfData != nullptr) {
-      funcProfData->SetStmtFreq(rangeGoto->GetStmtID(), freqSum - freqSumChecked);
       freqSumChecked += SumFreq(static_cast<uint32>(end), static_cast<uint32>(end));
     }
     if (stmt->GetDefaultLabel() == 0) {
-      localBlk->AddStatement(rangeGoto);
+      localBlk->AppendStatementsFromBlock(*jumpBlk);
     } else {
       cmpNode = BuildCmpNode(OP_ge, static_cast<uint32>(switchItems[static_cast<uint32>(end)].first));
       ifStmt = static_cast<IfStmtNode*>(mirModule.GetMIRBuilder()->CreateStmtIf(cmpNode));
-      ifStmt->GetThenPart()->AddStatement(rangeGoto);
+      ifStmt->GetThenPart()->AppendStatementsFromBlock(*jumpBlk);
       if (Options::profileUse && funcProfData != nullptr) {
         funcProfData->SetStmtFreq(ifStmt->GetThenPart()->GetStmtID(),
                                   freqSum + SumFreq(static_cast<uint32>(end), static_cast<uint32>(end)));
@@ -349,11 +543,11 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
     int32 lastIdx = -1;
     bool freqPriority = false;
     // The setting of kClusterSwitchDensityLow to such a lower value (0.2) makes other strategies less useful
-    if (Options::profileUse && funcProfData != nullptr && (cgLowerer->GetLabel2Freq().size() != 0)) {
+    if (Options::profileUse && funcProfData != nullptr && HasLabelFreq()) {
       for (int32 idx = start; idx <= end; idx++) {
         if (switchItems[static_cast<uint32>(idx)].second == 0) {
-          freq2case.push_back(std::make_pair(cgLowerer->GetLabel2Freq()[stmt->GetCasePair(static_cast<uint32>(
-              switchItems[static_cast<uint32>(idx)].first)).second], switchItems[static_cast<uint32>(idx)].first));
+          freq2case.push_back(std::make_pair(GetLabelFreq(stmt->GetCasePair(static_cast<uint32>(
+              switchItems[static_cast<uint32>(idx)].first)).second), switchItems[static_cast<uint32>(idx)].first));
           lastIdx = idx;
         } else {
           break;
@@ -373,7 +567,7 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
         if (cGoto != nullptr) {
           localBlk->AddStatement(cGoto);
           funcProfData->SetStmtFreq(cGoto->GetStmtID(), freqSum - freqSumChecked);
-          freqSumChecked += cgLowerer->GetLabel2Freq()[stmt->GetCasePair(idx).second];
+          freqSumChecked += GetLabelFreq(stmt->GetCasePair(idx).second);
         }
       }
 
@@ -420,24 +614,26 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
     return localBlk;
   }
 
-  int64 lowestTag = stmt->GetCasePair(static_cast<uint32>(switchItems[static_cast<uint32>(start)].first)).first;
-  int64 highestTag = stmt->GetCasePair(static_cast<uint32>(switchItems[static_cast<uint32>(end)].first)).first;
-
-  /*
-   * if lowestTag and higesttag have the same sign, use difference
-   * if lowestTag and higesttag have the diefferent sign, use sum
-   * 1LL << 63 judge lowestTag ^ highestTag operate result highest
-   * bit is 1 or not, the result highest bit is 1 express lowestTag
-   * and highestTag have same sign , otherwise diefferent sign.highestTag
-   * add or subtract lowestTag divide 2 to get middle tag.
-   */
-  int64 middleTag = ((((static_cast<uint64>(lowestTag)) ^ (static_cast<uint64>(highestTag))) & (1ULL << 63)) == 0)
-                      ? (highestTag - lowestTag) / 2 + lowestTag
-                      : (highestTag + lowestTag) / 2;
   /* find the mid-point in switch_items between start and end */
-  int32 mid = start;
-  while (stmt->GetCasePair(static_cast<uint32>(switchItems[static_cast<uint32>(mid)].first)).first < middleTag) {
-    ++mid;
+  int32 mid = (Options::profileUse && funcProfData != nullptr) ? FindWeightedMid(start, end) : -1;
+  if (mid < 0) {
+    int64 lowestTag = stmt->GetCasePair(static_cast<uint32>(switchItems[static_cast<uint32>(start)].first)).first;
+    int64 highestTag = stmt->GetCasePair(static_cast<uint32>(switchItems[static_cast<uint32>(end)].first)).first;
+    /*
+     * if lowestTag and higesttag have the same sign, use difference
+     * if lowestTag and higesttag have the diefferent sign, use sum
+     * 1LL << 63 judge lowestTag ^ highestTag operate result highest
+     * bit is 1 or not, the result highest bit is 1 express lowestTag
+     * and highestTag have same sign , otherwise diefferent sign.highestTag
+     * add or subtract lowestTag divide 2 to get middle tag.
+     */
+    int64 middleTag = ((((static_cast<uint64>(lowestTag)) ^ (static_cast<uint64>(highestTag))) & (1ULL << 63)) == 0)
+                        ? (highestTag - lowestTag) / 2 + lowestTag
+                        : (highestTag + lowestTag) / 2;
+    mid = start;
+    while (stmt->GetCasePair(static_cast<uint32>(switchItems[static_cast<uint32>(mid)].first)).first < middleTag) {
+      ++mid;
+    }
   }
   ASSERT(mid >= start, "switch lowering logic mid should greater than or equal start");
   ASSERT(mid <= end, "switch lowering logic mid should less than or equal end");
@@ -477,6 +673,47 @@ BlockNode *SwitchLowerer::BuildCodeForSwitchItems(int32 start, int32 end, bool l
   return localBlk;
 }
 
+/*
+ * Tests the cases taking most of the executions of the switch before dispatching on the others, and removes them
+ * from the switch table.  Only a case with a label of its own is peeled, the frequency of a shared label says
+ * nothing about each of its tags.
+ */
+void SwitchLowerer::PeelHotCases(BlockNode &blk) {
+  FuncProfInfo *funcProfData = mirModule.CurFunction()->GetFuncProfData();
+  if (!Options::profileUse || funcProfData == nullptr || !HasLabelFreq() || stmt->GetDefaultLabel() == 0) {
+    return;
+  }
+  FreqType freqLeft = funcProfData->GetStmtFreq(stmt->GetStmtID());
+  if (freqLeft <= 0) {
+    return;
+  }
+  CaseVector &switchTable = stmt->GetSwitchTable();
+  std::unordered_map<LabelIdx, uint32> labelUses;
+  for (const CasePair &casePair : switchTable) {
+    ++labelUses[casePair.second];
+  }
+  for (uint32 peeled = 0; peeled < kMaxPeeledCases && switchTable.size() > 1; ++peeled) {
+    size_t hotIdx = switchTable.size();
+    FreqType hotFreq = 0;
+    for (size_t i = 0; i < switchTable.size(); ++i) {
+      FreqType freq = GetLabelFreq(switchTable[i].second);
+      if (labelUses[switchTable[i].second] == 1 && freq > hotFreq) {
+        hotIdx = i;
+        hotFreq = freq;
+      }
+    }
+    if (hotIdx == switchTable.size() || static_cast<float>(hotFreq) < kPeelCaseRatio * static_cast<float>(freqLeft)) {
+      break;
+    }
+    CondGotoNode *cGoto = BuildCondGotoNode(static_cast<int32>(hotIdx), OP_brtrue,
+                                            *BuildCmpNode(OP_eq, static_cast<uint32>(hotIdx)));
+    blk.AddStatement(cGoto);
+    funcProfData->SetStmtFreq(cGoto->GetStmtID(), freqLeft);
+    freqLeft -= std::min(hotFreq, freqLeft);
+    (void)switchTable.erase(switchTable.begin() + static_cast<std::ptrdiff_t>(hotIdx));
+  }
+}
+
 BlockNode *SwitchLowerer::LowerSwitch(LabelIdx newLabelIdx) {
   if (stmt->GetSwitchTable().empty()) {  /* change to goto */
     BlockNode *localBlk = mirModule.CurFuncCodeMemPool()->New<BlockNode>();
@@ -494,11 +731,19 @@ BlockNode *SwitchLowerer::LowerSwitch(LabelIdx newLabelIdx) {
   }
 
   MapleVector<Cluster> clusters(ownAllocator->Adapter());
+  MapleVector<Cluster> bitTests(ownAllocator->Adapter());
   stmt->SortCasePair(CasePairKeyLessThan);
+  BlockNode *peelBlk = mirModule.CurFuncCodeMemPool()->New<BlockNode>();
+  PeelHotCases(*peelBlk);
   FindClusters(clusters);
-  InitSwitchItems(clusters);
+  FindBitTestClusters(clusters, bitTests);
+  InitSwitchItems(clusters, bitTests);
   BlockNode *blkNode = BuildCodeForSwitchItems(0, static_cast<int>(switchItems.size()) - 1, false, false,
                                                SumFreq(0, static_cast<uint32>(switchItems.size() - 1)), newLabelIdx);
+  if (peelBlk->GetFirst() != nullptr) {
+    peelBlk->AppendStatementsFromBlock(*blkNode);
+    blkNode = peelBlk;
+  }
   if (!jumpToDefaultBlockGenerated) {
     GotoNode *gotoDft = BuildGotoNode(-1);
     if (gotoDft != nullptr) {
@@ -27,7 +27,7 @@ void AArch64CombineRedundantX16Opt::Run() {
       if (!insn->IsMachineInstruction()) {
         continue;
       }
-      if (insn->GetMachineOpcode() == MOP_c_counter) {
+      if (insn->GetMachineOpcode() == MOP_c_counter || insn->GetMachineOpcode() == MOP_c_counter_atomic) {
         ASSERT(bb->GetFirstInsn() == insn, "invalid pgo counter-insn");
         continue;
       }
@@ -20,6 +20,7 @@
 #include "cfi.h"
 #include "dbg.h"
 #include "cg_irbuilder.h"
+#include "litepgo_format.h"
 
 namespace {
 using namespace maple;
@@ -761,6 +762,36 @@ void AArch64AsmEmitter::Run(FuncEmitInfo &funcEmitInfo) {
 #endif /* ~EMIT_INSN_COUNT */
 }
 
+void AArch64AsmEmitter::EmitOutlinedFunction(const std::string &name, const MapleVector<Insn*> &body,
+                                             bool isTailCall) {
+  Emitter &emitter = *GetCG()->GetEmitter();
+  MIRModule &mirModule = *GetCG()->GetMIRModule();
+  (void)emitter.Emit("\n");
+  if (CGOptions::IsFunctionSections()) {
+    (void)emitter.Emit("\t.section  .text.").Emit(name).Emit(",\"ax\",@progbits\n");
+  } else {
+    (void)emitter.Emit("\t.text\n");
+  }
+  (void)emitter.Emit("\t.p2align 2\n");
+  (void)emitter.Emit("\t.type\t" + name + ", %function\n");
+  (void)emitter.Emit(name + ":\n");
+  /* same condition as gencfi, the frame is the caller's and the return address stays in lr */
+  bool needCfi = !mirModule.IsCModule() || CGOptions::GetInstance().IsUnwindTables() || mirModule.IsWithDbgInfo();
+  if (needCfi) {
+    (void)emitter.Emit("\t.cfi_startproc\n");
+  }
+  for (Insn *insn : body) {
+    EmitAArch64Insn(emitter, *insn);
+  }
+  if (!isTailCall) {
+    (void)emitter.Emit("\tret\n");
+  }
+  if (needCfi) {
+    (void)emitter.Emit("\t.cfi_endproc\n");
+  }
+  (void)emitter.Emit("\t.size\t" + name + ", .-").Emit(name + "\n");
+}
+
 void AArch64AsmEmitter::EmitAArch64Insn(maplebe::Emitter &emitter, Insn &insn) const {
   MOperator mOp = insn.GetMachineOpcode();
   emitter.SetCurrentMOP(mOp);
@@ -794,6 +825,10 @@ void AArch64AsmEmitter::EmitAArch64Insn(maplebe::Emitter &emitter, Insn &insn) c
       EmitCCounter(emitter, insn);
       return;
     }
+    case MOP_c_counter_atomic: {
+      EmitCCounterAtomic(emitter, insn);
+      return;
+    }
     case MOP_asm: {
       EmitInlineAsm(emitter, insn);
       return;
@@ -1385,6 +1420,74 @@ void AArch64AsmEmitter::EmitCCounter(Emitter &emitter, const Insn &insn) const {
   }
 }
 
+void AArch64AsmEmitter::EmitCCounterAtomic(Emitter &emitter, const Insn &insn) const {
+  const InsnDesc *md = &AArch64CG::kMd[MOP_c_counter_atomic];
+  auto *stImmOpnd = static_cast<StImmOperand*>(&insn.GetOperand(kInsnFirstOpnd));
+  auto offset = static_cast<uint64>(static_cast<ImmOperand&>(insn.GetOperand(kInsnSecondOpnd)).GetValue());
+  Operand *valueOpnd = &insn.GetOperand(kInsnThirdOpnd);
+  Operand *statusOpnd = &insn.GetOperand(kInsnFourthOpnd);
+  auto rowShift = static_cast<ImmOperand&>(insn.GetOperand(kInsnFifthOpnd)).GetValue();
+  A64OpndEmitVisitor valueVisitor(emitter, md->opndMD[kInsnThirdOpnd]);
+  A64OpndEmitVisitor statusVisitor(emitter, md->opndMD[kInsnFourthOpnd]);
+  auto emitValue = [&valueOpnd, &valueVisitor]() {
+    valueOpnd->Accept(valueVisitor);
+  };
+  bool needSpill = static_cast<RegOperand*>(valueOpnd)->GetRegisterNumber() == R30;
+  CHECK_FATAL(static_cast<RegOperand*>(valueOpnd)->GetRegisterNumber() != R16, "check this case");
+  if (needSpill) {
+    (void)emitter.Emit("\tstp\tx15, x30, [sp, #-16]!\n");
+  }
+  /* shard index from the thread pointer, see litepgo_format.h */
+  if (rowShift != 0) {
+    (void)emitter.Emit("\tmrs\t");
+    emitValue();
+    (void)emitter.Emit(", tpidr_el0\n\teor\t");
+    emitValue();
+    (void)emitter.Emit(", ");
+    emitValue();
+    (void)emitter.Emit(", ");
+    emitValue();
+    (void)emitter.Emit(", lsr #4\n\tubfx\t");
+    emitValue();
+    (void)emitter.Emit(", ");
+    emitValue();
+    (void)emitter.Emit(", #12, #").Emit(MPL_LITE_PGO_SHARD_BITS).Emit("\n");
+  }
+  /* get counter address */
+  (void)emitter.Emit("\tadrp\tx16, ").Emit(stImmOpnd->GetName()).Emit("\n");
+  (void)emitter.Emit("\tadd\tx16, x16, :lo12:").Emit(stImmOpnd->GetName()).Emit("\n");
+  if (rowShift != 0) {
+    (void)emitter.Emit("\tadd\tx16, x16, ");
+    emitValue();
+    (void)emitter.Emit(", lsl #").Emit(rowShift).Emit("\n");
+  }
+  constexpr uint64 kImm12Mask = 0xfff;
+  constexpr uint32 kImm12Bits = 12;
+  if ((offset >> kImm12Bits) != 0) {
+    (void)emitter.Emit("\tadd\tx16, x16, #").Emit(offset >> kImm12Bits).Emit(", lsl #12\n");
+  }
+  if ((offset & kImm12Mask) != 0) {
+    (void)emitter.Emit("\tadd\tx16, x16, #").Emit(offset & kImm12Mask).Emit("\n");
+  }
+  /* exclusive increment, retried until no other thread wrote the counter in between */
+  (void)emitter.Emit("1:\n\tldxr\t");
+  emitValue();
+  (void)emitter.Emit(", [x16]\n\tadd\t");
+  emitValue();
+  (void)emitter.Emit(", ");
+  emitValue();
+  (void)emitter.Emit(", #1\n\tstxr\t");
+  statusOpnd->Accept(statusVisitor);
+  (void)emitter.Emit(", ");
+  emitValue();
+  (void)emitter.Emit(", [x16]\n\tcbnz\t");
+  statusOpnd->Accept(statusVisitor);
+  (void)emitter.Emit(", 1b\n");
+  if (needSpill) {
+    (void)emitter.Emit("\tldp\tx15, x30, [sp], #16\n");
+  }
+}
+
 void AArch64AsmEmitter::EmitAdrpLabel(Emitter &emitter, const Insn &insn) const {
   /* adrp    xd, label
    * add     xd, xd, #lo12:label
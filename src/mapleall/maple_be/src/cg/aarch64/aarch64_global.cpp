@@ -403,7 +403,7 @@ void ForwardPropPattern::Optimize(Insn &insn) {
     AArch64CG::UpdateMopOfPropedInsn(*useInsn);
   }
   insn.SetOperand(0, secondOpnd);
-  cgFunc.GetRD()->UpdateInOut(*insn.GetBB(), true);
+  cgFunc.GetRD()->UpdateInOut(*insn.GetBB());
 }
 
 void ForwardPropPattern::RemoveMopUxtwToMov(Insn &insn) {
@@ -808,10 +808,10 @@ void BackPropPattern::Optimize(Insn &insn) {
       (firstRegNO == R0) &&
       (static_cast<RegOperand&>(insn.GetOperand(kInsnSecondOpnd)).GetRegisterNumber() == R0))  {
     /* Keep this instruction: mov R0, R0 */
-    cgFunc.GetRD()->UpdateInOut(*insn.GetBB(), true);
+    cgFunc.GetRD()->UpdateInOut(*insn.GetBB());
   } else {
     insn.GetBB()->RemoveInsn(insn);
-    cgFunc.GetRD()->UpdateInOut(*insn.GetBB(), true);
+    cgFunc.GetRD()->UpdateInOut(*insn.GetBB());
   }
 }
 
@@ -965,7 +965,7 @@ void CmpCsetPattern::Optimize(Insn &insn) {
     bb.ReplaceInsn(insn, newInsn);
     bb.RemoveInsn(*csetInsn);
   }
-  cgFunc.GetRD()->UpdateInOut(bb, true);
+  cgFunc.GetRD()->UpdateInOut(bb);
 }
 
 void CmpCsetPattern::Init() {
@@ -1121,7 +1121,7 @@ bool RedundantUxtPattern::CheckCondition(Insn &insn) {
   if (RegOperand::IsSameReg(firstOpnd, *secondOpnd)) {
     bb.RemoveInsn(insn);
     /* update in/out */
-    cgFunc.GetRD()->UpdateInOut(bb, true);
+    cgFunc.GetRD()->UpdateInOut(bb);
     return false;
   }
   useInsnSet = cgFunc.GetRD()->FindUseForRegOpnd(insn, 0, false);
@@ -1135,7 +1135,7 @@ bool RedundantUxtPattern::CheckCondition(Insn &insn) {
   if (useInsnSet.empty()) {
     bb.RemoveInsn(insn);
     /* update in/out */
-    cgFunc.GetRD()->UpdateInOut(bb, true);
+    cgFunc.GetRD()->UpdateInOut(bb);
     return false;
   }
 
@@ -1155,7 +1155,7 @@ void RedundantUxtPattern::Optimize(Insn &insn) {
   BB &bb = *insn.GetBB();
   ReplaceAllUsedOpndWithNewOpnd(useInsnSet, firstRegNO, *secondOpnd, true);
   bb.RemoveInsn(insn);
-  cgFunc.GetRD()->UpdateInOut(bb, true);
+  cgFunc.GetRD()->UpdateInOut(bb);
 }
 
 void RedundantUxtPattern::Init() {
@@ -1296,11 +1296,11 @@ void LocalVarSaveInsnPattern::Optimize(Insn &insn) {
   Insn &ldrInsn = cgFunc.GetInsnBuilder()->BuildInsn(ldrOpCode, *secondInsnSrcOpnd, *secondInsnDestOpnd);
   ldrInsn.SetId(useInsn->GetId() - 1);
   useInsn->GetBB()->InsertInsnBefore(*useInsn, ldrInsn);
-  cgFunc.GetRD()->UpdateInOut(*useInsn->GetBB(), true);
+  cgFunc.GetRD()->UpdateInOut(*useInsn->GetBB());
   secondInsn->SetOperand(kInsnFirstOpnd, *firstInsnSrcOpnd);
   BB *saveInsnBB = insn.GetBB();
   saveInsnBB->RemoveInsn(insn);
-  cgFunc.GetRD()->UpdateInOut(*saveInsnBB, true);
+  cgFunc.GetRD()->UpdateInOut(*saveInsnBB);
 }
 
 void LocalVarSaveInsnPattern::Init() {
@@ -1704,7 +1704,7 @@ void ExtendShiftOptPattern::ReplaceUseInsn(Insn &use, const Insn &def, uint32 am
     defInsn->GetBB()->RemoveInsn(*defInsn);
   }
   cgFunc.GetRD()->InitGenUse(*defInsn->GetBB(), false);
-  cgFunc.GetRD()->UpdateInOut(*use.GetBB(), true);
+  cgFunc.GetRD()->UpdateInOut(*use.GetBB());
   newInsn = replaceUseInsn;
   optSuccess = true;
 }
@@ -2224,7 +2224,7 @@ void AndCbzPattern::Optimize(Insn &insn) {
     LogInfo::MapleLogger() << "=======NewInsn :\n";
     newInsn.Dump();
   }
-  cgFunc.GetRD()->UpdateInOut(*bb, true);
+  cgFunc.GetRD()->UpdateInOut(*bb);
 }
 
 void AndCbzPattern::Run() {
@@ -2382,7 +2382,7 @@ void SameRHSPropPattern::Optimize(Insn &insn) {
     LogInfo::MapleLogger() << "======= NewInsn :\n";
     newInsn.Dump();
   }
-  cgFunc.GetRD()->UpdateInOut(*bb, true);
+  cgFunc.GetRD()->UpdateInOut(*bb);
 }
 
 void SameRHSPropPattern::Run() {
@@ -2534,11 +2534,11 @@ void ContinuousLdrPattern::Optimize(Insn &insn) {
     ubfxInsn.SetId(insn.GetId());
     bb->ReplaceInsn(insn, ubfxInsn);
     bb->RemoveInsn(*insn.GetPrev()->GetPrev());
-    cgFunc.GetRD()->UpdateInOut(*bb, true);
+    cgFunc.GetRD()->UpdateInOut(*bb);
     return;
   }
 
-  cgFunc.GetRD()->UpdateInOut(*bb, true);
+  cgFunc.GetRD()->UpdateInOut(*bb);
 }
 
 void ContinuousLdrPattern::Run() {
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "aarch64_outliner.h"
+#include <map>
+#include "aarch64_emitter.h"
+
+namespace maplebe {
+void AArch64MachineOutliner::EmitOutlinedFunctions(Emitter &emitter) const {
+  auto &asmEmitter = static_cast<AArch64AsmEmitter&>(emitter);
+  for (auto *outlined : outlinedFuncs) {
+    asmEmitter.EmitOutlinedFunction(outlined->symbol->GetName(), outlined->body, outlined->isTailCall);
+  }
+}
+
+/* Symbols of function scope are emitted with the puidx of the current function appended. */
+bool AArch64MachineOutliner::IsOutlinableSymbol(const MIRSymbol *symbol) const {
+  if (symbol == nullptr) {
+    return true;
+  }
+  return !symbol->IsLocal() && symbol->GetStorageClass() != kScPstatic && !symbol->IsThreadLocal();
+}
+
+bool AArch64MachineOutliner::GetOperandKey(const Operand &opnd, std::string &key) const {
+  key += '|';
+  key += std::to_string(opnd.GetKind());
+  key += ':';
+  switch (opnd.GetKind()) {
+    case Operand::kOpdRegister: {
+      auto &regOpnd = static_cast<const RegOperand&>(opnd);
+      if (regOpnd.IsVirtualRegister() || regOpnd.GetRegisterNumber() == RLR) {
+        return false;
+      }
+      key += std::to_string(regOpnd.GetRegisterNumber()) + ':' + std::to_string(regOpnd.GetSize()) + ':' +
+             std::to_string(regOpnd.GetRegisterType());
+      return true;
+    }
+    case Operand::kOpdImmediate:
+    case Operand::kOpdFPImmediate:
+      key += static_cast<const ImmOperand&>(opnd).GetHashContent() + ':' + std::to_string(opnd.GetSize());
+      return true;
+    case Operand::kOpdOffset: {
+      auto &ofstOpnd = static_cast<const OfstOperand&>(opnd);
+      if (!IsOutlinableSymbol(ofstOpnd.GetSymbol())) {
+        return false;
+      }
+      key += ofstOpnd.GetHashContent() + ':' + std::to_string(opnd.GetSize());
+      if (ofstOpnd.GetSymbol() != nullptr) {
+        key += ':' + ofstOpnd.GetSymbolName();
+      }
+      return true;
+    }
+    case Operand::kOpdStImmediate: {
+      /* both StImmOperand and the symbol form of ImmOperand use this kind */
+      if (auto *stImmOpnd = dynamic_cast<const StImmOperand*>(&opnd)) {
+        if (!IsOutlinableSymbol(stImmOpnd->GetSymbol())) {
+          return false;
+        }
+        key += stImmOpnd->GetName() + ':' + std::to_string(stImmOpnd->GetOffset()) + ':' +
+               std::to_string(stImmOpnd->GetRelocs());
+        return true;
+      }
+      auto &immOpnd = static_cast<const ImmOperand&>(opnd);
+      if (!IsOutlinableSymbol(immOpnd.GetSymbol())) {
+        return false;
+      }
+      key += immOpnd.GetName() + ':' + std::to_string(immOpnd.GetValue()) + ':' +
+             std::to_string(immOpnd.GetRelocs());
+      return true;
+    }
+    case Operand::kOpdMem: {
+      auto &memOpnd = static_cast<const MemOperand&>(opnd);
+      if (!IsOutlinableSymbol(memOpnd.GetSymbol())) {
+        return false;
+      }
+      key += std::to_string(memOpnd.GetAddrMode()) + ':' + std::to_string(opnd.GetSize());
+      if (memOpnd.GetSymbol() != nullptr) {
+        key += ':' + memOpnd.GetSymbolName();
+      }
+      if (memOpnd.GetAddrMode() == MemOperand::kBOE || memOpnd.GetAddrMode() == MemOperand::kBOL) {
+        key += ':' + memOpnd.GetExtendAsString() + std::to_string(memOpnd.ShiftAmount());
+      }
+      if (memOpnd.GetBaseRegister() != nullptr && !GetOperandKey(*memOpnd.GetBaseRegister(), key)) {
+        return false;
+      }
+      if (memOpnd.GetIndexRegister() != nullptr && !GetOperandKey(*memOpnd.GetIndexRegister(), key)) {
+        return false;
+      }
+      return memOpnd.GetOffsetOperand() == nullptr || GetOperandKey(*memOpnd.GetOffsetOperand(), key);
+    }
+    case Operand::kOpdCond:
+      key += std::to_string(static_cast<const CondOperand&>(opnd).GetCode());
+      return true;
+    case Operand::kOpdShift:
+    case Operand::kOpdExtend:
+      key += opnd.GetHashContent();
+      return true;
+    default:
+      /* labels, function names, lists and comments */
+      return false;
+  }
+}
+
+bool AArch64MachineOutliner::GetInsnKey(const Insn &insn, std::string &key) const {
+  if (!insn.IsMachineInstruction()) {
+    return false;
+  }
+  MOperator mOp = insn.GetMachineOpcode();
+  const InsnDesc *md = insn.GetDesc();
+  /* intrinsics expanded by the emitter may refer to labels of the current function */
+  if (md->GetAtomicNum() != 1 || md->IsVectorOp() || md->IsAtomic() || md->IsSpecialIntrinsic() ||
+      md->IsInlineAsm() || mOp == MOP_prefetch) {
+    return false;
+  }
+  if ((md->IsCall() || md->IsTailCall() || md->IsBranch()) && mOp != MOP_xret) {
+    return false;
+  }
+  key += std::to_string(mOp);
+  for (uint32 i = 0; i < insn.GetOperandSize(); ++i) {
+    const Operand &opnd = insn.GetOperand(i);
+    if (md->GetOpndDes(i)->IsVectorOperand()) {
+      return false;
+    }
+    /* the outlined function has no frame of its own and cfi only describes the caller's */
+    if (opnd.IsRegister() && insn.OpndIsDef(i)) {
+      regno_t regNO = static_cast<const RegOperand&>(opnd).GetRegisterNumber();
+      if (regNO == RSP || regNO == R29) {
+        return false;
+      }
+    }
+    if (opnd.IsMemoryAccessOperand()) {
+      /* stack slots stay in their function, the outlined body must not depend on the frame layout of its callers */
+      auto &memOpnd = static_cast<const MemOperand&>(opnd);
+      const RegOperand *baseOpnd = memOpnd.GetBaseRegister();
+      if (baseOpnd != nullptr && (baseOpnd->GetRegisterNumber() == RSP ||
+          (!memOpnd.IsIntactIndexed() && baseOpnd->GetRegisterNumber() == R29))) {
+        return false;
+      }
+    }
+    if (!GetOperandKey(opnd, key)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AArch64MachineOutliner::GetRegRef(const Insn &insn, regno_t reg, bool &isUse, bool &isDef) {
+  for (uint32 i = 0; i < insn.GetOperandSize(); ++i) {
+    Operand &opnd = insn.GetOperand(i);
+    if (opnd.IsRegister()) {
+      if (static_cast<RegOperand&>(opnd).GetRegisterNumber() == reg) {
+        isUse = isUse || insn.OpndIsUse(i);
+        isDef = isDef || insn.OpndIsDef(i);
+      }
+    } else if (opnd.IsMemoryAccessOperand()) {
+      auto &memOpnd = static_cast<MemOperand&>(opnd);
+      if ((memOpnd.GetBaseRegister() != nullptr && memOpnd.GetBaseRegister()->GetRegisterNumber() == reg) ||
+          (memOpnd.GetIndexRegister() != nullptr && memOpnd.GetIndexRegister()->GetRegisterNumber() == reg)) {
+        isUse = true;
+      }
+    } else if (opnd.IsList()) {
+      for (auto *regOpnd : static_cast<ListOperand&>(opnd).GetOperands()) {
+        if (regOpnd->GetRegisterNumber() == reg) {
+          isUse = isUse || insn.OpndIsUse(i);
+          isDef = isDef || insn.OpndIsDef(i);
+        }
+      }
+    }
+  }
+}
+
+/*
+ * The return address is saved once lr is stored to the stack, calls clobber lr but not the saved copy, any other
+ * def of lr is the restore (or a scratch use) and lr has to be preserved from there.
+ */
+bool AArch64MachineOutliner::IsLRSavedAfter(const Insn &insn, bool saved) {
+  if (!insn.IsMachineInstruction() || insn.IsCall()) {
+    return saved;
+  }
+  bool isUse = false;
+  bool isDef = false;
+  GetRegRef(insn, RLR, isUse, isDef);
+  if (isDef) {
+    return false;
+  }
+  return saved || (isUse && insn.IsStore());
+}
+
+void AArch64MachineOutliner::AnalyzeFunction(CGFunc &func) {
+  bool readsVeneerReg = false;
+  FOR_ALL_BB(bb, &func) {
+    FOR_BB_INSNS(insn, bb) {
+      if (!insn->IsMachineInstruction()) {
+        continue;
+      }
+      bool isUse = false;
+      bool isDef = false;
+      GetRegRef(*insn, R16, isUse, isDef);
+      GetRegRef(*insn, R17, isUse, isDef);
+      readsVeneerReg = readsVeneerReg || isUse;
+    }
+  }
+  if (readsVeneerReg) {
+    (void)veneerRegReaders.insert(&func);
+  }
+  if (func.IsEntryCold()) {
+    return;
+  }
+  /* forward must-analysis: optimistic start, the entry and bbs without preds never have lr saved */
+  std::map<const BB*, bool> savedOut;
+  FOR_ALL_BB(bb, &func) {
+    savedOut[bb] = true;
+  }
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    FOR_ALL_BB(bb, &func) {
+      bool saved = bb != func.GetFirstBB() && (!bb->GetPreds().empty() || !bb->GetEhPreds().empty());
+      for (auto *pred : bb->GetPreds()) {
+        saved = saved && savedOut[pred];
+      }
+      for (auto *pred : bb->GetEhPreds()) {
+        saved = saved && savedOut[pred];
+      }
+      if (saved) {
+        (void)lrSavedBBs.insert(bb);
+      } else {
+        (void)lrSavedBBs.erase(bb);
+      }
+      FOR_BB_INSNS(insn, bb) {
+        saved = IsLRSavedAfter(*insn, saved);
+      }
+      if (savedOut[bb] != saved) {
+        savedOut[bb] = saved;
+        changed = true;
+      }
+    }
+  }
+}
+
+bool AArch64MachineOutliner::IsLRSavedAt(const Insn &insn) const {
+  const BB *bb = insn.GetBB();
+  bool saved = lrSavedBBs.find(bb) != lrSavedBBs.end();
+  for (const Insn *cur = bb->GetFirstInsn(); cur != nullptr && cur != &insn; cur = cur->GetNext()) {
+    saved = IsLRSavedAfter(*cur, saved);
+  }
+  return saved;
+}
+
+/* x16/x17 must be written before being read from the start of the sequence on */
+bool AArch64MachineOutliner::IsVeneerRegDeadAt(const CGFunc &func, const Insn &first, regno_t reg,
+                                               bool isTailCall) const {
+  for (const Insn *insn = &first; insn != nullptr; insn = insn->GetNext()) {
+    if (!insn->IsMachineInstruction()) {
+      continue;
+    }
+    if (insn->IsCall()) {
+      return true;
+    }
+    bool isUse = false;
+    bool isDef = false;
+    GetRegRef(*insn, reg, isUse, isDef);
+    if (isUse) {
+      return false;
+    }
+    if (isDef) {
+      return true;
+    }
+  }
+  return isTailCall || veneerRegReaders.find(&func) == veneerRegReaders.end();
+}
+
+bool AArch64MachineOutliner::CanOutlineAt(const CGFunc &func, const Insn &first, bool isTailCall) const {
+  if (!isTailCall && !IsLRSavedAt(first)) {
+    return false;
+  }
+  return IsVeneerRegDeadAt(func, first, R16, isTailCall) && IsVeneerRegDeadAt(func, first, R17, isTailCall);
+}
+
+Insn &AArch64MachineOutliner::BuildOutlinedCall(CGFunc &func, const MIRSymbol &symbol, bool isTailCall) const {
+  auto &a64Func = static_cast<AArch64CGFunc&>(func);
+  Operand &targetOpnd = a64Func.GetOrCreateFuncNameOpnd(symbol);
+  ListOperand *srcOpnds = a64Func.CreateListOpnd(*func.GetFuncScopeAllocator());
+  return func.GetInsnBuilder()->BuildInsn(isTailCall ? MOP_tail_call_opt_xbl : MOP_xbl, targetOpnd, *srcOpnds);
+}
+}  /* namespace maplebe */
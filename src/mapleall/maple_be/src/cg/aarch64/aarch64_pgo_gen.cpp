@@ -16,18 +16,22 @@
 #include "aarch64_cg.h"
 namespace maplebe {
 void AArch64ProfGen::InstrumentBB(BB &bb, MIRSymbol &countTab, uint32 offset) {
-  regno_t freeUseRegNo = R30;
+  /* atomic increments need a second free register for the exclusive store status */
+  bool isAtomic = CGOptions::GetLitePgoCounterMode() != CGOptions::kPlainCounter;
+  size_t needRegs = isAtomic ? 2 : 1;
+  std::vector<regno_t> freeRegs;
   auto *a64Func = static_cast<AArch64CGFunc *>(f);
-  for (regno_t reg = R8; reg < R29; ++reg) {
+  for (regno_t reg = R8; reg < R29 && freeRegs.size() < needRegs; ++reg) {
     if (bb.GetLiveInRegNO().count(reg) == 0 && reg != R16) {
       if (!AArch64Abi::IsCalleeSavedReg(static_cast<AArch64reg>(reg)) ||
           (AArch64Abi::IsCalleeSavedReg(static_cast<AArch64reg>(reg)) &&
            a64Func->IsUsedCalleeSavedReg(static_cast<AArch64reg>(reg)))) {
-        freeUseRegNo = reg;
-        break;
+        freeRegs.push_back(reg);
       }
     }
   }
+  /* R30 tells the emitter to spill the link register (and x15 for atomic increments) around the update */
+  regno_t freeUseRegNo = freeRegs.size() == needRegs ? freeRegs[0] : R30;
   StImmOperand &funcPtrSymOpnd = a64Func->CreateStImmOperand(countTab, 0, 0);
   RegOperand &tempRegOpnd = a64Func->GetOrCreatePhysicalRegisterOperand(
       static_cast<AArch64reg>(freeUseRegNo), k64BitSize, kRegTyInt);
@@ -35,7 +39,17 @@ void AArch64ProfGen::InstrumentBB(BB &bb, MIRSymbol &countTab, uint32 offset) {
   /* skip size */
   uint32 ofStByteSize = offset << 3U;
   ImmOperand &countOfst = a64Func->CreateImmOperand(ofStByteSize, k64BitSize, false);
-  auto &counterInsn = f->GetInsnBuilder()->BuildInsn(MOP_c_counter, funcPtrSymOpnd, countOfst, tempRegOpnd);
+  if (!isAtomic) {
+    auto &counterInsn = f->GetInsnBuilder()->BuildInsn(MOP_c_counter, funcPtrSymOpnd, countOfst, tempRegOpnd);
+    bb.InsertInsnBegin(counterInsn);
+    return;
+  }
+  regno_t statusRegNo = freeUseRegNo == R30 ? R15 : freeRegs[1];
+  RegOperand &statusRegOpnd = a64Func->GetOrCreatePhysicalRegisterOperand(
+      static_cast<AArch64reg>(statusRegNo), k32BitSize, kRegTyInt);
+  ImmOperand &rowShiftOpnd = a64Func->CreateImmOperand(shardRowShift, k32BitSize, false);
+  auto &counterInsn = f->GetInsnBuilder()->BuildInsn(MOP_c_counter_atomic, funcPtrSymOpnd, countOfst, tempRegOpnd,
+                                                     statusRegOpnd, rowShiftOpnd);
   bb.InsertInsnBegin(counterInsn);
 }
 
@@ -43,7 +57,8 @@ void AArch64ProfGen::CreateCallForDump(BB &bb, const MIRSymbol &dumpCall) {
   Insn *fristI = bb.GetFirstInsn();
   Operand &targetOpnd = static_cast<AArch64CGFunc*>(f)->GetOrCreateFuncNameOpnd(dumpCall);
   Insn &callDumpInsn = f->GetInsnBuilder()->BuildInsn(MOP_xbl, targetOpnd);
-  if (fristI && fristI->GetMachineOpcode() == MOP_c_counter) {
+  if (fristI && (fristI->GetMachineOpcode() == MOP_c_counter ||
+                 fristI->GetMachineOpcode() == MOP_c_counter_atomic)) {
     bb.InsertInsnAfter(*fristI, callDumpInsn);
   } else {
     bb.InsertInsnBegin(callDumpInsn);
@@ -221,7 +221,7 @@ void AArch64StoreLoadOpt::GenerateMoveDeadInsn(RegOperand &resRegOpnd, RegOperan
     strInsn.GetBB()->InsertInsnAfter(strInsn, *newMovInsn);
     str2MovMap[&strInsn][memSeq] = newMovInsn;
     /* update DataInfo */
-    cgFunc.GetRD()->UpdateInOut(*strInsn.GetBB(), true);
+    cgFunc.GetRD()->UpdateInOut(*strInsn.GetBB());
   } else {
     newMovInsn = str2MovMap[&strInsn][memSeq];
     vregOpnd = &static_cast<RegOperand&>(newMovInsn->GetOperand(kInsnFirstOpnd));
@@ -721,9 +721,8 @@ bool AArch64StoreLoadOpt::ReplaceMemOpnd(Insn &insn, regno_t regNo, RegOperand &
     }
     regDefInsn->GetBB()->RemoveInsn(*regDefInsn);
   }
-  cgFunc.GetRD()->InitGenUse(*regDefInsn->GetBB(), false);
-  cgFunc.GetRD()->UpdateInOut(*insn.GetBB(), false);
-  cgFunc.GetRD()->UpdateInOut(*insn.GetBB(), true);
+  cgFunc.GetRD()->UpdateInOut(*regDefInsn->GetBB());
+  cgFunc.GetRD()->UpdateInOut(*insn.GetBB());
   return true;
 }
 
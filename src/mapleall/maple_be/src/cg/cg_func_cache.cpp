@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "cg_func_cache.h"
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cg_options.h"
+#include "cgfunc.h"
+#include "muid.h"
+#include "version.h"
+
+namespace maplebe {
+namespace {
+const std::string kEntrySuffix = ".s";
+const std::string kCallGraphSuffix = ".cgprof";
+
+std::string Digest(const std::string &text) {
+  MuidContext status;
+  MuidInit(status);
+  if (!text.empty()) {
+    MuidDecode(status, *reinterpret_cast<const unsigned char*>(text.data()), text.size());
+  }
+  unsigned char digest[kDigestHashLength];
+  MuidEncode(digest, status);
+  std::ostringstream oss;
+  for (unsigned char byte : digest) {
+    oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<uint32>(byte);
+  }
+  return oss.str();
+}
+
+/* LOC lines only matter with debug info, dropping them keeps the functions below an edit cacheable */
+std::string StripSrcPos(const std::string &text) {
+  std::istringstream in(text);
+  std::string result;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t pos = line.find_first_not_of(" \t");
+    if (pos != std::string::npos && line.compare(pos, 4, "LOC ") == 0) {
+      continue;
+    }
+    result += line;
+    result += '\n';
+  }
+  return result;
+}
+
+bool IsDeclaration(const MIRSymbol &sym) {
+  return sym.GetStorageClass() == kScExtern || sym.GetSKind() == kStFunc;
+}
+
+/*
+ * The ordinal of a function is part of its short name, and of its local labels on x86_64. Labels numbered by
+ * the puIdx which happens to equal the ordinal are counted too.
+ */
+bool DependsOnOrdinal(const std::string &text, const CGFunc &cgFunc) {
+  return text.find(cgFunc.GetShortFuncName().c_str()) != std::string::npos ||
+         text.find(".L." + std::to_string(cgFunc.GetUniqueID()) + "__") != std::string::npos;
+}
+
+bool PublishEntry(const std::string &tmpEntry, const std::string &entry) {
+  if (std::rename(tmpEntry.c_str(), entry.c_str()) != 0) {
+    (void)std::remove(tmpEntry.c_str());
+    return false;
+  }
+  return true;
+}
+}  /* anonymous namespace */
+
+CgFuncCache::CgFuncCache(MIRModule &mod, const CGOptions &cgOptions) : mirModule(mod) {
+  if (CGOptions::GetFuncCacheDir().empty()) {
+    return;
+  }
+  /* debug info and ipara carry state from one function to another, the object emitter has no text to reuse */
+  if (cgOptions.WithDwarf() || CGOptions::DoIPARA() || CGOptions::UseRange() ||
+      CGOptions::GetEmitFileType() != CGOptions::kAsm) {
+    return;
+  }
+  const std::string &dir = CGOptions::GetFuncCacheDir();
+  if (mkdir(dir.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0 && errno != EEXIST) {
+    LogInfo::MapleLogger(kLlWarn) << "Warning: cg function cache directory " << dir << " is not usable\n";
+    return;
+  }
+  cacheDir = dir;
+  keepSrcPos = cgOptions.GenerateVerboseAsm();
+
+  std::ostringstream oss;
+  oss << Version::GetVersionStr() << '\n';
+  for (auto *category : { &maplecl::CommandLine::GetCommandLine().defaultCategory,
+                          &maplecl::CommandLine::GetCommandLine().cgCategory }) {
+    for (maplecl::OptionInterface *opt : category->GetEnabledOptions()) {
+      if (opt == &opts::cg::funcCache) {
+        continue;
+      }
+      oss << opt->GetName();
+      for (const std::string &val : opt->GetRawValues()) {
+        oss << ' ' << val;
+      }
+      oss << '\n';
+    }
+  }
+  if (!CGOptions::GetLiteProfile().empty()) {
+    /* the counters lay out the blocks and make the call graph */
+    std::ifstream profile(CGOptions::GetLiteProfile(), std::ios::binary);
+    std::ostringstream counters;
+    counters << profile.rdbuf();
+    oss << "lite profile " << Digest(counters.str()) << '\n';
+  }
+  oss << DumpToString([this]() { mirModule.DumpGlobals(); });
+  moduleDigest = Digest(keepSrcPos ? oss.str() : StripSrcPos(oss.str()));
+  symNumBefore = GlobalTables::GetGsymTable().GetSymbolTableSize();
+  scannedSymNum = symNumBefore;
+}
+
+std::string CgFuncCache::DumpToString(const std::function<void()> &dumper) const {
+  std::ostringstream oss;
+  std::streambuf *logBuf = LogInfo::MapleLogger().rdbuf();
+  (void)LogInfo::MapleLogger().rdbuf(oss.rdbuf());
+  dumper();
+  (void)LogInfo::MapleLogger().rdbuf(logBuf);
+  return oss.str();
+}
+
+std::string CgFuncCache::GetEntryPath(const std::string &key, const std::string &suffix) const {
+  return cacheDir + "/" + key + suffix;
+}
+
+bool CgFuncCache::Reuse(MIRFunction &func, uint32 funcId, Emitter &emitter, LitePgoCallGraph *callGraph) {
+  curKey.clear();
+  curOrdinalKey.clear();
+  std::string funcText = DumpToString([&func]() { func.Dump(false); });
+  if (funcText.empty()) {
+    return false;
+  }
+  std::ostringstream oss;
+  oss << moduleDigest << ' ' << static_cast<uint32>(CGOptions::GetInstance().GetOptimizeLevel())
+      << '\n' << (keepSrcPos ? funcText : StripSrcPos(funcText));
+  curKey = Digest(oss.str());
+  curOrdinalKey = Digest(curKey + ' ' + std::to_string(funcId));
+  return EmitEntry(curKey, emitter, callGraph) || EmitEntry(curOrdinalKey, emitter, callGraph);
+}
+
+bool CgFuncCache::EmitEntry(const std::string &key, Emitter &emitter, LitePgoCallGraph *callGraph) const {
+  std::ifstream in(GetEntryPath(key, kEntrySuffix), std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::ostringstream cached;
+  cached << in.rdbuf();
+  if (in.bad()) {
+    return false;
+  }
+  if (callGraph != nullptr) {
+    LitePgoCallGraph funcCallGraph;
+    std::string err;
+    if (!funcCallGraph.Read(GetEntryPath(key, kCallGraphSuffix), err)) {
+      return false;
+    }
+    callGraph->Merge(funcCallGraph);
+  }
+  (void)emitter.Emit(cached.str());
+  return true;
+}
+
+void CgFuncCache::BeginFunction(Emitter &emitter) {
+  funcBuf.str("");
+  savedBuf = emitter.RedirectOutput(&funcBuf);
+  pendingNumBefore = emitter.GetPendingGlobalEntryNum();
+  symNumBefore = GlobalTables::GetGsymTable().GetSymbolTableSize();
+}
+
+void CgFuncCache::CollectCGDefinedSymbols() {
+  size_t symNum = GlobalTables::GetGsymTable().GetSymbolTableSize();
+  for (size_t i = scannedSymNum; i < symNum; ++i) {
+    MIRSymbol *sym = GlobalTables::GetGsymTable().GetSymbolFromStidx(static_cast<uint32>(i), true);
+    if (sym != nullptr && !IsDeclaration(*sym)) {
+      cgDefinedSymbols.push_back(sym->GetName());
+    }
+  }
+  scannedSymNum = symNum;
+}
+
+bool CgFuncCache::IsSelfContained(const std::string &text, const Emitter &emitter) {
+  if (emitter.GetPendingGlobalEntryNum() != pendingNumBefore) {
+    return false;
+  }
+  size_t symNum = GlobalTables::GetGsymTable().GetSymbolTableSize();
+  for (size_t i = symNumBefore; i < symNum; ++i) {
+    MIRSymbol *sym = GlobalTables::GetGsymTable().GetSymbolFromStidx(static_cast<uint32>(i), true);
+    if (sym != nullptr && !IsDeclaration(*sym)) {
+      return false;
+    }
+  }
+  for (const std::string &name : cgDefinedSymbols) {
+    if (text.find(name) != std::string::npos) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CgFuncCache::EndFunction(Emitter &emitter, const CGFunc &cgFunc, const LitePgoCallGraph *funcCallGraph) {
+  (void)emitter.RedirectOutput(savedBuf);
+  savedBuf = nullptr;
+  std::string text = funcBuf.str();
+  (void)emitter.Emit(text);
+  bool selfContained = IsSelfContained(text, emitter);
+  CollectCGDefinedSymbols();
+  if (curKey.empty() || !selfContained) {
+    return;
+  }
+  const std::string &key = DependsOnOrdinal(text, cgFunc) ? curOrdinalKey : curKey;
+  /*
+   * concurrent compilations may share the directory, publish the entries with atomic renames, the call graph
+   * first since a hit needs both
+   */
+  std::string tmpSuffix = ".tmp" + std::to_string(getpid());
+  if (funcCallGraph != nullptr) {
+    std::string callGraphEntry = GetEntryPath(key, kCallGraphSuffix);
+    std::string err;
+    if (!funcCallGraph->Write(callGraphEntry + tmpSuffix, err)) {
+      (void)std::remove((callGraphEntry + tmpSuffix).c_str());
+      return;
+    }
+    if (!PublishEntry(callGraphEntry + tmpSuffix, callGraphEntry)) {
+      return;
+    }
+  }
+  std::string entry = GetEntryPath(key, kEntrySuffix);
+  std::string tmpEntry = entry + tmpSuffix;
+  std::ofstream out(tmpEntry, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    return;
+  }
+  out << text;
+  out.close();
+  if (out.fail()) {
+    (void)std::remove(tmpEntry.c_str());
+    return;
+  }
+  (void)PublishEntry(tmpEntry, entry);
+}
+}  /* namespace maplebe */
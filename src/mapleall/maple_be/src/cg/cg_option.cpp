@@ -65,10 +65,13 @@ bool CGOptions::liteProfGen = false;
 bool CGOptions::liteProfUse = false;
 bool CGOptions::liteProfVerify = false;
 std::string CGOptions::liteProfile = "";
+std::string CGOptions::litePgoCallGraphDir = "";
 std::string CGOptions::litePgoWhiteList = "";
+CGOptions::LitePgoCounterMode CGOptions::litePgoCounterMode = kPlainCounter;
 std::string CGOptions::instrumentationOutPutPath = "";
 std::string CGOptions::litePgoOutputFunction = "";
 std::string CGOptions::functionProrityFile = "";
+std::string CGOptions::funcCacheDir = "";
 std::string CGOptions::functionReorderAlgorithm = "";
 std::string CGOptions::functionReorderProfile = "";
 std::string CGOptions::cpu = "cortex-a53";
@@ -90,6 +93,7 @@ bool CGOptions::exclusiveEH = false;
 bool CGOptions::doEBO = false;
 bool CGOptions::doCGSSA = false;
 bool CGOptions::doLayoutColdPath = false;
+bool CGOptions::doLayoutExtTsp = false;
 bool CGOptions::doGlobalSchedule = false;
 bool CGOptions::doLocalSchedule = false;
 bool CGOptions::doVerifySchedule = false;
@@ -156,6 +160,7 @@ bool CGOptions::arm64ilp32 = false;
 bool CGOptions::noCommon = false;
 bool CGOptions::flavorLmbc = false;
 bool CGOptions::doAggrOpt = false;
+bool CGOptions::doMachineOutline = false;
 CGOptions::VisibilityType CGOptions::visibilityType = kDefaultVisibility;
 CGOptions::TLSModel CGOptions::tlsModel = kDefaultTLSModel;
 bool CGOptions::noplt = false;
@@ -704,6 +709,10 @@ bool CGOptions::SolveOptions(bool isDebug) {
     opts::cg::layoutColdPath ? EnableLayoutColdPath() : DisableLayoutColdPath();
   }
 
+  if (opts::cg::layoutExtTsp.IsEnabledByUser()) {
+    opts::cg::layoutExtTsp ? EnableLayoutExtTsp() : DisableLayoutExtTsp();
+  }
+
   if (opts::cg::coldPathThreshold.IsEnabledByUser()) {
     SetColdPathThreshold(opts::cg::coldPathThreshold);
   }
@@ -758,6 +767,10 @@ bool CGOptions::SolveOptions(bool isDebug) {
     SetLitePgoWhiteList(opts::cg::litePgoWhiteList);
   }
 
+  if (opts::cg::litePgoCounterMode.IsEnabledByUser()) {
+    SetLitePgoCounterMode(opts::cg::litePgoCounterMode);
+  }
+
   if (opts::cg::instrumentationDir.IsEnabledByUser()) {
     SetInstrumentationOutPutPath(opts::cg::instrumentationDir);
     if (!opts::cg::instrumentationDir.GetValue().empty()) {
@@ -772,10 +785,22 @@ bool CGOptions::SolveOptions(bool isDebug) {
     }
   }
 
+  if (opts::cg::litePgoCallGraphDir.IsEnabledByUser()) {
+    SetLitePgoCallGraphDir(opts::cg::litePgoCallGraphDir);
+  }
+
   if (opts::cg::functionPriority.IsEnabledByUser()) {
     SetFunctionPriority(opts::cg::functionPriority);
   }
 
+  if (opts::cg::funcCache.IsEnabledByUser()) {
+    SetFuncCacheDir(opts::cg::funcCache);
+  }
+
+  if (opts::cg::machineOutline.IsEnabledByUser()) {
+    opts::cg::machineOutline ? EnableMachineOutline() : DisableMachineOutline();
+  }
+
   if (opts::functionReorderAlgorithm.IsEnabledByUser()) {
     SetFunctionReorderAlgorithm(opts::functionReorderAlgorithm);
   }
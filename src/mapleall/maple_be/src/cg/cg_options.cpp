@@ -498,6 +498,11 @@ maplecl::Option<bool> layoutColdPath({"--layout-cold-path"},
     "  --no-layout-cold-path       \n",
     {cgCategory}, maplecl::DisableWith("--no-layout-cold-path"));
 
+maplecl::Option<bool> layoutExtTsp({"--layout-ext-tsp"},
+    "  --layout-ext-tsp            \tOrder the blocks of the profile guided layout by ext-TSP score\n"
+    "  --no-layout-ext-tsp         \n",
+    {cgCategory}, maplecl::DisableWith("--no-layout-ext-tsp"));
+
 maplecl::Option<bool> globalSchedule({"--global-schedule"},
     "  --global-schedule           \tPerform global schedule\n"
     "  --no-global-schedule        \n",
@@ -567,6 +572,12 @@ maplecl::Option<std::string> litePgoWhiteList ({"--lite-pgo-white-list"},
     "                              \tInstrumentation function white list\n",
     {driverCategory, cgCategory}, kOptMaple);
 
+maplecl::Option<std::string> litePgoCounterMode ({"--lite-pgo-counter-mode"},
+    "  --lite-pgo-counter-mode=plain|atomic|sharded\n"
+    "                              \tHow instrumented bbs increment their counters: plain(default), atomic, or\n"
+    "                              \tatomic on per-thread counter rows summed at dump time\n",
+    {driverCategory, cgCategory}, kOptMaple);
+
 maplecl::Option<std::string> litePgoOutputFunc ({"--lite-pgo-output-func"},
     "  --lite-pgo-output-func=function name\n"
     "                              \tGenerate lite profile at the exit of the output "
@@ -577,11 +588,28 @@ maplecl::Option<std::string> litePgoFile({"--lite-pgo-file"},
     "  --lite-pgo-file=filepath    \tLite pgo guide file\n",
     {driverCategory, cgCategory}, kOptMaple);
 
+maplecl::Option<std::string> litePgoCallGraphDir({"--lite-pgo-call-graph-dir"},
+    "  --lite-pgo-call-graph-dir=directory\n"
+    "                              \tWith --lite-pgo-file, write the call graph of the module weighted by the\n"
+    "                              \tprofile to the directory, for mplprofdata order\n",
+    {driverCategory, cgCategory}, kOptMaple);
+
 maplecl::Option<std::string> functionPriority({"--function-priority"},
     "  --function-priority=filepath \tWhen profile data is given, priority suffix is added to section "
     "name in order to improve code locality\n",
     {cgCategory});
 
+maplecl::Option<std::string> funcCache({"--cg-func-cache"},
+    "  --cg-func-cache=dir         \tReuse the assembly of the functions whose MIR, referenced globals and options\n"
+    "                              \tare unchanged since a previous compilation, cached in dir\n",
+    {driverCategory, cgCategory}, kOptMaple);
+
+maplecl::Option<bool> machineOutline({"--machine-outline"},
+    "  --machine-outline           \tOutline the instruction sequences repeated across the functions of the module\n"
+    "                              \tinto shared functions after register allocation(default:off)\n"
+    "  --no-machine-outline\n",
+    {driverCategory, cgCategory}, kOptMaple, maplecl::DisableWith("--no-machine-outline"));
+
 maplecl::Option<bool> litePgoVerify({"--lite-pgo-verify"},
     "  --lite-pgo-verify           \tverify lite-pgo data strictly, abort when encountering mismatch "
     "data(default:skip).\n"
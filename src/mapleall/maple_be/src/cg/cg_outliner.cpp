@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "cg_outliner.h"
+#include <algorithm>
+#include <unordered_map>
+#include "suffix_array.h"
+#include "option.h"
+
+namespace maplebe {
+namespace {
+/* longer sequences are rarely repeated, and the suffix array reports every prefix length of them */
+constexpr size_t kMaxOutlineLength = 64;
+/* with profile data, BBs executed at least 1/kHotCountRatio as often as the hottest BB are left alone */
+constexpr FreqType kHotCountRatio = 100;
+}
+
+/*
+ * Size in insns saved by outlining length insns repeated numOccurrences times: every occurrence becomes one call
+ * and the outlined function holds one copy of the sequence, plus a return unless it ends with one.
+ */
+int64 MachineOutliner::GetBenefit(size_t numOccurrences, size_t length, bool isTailCall) {
+  int64 before = static_cast<int64>(numOccurrences * length);
+  int64 after = static_cast<int64>(numOccurrences + length + (isTailCall ? 0 : 1));
+  return before - after;
+}
+
+FreqType MachineOutliner::GetBBCount(const BB &bb) const {
+  return CGOptions::DoLiteProfUse() ? static_cast<FreqType>(bb.GetFrequency()) : bb.GetProfFreq();
+}
+
+bool MachineOutliner::IsOutlinableBB(const BB &bb) const {
+  if (bb.IsUnreachable()) {
+    return false;
+  }
+  if (!useProfile || bb.IsInColdSection()) {
+    return true;
+  }
+  FreqType count = GetBBCount(bb);
+  return count == 0 || count * kHotCountRatio < maxBBCount;
+}
+
+size_t MachineOutliner::MapInsns(std::vector<size_t> &str, std::vector<InsnPosition> &positions) {
+  std::unordered_map<std::string, size_t> keyIds;
+  size_t nextId = 1;  // 0 is the terminating sentinel
+  auto addSeparator = [&str, &positions, &nextId]() {
+    if (!positions.empty() && positions.back().insn == nullptr) {
+      return;
+    }
+    str.push_back(nextId++);
+    positions.push_back({ nullptr, nullptr });
+  };
+  std::string key;
+  for (CGFunc *func : funcs) {
+    FOR_ALL_BB(bb, func) {
+      if (IsOutlinableBB(*bb)) {
+        FOR_BB_INSNS(insn, bb) {
+          key.clear();
+          if (!GetInsnKey(*insn, key)) {
+            addSeparator();
+            continue;
+          }
+          auto ret = keyIds.emplace(key, nextId);
+          if (ret.second) {
+            ++nextId;
+          }
+          str.push_back(ret.first->second);
+          positions.push_back({ func, insn });
+        }
+      }
+      /* sequences never span BBs */
+      addSeparator();
+    }
+  }
+  str.push_back(0);
+  positions.push_back({ nullptr, nullptr });
+  return nextId;
+}
+
+void MachineOutliner::CollectCandidates(const std::vector<size_t> &str, size_t alphabetSize,
+                                        const std::vector<InsnPosition> &positions,
+                                        std::vector<Candidate> &candidates) const {
+  SuffixArray sa(str, str.size(), alphabetSize);
+  sa.Run(true);
+  for (auto *subStrings : sa.GetRepeatedSubStrings()) {
+    size_t length = subStrings->GetLength();
+    std::vector<size_t> starts;
+    if (length <= kMaxOutlineLength) {
+      for (auto &occurrence : subStrings->GetOccurrences()) {
+        starts.push_back(occurrence.first);
+      }
+    }
+    delete subStrings;
+    if (starts.size() < 2) {
+      continue;
+    }
+    std::sort(starts.begin(), starts.end());
+    /* a return ends its bb, so it can only be the last insn of a sequence */
+    bool isTailCall = IsReturn(*positions[starts.front() + length - 1].insn);
+    Candidate candidate = { {}, length, isTailCall, 0 };
+    size_t lastEnd = 0;
+    for (size_t start : starts) {
+      if (!candidate.starts.empty() && start < lastEnd) {
+        continue;
+      }
+      const InsnPosition &first = positions[start];
+      if (!CanOutlineAt(*first.func, *first.insn, isTailCall)) {
+        continue;
+      }
+      candidate.starts.push_back(start);
+      lastEnd = start + length;
+    }
+    candidate.benefit = GetBenefit(candidate.starts.size(), length, isTailCall);
+    if (candidate.starts.size() < 2 || candidate.benefit <= 0) {
+      continue;
+    }
+    candidates.push_back(std::move(candidate));
+  }
+}
+
+void MachineOutliner::Outline(const Candidate &candidate, const std::vector<InsnPosition> &positions) {
+  std::string name = "OUTLINED_FUNCTION_" + std::to_string(outlinedFuncs.size());
+  /* not entered in the global symbol table, the outlined functions are emitted by the outliner only */
+  auto *symbol = memPool.New<MIRSymbol>(0, kScopeGlobal);
+  symbol->SetNameStrIdx(name);
+  symbol->SetSKind(kStFunc);
+  symbol->SetStorageClass(kScText);
+  auto *outlined = memPool.New<OutlinedFunction>(*symbol, alloc, candidate.isTailCall);
+  for (size_t start : candidate.starts) {
+    const InsnPosition &first = positions[start];
+    BB &bb = *first.insn->GetBB();
+    (void)bb.InsertInsnBefore(*first.insn, BuildOutlinedCall(*first.func, *symbol, candidate.isTailCall));
+    for (size_t i = start; i < start + candidate.length; ++i) {
+      Insn *insn = positions[i].insn;
+      if (outlined->body.size() < candidate.length) {
+        outlined->body.push_back(insn);
+      }
+      bb.RemoveInsn(*insn);
+    }
+  }
+  outlined->numOccurrences = static_cast<uint32>(candidate.starts.size());
+  numReplaced += outlined->numOccurrences;
+  numSavedInsns += static_cast<uint32>(GetBenefit(candidate.starts.size(), candidate.length, candidate.isTailCall));
+  outlinedFuncs.push_back(outlined);
+}
+
+void MachineOutliner::Run() {
+  useProfile = CGOptions::DoLiteProfUse() || Options::profileUse;
+  for (CGFunc *func : funcs) {
+    if (useProfile) {
+      FOR_ALL_BB(bb, func) {
+        maxBBCount = std::max(maxBBCount, GetBBCount(*bb));
+      }
+    }
+    AnalyzeFunction(*func);
+  }
+  std::vector<size_t> str;
+  std::vector<InsnPosition> positions;
+  size_t alphabetSize = MapInsns(str, positions);
+  std::vector<Candidate> candidates;
+  CollectCandidates(str, alphabetSize, positions, candidates);
+  std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+    return a.benefit > b.benefit;
+  });
+  /* all the legality checks were done on the original insns, an insn is outlined at most once */
+  std::vector<bool> claimed(str.size(), false);
+  for (Candidate &candidate : candidates) {
+    std::vector<size_t> starts;
+    for (size_t start : candidate.starts) {
+      auto end = claimed.begin() + static_cast<std::ptrdiff_t>(start + candidate.length);
+      if (std::find(claimed.begin() + static_cast<std::ptrdiff_t>(start), end, true) == end) {
+        starts.push_back(start);
+      }
+    }
+    if (starts.size() < 2 || GetBenefit(starts.size(), candidate.length, candidate.isTailCall) <= 0) {
+      continue;
+    }
+    for (size_t start : starts) {
+      std::fill(claimed.begin() + static_cast<std::ptrdiff_t>(start),
+                claimed.begin() + static_cast<std::ptrdiff_t>(start + candidate.length), true);
+    }
+    candidate.starts = std::move(starts);
+    Outline(candidate, positions);
+  }
+  if (!CGOptions::IsQuiet()) {
+    LogInfo::MapleLogger() << "machine outliner: " << outlinedFuncs.size() << " functions outlined from "
+                           << numReplaced << " sequences, " << numSavedInsns << " insns saved\n";
+  }
+}
+}  /* namespace maplebe */
@@ -16,6 +16,7 @@
 #include "optimize_common.h"
 #include "instrument.h"
 #include "itab_util.h"
+#include "litepgo_format.h"
 #include "cg.h"
 
 namespace maplebe {
@@ -109,9 +110,10 @@ static inline MIRSymbol *GetOrCreateModuleInfo(MIRModule &m, const std::vector<M
   FieldVector fields;
   /* Create module scope profile descriptor type */                                        // Field
   GStrIdx modNameStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("mod_hash");        // 1
-  GStrIdx nextModStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("next_mod");        // 2
-  GStrIdx funcNumStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("func_number");     // 3
-  GStrIdx funcPtrStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("func_info_ptr");   // 4
+  GStrIdx shardsStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("counter_shards");   // 2
+  GStrIdx nextModStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("next_mod");        // 3
+  GStrIdx funcNumStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("func_number");     // 4
+  GStrIdx funcPtrStrIdx = m.GetMIRBuilder()->GetOrCreateStringIndex("func_info_ptr");   // 5
 
   MIRType *u64Ty = GlobalTables::GetTypeTable().GetUInt64();
   TyIdx u64TyIdx = u64Ty->GetTypeIndex();
@@ -120,6 +122,7 @@ static inline MIRSymbol *GetOrCreateModuleInfo(MIRModule &m, const std::vector<M
   TyIdx ptrTyIdx = GlobalTables::GetTypeTable().GetPtr()->GetTypeIndex();
   MIRType *voidPtrTy = GlobalTables::GetTypeTable().GetVoidPtr();
   fields.emplace_back(FieldPair(modNameStrIdx, TyIdxFieldAttrPair(u32TyIdx, FieldAttrs())));
+  fields.emplace_back(FieldPair(shardsStrIdx, TyIdxFieldAttrPair(u32TyIdx, FieldAttrs())));
   fields.emplace_back(FieldPair(nextModStrIdx, TyIdxFieldAttrPair(ptrTyIdx, FieldAttrs())));
   fields.emplace_back(FieldPair(funcNumStrIdx, TyIdxFieldAttrPair(u64TyIdx, FieldAttrs())));
   fields.emplace_back(FieldPair(funcPtrStrIdx, TyIdxFieldAttrPair(ptrTyIdx, FieldAttrs())));
@@ -132,19 +135,26 @@ static inline MIRSymbol *GetOrCreateModuleInfo(MIRModule &m, const std::vector<M
   MIRIntConst *modHashMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(
       DJBHash(LiteProfile::FlatenName(m.GetFileName()).c_str()), *u32Ty);
   modProfSymMirConst->AddItem(modHashMirConst, 1);
+  MIRIntConst *shardsMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(
+      CGProfGen::GetCounterShards(), *u32Ty);
+  modProfSymMirConst->AddItem(shardsMirConst, 2);
   MIRIntConst *nextMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(0, *voidPtrTy);
-  modProfSymMirConst->AddItem(nextMirConst, 2);
+  modProfSymMirConst->AddItem(nextMirConst, 3);
   MIRIntConst *funcNumMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(validFuncs.size(), *u64Ty);
-  modProfSymMirConst->AddItem(funcNumMirConst, 3);
+  modProfSymMirConst->AddItem(funcNumMirConst, 4);
   MIRSymbol *funcTblSym = GetOrCreateFuncInfoTbl(m, validFuncs);
   auto *tblConst = m.GetMemPool()->New<MIRAddrofConst>(
       funcTblSym->GetStIdx(), 0, *GlobalTables::GetTypeTable().GetPtr());
-  modProfSymMirConst->AddItem(tblConst, 4);
+  modProfSymMirConst->AddItem(tblConst, 5);
 
   sym->SetKonst(modProfSymMirConst);
   return sym;
 }
 
+uint32 CGProfGen::GetCounterShards() {
+  return CGOptions::GetLitePgoCounterMode() == CGOptions::kShardedCounter ? MPL_LITE_PGO_SHARDS : 1;
+}
+
 void CGProfGen::CreateProfFileSym(MIRModule &m, std::string &outputPath, const std::string &symName) {
   auto *mirBuilder = m.GetMIRBuilder();
   auto *charPtrType = GlobalTables::GetTypeTable().GetTypeFromTyIdx(TyIdx(PTY_a64));
@@ -253,8 +263,12 @@ void CGProfGen::InstrumentFunction() {
   CGCFG *cfg = f->GetTheCFG();
   CHECK_FATAL(cfg != nullptr, "exit");
 
-  MIRSymbol *bbCounterTab = GetOrCreateFuncCounter(f->GetFunction(),
-      static_cast<uint32>(iBBs.size()), cfg->ComputeCFGHash());
+  auto counterNum = static_cast<uint32>(iBBs.size());
+  uint32 shards = GetCounterShards();
+  if (shards > 1) {
+    shardRowShift = static_cast<uint32>(__builtin_ctz(Mpl_Lite_Pgo_ShardStride(counterNum)));
+  }
+  MIRSymbol *bbCounterTab = GetOrCreateFuncCounter(f->GetFunction(), counterNum, cfg->ComputeCFGHash(), shards);
   BECommon *be = Globals::GetInstance()->GetBECommon();
   uint32 newTypeTableSize = GlobalTables::GetTypeTable().GetTypeTableSize();
   if (newTypeTableSize != oldTypeTableSize) {
@@ -28,6 +28,9 @@
 #include "target_info.h"
 #include "standardize.h"
 #include "cg_callgraph_reorder.h"
+#include "cg_func_cache.h"
+#include "cg_outliner.h"
+#include "litepgo.h"
 #if defined(TARGAARCH64) && TARGAARCH64
 #include "aarch64_emitter.h"
 #include "aarch64_cg.h"
@@ -357,9 +360,9 @@ void CgFuncPM::GenerateOutPutFile(MIRModule &m) const {
   InitProfile(m);
 }
 
-bool CgFuncPM::FuncLevelRun(CGFunc &cgFunc, AnalysisDataManager &serialADM) {
+bool CgFuncPM::FuncLevelRun(CGFunc &cgFunc, AnalysisDataManager &serialADM, size_t beginIdx, size_t endIdx) {
   bool changed = false;
-  for (size_t i = 0; i < phasesSequence.size(); ++i) {
+  for (size_t i = beginIdx; i < endIdx; ++i) {
     SolveSkipFrom(CGOptions::GetSkipFromPhase(), i);
     const MaplePhaseInfo *curPhase = MaplePhaseRegister::GetMaplePhaseRegister()->GetPhaseByID(phasesSequence[i]);
     if (!IsQuiet()) {
@@ -377,6 +380,43 @@ bool CgFuncPM::FuncLevelRun(CGFunc &cgFunc, AnalysisDataManager &serialADM) {
   return changed;
 }
 
+/*
+ * The machine outliner needs the final code of every function of the module, emission is then deferred to the end
+ * and the code of the functions is kept alive until then.
+ */
+MachineOutliner *CgFuncPM::CreateMachineOutliner(MIRModule &m, bool withFuncCache) {
+  if (!CGOptions::DoMachineOutline() || !m.IsCModule() || withFuncCache || cgOptions->WithDwarf() ||
+      m.HasPartO2List() || CGOptions::GetEmitFileType() != CGOptions::kAsm || phasesSequence.empty()) {
+    return nullptr;
+  }
+  const MaplePhaseInfo *lastPhase = MaplePhaseRegister::GetMaplePhaseRegister()->GetPhaseByID(phasesSequence.back());
+  if (lastPhase->PhaseName() != "cgemit") {
+    return nullptr;
+  }
+  return cg->CreateMachineOutliner(*GetManagerMemPool(), m);
+}
+
+bool CgFuncPM::OutlineAndEmit(MIRModule &m, MachineOutliner &outliner, std::vector<DeferredFunc> &deferredFuncs,
+                              AnalysisDataManager &serialADM) {
+  outliner.Run();
+  bool changed = false;
+  for (auto &deferred : deferredFuncs) {
+    m.SetCurFunction(deferred.mirFunc);
+    CG::SetCurCGFunc(*deferred.cgFunc);
+    changed = FuncLevelRun(*deferred.cgFunc, serialADM, phasesSequence.size() - 1, phasesSequence.size()) || changed;
+    if (litePgoCallGraph != nullptr) {
+      RecordLitePgoCallGraph(*deferred.cgFunc, *litePgoCallGraph);
+    }
+  }
+  /* the bodies of the outlined functions are insns of the deferred functions */
+  outliner.EmitOutlinedFunctions(*cg->GetEmitter());
+  for (auto &deferred : deferredFuncs) {
+    deferred.mirFunc->ReleaseCodeMemory();
+  }
+  deferredFuncs.clear();
+  return changed;
+}
+
 void CgFuncPM::PostOutPut(MIRModule &m) const {
   cg->GetEmitter()->EmitHugeSoRoutines(true);
   if (cgOptions->WithDwarf()) {
@@ -601,6 +641,9 @@ bool CgFuncPM::PhaseRun(MIRModule &m) {
     InitFunctionPriority(priorityList);
 
     auto reorderedFunctions = ReorderFunction(m, priorityList);
+    if (!CGOptions::GetLitePgoCallGraphDir().empty() && !CGOptions::GetLiteProfile().empty()) {
+      litePgoCallGraph = std::make_unique<LitePgoCallGraph>();
+    }
 
     if (opts::aggressiveTlsLocalDynamicOpt) {
       m.SetTlsAnchorHashString();
@@ -622,6 +665,9 @@ bool CgFuncPM::PhaseRun(MIRModule &m) {
     if (reorderedFunctions) {
       funcList = &reorderedFunctions.value();
     }
+    CgFuncCache funcCache(m, *cgOptions);
+    MachineOutliner *outliner = CreateMachineOutliner(m, funcCache.IsEnabled());
+    std::vector<DeferredFunc> deferredFuncs;
     for (auto it = funcList->begin(); it != funcList->end(); ++it) {
       ASSERT(serialADM->CheckAnalysisInfoEmpty(), "clean adm before function run");
       MIRFunction *mirFunc = *it;
@@ -652,6 +698,17 @@ bool CgFuncPM::PhaseRun(MIRModule &m) {
       /* LowerIR. */
       m.SetCurFunction(mirFunc);
 
+      if (funcCache.IsEnabled()) {
+        /* the call graph recorded with the cached assembly is merged into the module one on a hit */
+        if (funcCache.Reuse(*mirFunc, countFuncId + 1, *cg->GetEmitter(), litePgoCallGraph.get())) {
+          mirFunc->SetPuidxOrigin(++countFuncId);
+          mirFunc->ReleaseCodeMemory();
+          ++rangeNum;
+          continue;
+        }
+        funcCache.BeginFunction(*cg->GetEmitter());
+      }
+
       if (cg->DoConstFold()) {
         DumpMIRFunc(*mirFunc, "************* before ConstantFold **************");
         ConstantFold cf(m);
@@ -665,9 +722,9 @@ bool CgFuncPM::PhaseRun(MIRModule &m) {
       MIRSymbol *funcSt = GlobalTables::GetGsymTable().GetSymbolFromStidx(mirFunc->GetStIdx().Idx());
       auto funcMp = std::make_unique<ThreadLocalMemPool>(memPoolCtrler, funcSt->GetName());
       auto stackMp = std::make_unique<StackMemPool>(funcMp->GetCtrler(), "");
-      MapleAllocator funcScopeAllocator(funcMp.get());
+      auto funcScopeAllocator = std::make_unique<MapleAllocator>(funcMp.get());
       mirFunc->SetPuidxOrigin(++countFuncId);
-      CGFunc *cgFunc = cg->CreateCGFunc(m, *mirFunc, *beCommon, *funcMp, *stackMp, funcScopeAllocator, countFuncId);
+      CGFunc *cgFunc = cg->CreateCGFunc(m, *mirFunc, *beCommon, *funcMp, *stackMp, *funcScopeAllocator, countFuncId);
       CHECK_FATAL(cgFunc != nullptr, "Create CG Function failed in cg_phase_manager");
       CG::SetCurCGFunc(*cgFunc);
       MarkFunctionPriority(priorityList, *cgFunc);
@@ -678,13 +735,36 @@ bool CgFuncPM::PhaseRun(MIRModule &m) {
       if (CGOptions::UseRange() && rangeNum >= CGOptions::GetRangeBegin() && rangeNum <= CGOptions::GetRangeEnd()) {
         CGOptions::EnableInRange();
       }
-      changed = FuncLevelRun(*cgFunc, *serialADM);
+      if (outliner != nullptr) {
+        /* run everything but cgemit */
+        changed = FuncLevelRun(*cgFunc, *serialADM, 0, phasesSequence.size() - 1);
+        serialADM->EraseAllAnalysisPhase();
+        outliner->AddFunction(*cgFunc);
+        deferredFuncs.push_back({ std::move(funcMp), std::move(stackMp), std::move(funcScopeAllocator), mirFunc,
+                                  cgFunc });
+        ++rangeNum;
+        CGOptions::DisableInRange();
+        continue;
+      }
+      changed = FuncLevelRun(*cgFunc, *serialADM, 0, phasesSequence.size());
+      LitePgoCallGraph funcCallGraph;
+      if (litePgoCallGraph != nullptr) {
+        RecordLitePgoCallGraph(*cgFunc, funcCallGraph);
+        litePgoCallGraph->Merge(funcCallGraph);
+      }
+      if (funcCache.IsEnabled()) {
+        funcCache.EndFunction(*cg->GetEmitter(), *cgFunc, litePgoCallGraph != nullptr ? &funcCallGraph : nullptr);
+      }
       /* Delete mempool. */
       mirFunc->ReleaseCodeMemory();
       ++rangeNum;
       CGOptions::DisableInRange();
     }
+    if (outliner != nullptr) {
+      changed = OutlineAndEmit(m, *outliner, deferredFuncs, *serialADM) || changed;
+    }
     PostOutPut(m);
+    WriteLitePgoCallGraph(m);
   } else {
     LogInfo::MapleLogger(kLlErr) << "Skipped generating .s because -no-cg is given" << '\n';
   }
@@ -694,6 +774,46 @@ bool CgFuncPM::PhaseRun(MIRModule &m) {
   return changed;
 }
 
+/*
+ * Records the entry count, the size and the direct calls of an emitted function. Calls are weighted by the count
+ * of their bb, which lite-pgo already measures, so the instrumented runtime needs no counter of its own for them.
+ * The size assumes 4 bytes per machine instruction, exact on aarch64 and an estimate elsewhere.
+ */
+void CgFuncPM::RecordLitePgoCallGraph(const CGFunc &f, LitePgoCallGraph &callGraph) const {
+  constexpr uint64 kInsnBytes = 4;
+  bool withProfile = f.HasLaidOutByPgoUse();
+  uint64 insnNum = 0;
+  FOR_ALL_BB_CONST(bb, &f) {
+    FOR_BB_INSNS_CONST(insn, bb) {
+      if (!insn->IsMachineInstruction()) {
+        continue;
+      }
+      ++insnNum;
+      if (!withProfile || bb->GetFrequency() == 0 || (!insn->IsCall() && !insn->IsTailCall())) {
+        continue;
+      }
+      Operand *target = insn->GetCallTargetOperand();
+      if (target != nullptr && target->IsFuncNameOpnd()) {
+        callGraph.AddCall(f.GetName(), static_cast<FuncNameOperand*>(target)->GetName(), bb->GetFrequency());
+      }
+    }
+  }
+  uint64 entryCount = (withProfile && f.GetFirstBB() != nullptr) ? f.GetFirstBB()->GetFrequency() : 0;
+  callGraph.AddFunction(f.GetName(), entryCount, insnNum * kInsnBytes);
+}
+
+void CgFuncPM::WriteLitePgoCallGraph(const MIRModule &m) const {
+  if (litePgoCallGraph == nullptr) {
+    return;
+  }
+  std::string fileName = CGOptions::GetLitePgoCallGraphDir() + "/" + LiteProfile::FlatenName(m.GetFileName()) +
+      ".cgprof";
+  std::string err;
+  if (!litePgoCallGraph->Write(fileName, err)) {
+    LogInfo::MapleLogger() << "WARN: " << err << '\n';
+  }
+}
+
 void CgFuncPM::DumpFuncCGIR(const CGFunc &f, const std::string &phaseName) const {
   if (CGOptions::DumpPhase(phaseName) && CGOptions::FuncFilter(f.GetName())) {
     LogInfo::MapleLogger() << "\n******** CG IR After " << phaseName << ": *********\n";
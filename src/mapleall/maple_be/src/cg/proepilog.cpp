@@ -242,7 +242,13 @@ bool CgGenProEpiLog::PhaseRun(maplebe::CGFunc &f) {
   genPE = GetPhaseAllocator()->New<Arm32GenProEpilog>(f);
 #endif
 #if defined(TARGX86_64) && TARGX86_64
-  genPE = GetPhaseAllocator()->New<X64GenProEpilog>(f);
+  const ProEpilogSaveInfo *saveInfo = nullptr;
+  if (Globals::GetInstance()->GetOptimLevel() >= CGOptions::kLevel2 && !CGOptions::OptimizeForSize()) {
+    auto *proepilogIt = GetAnalysisInfoHook()->ForceRunAnalysisPhase<MapleFunctionPhase<CGFunc>, CGFunc>(
+        &CgProEpilogAnalysis::id, f);
+    saveInfo = static_cast<CgProEpilogAnalysis*>(proepilogIt)->GetResult();
+  }
+  genPE = GetPhaseAllocator()->New<X64GenProEpilog>(f, saveInfo);
 #endif
   genPE->Run();
   return false;
@@ -376,7 +376,7 @@ bool ReachingDefinition::GenerateOut(const BB &bb) {
 
   if ((mode & kRDMemAnalysis) != 0) {
     LocalMapleAllocator alloc(stackMp);
-    DataInfo &bbMemOutBak = memOut[bb.GetId()]->Clone(alloc);
+    SparseDataInfo &bbMemOutBak = memOut[bb.GetId()]->Clone(alloc);
     *memOut[bb.GetId()] = *memIn[bb.GetId()];
     memOut[bb.GetId()]->OrBits(*memGen[bb.GetId()]);
     if (!memOut[bb.GetId()]->IsEqual(bbMemOutBak)) {
@@ -430,7 +430,7 @@ bool ReachingDefinition::GenerateIn(const BB &bb) {
   }
   if ((mode & kRDMemAnalysis) != 0) {
     LocalMapleAllocator alloc(stackMp);
-    DataInfo &memInBak = memIn[bb.GetId()]->Clone(alloc);
+    SparseDataInfo &memInBak = memIn[bb.GetId()]->Clone(alloc);
     for (auto predBB : bb.GetPreds()) {
       memIn[bb.GetId()]->OrBits(*memOut[predBB->GetId()]);
     }
@@ -549,10 +549,10 @@ void ReachingDefinition::InitRegAndMemInfo(const BB &bb) {
 
   if ((mode & kRDMemAnalysis) != 0) {
     const int32 kStackSize = GetStackSize();
-    memGen[bb.GetId()] = new DataInfo((kStackSize / kMemZoomSize), rdAlloc);
-    memUse[bb.GetId()] = new DataInfo((kStackSize / kMemZoomSize), rdAlloc);
-    memIn[bb.GetId()] = new DataInfo((kStackSize / kMemZoomSize), rdAlloc);
-    memOut[bb.GetId()] = new DataInfo((kStackSize / kMemZoomSize), rdAlloc);
+    memGen[bb.GetId()] = new SparseDataInfo((kStackSize / kMemZoomSize), rdAlloc);
+    memUse[bb.GetId()] = new SparseDataInfo((kStackSize / kMemZoomSize), rdAlloc);
+    memIn[bb.GetId()] = new SparseDataInfo((kStackSize / kMemZoomSize), rdAlloc);
+    memOut[bb.GetId()] = new SparseDataInfo((kStackSize / kMemZoomSize), rdAlloc);
   }
 }
 
@@ -682,63 +682,39 @@ void ReachingDefinition::GenerateIn(const BB &bb, std::queue<BB*> &worklist, std
   }
 }
 
-/* if bb->out changed, update in and out */
+/*
+ * rebuild gen of changedBB from its insns and propagate the words of gen it changed. InitGenUse rebuilds the reg
+ * and the mem info together, so the changes of both are propagated; only those words of in/out are recomputed.
+ */
 void ReachingDefinition::UpdateInOut(BB &changedBB) {
-  InitGenUse(changedBB, false);
-  if (!GenerateOut(changedBB)) {
-    return;
-  }
-
-  std::unordered_set<BB*> bbSet;
-  std::unordered_set<BB*>::iterator setItr;
-
-  for (auto succ : changedBB.GetSuccs()) {
-    (void)bbSet.insert(succ);
-  }
-
-  for (auto ehSucc : changedBB.GetEhSuccs()) {
-    (void)bbSet.insert(ehSucc);
-  }
-
-  while (!bbSet.empty()) {
-    setItr = bbSet.begin();
-    BB *bb = *setItr;
-    ASSERT(bb != nullptr, "null ptr check");
-    bbSet.erase(setItr);
-
-    if (GenerateIn(*bb)) {
-      if (GenerateOut(*bb)) {
-        for (auto succ : bb->GetSuccs()) {
-          (void)bbSet.insert(succ);
-        }
-
-        for (auto ehSucc : bb->GetEhSuccs()) {
-          (void)bbSet.insert(ehSucc);
-        }
-      }
+  std::set<uint32> changedRegIndex;
+  std::set<uint32> changedMemIndex;
+  {
+    LocalMapleAllocator alloc(stackMp);
+    DataInfo *regGenBak = nullptr;
+    SparseDataInfo *memGenBak = nullptr;
+    if ((mode & kRDRegAnalysis) != 0) {
+      regGenBak = &regGen[changedBB.GetId()]->Clone(alloc);
+    }
+    if ((mode & kRDMemAnalysis) != 0) {
+      memGenBak = &memGen[changedBB.GetId()]->Clone(alloc);
+    }
+    InitGenUse(changedBB, false);
+    if (regGenBak != nullptr) {
+      regGenBak->EorBits(*regGen[changedBB.GetId()]);
+      regGenBak->GetNonZeroElemsIndex(changedRegIndex);
+    }
+    if (memGenBak != nullptr) {
+      memGenBak->EorBits(*memGen[changedBB.GetId()]);
+      memGenBak->GetNonZeroElemsIndex(changedMemIndex);
     }
   }
-
-  if (!changedBB.IsCleanup() && firstCleanUpBB != nullptr) {
-    BuildInOutForCleanUpBB();
-  }
+  PropagateChangedInfo(changedBB, changedRegIndex, true);
+  PropagateChangedInfo(changedBB, changedMemIndex, false);
 }
 
-void ReachingDefinition::UpdateInOut(BB &changedBB, bool isReg) {
-  std::set<uint32> changedInfoIndex;
-  if (isReg) {
-    LocalMapleAllocator alloc(stackMp);
-    DataInfo &genInfoBak = regGen[changedBB.GetId()]->Clone(alloc);
-    InitGenUse(changedBB, false);
-    genInfoBak.EorBits(*regGen[changedBB.GetId()]);
-    genInfoBak.GetNonZeroElemsIndex(changedInfoIndex);
-  } else {
-    LocalMapleAllocator alloc(stackMp);
-    DataInfo &genInfoBak = memGen[changedBB.GetId()]->Clone(alloc);
-    InitGenUse(changedBB, false);
-    genInfoBak.EorBits(*memGen[changedBB.GetId()]);
-    genInfoBak.GetNonZeroElemsIndex(changedInfoIndex);
-  }
+void ReachingDefinition::PropagateChangedInfo(const BB &changedBB, const std::set<uint32> &changedInfoIndex,
+                                              bool isReg) {
   if (changedInfoIndex.empty()) {
     return;
   }
@@ -775,7 +751,6 @@ void ReachingDefinition::UpdateInOut(BB &changedBB, bool isReg) {
   }
 }
 
-
 /* compute bb->in, bb->out for cleanup BBs */
 void ReachingDefinition::BuildInOutForCleanUpBB() {
   ASSERT(firstCleanUpBB != nullptr, "firstCleanUpBB must not be nullptr");
@@ -1311,6 +1286,7 @@ void ReachingDefinition::EnlargeRegCapacity(uint32 size) {
 
 void ReachingDefinition::DumpInfo(const BB &bb, DumpType flag) const {
   const DataInfo *info = nullptr;
+  const SparseDataInfo *memInfo = nullptr;
   switch (flag) {
     case kDumpRegGen:
       LogInfo::MapleLogger() << "    regGen:\n";
@@ -1330,40 +1306,48 @@ void ReachingDefinition::DumpInfo(const BB &bb, DumpType flag) const {
       break;
     case kDumpMemGen:
       LogInfo::MapleLogger() << "    memGen:\n";
-      info = memGen[bb.GetId()];
+      memInfo = memGen[bb.GetId()];
       break;
     case kDumpMemIn:
       LogInfo::MapleLogger() << "    memIn:\n";
-      info = memIn[bb.GetId()];
+      memInfo = memIn[bb.GetId()];
       break;
     case kDumpMemOut:
       LogInfo::MapleLogger() << "    memOut:\n";
-      info = memOut[bb.GetId()];
+      memInfo = memOut[bb.GetId()];
       break;
     case kDumpMemUse:
       LogInfo::MapleLogger() << "    memUse:\n";
-      info = memUse[bb.GetId()];
+      memInfo = memUse[bb.GetId()];
       break;
     default:
       return;
   }
-  ASSERT(info != nullptr, "null ptr check");
+  std::set<uint32> bits;
+  if (memInfo != nullptr) {
+    memInfo->GetBitsOfInfo(bits);
+  } else {
+    ASSERT(info != nullptr, "null ptr check");
+    for (uint32 i = 0; i != info->Size(); ++i) {
+      if (info->TestBit(i)) {
+        (void)bits.insert(i);
+      }
+    }
+  }
   uint32 count = 1;
   LogInfo::MapleLogger() << "        ";
-  for (uint32 i = 0; i != info->Size(); ++i) {
-    if (info->TestBit(i)) {
-      count += 1;
-      if (kDumpMemGen <= flag && flag <= kDumpMemUse) {
-        /* Each element i means a 4 byte stack slot. */
-        LogInfo::MapleLogger() << (i * 4) << " ";
-      } else {
-        LogInfo::MapleLogger() << i << " ";
-      }
-      /* 10 output per line */
-      if (count % 10 == 0) {
-        LogInfo::MapleLogger() << "\n";
-        LogInfo::MapleLogger() << "        ";
-      }
+  for (uint32 i : bits) {
+    count += 1;
+    if (kDumpMemGen <= flag && flag <= kDumpMemUse) {
+      /* Each element i means a 4 byte stack slot. */
+      LogInfo::MapleLogger() << (i * 4) << " ";
+    } else {
+      LogInfo::MapleLogger() << i << " ";
+    }
+    /* 10 output per line */
+    if (count % 10 == 0) {
+      LogInfo::MapleLogger() << "\n";
+      LogInfo::MapleLogger() << "        ";
     }
   }
 
@@ -16,6 +16,8 @@
 #include "cgfunc.h"
 #if TARGAARCH64
 #include "aarch64_regsaves.h"
+#elif defined(TARGX86_64) && TARGX86_64
+#include "x64_regsaves.h"
 #elif defined(TARGRISCV64) && TARGRISCV64
 #include "riscv64_regsaves.h"
 #endif
@@ -42,8 +44,13 @@ bool CgRegSavesOpt::PhaseRun(maplebe::CGFunc &f) {
   DomAnalysis *dom = nullptr;
   PostDomAnalysis *pdom = nullptr;
   LoopAnalysis *loop = nullptr;
-  if (Globals::GetInstance()->GetOptimLevel() >= CGOptions::kLevel1 &&
-      f.GetCG()->GetCGOptions().DoColoringBasedRegisterAllocation()) {
+#if defined(TARGX86_64) && TARGX86_64
+  /* X64RegSavesOpt needs them whichever register allocator ran */
+  bool needDom = true;
+#else
+  bool needDom = f.GetCG()->GetCGOptions().DoColoringBasedRegisterAllocation();
+#endif
+  if (Globals::GetInstance()->GetOptimLevel() >= CGOptions::kLevel1 && needDom) {
     MaplePhase *phase = GetAnalysisInfoHook()->
         ForceRunAnalysisPhase<MapleFunctionPhase<CGFunc>, CGFunc>(&CgDomAnalysis::id, f);
     dom = static_cast<CgDomAnalysis*>(phase)->GetResult();
@@ -62,6 +69,11 @@ bool CgRegSavesOpt::PhaseRun(maplebe::CGFunc &f) {
   CHECK_FATAL(pdom != nullptr, "null ptr check");
   CHECK_FATAL(loop != nullptr, "null ptr check");
   regSavesOpt = memPool->New<AArch64RegSavesOpt>(f, *memPool, *dom, *pdom, *loop);
+#elif defined(TARGX86_64) && TARGX86_64
+  CHECK_FATAL(dom != nullptr, "null ptr check");
+  CHECK_FATAL(pdom != nullptr, "null ptr check");
+  CHECK_FATAL(loop != nullptr, "null ptr check");
+  regSavesOpt = memPool->New<X64RegSavesOpt>(f, *memPool, *dom, *pdom, *loop);
 #elif defined(TARGRISCV64) || TARGRISCV64
   regSavesOpt = memPool->New<Riscv64RegSavesOpt>(f, *memPool);
 #endif
@@ -21,44 +21,107 @@
 namespace maplebe {
 using namespace maple;
 
+/*
+ * Without calls, stack accesses, callee saved registers to save in the prolog, varargs or alloca, the function
+ * runs on the frame of its caller and needs no prolog/epilog at all.
+ */
+static inline bool X64NeedProEpilog(CGFunc &cgFunc) {
+  if (cgFunc.GetMirModule().GetSrcLang() != kSrcLangC || cgFunc.GetFunction().GetAttr(FUNCATTR_varargs) ||
+      cgFunc.HasVLAOrAlloca() || cgFunc.GetNeedStackProtect()) {
+    return true;
+  }
+  auto &x64CGFunc = static_cast<X64CGFunc&>(cgFunc);
+  if (x64CGFunc.IsCalleeSavesPlaced() ? !x64CGFunc.GetProEpilogSavedRegs().empty() :
+      !x64CGFunc.GetCalleeSavedRegs().empty()) {
+    return true;
+  }
+  auto isFrameReg = [](const RegOperand *regOpnd) {
+    return regOpnd != nullptr && (regOpnd->GetRegisterNumber() == x64::RBP || regOpnd->GetRegisterNumber() == x64::RSP);
+  };
+  FOR_ALL_BB(bb, &cgFunc) {
+    FOR_BB_INSNS(insn, bb) {
+      if (!insn->IsMachineInstruction()) {
+        continue;
+      }
+      if (insn->IsCall() || insn->IsSpecialCall() || insn->IsAsmInsn()) {
+        return true;
+      }
+      for (uint32 i = 0; i < insn->GetOperandSize(); ++i) {
+        Operand &opnd = insn->GetOperand(i);
+        if (opnd.IsRegister() && isFrameReg(static_cast<RegOperand*>(&opnd))) {
+          return true;
+        }
+        if (opnd.IsMemoryAccessOperand()) {
+          auto &memOpnd = static_cast<MemOperand&>(opnd);
+          if (isFrameReg(memOpnd.GetBaseRegister()) || isFrameReg(memOpnd.GetIndexRegister())) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool X64ProEpilogAnalysis::NeedProEpilog() {
+  return X64NeedProEpilog(cgFunc);
+}
+
 bool X64GenProEpilog::NeedProEpilog() {
-  return true;
+  return X64NeedProEpilog(cgFunc);
 }
+
 void X64GenProEpilog::GenerateCalleeSavedRegs(bool isPush) {
   X64CGFunc &x64cgFunc = static_cast<X64CGFunc&>(cgFunc);
-  const auto &calleeSavedRegs = x64cgFunc.GetCalleeSavedRegs();
-  if (calleeSavedRegs.empty()) {
-    return;
+  const auto &calleeSavedRegs = x64cgFunc.IsCalleeSavesPlaced() ? x64cgFunc.GetProEpilogSavedRegs() :
+      x64cgFunc.GetCalleeSavedRegs();
+  for (const auto &reg : calleeSavedRegs) {
+    AppendCalleeSavedRegInsn(cgFunc, reg, isPush);
   }
+}
+
+/* the slots keep the order of GetCalleeSavedRegs whichever regs are saved in the prolog */
+int64 X64GenProEpilog::GetCalleeSavedRegOffset(CGFunc &cgFunc, x64::X64reg reg) {
+  auto &x64cgFunc = static_cast<X64CGFunc&>(cgFunc);
   /* CalleeSave(0) = -(FrameSize + CalleeReg - ArgsStk) */
   X64MemLayout *memLayout = static_cast<X64MemLayout*>(cgFunc.GetMemlayout());
-  int64 offset = -(memLayout->StackFrameSize() + static_cast<X64CGFunc&>(cgFunc).SizeOfCalleeSaved() -
+  int64 offset = -(memLayout->StackFrameSize() + x64cgFunc.SizeOfCalleeSaved() -
       memLayout->SizeOfArgsToStackPass());
-  RegOperand &baseReg = cgFunc.GetOpndBuilder()->CreatePReg(x64::RBP, k64BitSize, kRegTyInt);
-  for (const auto &reg : calleeSavedRegs) {
-    RegType regType = IsGPRegister(reg) ? kRegTyInt : kRegTyFloat;
-    uint32 regByteSize = IsGPRegister(reg) ? kIntregBytelen : kFpregBytelen;
-    uint32 regSize = regByteSize * kBitsPerByte;
-    ASSERT((regSize == k32BitSize || regSize == k64BitSize), "only supported 32/64-bits");
-    RegOperand &calleeReg = cgFunc.GetOpndBuilder()->CreatePReg(reg, regSize, regType);
-    MemOperand &memOpnd = cgFunc.GetOpndBuilder()->CreateMem(baseReg, offset, regSize);
-    if (isPush) {
-      GeneratePushCalleeSavedRegs(calleeReg, memOpnd, regSize);
-    } else {
-      GeneratePopCalleeSavedRegs(calleeReg, memOpnd, regSize);
+  for (const auto &calleeReg : x64cgFunc.GetCalleeSavedRegs()) {
+    if (calleeReg == reg) {
+      return offset;
     }
-    offset += regByteSize;
+    offset += IsGPRegister(calleeReg) ? kIntregBytelen : kFpregBytelen;
   }
+  CHECK_FATAL(false, "not a callee saved register of the function");
+  return offset;
 }
 
-void X64GenProEpilog::GeneratePushCalleeSavedRegs(RegOperand &regOpnd, MemOperand &memOpnd, uint32 regSize) {
+void X64GenProEpilog::AppendCalleeSavedRegInsn(CGFunc &cgFunc, x64::X64reg reg, bool isPush) {
+  RegType regType = IsGPRegister(reg) ? kRegTyInt : kRegTyFloat;
+  uint32 regByteSize = IsGPRegister(reg) ? kIntregBytelen : kFpregBytelen;
+  uint32 regSize = regByteSize * kBitsPerByte;
+  ASSERT((regSize == k32BitSize || regSize == k64BitSize), "only supported 32/64-bits");
+  RegOperand &baseReg = cgFunc.GetOpndBuilder()->CreatePReg(x64::RBP, k64BitSize, kRegTyInt);
+  RegOperand &calleeReg = cgFunc.GetOpndBuilder()->CreatePReg(reg, regSize, regType);
+  MemOperand &memOpnd = cgFunc.GetOpndBuilder()->CreateMem(baseReg, GetCalleeSavedRegOffset(cgFunc, reg), regSize);
+  if (isPush) {
+    GeneratePushCalleeSavedRegs(cgFunc, calleeReg, memOpnd, regSize);
+  } else {
+    GeneratePopCalleeSavedRegs(cgFunc, calleeReg, memOpnd, regSize);
+  }
+}
+
+void X64GenProEpilog::GeneratePushCalleeSavedRegs(CGFunc &cgFunc, RegOperand &regOpnd, MemOperand &memOpnd,
+                                                  uint32 regSize) {
   MOperator mMovrmOp = (regSize == k32BitSize) ? x64::MOP_movl_r_m : x64::MOP_movq_r_m;
   Insn &copyInsn = cgFunc.GetInsnBuilder()->BuildInsn(mMovrmOp, X64CG::kMd[mMovrmOp]);
   copyInsn.AddOpndChain(regOpnd).AddOpndChain(memOpnd);
   cgFunc.GetCurBB()->AppendInsn(copyInsn);
 }
 
-void X64GenProEpilog::GeneratePopCalleeSavedRegs(RegOperand &regOpnd, MemOperand &memOpnd, uint32 regSize) {
+void X64GenProEpilog::GeneratePopCalleeSavedRegs(CGFunc &cgFunc, RegOperand &regOpnd, MemOperand &memOpnd,
+                                                 uint32 regSize) {
   MOperator mMovrmOp = (regSize == k32BitSize) ? x64::MOP_movl_m_r : x64::MOP_movq_m_r;
   Insn &copyInsn = cgFunc.GetInsnBuilder()->BuildInsn(mMovrmOp, X64CG::kMd[mMovrmOp]);
   copyInsn.AddOpndChain(memOpnd).AddOpndChain(regOpnd);
@@ -149,6 +212,21 @@ void X64GenProEpilog::GenerateProlog(BB &bb) {
   cgFunc.SetCurBB(*formerCurBB);
 }
 
+/* the epilog goes before the branch ending the BB, e.g. the jump to the return BB */
+void X64GenProEpilog::AppendBBtoEpilog(BB &epilogBB, BB &newBB) const {
+  FOR_BB_INSNS(insn, &newBB) {
+    insn->SetDoNotRemove(true);
+  }
+  auto *lastInsn = epilogBB.GetLastMachineInsn();
+  if (lastInsn != nullptr && lastInsn->IsBranch()) {
+    epilogBB.RemoveInsn(*lastInsn);
+    epilogBB.AppendBBInsns(newBB);
+    epilogBB.AppendInsn(*lastInsn);
+  } else {
+    epilogBB.AppendBBInsns(newBB);
+  }
+}
+
 void X64GenProEpilog::GenerateEpilog(BB &bb) {
   auto &x64CGFunc = static_cast<X64CGFunc&>(cgFunc);
   BB *formerCurBB = cgFunc.GetCurBB();
@@ -174,17 +252,37 @@ void X64GenProEpilog::GenerateEpilog(BB &bb) {
     pushInsn.AddOpndChain(opndFpReg);
     cgFunc.GetCurBB()->AppendInsn(pushInsn);
   }
-  /* ret */
-  MOperator mRetOp = x64::MOP_retq;
-  Insn &retInsn = cgFunc.GetInsnBuilder()->BuildInsn(mRetOp, X64CG::kMd[mRetOp]);
-  cgFunc.GetCurBB()->AppendInsn(retInsn);
 
-  bb.AppendBBInsns(*x64CGFunc.GetDummyBB());
+  AppendBBtoEpilog(bb, *x64CGFunc.GetDummyBB());
   cgFunc.SetCurBB(*formerCurBB);
 }
 
+void X64GenProEpilog::GenerateRetInsn(BB &bb) {
+  MOperator mRetOp = x64::MOP_retq;
+  Insn &retInsn = cgFunc.GetInsnBuilder()->BuildInsn(mRetOp, X64CG::kMd[mRetOp]);
+  bb.AppendInsn(retInsn);
+}
+
 void X64GenProEpilog::Run() {
-  GenerateProlog(*(cgFunc.GetFirstBB()));
-  GenerateEpilog(*(cgFunc.GetLastBB()));
+  /* all returns jump to the last BB */
+  BB &retBB = *cgFunc.GetLastBB();
+  if (!NeedProEpilog()) {
+    GenerateRetInsn(retBB);
+    return;
+  }
+  if (saveInfo == nullptr || saveInfo->prologBBs.empty()) {
+    GenerateProlog(*(cgFunc.GetFirstBB()));
+    GenerateEpilog(retBB);
+  } else {
+    /* shrink-wrapped: the paths avoiding prologBBs never set up the frame */
+    CHECK_FATAL(cgFunc.GetMirModule().IsCModule(), "NIY, only support C");
+    for (auto bbId : saveInfo->prologBBs) {
+      GenerateProlog(*cgFunc.GetBBFromID(bbId));
+    }
+    for (auto bbId : saveInfo->epilogBBs) {
+      GenerateEpilog(*cgFunc.GetBBFromID(bbId));
+    }
+  }
+  GenerateRetInsn(retBB);
 }
 }  /* namespace maplebe */
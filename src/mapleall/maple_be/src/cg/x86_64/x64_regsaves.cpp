@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "x64_regsaves.h"
+#include "x64_proepilog.h"
+#include "cg_ssa_pre.h"
+#include "cg_mc_ssa_pre.h"
+#include "cg_ssu_pre.h"
+#include "securec.h"
+
+namespace maplebe {
+
+#define RS_DUMP CG_DEBUG_FUNC(*cgFunc)
+
+using namespace x64;
+
+static_assert(kMaxRegNum <= sizeof(X64RegSavesOpt::CalleeBitsType) * kBitsPerByte,
+              "callee-saved register bits do not fit");
+
+void X64RegSavesOpt::InitData() {
+  size_t bitsSize = cgFunc->NumBBs() * sizeof(CalleeBitsType);
+  calleeBitsDef = memPool->NewArray<CalleeBitsType>(cgFunc->NumBBs());
+  errno_t retDef = memset_s(calleeBitsDef, bitsSize, 0, bitsSize);
+  calleeBitsUse = memPool->NewArray<CalleeBitsType>(cgFunc->NumBBs());
+  errno_t retUse = memset_s(calleeBitsUse, bitsSize, 0, bitsSize);
+  calleeBitsAcc = memPool->NewArray<CalleeBitsType>(cgFunc->NumBBs());
+  errno_t retAccDef = memset_s(calleeBitsAcc, bitsSize, 0, bitsSize);
+  CHECK_FATAL(retDef == EOK && retUse == EOK && retAccDef == EOK, "memset_s of calleesBits failed");
+
+  /* e.g. rbp, never moved out of the prolog */
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  for (auto reg : x64CGFunc->GetCalleeSavedRegs()) {
+    if (!IsCandidateReg(reg)) {
+      x64CGFunc->AddProEpilogSavedReg(reg);
+    }
+  }
+
+  for (auto bb : bfs->sortedBBs) {
+    id2bb[bb->GetId()] = bb;
+  }
+}
+
+void X64RegSavesOpt::CollectLiveInfo(const BB &bb, const Operand &opnd, bool isDef, bool isUse) {
+  if (!opnd.IsRegister()) {
+    return;
+  }
+  const RegOperand &regOpnd = static_cast<const RegOperand&>(opnd);
+  regno_t regNO = regOpnd.GetRegisterNumber();
+  if (regOpnd.GetRegisterType() == kRegTyVary || !IsCandidateReg(regNO)) {
+    return;   /* check only callee-save registers */
+  }
+  if (isDef) {
+    SetCalleeBit(calleeBitsDef, bb.GetId(), regNO);
+  }
+  if (isUse) {
+    SetCalleeBit(calleeBitsUse, bb.GetId(), regNO);
+  }
+}
+
+void X64RegSavesOpt::ProcessOperands(const Insn &insn, const BB &bb) {
+  const InsnDesc *md = insn.GetDesc();
+  for (uint32 i = 0; i < insn.GetOperandSize(); ++i) {
+    Operand &opnd = insn.GetOperand(i);
+    if (opnd.IsList()) {
+      /* asm operand lists included, whether they are read or written is not told apart */
+      for (auto *op : static_cast<ListOperand&>(opnd).GetOperands()) {
+        CollectLiveInfo(bb, *op, insn.IsAsmInsn(), true);
+      }
+    } else if (opnd.IsMemoryAccessOperand()) {
+      auto &memOpnd = static_cast<MemOperand&>(opnd);
+      if (memOpnd.GetBaseRegister() != nullptr) {
+        CollectLiveInfo(bb, *memOpnd.GetBaseRegister(), false, true);
+      }
+      if (memOpnd.GetIndexRegister() != nullptr) {
+        CollectLiveInfo(bb, *memOpnd.GetIndexRegister(), false, true);
+      }
+    } else {
+      auto *regProp = md->opndMD[i];
+      CollectLiveInfo(bb, opnd, regProp->IsRegDef(), regProp->IsRegUse());
+    }
+  }
+}
+
+void X64RegSavesOpt::GenAccDefs() {
+  /* Set up accumulated callee def bits in all blocks */
+  for (auto bb : bfs->sortedBBs) {
+    CalleeBitsType curbbBits = GetBBCalleeBits(calleeBitsDef, bb->GetId());
+    if (bb->GetPreds().empty()) {
+      calleeBitsAcc[bb->GetId()] = curbbBits;
+      continue;
+    }
+    CalleeBitsType tmp = ~static_cast<CalleeBitsType>(0);
+    for (auto pred : bb->GetPreds()) {
+      if (loopInfo.IsBackEdge(*pred, *bb)) {
+        continue;
+      }
+      tmp &= GetBBCalleeBits(calleeBitsAcc, pred->GetId());
+    }
+    calleeBitsAcc[bb->GetId()] = curbbBits | tmp;
+  }
+}
+
+/* Record in each BB the defs and uses of the callee-saved registers */
+void X64RegSavesOpt::GenRegDefUse() {
+  for (auto *bb : bfs->sortedBBs) {
+    FOR_BB_INSNS(insn, bb) {
+      if (!insn->IsMachineInstruction()) {
+        continue;
+      }
+      ProcessOperands(*insn, *bb);
+    }
+  }
+
+  GenAccDefs();
+
+  if (RS_DUMP) {
+    LogInfo::MapleLogger() << "CalleeBits for " << cgFunc->GetName() << ":\n";
+    for (BBID i = 1; i < cgFunc->NumBBs(); ++i) {
+      LogInfo::MapleLogger() << i << " : " << calleeBitsDef[i] << " " <<
+          calleeBitsUse[i] << " " << calleeBitsAcc[i] << "\n";
+    }
+  }
+}
+
+/* a use not preceded by a def on every path reads the value of the caller, it cannot be shrink-wrapped */
+bool X64RegSavesOpt::CheckForUseBeforeDefPath() const {
+  for (BBID bid = 0; bid < cgFunc->NumBBs(); ++bid) {
+    CalleeBitsType use = GetBBCalleeBits(calleeBitsUse, bid);
+    if ((use & GetBBCalleeBits(calleeBitsAcc, bid)) != use) {
+      if (RS_DUMP) {
+        LogInfo::MapleLogger() << "BB" << bid << " has a use before def path\n";
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void X64RegSavesOpt::SaveAllAtProlog() {
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  for (auto reg : x64CGFunc->GetCalleeSavedRegs()) {
+    x64CGFunc->AddProEpilogSavedReg(reg);
+  }
+}
+
+/* Restore cannot be applied, place both save and restore in prolog/epilog */
+void X64RegSavesOpt::RevertToRestoreAtEpilog(X64reg reg) {
+  for (auto *sp : bbSavedRegs) {
+    if (sp != nullptr) {
+      sp->RemoveSaveReg(reg);
+    }
+  }
+  static_cast<X64CGFunc*>(cgFunc)->AddProEpilogSavedReg(reg);
+  if (RS_DUMP) {
+    LogInfo::MapleLogger() << "Restore R" << (reg - 1) << " n/a, do in Pro/Epilog\n";
+  }
+}
+
+void X64RegSavesOpt::DetermineCalleeSaveLocations() {
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  MapleAllocator sprealloc(memPool);
+  for (auto reg : x64CGFunc->GetCalleeSavedRegs()) {
+    if (!IsCandidateReg(reg)) {
+      continue;
+    }
+    SsaPreWorkCand wkCand(&sprealloc);
+    for (BBID bid = 1; bid < static_cast<BBID>(bbSavedRegs.size()); ++bid) {
+      /* Set the BB occurrences of this callee-saved register */
+      if (IsCalleeBitSetDef(bid, reg) || IsCalleeBitSetUse(bid, reg)) {
+        (void)wkCand.occBBs.insert(bid);
+      }
+    }
+    if (cgFunc->GetFunction().GetFuncProfData() == nullptr) {
+      DoSavePlacementOpt(cgFunc, &domInfo, &loopInfo, &wkCand);
+    } else {
+      DoProfileGuidedSavePlacement(cgFunc, &domInfo, &loopInfo, &wkCand);
+    }
+    if (wkCand.saveAtEntryBBs.empty() || wkCand.saveAtProlog) {
+      x64CGFunc->AddProEpilogSavedReg(reg);
+      if (RS_DUMP) {
+        LogInfo::MapleLogger() << "Save R" << (reg - 1) << " n/a, do in Pro/Epilog\n";
+      }
+      continue;
+    }
+    for (BBID entBB : wkCand.saveAtEntryBBs) {
+      if (RS_DUMP) {
+        LogInfo::MapleLogger() << "BB " << entBB << " save for : R" << (reg - 1) << "\n";
+      }
+      GetbbSavedRegsEntry(entBB)->InsertSaveReg(reg);
+    }
+  }
+}
+
+bool X64RegSavesOpt::InsnUsesReg(const Insn &insn, regno_t reg) {
+  for (uint32 i = 0; i < insn.GetOperandSize(); ++i) {
+    const Operand &opnd = insn.GetOperand(i);
+    if (opnd.IsRegister() && static_cast<const RegOperand&>(opnd).GetRegisterNumber() == reg) {
+      return true;
+    }
+    if (opnd.IsMemoryAccessOperand()) {
+      auto &memOpnd = static_cast<const MemOperand&>(opnd);
+      if ((memOpnd.GetBaseRegister() != nullptr && memOpnd.GetBaseRegister()->GetRegisterNumber() == reg) ||
+          (memOpnd.GetIndexRegister() != nullptr && memOpnd.GetIndexRegister()->GetRegisterNumber() == reg)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Determine the restore locations of the registers saved away from the prolog by calling ssu-pre */
+void X64RegSavesOpt::DetermineCalleeRestoreLocations() {
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  MapleAllocator sprealloc(memPool);
+  for (auto reg : x64CGFunc->GetCalleeSavedRegs()) {
+    const auto &pe = x64CGFunc->GetProEpilogSavedRegs();
+    if (pe.find(reg) != pe.end()) {
+      continue;
+    }
+    SPreWorkCand wkCand(&sprealloc);
+    for (BBID bid = 1; bid < static_cast<BBID>(bbSavedRegs.size()); ++bid) {
+      SavedRegInfo *sp = bbSavedRegs[bid];
+      if (sp != nullptr && sp->ContainSaveReg(reg)) {
+        (void)wkCand.saveBBs.insert(bid);
+      }
+      if (IsCalleeBitSetDef(bid, reg) || IsCalleeBitSetUse(bid, reg)) {
+        (void)wkCand.occBBs.insert(bid);
+      }
+    }
+    DoRestorePlacementOpt(cgFunc, &pDomInfo, &wkCand);
+    if (wkCand.saveBBs.empty() || wkCand.restoreAtEpilog) {
+      RevertToRestoreAtEpilog(reg);
+      continue;
+    }
+    /*
+     * A restore at the exit of a BB goes before its ending branch, which must not read the register. Without a
+     * branch the BB must fall through to a single succ: critical edges are not split on x64.
+     */
+    bool exitsOk = true;
+    for (BBID exitBB : wkCand.restoreAtExitBBs) {
+      BB *bb = id2bb[exitBB];
+      Insn *lastInsn = bb->GetLastMachineInsn();
+      if (lastInsn != nullptr && lastInsn->IsBranch()) {
+        exitsOk = !InsnUsesReg(*lastInsn, reg);
+      } else {
+        exitsOk = bb->GetSuccs().size() <= 1;
+      }
+      if (!exitsOk) {
+        break;
+      }
+    }
+    if (!exitsOk) {
+      RevertToRestoreAtEpilog(reg);
+      continue;
+    }
+    for (BBID entBB : wkCand.restoreAtEntryBBs) {
+      if (RS_DUMP) {
+        LogInfo::MapleLogger() << "BB " << entBB << " entry restore: R" << (reg - 1) << "\n";
+      }
+      GetbbSavedRegsEntry(entBB)->InsertEntryReg(reg);
+    }
+    for (BBID exitBB : wkCand.restoreAtExitBBs) {
+      if (RS_DUMP) {
+        LogInfo::MapleLogger() << "BB " << exitBB << " exit restore: R" << (reg - 1) << "\n";
+      }
+      SavedRegInfo *sp = GetbbSavedRegsEntry(exitBB);
+      sp->InsertExitReg(reg);
+      Insn *lastInsn = id2bb[exitBB]->GetLastMachineInsn();
+      sp->insertAtLastMinusOne = lastInsn != nullptr && lastInsn->IsBranch();
+    }
+  }
+}
+
+void X64RegSavesOpt::InsertCalleeSaveCode() {
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  BB *saveBB = cgFunc->GetCurBB();
+  for (BB *bb : bfs->sortedBBs) {
+    SavedRegInfo *sp = bbSavedRegs[bb->GetId()];
+    if (sp == nullptr || sp->GetSaveSet().empty()) {
+      continue;
+    }
+    x64CGFunc->GetDummyBB()->ClearInsns();
+    cgFunc->SetCurBB(*x64CGFunc->GetDummyBB());
+    for (auto reg : sp->GetSaveSet()) {
+      X64GenProEpilog::AppendCalleeSavedRegInsn(*cgFunc, static_cast<X64reg>(reg), true);
+    }
+    FOR_BB_INSNS(insn, x64CGFunc->GetDummyBB()) {
+      insn->SetDoNotRemove(true);
+    }
+    bb->InsertAtBeginning(*x64CGFunc->GetDummyBB());
+  }
+  cgFunc->SetCurBB(*saveBB);
+}
+
+void X64RegSavesOpt::InsertCalleeRestoreCode() {
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  BB *saveBB = cgFunc->GetCurBB();
+  for (BB *bb : bfs->sortedBBs) {
+    SavedRegInfo *sp = bbSavedRegs[bb->GetId()];
+    if (sp == nullptr) {
+      continue;
+    }
+    BB *dummyBB = x64CGFunc->GetDummyBB();
+    if (!sp->GetEntrySet().empty()) {
+      dummyBB->ClearInsns();
+      cgFunc->SetCurBB(*dummyBB);
+      for (auto reg : sp->GetEntrySet()) {
+        X64GenProEpilog::AppendCalleeSavedRegInsn(*cgFunc, static_cast<X64reg>(reg), false);
+      }
+      FOR_BB_INSNS(insn, dummyBB) {
+        insn->SetDoNotRemove(true);
+      }
+      bb->InsertAtBeginning(*dummyBB);
+    }
+    if (!sp->GetExitSet().empty()) {
+      dummyBB->ClearInsns();
+      cgFunc->SetCurBB(*dummyBB);
+      for (auto reg : sp->GetExitSet()) {
+        X64GenProEpilog::AppendCalleeSavedRegInsn(*cgFunc, static_cast<X64reg>(reg), false);
+      }
+      FOR_BB_INSNS(insn, dummyBB) {
+        insn->SetDoNotRemove(true);
+      }
+      if (sp->insertAtLastMinusOne) {
+        bb->InsertAtEndMinus1(*dummyBB);
+      } else {
+        bb->InsertAtEnd(*dummyBB);
+      }
+    }
+  }
+  cgFunc->SetCurBB(*saveBB);
+}
+
+/* Callee-save registers save/restore placement optimization */
+void X64RegSavesOpt::Run() {
+  if (Globals::GetInstance()->GetOptimLevel() <= CGOptions::kLevel1 || !cgFunc->GetMirModule().IsCModule()) {
+    return;
+  }
+  auto *x64CGFunc = static_cast<X64CGFunc*>(cgFunc);
+  x64CGFunc->SetCalleeSavesPlaced();
+
+  Bfs localBfs(*cgFunc, *memPool);
+  bfs = &localBfs;
+  bfs->ComputeBlockOrder();
+  if (RS_DUMP) {
+    LogInfo::MapleLogger() << "##Calleeregs Placement for: " << cgFunc->GetName() << "\n";
+  }
+
+  InitData();
+  GenRegDefUse();
+  if (!CGOptions::UseSsaPreSave() || cgFunc->GetNeedStackProtect() || CheckForUseBeforeDefPath()) {
+    SaveAllAtProlog();
+    return;
+  }
+  DetermineCalleeSaveLocations();
+  DetermineCalleeRestoreLocations();
+
+  InsertCalleeSaveCode();
+  InsertCalleeRestoreCode();
+}
+}  /* namespace maplebe */
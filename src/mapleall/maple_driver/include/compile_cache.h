@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MAPLE_DRIVER_INCLUDE_COMPILE_CACHE_H
+#define MAPLE_DRIVER_INCLUDE_COMPILE_CACHE_H
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "compiler.h"
+#include "muid.h"
+
+namespace maple {
+constexpr char kCompileCacheDirEnv[] = "MAPLE_COMPILE_CACHE_DIR";
+
+/* Digest of a sequence of strings and file contents, the key of a cache entry.
+ * Each string is hashed along with its length, so that ("a", "", "b"), ("a", "b") and ("ab") all differ. */
+class CompileCacheKey {
+ public:
+  CompileCacheKey();
+  ~CompileCacheKey() = default;
+
+  void AddString(const std::string &str);
+  bool AddFile(const std::string &path);
+  /* the digest as a hex string, nothing may be added afterwards */
+  std::string Finish();
+
+ private:
+  MuidContext status;
+};
+
+/* Content-addressed cache of object files produced by the driver.
+ * A cache unit is the Action subtree rooted at an "as" action, i.e. all the tools run to produce one object file.
+ * Its key is the digest of
+ *   - the compiler version and the target triple,
+ *   - the options enabled on the driver command line and the effective option vectors (Compiler::MakeOption) of
+ *     the external tools of the unit, with the paths of the intermediate files stripped,
+ *   - the preprocessed source when the unit starts with clang, the content of the input file otherwise.
+ * On a hit all the actions of the unit are skipped and the cached object is copied to the output of the unit.
+ * The cache directory is bounded by --compile-cache-size, least recently used entries are evicted first.
+ * The directory is only scanned for eviction once the entries stored since the last scan, which every driver
+ * sharing the cache appends to a log, may have filled the slack the last eviction left below the limit.
+ */
+class CompileCache {
+ public:
+  explicit CompileCache(const MplOptions &mplOptions);
+  ~CompileCache() = default;
+
+  bool IsEnabled() const {
+    return !cacheDir.empty();
+  }
+
+  /* Called before running action. Returns true if the action need not run since the object of its unit is
+   * restored from the cache. */
+  bool TryReuse(const Action &action);
+  /* Called after action has run successfully, stores the object once the root of a unit has run. */
+  void Store(const Action &action);
+
+  /* Accounts size bytes just stored in dir, returns true when its entries need to be scanned for eviction */
+  static bool AddStoredSize(const std::string &dir, uint64 limit, uint64 size);
+  /* Evicts the least recently used entries of dir down to 90% of limit once they exceed limit */
+  static void Evict(const std::string &dir, uint64 limit);
+
+ private:
+  struct Unit {
+    const Action *root = nullptr;
+    const Action *firstAction = nullptr;
+    std::vector<const Action*> actions;
+    std::string output;
+    std::string key;
+    bool hit = false;
+  };
+
+  void CollectUnits(const Action &action);
+  void CollectUnitActions(const Action &action, size_t unitIdx);
+  bool IsCacheable(const Unit &unit) const;
+  bool HashInput(const Unit &unit, CompileCacheKey &cacheKey) const;
+  void HashOptions(const Unit &unit, CompileCacheKey &cacheKey) const;
+  std::string GetEntryPath(const std::string &key) const;
+
+  const MplOptions &mplOptions;
+  std::string cacheDir;
+  uint64 sizeLimit = 0;
+  std::vector<Unit> units;
+  std::unordered_map<const Action*, size_t> action2Unit;
+};
+}  // namespace maple
+#endif  // MAPLE_DRIVER_INCLUDE_COMPILE_CACHE_H
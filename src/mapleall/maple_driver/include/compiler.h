@@ -105,6 +105,8 @@ class Compiler {
   }
 
  private:
+  friend class CompileCache;
+
   const std::string name;
   std::vector<MplOption> MakeOption(const MplOptions &options,
                                     const Action &action) const;
@@ -64,6 +64,7 @@ extern maplecl::Option<bool> verify;
 extern maplecl::Option<bool> decoupleStatic;
 extern maplecl::Option<bool> gcOnly;
 extern maplecl::Option<bool> timePhase;
+extern maplecl::Option<bool> memStats;
 extern maplecl::Option<bool> genMeMpl;
 extern maplecl::Option<bool> compileWOLink;
 extern maplecl::Option<bool> genVtable;
@@ -89,6 +90,8 @@ extern maplecl::Option<bool> genMapleBC;
 extern maplecl::Option<bool> genLMBC;
 extern maplecl::Option<bool> profileGen;
 extern maplecl::Option<bool> profileUse;
+extern maplecl::Option<bool> profileValues;
+extern maplecl::Option<std::string> sampleProfile;
 extern maplecl::Option<bool> missingProfDataIsError;
 extern maplecl::Option<bool> stackProtectorStrong;
 extern maplecl::Option<bool> stackProtectorAll;
@@ -1888,6 +1891,7 @@ extern maplecl::Option<bool> fPIC;
 extern maplecl::Option<bool> ignoreUnsupOpt;
 extern maplecl::Option<bool> exportMpltInline;
 extern maplecl::Option<bool> importMpltInline;
+extern maplecl::Option<bool> inlineDb;
 
 /* ##################### STRING Options ############################################################### */
 
@@ -1916,6 +1920,7 @@ extern maplecl::List<std::string> includeDir;
 extern maplecl::List<std::string> includeSystem;
 extern maplecl::Option<std::string> output;
 extern maplecl::Option<std::string> saveTempOpt;
+extern maplecl::Option<std::string> compileCacheDir;
 extern maplecl::Option<std::string> target;
 extern maplecl::Option<std::string> linkerTimeOptE;
 extern maplecl::Option<std::string> oMT;
@@ -2098,6 +2103,8 @@ extern maplecl::Option<std::string> inlineMpltDir;
 
 extern maplecl::Option<uint32_t> helpLevel;
 extern maplecl::Option<uint32_t> funcInliceSize;
+extern maplecl::Option<uint32_t> compileCacheSize;
+extern maplecl::Option<uint32_t> parseThreads;
 extern maplecl::Option<uint32_t> initOptNum;
 extern maplecl::Option<uint32_t> oWframeLargerThan;
 
@@ -15,6 +15,7 @@
 #ifndef MAPLE_DRIVER_INCLUDE_DRIVER_RUNNER_H
 #define MAPLE_DRIVER_INCLUDE_DRIVER_RUNNER_H
 
+#include <set>
 #include <vector>
 #include <string>
 #include "me_option.h"
@@ -76,6 +77,8 @@ class DriverRunner final {
   ErrorCode ParseSrcLang(MIRSrcLang &srcLang) const;
   void SolveCrossModuleInJava(MIRParser &parser) const;
   void SolveCrossModuleInC(MIRParser &parser) const;
+  void SolveCrossModuleByInlineDB(MIRParser &parser, const std::set<std::string> &files,
+                                  const std::string &identPart) const;
   void SetPrintOutExe(const std::string outExe) {
     printOutExe = outExe;
   }
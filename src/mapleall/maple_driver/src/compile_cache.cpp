@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "compile_cache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include "driver_options.h"
+#include "file_utils.h"
+#include "triple.h"
+#include "version.h"
+
+namespace maple {
+namespace {
+constexpr uint64 kBytesPerMB = 1024 * 1024;
+constexpr size_t kHashChunkSize = 64 * 1024;
+constexpr uint32 kBitsPerByte = 8;
+constexpr uint64 kLowWaterPercent = 90;
+constexpr uint64 kPercent = 100;
+const std::string kCacheEntrySuffix = ".o";
+const std::string kStoredLogName = "stored.log";
+
+/* eviction leaves the entries below this, the stores in between need not scan the directory */
+uint64 GetLowWater(uint64 limit) {
+  return limit / kPercent * kLowWaterPercent;
+}
+
+bool CopyFile(const std::string &from, const std::string &to) {
+  std::ifstream in(from, std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::ofstream out(to, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    return false;
+  }
+  out << in.rdbuf();
+  return out.good();
+}
+
+/* Create dir and its parents, other drivers sharing the cache may be creating them concurrently */
+bool MakeDirs(const std::string &dir) {
+  std::string path = dir + kFileSeperatorStr;
+  size_t pos = 0;
+  while ((pos = path.find_first_of(kFileSeperatorStr, pos + 1)) != std::string::npos) {
+    std::string sub = path.substr(0, pos);
+    if (mkdir(sub.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0 && errno != EEXIST) {
+      return false;
+    }
+  }
+  return access(dir.c_str(), W_OK | R_OK) == 0;
+}
+}  // namespace
+
+CompileCacheKey::CompileCacheKey() {
+  MuidInit(status);
+}
+
+void CompileCacheKey::AddString(const std::string &str) {
+  /* the length goes first, in a fixed byte order so that keys do not depend on the host */
+  unsigned char len[sizeof(uint64)];
+  uint64 size = str.size();
+  for (size_t i = 0; i < sizeof(uint64); ++i) {
+    len[i] = static_cast<unsigned char>(size >> (i * kBitsPerByte));
+  }
+  MuidDecode(status, len[0], sizeof(uint64));
+  if (!str.empty()) {
+    MuidDecode(status, *reinterpret_cast<const unsigned char*>(str.data()), str.size());
+  }
+}
+
+bool CompileCacheKey::AddFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::vector<char> buffer(kHashChunkSize);
+  while (in.good()) {
+    (void)in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::streamsize got = in.gcount();
+    if (got > 0) {
+      MuidDecode(status, *reinterpret_cast<const unsigned char*>(buffer.data()), static_cast<size_t>(got));
+    }
+  }
+  return !in.bad();
+}
+
+std::string CompileCacheKey::Finish() {
+  unsigned char digest[kDigestHashLength];
+  MuidEncode(digest, status);
+  std::ostringstream keyStream;
+  for (unsigned char byte : digest) {
+    keyStream << std::hex << std::setw(2) << std::setfill('0') << static_cast<uint32>(byte);
+  }
+  return keyStream.str();
+}
+
+CompileCache::CompileCache(const MplOptions &mplOptions) : mplOptions(mplOptions) {
+  if (opts::compileCacheDir.IsEnabledByUser()) {
+    cacheDir = opts::compileCacheDir.GetValue();
+  } else {
+    cacheDir = FileUtils::SafeGetenv(kCompileCacheDirEnv);
+  }
+  if (cacheDir.empty()) {
+    return;
+  }
+  /* depfiles, LTO objects and preprocessed outputs are not produced by a cache hit */
+  if (opts::oMD.IsEnabledByUser() || opts::linkerTimeOpt.IsEnabledByUser() ||
+      opts::onlyPreprocess.IsEnabledByUser() || mplOptions.GetIsLto()) {
+    cacheDir.clear();
+    return;
+  }
+  if (!MakeDirs(cacheDir)) {
+    LogInfo::MapleLogger(kLlWarn) << "Warning: compile cache directory " << cacheDir << " is not usable\n";
+    cacheDir.clear();
+    return;
+  }
+  sizeLimit = static_cast<uint64>(opts::compileCacheSize.GetValue()) * kBytesPerMB;
+  for (const std::unique_ptr<Action> &action : mplOptions.GetActions()) {
+    CollectUnits(*action);
+  }
+}
+
+void CompileCache::CollectUnits(const Action &action) {
+  if (action.GetTool() == kAsFlag) {
+    size_t unitIdx = units.size();
+    (void)units.emplace_back();
+    units[unitIdx].root = &action;
+    CollectUnitActions(action, unitIdx);
+    if (!units[unitIdx].actions.empty()) {
+      units[unitIdx].firstAction = units[unitIdx].actions.front();
+    }
+    return;
+  }
+  for (const std::unique_ptr<Action> &inAction : action.GetInputActions()) {
+    CollectUnits(*inAction);
+  }
+}
+
+/* actions are collected in the order CompilerFactory::Select runs them, from leaf to root */
+void CompileCache::CollectUnitActions(const Action &action, size_t unitIdx) {
+  for (const std::unique_ptr<Action> &inAction : action.GetInputActions()) {
+    CollectUnitActions(*inAction, unitIdx);
+  }
+  if (action.GetTool() == kInputPhase) {
+    return;
+  }
+  units[unitIdx].actions.push_back(&action);
+  action2Unit[&action] = unitIdx;
+}
+
+bool CompileCache::IsCacheable(const Unit &unit) const {
+  if (unit.firstAction == nullptr || !unit.firstAction->IsItFirstRealAction()) {
+    return false;
+  }
+  /* a unit must be a single chain of tools over a single input */
+  for (const Action *action : unit.actions) {
+    if (action->GetInputActions().size() != 1 || action->GetCompiler() == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CompileCache::HashOptions(const Unit &unit, CompileCacheKey &cacheKey) const {
+  /* options of the driver command line, they also drive the in-process maplecomb.
+   * Include paths only matter through the preprocessed source which is hashed by HashInput. */
+  for (maplecl::OptionInterface *opt : maplecl::CommandLine::GetCommandLine().defaultCategory.GetEnabledOptions()) {
+    if (opt == &opts::output || opt == &opts::compileCacheDir || opt == &opts::compileCacheSize ||
+        opt == &opts::includeDir || opt == &opts::includeSystem) {
+      continue;
+    }
+    cacheKey.AddString(opt->GetName());
+    for (const std::string &val : opt->GetRawValues()) {
+      cacheKey.AddString(val);
+    }
+  }
+  for (const auto &exeOption : mplOptions.GetExeOptions()) {
+    cacheKey.AddString(exeOption.first);
+    for (const std::string &val : exeOption.second) {
+      cacheKey.AddString(val);
+    }
+  }
+  /* effective options of the external tools run after clang. Intermediate files live in the output folder which
+   * depends on the build directory, the input and -o are left out as well since the key must only depend on the
+   * content. */
+  for (const Action *action : unit.actions) {
+    cacheKey.AddString(action->GetTool());
+    if (action->GetTool() != kBinNameCpp2mpl && action->GetTool() != kAsFlag) {
+      continue;
+    }
+    std::vector<MplOption> options = action->GetCompiler()->MakeOption(mplOptions, *action);
+    const std::string &outFolder = action->GetOutputFolder();
+    for (const MplOption &opt : options) {
+      if (opt.GetKey() == "-o" || opt.GetKey() == action->GetInputFile()) {
+        continue;
+      }
+      cacheKey.AddString(outFolder.empty() ? opt.GetKey() : StringUtils::Replace(opt.GetKey(), outFolder, ""));
+      cacheKey.AddString(outFolder.empty() ? opt.GetValue() : StringUtils::Replace(opt.GetValue(), outFolder, ""));
+    }
+  }
+}
+
+bool CompileCache::HashInput(const Unit &unit, CompileCacheKey &cacheKey) const {
+  const Action &first = *unit.firstAction;
+  if (first.GetTool() != kBinNameClang) {
+    return cacheKey.AddFile(first.GetInputFile());
+  }
+  /* hash the preprocessed source rather than the file, so that changes of included headers are seen.
+   * Line markers are dropped unless debug info is generated, they contain the paths of the build directory. */
+  std::vector<MplOption> clangOptions = first.GetCompiler()->MakeOption(mplOptions, first);
+  std::vector<MplOption> ppOptions;
+  for (const MplOption &opt : clangOptions) {
+    if (opt.GetKey() != "-o" && opt.GetKey() != "-emit-ast") {
+      ppOptions.push_back(opt);
+    }
+  }
+  (void)ppOptions.emplace_back("-E", "");
+  if (!opts::withDwarf.IsEnabledByUser()) {
+    (void)ppOptions.emplace_back("-P", "");
+  }
+  std::string ppFile = first.GetFullOutputName() + ".cache.i";
+  (void)ppOptions.emplace_back("-o", ppFile);
+  bool ret = first.GetCompiler()->Exe(mplOptions, first, ppOptions) == 0 && cacheKey.AddFile(ppFile);
+  (void)FileUtils::Remove(ppFile);
+  return ret;
+}
+
+std::string CompileCache::GetEntryPath(const std::string &key) const {
+  return cacheDir + kFileSeperatorStr + key + kCacheEntrySuffix;
+}
+
+bool CompileCache::TryReuse(const Action &action) {
+  auto it = action2Unit.find(&action);
+  if (it == action2Unit.end()) {
+    return false;
+  }
+  Unit &unit = units[it->second];
+  if (&action != unit.firstAction) {
+    return unit.hit;
+  }
+  if (!IsCacheable(unit)) {
+    return false;
+  }
+  std::vector<MplOption> asOptions = unit.root->GetCompiler()->MakeOption(mplOptions, *unit.root);
+  /* the last -o wins, the user specified output is appended after the default one */
+  for (const MplOption &opt : asOptions) {
+    if (opt.GetKey() == "-o") {
+      unit.output = opt.GetValue();
+    }
+  }
+  if (unit.output.empty()) {
+    return false;
+  }
+
+  CompileCacheKey cacheKey;
+  cacheKey.AddString(Version::GetVersionStr());
+  cacheKey.AddString(Triple::GetTriple().Str());
+  HashOptions(unit, cacheKey);
+  if (!HashInput(unit, cacheKey)) {
+    return false;
+  }
+  unit.key = cacheKey.Finish();
+
+  std::string entry = GetEntryPath(unit.key);
+  if (!FileUtils::IsFileExists(entry) || !CopyFile(entry, unit.output)) {
+    if (opts::debug) {
+      LogInfo::MapleLogger() << "Compile cache miss " << unit.key << " for " << unit.output << '\n';
+    }
+    return false;
+  }
+  /* refresh the access time of the entry for the LRU eviction */
+  (void)utime(entry.c_str(), nullptr);
+  if (opts::debug) {
+    LogInfo::MapleLogger() << "Compile cache hit " << unit.key << " for " << unit.output << '\n';
+  }
+  unit.hit = true;
+  return true;
+}
+
+void CompileCache::Store(const Action &action) {
+  auto it = action2Unit.find(&action);
+  if (it == action2Unit.end()) {
+    return;
+  }
+  const Unit &unit = units[it->second];
+  if (&action != unit.root || unit.hit || unit.key.empty()) {
+    return;
+  }
+  /* other drivers may read the entry concurrently, publish it with an atomic rename */
+  std::string entry = GetEntryPath(unit.key);
+  std::string tmpEntry = entry + ".tmp" + std::to_string(getpid());
+  if (!CopyFile(unit.output, tmpEntry) || std::rename(tmpEntry.c_str(), entry.c_str()) != 0) {
+    (void)FileUtils::Remove(tmpEntry);
+    return;
+  }
+  struct stat st;
+  if (stat(entry.c_str(), &st) == 0 && AddStoredSize(cacheDir, sizeLimit, static_cast<uint64>(st.st_size))) {
+    Evict(cacheDir, sizeLimit);
+  }
+}
+
+/* The log holds the sizes of the entries stored since the last scan, one per line. Appends of a line are atomic,
+ * so the drivers sharing the cache need no lock. A missing log means the directory was never scanned. */
+bool CompileCache::AddStoredSize(const std::string &dir, uint64 limit, uint64 size) {
+  std::string logPath = dir + kFileSeperatorStr + kStoredLogName;
+  bool scanned = FileUtils::IsFileExists(logPath);
+  std::ofstream log(logPath, std::ios::out | std::ios::app);
+  log << size << '\n';
+  log.close();
+  if (!scanned) {
+    return true;
+  }
+  std::ifstream in(logPath);
+  uint64 stored = 0;
+  uint64 entrySize = 0;
+  while (in >> entrySize) {
+    stored += entrySize;
+  }
+  return stored > limit - GetLowWater(limit);
+}
+
+void CompileCache::Evict(const std::string &dir, uint64 limit) {
+  /* claim the log, a driver failing to do so leaves the scan to the one which did */
+  std::string logPath = dir + kFileSeperatorStr + kStoredLogName;
+  std::string claimedLog = logPath + ".tmp" + std::to_string(getpid());
+  if (FileUtils::IsFileExists(logPath) && std::rename(logPath.c_str(), claimedLog.c_str()) != 0) {
+    return;
+  }
+  (void)FileUtils::Remove(claimedLog);
+  /* the entries stored from now on count towards the next scan */
+  std::ofstream(logPath, std::ios::out | std::ios::trunc).close();
+
+  struct Entry {
+    std::string path;
+    time_t lastUse;
+    uint64 size;
+  };
+  std::vector<std::string> fileNames;
+  FileUtils::GetFileNames(dir + kFileSeperatorStr, fileNames);
+  std::vector<Entry> entries;
+  uint64 totalSize = 0;
+  for (const std::string &fileName : fileNames) {
+    struct stat st;
+    if (!StringUtils::EndsWith(fileName, kCacheEntrySuffix) || stat(fileName.c_str(), &st) != 0) {
+      continue;
+    }
+    (void)entries.push_back({fileName, st.st_mtime, static_cast<uint64>(st.st_size)});
+    totalSize += static_cast<uint64>(st.st_size);
+  }
+  uint64 lowWater = GetLowWater(limit);
+  if (totalSize <= limit) {
+    /* the entries above the low water already use part of the slack */
+    if (totalSize > lowWater) {
+      std::ofstream(logPath, std::ios::out | std::ios::app) << (totalSize - lowWater) << '\n';
+    }
+    return;
+  }
+  std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+    return a.lastUse < b.lastUse;
+  });
+  for (const Entry &entry : entries) {
+    if (totalSize <= lowWater) {
+      break;
+    }
+    if (std::remove(entry.path.c_str()) == 0) {
+      totalSize -= entry.size;
+    }
+  }
+}
+}  // namespace maple
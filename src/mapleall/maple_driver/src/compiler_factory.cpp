@@ -14,6 +14,7 @@
  */
 #include "compiler_factory.h"
 #include <regex>
+#include "compile_cache.h"
 #include "driver_options.h"
 #include "file_utils.h"
 #include "string_utils.h"
@@ -146,6 +147,7 @@ ErrorCode CompilerFactory::Compile(MplOptions &mplOptions) {
     return ret;
   }
 
+  CompileCache compileCache(mplOptions);
   for (auto *action : actions) {
     if (action == nullptr) {
       LogInfo::MapleLogger() << "Failed! Compiler is null." << "\n";
@@ -157,10 +159,16 @@ ErrorCode CompilerFactory::Compile(MplOptions &mplOptions) {
       return kErrorToolNotFound;
     }
 
+    if (compileCache.IsEnabled() && compileCache.TryReuse(*action)) {
+      continue;
+    }
     ret = compiler->Compile(mplOptions, *action, this->theModule);
     if (ret != kErrorNoError) {
       return ret;
     }
+    if (compileCache.IsEnabled()) {
+      compileCache.Store(*action);
+    }
   }
   if (opts::debug) {
     mplOptions.PrintDetailCommand(false);
@@ -68,6 +68,11 @@ maplecl::Option<bool> timePhase({"-time-phases"},
     "  -time-phases                \tTiming phases and print percentages.\n",
     {driverCategory}, kOptMaple);
 
+maplecl::Option<bool> memStats({"--mem-stats", "-mem-stats"},
+    "  --mem-stats                 \tPrint the peak bytes of each MemPool and the bytes allocated for each type,\n"
+    "                              \tIR node kinds included.\n",
+    {driverCategory}, kOptMaple);
+
 maplecl::Option<bool> genMeMpl({"--genmempl"},
     "  --genmempl                  \tGenerate me.mpl file.\n",
     {driverCategory}, kOptMaple, maplecl::kHide);
@@ -184,6 +189,16 @@ maplecl::Option<bool> profileUse({"--profileUse"},
     "  --profileUse                \tOptimize static languages with profile data.\n",
     {driverCategory, mpl2mplCategory}, kOptMaple, maplecl::kHide);
 
+maplecl::Option<bool> profileValues({"--profile-values"},
+    "  --profile-values            \tWith --profileGen, also profile the callees of indirect calls and the sizes of\n"
+    "                              \tmemcpy/memset, --profileUse promotes and specializes them with the data.\n",
+    {driverCategory, meCategory, mpl2mplCategory}, kOptMaple, maplecl::kHide);
+
+maplecl::Option<std::string> sampleProfile({"--sample-profile"},
+    "  --sample-profile=filepath   \tOptimize static languages with the samples of a perf script dump\n"
+    "                              \t(perf script -F ip,sym,srcline) instead of instrumented profile data.\n",
+    {driverCategory, meCategory, mpl2mplCategory}, kOptMaple, maplecl::kHide);
+
 maplecl::Option<bool> missingProfDataIsError({"--missing-profdata-is-error"},
     "  --missing-profdata-is-error \tTreat missing profile data file as error.\n"
     "  --no-missing-profdata-is-error\n"
@@ -671,6 +686,12 @@ maplecl::Option<bool> importMpltInline({"-fimport-inline-mplt"},
     {driverCategory, mpl2mplCategory}, kOptCommon | kOptOptimization | kOptMaple,
      maplecl::DisableWith("-fno-import-inline-mplt"), maplecl::Init(false));
 
+maplecl::Option<bool> inlineDb({"-finline-db"},
+    "  -finline-db                 \tExport and import the inline mplt as an indexed database, function bodies\n"
+    "                              \tare imported on demand.\n",
+    {driverCategory, hir2mplCategory, mpl2mplCategory}, kOptCommon | kOptOptimization | kOptMaple,
+     maplecl::DisableWith("-fno-inline-db"), maplecl::Init(false));
+
 /* ##################### STRING Options ############################################################### */
 
 maplecl::Option<std::string> help({"--help", "-h"},
@@ -776,6 +797,12 @@ maplecl::Option<std::string> saveTempOpt({"--save-temps"},
     "                              \t--save-temps=file1,file2,file3 Save the target files.\n",
     {driverCategory}, kOptDriver, maplecl::kOptionalValue);
 
+maplecl::Option<std::string> compileCacheDir({"--compile-cache-dir"},
+    "  --compile-cache-dir=<dir>   \tReuse the object files of previous compilations with the same preprocessed\n"
+    "                              \tsource, options and compiler version from <dir>. The environment variable\n"
+    "                              \tMAPLE_COMPILE_CACHE_DIR is used if it is not set.\n",
+    {driverCategory}, kOptDriver);
+
 maplecl::Option<std::string> target({"--target", "-target"},
     "  --target=<arch><abi>        \tDescribe target platform. Example: --target=aarch64-gnu or "
     "--target=aarch64_be-gnuilp32\n",
@@ -921,6 +948,16 @@ maplecl::Option<uint32_t> helpLevel({"--level"},
     "                              \tNUM=3: Debug options\n",
     {driverCategory}, kOptMaple, maplecl::kHide);
 
+maplecl::Option<uint32_t> compileCacheSize({"--compile-cache-size"},
+    "  --compile-cache-size=NUM    \tSize limit of the compile cache directory in MB, least recently used\n"
+    "                              \tobjects are evicted first. Default: 2048.\n",
+    {driverCategory}, kOptDriver, maplecl::Init(2048));
+
+maplecl::Option<uint32_t> parseThreads({"--parse-threads"},
+    "  --parse-threads=n           \tParse the function bodies of the input .mpl file using n threads,\n"
+    "                              \tonce all its declarations are parsed. Default: 1.\n",
+    {driverCategory}, kOptMaple, maplecl::Init(1));
+
 maplecl::Option<uint32_t> funcInliceSize({"-func-inline-size", "--func-inline-size"},
     "  --func-inline-size           \tSet func inline size.\n",
     {driverCategory, hir2mplCategory}, kOptMaple);
@@ -20,6 +20,7 @@
 #include "mir_function.h"
 #include "mir_parser.h"
 #include "file_utils.h"
+#include "inline_db.h"
 #include "constantfold.h"
 #include "lower.h"
 #include "me_phase_manager.h"
@@ -174,7 +175,7 @@ static std::string GetSingleFileName(const std::string input) {
   return input.substr(pos + 1);
 }
 
-static void GetFiles(const std::string &path, std::set<std::string> &fileSet) {
+static void GetFiles(const std::string &path, const std::string &keyWords, std::set<std::string> &fileSet) {
   auto dir = opendir(path.c_str());
   if (!dir) {
     LogInfo::MapleLogger(kLlErr) << "Error: Cannot open inline mplt dir " << Options::inlineMpltDir << '\n';
@@ -190,10 +191,9 @@ static void GetFiles(const std::string &path, std::set<std::string> &fileSet) {
     auto fileName = path + kFileSeperatorChar + file->d_name;
 
     if (file->d_type == DT_DIR) {
-      GetFiles(fileName, fileSet);
+      GetFiles(fileName, keyWords, fileSet);
     }
 
-    std::string keyWords = ".mplt_inline";
     if (file->d_type == DT_REG && fileName.size() > keyWords.size() &&
         fileName.substr(fileName.size() - keyWords.size()) == keyWords) {
       (void)fileSet.emplace(fileName);
@@ -224,9 +224,13 @@ void DriverRunner::SolveCrossModuleInC(MIRParser &parser) const {
 
   // find all inline mplt files from dir
   std::set<std::string> files;
-  GetFiles(Options::inlineMpltDir, files);
+  GetFiles(Options::inlineMpltDir, Options::inlineDb ? InlineDB::kFileSuffix : ".mplt_inline", files);
   std::string curPath = FileUtils::GetCurDirPath();
   auto identPart = FileUtils::GetFileNameHashStr(curPath + kFileSeperatorChar + GetPureName(theModule->GetFileName()));
+  if (Options::inlineDb) {
+    SolveCrossModuleByInlineDB(parser, files, identPart);
+    return;
+  }
 
   LogInfo::MapleLogger() << "[CROSS_MODULE] read inline mplt files from: " << Options::inlineMpltDir << '\n';
   for (auto file : files) {
@@ -248,6 +252,107 @@ void DriverRunner::SolveCrossModuleInC(MIRParser &parser) const {
   }
 }
 
+static void CollectCallees(const BaseNode &node, std::vector<MIRFunction*> &callees) {
+  if (node.GetOpCode() == OP_block) {
+    for (auto &stmt : static_cast<const BlockNode&>(node).GetStmtNodes()) {
+      CollectCallees(stmt, callees);
+    }
+    return;
+  }
+  if (node.GetOpCode() == OP_call || node.GetOpCode() == OP_callassigned) {
+    PUIdx puIdx = static_cast<const CallNode&>(node).GetPUIdx();
+    callees.push_back(GlobalTables::GetFunctionTable().GetFunctionFromPuidx(puIdx));
+  }
+  for (size_t i = 0; i < node.NumOpnds(); ++i) {
+    if (node.Opnd(i) != nullptr) {
+      CollectCallees(*node.Opnd(i), callees);
+    }
+  }
+}
+
+// Import the bodies of the functions the module calls but does not define, including those called by the
+// imported bodies. The persisted summary rules out the bodies ginline would not inline anyway.
+void DriverRunner::SolveCrossModuleByInlineDB(MIRParser &parser, const std::set<std::string> &files,
+                                              const std::string &identPart) const {
+  InlineDB db;
+  for (auto file : files) {
+    TrimString(file);
+    // skip the database of this mirmodule to avoid duplicate definition.
+    if (file.empty() || GetSingleFileName(file).find(identPart) != std::string::npos) {
+      continue;
+    }
+    std::string err;
+    if (!db.ReadIndex(file, err)) {
+      LogInfo::MapleLogger(kLlErr) << "Error: " << err << '\n';
+      CHECK_FATAL_FALSE("read inline database failed!");
+    }
+  }
+  LogInfo::MapleLogger() << "[CROSS_MODULE] read inline database of " << db.GetFuncNum() << " functions from: " <<
+      Options::inlineMpltDir << '\n';
+  std::vector<MIRFunction*> worklist;
+  for (auto *func : theModule->GetFunctionList()) {
+    if (func != nullptr && func->GetBody() != nullptr) {
+      worklist.push_back(func);
+    }
+  }
+  std::set<std::string> imported;
+  auto importBody = [this, &db, &parser, &imported](const InlineDBEntry &entry) {
+    if (!imported.insert(entry.name).second) {
+      return true;
+    }
+    std::string body;
+    std::string err;
+    if (!db.LoadBody(entry, body, err)) {
+      LogInfo::MapleLogger(kLlErr) << "Error: " << err << '\n';
+      return false;
+    }
+    if (!parser.ParseInlineFuncBody(body)) {
+      parser.EmitError(actualInput);
+      return false;
+    }
+    return true;
+  };
+  size_t numImported = 0;
+  while (!worklist.empty()) {
+    MIRFunction *caller = worklist.back();
+    worklist.pop_back();
+    std::vector<MIRFunction*> callees;
+    CollectCallees(*caller->GetBody(), callees);
+    for (auto *callee : callees) {
+      if (callee == nullptr || callee->GetBody() != nullptr) {
+        continue;
+      }
+      const InlineDBEntry *entry = db.Find(callee->GetName());
+      if (entry == nullptr || entry->IsStatic() ||
+          (!entry->IsDeclaredInline() && entry->staticInsns > Options::ginlineMaxNondeclaredInlineCallee)) {
+        continue;
+      }
+      // a body calling a static function the index dropped cannot be imported, check before parsing any of them
+      std::vector<const InlineDBEntry*> imports;
+      std::string missingDep;
+      if (!db.CollectImports(*entry, imports, missingDep)) {
+        if (opts::debug) {
+          LogInfo::MapleLogger() << "[CROSS_MODULE] skip importing " << entry->name << ", its dep " << missingDep <<
+              " is not in the inline database" << '\n';
+        }
+        continue;
+      }
+      bool ok = true;
+      for (auto *import : imports) {
+        ok = ok && importBody(*import);
+      }
+      CHECK_FATAL(ok, "import %s from the inline database failed", entry->name.c_str());
+      if (callee->GetBody() != nullptr) {
+        ++numImported;
+        worklist.push_back(callee);
+      }
+    }
+  }
+  if (opts::debug) {
+    LogInfo::MapleLogger() << "[CROSS_MODULE] imported " << numImported << " functions" << '\n';
+  }
+}
+
 ErrorCode DriverRunner::ParseInput() const {
   CHECK_MODULE(kErrorExit);
   if (opts::debug) {
@@ -256,6 +361,7 @@ ErrorCode DriverRunner::ParseInput() const {
   MPLTimer timer;
   timer.Start();
   MIRParser parser(*theModule);
+  parser.SetParseThreads(opts::parseThreads);
   ErrorCode ret = kErrorNoError;
   if (!fileParsed) {
     if (inputFileType != InputFileType::kFileTypeBpl &&
@@ -14,6 +14,7 @@
  */
 #include "compiler_factory.h"
 #include "error_code.h"
+#include "mempool.h"
 #include "mpl_options.h"
 #include "mpl_sighandler.h"
 #include "parse_spec.h"
@@ -28,9 +29,13 @@ int main(int argc, char **argv) {
   if (ret == kErrorNoError) {
     ret = static_cast<int>(ParseSpec::GetOptFromSpecsByGcc(argc, argv, mplOptions));
   }
+  MemPoolCtrler::memStats = opts::memStats;
   if (ret == kErrorNoError) {
     ret = static_cast<int>(CompilerFactory::GetInstance().Compile(mplOptions));
   }
+  if (MemPoolCtrler::memStats) {
+    memPoolCtrler.DumpMemStats(LogInfo::MapleLogger());
+  }
   PrintErrorMessage(ret);
   return ret;
 }
@@ -163,11 +163,11 @@ using MirConstT = MirIntConstT;
 // ADD
 //
 // BaseNodeT is an abstraction of expression.
-struct BaseNodeT {  // 4B
+struct BaseNodeT {  // 8B besides the vptr
   Opcode op;
-  PrimType ptyp;
+  PrimType ptyp : 8;  // all primtypes fit in a byte, keeps the node header in one word
   uint8 typeFlag;  // a flag to speed up type related operations in the VM
-  size_t numOpnds;  // only used for N-ary operators, switch and rangegoto
+  uint32 numOpnds;  // only used for N-ary operators, switch and rangegoto
   // operands immediately before each node
   virtual size_t NumOpnds() const {
     if (op == OP_switch || op == OP_rangegoto) {
@@ -180,7 +180,7 @@ struct BaseNodeT {  // 4B
     return numOpnds;
   }
   virtual void SetNumOpnds(size_t num) {
-    numOpnds = num;
+    numOpnds = static_cast<uint32>(num);
   }
 
   virtual Opcode GetOpCode() const {
@@ -140,22 +140,18 @@ class TypeTable {
   }
 
   MIRType *GetTypeFromTyIdx(TyIdx tyIdx) {
-    CHECK_FATAL(tyIdx < typeTable.size(), "array index out of range");
-    return typeTable.at(tyIdx);
+    return TypeAt(tyIdx);
   }
   const MIRType *GetTypeFromTyIdx(TyIdx tyIdx) const {
-    CHECK_FATAL(tyIdx < typeTable.size(), "array index out of range");
-    return typeTable.at(tyIdx);
+    return TypeAt(tyIdx);
   }
 
   MIRType *GetTypeFromTyIdx(uint32 index) const {
-    CHECK_FATAL(index < typeTable.size(), "array index out of range");
-    return typeTable.at(index);
+    return TypeAt(index);
   }
 
   PrimType GetPrimTypeFromTyIdx(const TyIdx &tyIdx) const {
-    CHECK_FATAL(tyIdx < typeTable.size(), "array index out of range");
-    return typeTable.at(tyIdx)->GetPrimType();
+    return TypeAt(tyIdx)->GetPrimType();
   }
 
   void SetTypeWithTyIdx(const TyIdx &tyIdx, MIRType &type);
@@ -166,266 +162,270 @@ class TypeTable {
   }
 
   uint32 GetTypeTableSize() const {
+    if (ThreadEnv::IsMeParallel()) {
+      std::shared_lock<std::shared_timed_mutex> lock(mtx);
+      return static_cast<uint32>(typeTable.size());
+    }
     return static_cast<uint32>(typeTable.size());
   }
 
   // Get primtive types.
   MIRType *GetPrimType(PrimType primType) const {
     ASSERT(primType < typeTable.size(), "array index out of range");
-    return typeTable.at(primType);
+    return TypeAt(primType);
   }
 
   MIRType *GetFloat() const {
     ASSERT(PTY_f32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_f32);
+    return TypeAt(PTY_f32);
   }
 
   MIRType *GetDouble() const {
     ASSERT(PTY_f64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_f64);
+    return TypeAt(PTY_f64);
   }
 
   MIRType *GetFloat128() const {
     ASSERT(PTY_f128 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_f128);
+    return TypeAt(PTY_f128);
   }
 
   MIRType *GetUInt1() const {
     ASSERT(PTY_u1 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u1);
+    return TypeAt(PTY_u1);
   }
 
   MIRType *GetUInt8() const {
     ASSERT(PTY_u8 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u8);
+    return TypeAt(PTY_u8);
   }
 
   MIRType *GetInt8() const {
     ASSERT(PTY_i8 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_i8);
+    return TypeAt(PTY_i8);
   }
 
   MIRType *GetUInt16() const {
     ASSERT(PTY_u16 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u16);
+    return TypeAt(PTY_u16);
   }
 
   MIRType *GetInt16() const {
     ASSERT(PTY_i16 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_i16);
+    return TypeAt(PTY_i16);
   }
 
   MIRType *GetInt32() const {
     ASSERT(PTY_i32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_i32);
+    return TypeAt(PTY_i32);
   }
 
   MIRType *GetUInt32() const {
     ASSERT(PTY_u32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u32);
+    return TypeAt(PTY_u32);
   }
 
   MIRType *GetInt64() const {
     ASSERT(PTY_i64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_i64);
+    return TypeAt(PTY_i64);
   }
 
   MIRType *GetUInt64() const {
     ASSERT(PTY_u64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u64);
+    return TypeAt(PTY_u64);
   }
 
   MIRType *GetInt128() const {
     ASSERT(PTY_i128 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_i128);
+    return TypeAt(PTY_i128);
   }
 
   MIRType *GetUInt128() const {
     ASSERT(PTY_u128 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u128);
+    return TypeAt(PTY_u128);
   }
 
   MIRType *GetPtr() const {
     ASSERT(PTY_ptr < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_ptr);
+    return TypeAt(PTY_ptr);
   }
 
 #ifdef USE_ARM32_MACRO
   MIRType *GetUIntType() const {
     ASSERT(PTY_u32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u32);
+    return TypeAt(PTY_u32);
   }
 
   MIRType *GetPtrType() const {
     ASSERT(PTY_u32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u32);
+    return TypeAt(PTY_u32);
   }
 #else
   MIRType *GetUIntType() const {
     ASSERT(PTY_u64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u64);
+    return TypeAt(PTY_u64);
   }
 
   MIRType *GetPtrType() const {
     ASSERT(PTY_ptr < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_ptr);
+    return TypeAt(PTY_ptr);
   }
 #endif
 
 #ifdef USE_32BIT_REF
   MIRType *GetCompactPtr() const {
     ASSERT(PTY_u32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u32);
+    return TypeAt(PTY_u32);
   }
 
 #else
   MIRType *GetCompactPtr() const {
     ASSERT(PTY_u64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_u64);
+    return TypeAt(PTY_u64);
   }
 
 #endif
   MIRType *GetRef() const {
     ASSERT(PTY_ref < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_ref);
+    return TypeAt(PTY_ref);
   }
 
   MIRType *GetAddr32() const {
     ASSERT(PTY_a32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_a32);
+    return TypeAt(PTY_a32);
   }
 
   MIRType *GetAddr64() const {
     ASSERT(PTY_a64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_a64);
+    return TypeAt(PTY_a64);
   }
 
   MIRType *GetVoid() const {
     ASSERT(PTY_void < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_void);
+    return TypeAt(PTY_void);
   }
 
 #ifdef DYNAMICLANG
   MIRType *GetDynundef() const {
     ASSERT(PTY_dynundef < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynundef);
+    return TypeAt(PTY_dynundef);
   }
 
   MIRType *GetDynany() const {
     ASSERT(PTY_dynany < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynany);
+    return TypeAt(PTY_dynany);
   }
 
   MIRType *GetDyni32() const {
     ASSERT(PTY_dyni32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dyni32);
+    return TypeAt(PTY_dyni32);
   }
 
   MIRType *GetDynf64() const {
     ASSERT(PTY_dynf64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynf64);
+    return TypeAt(PTY_dynf64);
   }
 
   MIRType *GetDynf32() const {
     ASSERT(PTY_dynf32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynf32);
+    return TypeAt(PTY_dynf32);
   }
 
   MIRType *GetDynstr() const {
     ASSERT(PTY_dynstr < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynstr);
+    return TypeAt(PTY_dynstr);
   }
 
   MIRType *GetDynobj() const {
     ASSERT(PTY_dynobj < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynobj);
+    return TypeAt(PTY_dynobj);
   }
 
   MIRType *GetDynbool() const {
     ASSERT(PTY_dynbool < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_dynbool);
+    return TypeAt(PTY_dynbool);
   }
 
 #endif
   MIRType *GetUnknown() const {
     ASSERT(PTY_unknown < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_unknown);
+    return TypeAt(PTY_unknown);
   }
   // vector type
   MIRType *GetV4Int32() const {
     ASSERT(PTY_v4i32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v4i32);
+    return TypeAt(PTY_v4i32);
   }
 
   MIRType *GetV2Int32() const {
     ASSERT(PTY_v2i32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v2i32);
+    return TypeAt(PTY_v2i32);
   }
 
   MIRType *GetV4UInt32() const {
     ASSERT(PTY_v4u32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v4u32);
+    return TypeAt(PTY_v4u32);
   }
   MIRType *GetV2UInt32() const {
     ASSERT(PTY_v2u32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v2u32);
+    return TypeAt(PTY_v2u32);
   }
 
   MIRType *GetV4Int16() const {
     ASSERT(PTY_v4i16 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v4i16);
+    return TypeAt(PTY_v4i16);
   }
   MIRType *GetV8Int16() const {
     ASSERT(PTY_v8i16 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v8i16);
+    return TypeAt(PTY_v8i16);
   }
 
   MIRType *GetV4UInt16() const {
     ASSERT(PTY_v4u16 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v4u16);
+    return TypeAt(PTY_v4u16);
   }
   MIRType *GetV8UInt16() const {
     ASSERT(PTY_v8u16 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v8u16);
+    return TypeAt(PTY_v8u16);
   }
 
   MIRType *GetV8Int8() const {
     ASSERT(PTY_v8i8 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v8i8);
+    return TypeAt(PTY_v8i8);
   }
   MIRType *GetV16Int8() const {
     ASSERT(PTY_v16i8 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v16i8);
+    return TypeAt(PTY_v16i8);
   }
 
   MIRType *GetV8UInt8() const {
     ASSERT(PTY_v8u8 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v8u8);
+    return TypeAt(PTY_v8u8);
   }
   MIRType *GetV16UInt8() const {
     ASSERT(PTY_v16u8 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v16u8);
+    return TypeAt(PTY_v16u8);
   }
   MIRType *GetV2Int64() const {
     ASSERT(PTY_v2i64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v2i64);
+    return TypeAt(PTY_v2i64);
   }
   MIRType *GetV2UInt64() const {
     ASSERT(PTY_v2u64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v2u64);
+    return TypeAt(PTY_v2u64);
   }
 
   MIRType *GetV2Float32() const {
     ASSERT(PTY_v2f32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v2f32);
+    return TypeAt(PTY_v2f32);
   }
   MIRType *GetV4Float32() const {
     ASSERT(PTY_v4f32 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v4f32);
+    return TypeAt(PTY_v4f32);
   }
   MIRType *GetV2Float64() const {
     ASSERT(PTY_v2f64 < typeTable.size(), "array index out of range");
-    return typeTable.at(PTY_v2f64);
+    return TypeAt(PTY_v2f64);
   }
 
   // Get or Create derived types.
@@ -490,6 +490,18 @@ class TypeTable {
     }
   };
 
+  // typeTable may grow under another thread while function bodies are parsed in parallel, the callers holding mtx
+  // read typeTable directly
+  MIRType *TypeAt(size_t idx) const {
+    if (ThreadEnv::IsMeParallel()) {
+      std::shared_lock<std::shared_timed_mutex> lock(mtx);
+      CHECK_FATAL(idx < typeTable.size(), "array index out of range");
+      return typeTable[idx];
+    }
+    CHECK_FATAL(idx < typeTable.size(), "array index out of range");
+    return typeTable[idx];
+  }
+
   // create an entry in typeTable for the type node
   MIRType *CreateType(const MIRType &oldType) {
     MIRType *newType = oldType.CopyMIRTypeNode();
@@ -584,6 +596,11 @@ class StringTable {
     if (strIdx == 0u) {
       if (ThreadEnv::IsMeParallel()) {
         std::unique_lock<std::shared_timed_mutex> lock(mtx);
+        // another thread may have added str since the lookup
+        auto it = stringTableMap.find(&str);
+        if (it != stringTableMap.end()) {
+          return it->second;
+        }
         strIdx.reset(stringTable.size());
         T *newStr = new T(str);
         stringTable.push_back(newStr);
@@ -779,22 +796,34 @@ class GSymbolTable {
   }
 
   bool IsValidIdx(size_t idx) const {
-    return idx < symbolTable.size();
+    return idx < GetSymbolTableSize();
   }
 
   MIRSymbol *GetSymbolFromStidx(uint32 idx, bool checkFirst = false) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+    if (ThreadEnv::IsMeParallel()) {
+      lock.lock();
+    }
     if (checkFirst && idx >= symbolTable.size()) {
       return nullptr;
     }
-    ASSERT(IsValidIdx(idx), "symbol table index out of range");
+    ASSERT(idx < symbolTable.size(), "symbol table index out of range");
     return symbolTable[idx];
   }
 
   void SetStrIdxStIdxMap(GStrIdx strIdx, StIdx stIdx) {
+    std::unique_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+    if (ThreadEnv::IsMeParallel()) {
+      lock.lock();
+    }
     strIdxToStIdxMap[strIdx] = stIdx;
   }
 
   StIdx GetStIdxFromStrIdx(GStrIdx idx) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+    if (ThreadEnv::IsMeParallel()) {
+      lock.lock();
+    }
     const auto it = strIdxToStIdxMap.find(idx);
     if (it == strIdxToStIdxMap.cend()) {
       return StIdx();
@@ -807,10 +836,18 @@ class GSymbolTable {
   }
 
   size_t GetSymbolTableSize() const {
+    if (ThreadEnv::IsMeParallel()) {
+      std::shared_lock<std::shared_timed_mutex> lock(mtx);
+      return symbolTable.size();
+    }
     return symbolTable.size();
   }
 
   MIRSymbol *GetSymbol(size_t idx) const {
+    std::shared_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+    if (ThreadEnv::IsMeParallel()) {
+      lock.lock();
+    }
     ASSERT(idx < symbolTable.size(), "array index out of range");
     return symbolTable.at(idx);
   }
@@ -825,6 +862,8 @@ class GSymbolTable {
   // hash table mapping string index to st index
   std::unordered_map<GStrIdx, StIdx, GStrIdxHash> strIdxToStIdxMap;
   std::vector<MIRSymbol*> symbolTable;  // map symbol idx to symbol node
+  // function bodies parsed in parallel look up and create globals, see MIRParser::ParseDeferredFuncBodies
+  mutable std::shared_timed_mutex mtx;
 };
 
 class GPragmaTable {
@@ -35,10 +35,17 @@ class MIRLexer {
     if (airFileInternal.is_open()) {
       airFileInternal.close();
     }
+    UnmapFile();
   }
 
   void PrepareForFile(const std::string &filename);
   void PrepareForString(const std::string &src);
+  // lex the size bytes at buf like a mapped file, buf must outlive the lexing
+  void PrepareForBuffer(const char *buf, size_t size);
+  // lex the file mapped by mainLexer from column col of the line starting at byte lineStart
+  void PrepareForMappedLine(const MIRLexer &mainLexer, size_t lineStart, uint32 col, uint32 line);
+  // skip to the } matching the { just lexed, without lexing what is in between
+  bool SkipBlock();
   TokenKind NextToken();
   TokenKind LexToken();
   TokenKind GetTokenKind() const {
@@ -53,6 +60,14 @@ class MIRLexer {
     return curIdx;
   }
 
+  bool IsReadingMappedFile() const {
+    return mapBase != nullptr && airFile == &airFileInternal;
+  }
+
+  size_t GetLineStartPos() const {
+    return lineStartPos;
+  }
+
   // get the identifier name after the % or $ prefix
   const std::string &GetName() const {
     return name;
@@ -92,6 +107,12 @@ class MIRLexer {
   MapleVector<std::string> seenComments;
   std::ifstream *airFile = nullptr;
   std::ifstream airFileInternal;
+  // the file given to PrepareForFile is mapped as a whole, airFileInternal is only opened if mmap fails
+  const char *mapBase = nullptr;
+  size_t mapSize = 0;
+  size_t mapPos = 0;
+  size_t lineStartPos = 0;  // offset in the mapped file of the current line
+  bool ownsMap = false;     // false if the mapping is borrowed from another lexer
   std::string line;
   size_t lineBufSize = 0;  // the allocated size of line(buffer).
   uint32 currentLineSize = 0;
@@ -99,7 +120,6 @@ class MIRLexer {
   uint32 lineNum = 0;
   TokenKind kind = TK_invalid;
   std::string name = "";  // store the name token without the % or $ prefix
-  MapleUnorderedMap<std::string, TokenKind> keywordMap;
 
   void RemoveReturnInline(std::string &removeLine) const {
     if (removeLine.empty()) {
@@ -114,6 +134,8 @@ class MIRLexer {
   }
 
   int ReadALine();  // read a line from MIR (text) file.
+  bool MapFile(const std::string &filename);
+  void UnmapFile();
   void GenName();
   TokenKind GetConstVal();
   TokenKind GetSpecialFloatConst();
@@ -1253,6 +1253,21 @@ class MIRFunction {
     return nCtrs;
   }
 
+  void SetValueProfCtrTbl(uint32 kind, MIRSymbol *tbl, uint32 num) {
+    CHECK_FATAL(Options::profileGen, "This is only for profileGen");
+    CHECK_FATAL(kind < kValueProfKindNum, "unknown value profile kind");
+    valueProfCtrTbls[kind] = tbl;
+    valueProfNumCtrs[kind] = num;
+  }
+
+  MIRSymbol *GetValueProfCtrTbl(uint32 kind) const {
+    return valueProfCtrTbls[kind];
+  }
+
+  uint32 GetValueProfNumCtrs(uint32 kind) const {
+    return valueProfNumCtrs[kind];
+  }
+
   void SetFileLineNoChksum(uint64 chksum) {
     CHECK_FATAL(Options::profileGen, "This is only for profileGen");
     fileLinenoChksum = chksum;
@@ -1487,6 +1502,9 @@ class MIRFunction {
   FuncDesc funcDesc{};
   MIRSymbol *profCtrTbl = nullptr;
   uint32 nCtrs = 0; // number of counters
+  // value profile counters of each ValueProfKind, see mpl_profdata.h
+  std::array<MIRSymbol*, kValueProfKindNum> valueProfCtrTbls = {};
+  std::array<uint32, kValueProfKindNum> valueProfNumCtrs = {};
   uint64 fileLinenoChksum = 0;
   uint64 cfgChksum = 0;
   FuncProfInfo *funcProfData = nullptr;
@@ -1518,9 +1518,7 @@ class StmtNode : public BaseNode, public PtrListNodeBase<StmtNode> {
   }
 
   void SetInlinedSrcPos(uint32 lineNum, uint32 fileNum, const GStrIdx &idx) {
-    srcPosition.SetInlinedFuncStrIdx(idx);
-    srcPosition.SetInlinedLineNum(lineNum);
-    srcPosition.SetInlinedFileNum(fileNum);
+    srcPosition.SetInlinedPos(lineNum, fileNum, idx);
   }
 
   uint32 GetStmtID() const {
@@ -14,6 +14,8 @@
  */
 #ifndef MAPLE_IR_INCLUDE_MIR_PARSER_H
 #define MAPLE_IR_INCLUDE_MIR_PARSER_H
+#include <array>
+#include <mutex>
 #include "mir_module.h"
 #include "lexer.h"
 #include "mir_nodes.h"
@@ -253,6 +255,8 @@ class MIRParser {
   bool ParseMIR(uint32 fileIdx = 0, uint32 option = 0, bool isIPA = false, bool isComb = false);
   bool ParseMIR(std::ifstream &mplFile);  // the main entry point
   bool ParseInlineFuncBody(std::ifstream &mplFile);
+  // the mplt_inline text of a single function, e.g. a body of the inline database
+  bool ParseInlineFuncBody(const std::string &src);
   bool ParseMPLT(std::ifstream &mpltFile, const std::string &importFileName);
   bool ParseMPLTStandalone(std::ifstream &mpltFile, const std::string &importFileName);
   bool ParseTypeFromString(const std::string &src, TyIdx &tyIdx);
@@ -262,11 +266,41 @@ class MIRParser {
     return options;
   }
 
+  // with threads > 1 the function bodies of the main input file are parsed in parallel once all its
+  // declarations are parsed
+  void SetParseThreads(uint32 threads) {
+    parseThreads = threads;
+  }
+
  private:
+  friend class FuncBodyParseTask;
+  // a function body skipped by the first pass, to be parsed by ParseDeferredFuncBodies
+  struct DeferredFuncBody {
+    MIRFunction *func = nullptr;
+    size_t lineStart = 0;  // offset of the line of the { in the mapped file
+    uint32 col = 0;        // column of the {
+    uint32 lineNum = 0;
+    uint16 lastFileNum = 0;
+    std::vector<std::string> comments;  // comments seen before the body
+    std::string message;
+    std::string warningMessage;
+    bool succeeded = false;
+  };
+
+  bool ParseFunctionBody(MIRFunction &func);
+  bool CanDeferFuncBody() const;
+  bool DeferFuncBody(MIRFunction &func);
+  void ParseDeferredFuncBody(DeferredFuncBody &deferred) const;
+  bool ParseDeferredFuncBodies();
+
+  // dispatch tables indexed by TokenKind, a nullptr entry means the token does not start the construct
+  template <typename FuncPtr>
+  using TokenDispatchTable = std::array<FuncPtr, kTokenKindNum>;
+
   // func ptr map for ParseMIR()
   using FuncPtrParseMIRForElem = bool (MIRParser::*)();
-  static std::map<TokenKind, FuncPtrParseMIRForElem> funcPtrMapForParseMIR;
-  static std::map<TokenKind, FuncPtrParseMIRForElem> InitFuncPtrMapForParseMIR();
+  static TokenDispatchTable<FuncPtrParseMIRForElem> funcPtrMapForParseMIR;
+  static TokenDispatchTable<FuncPtrParseMIRForElem> InitFuncPtrMapForParseMIR();
 
   bool TypeCompatible(const TyIdx &typeIdx1, const TyIdx &typeIdx2) const;
   bool IsTypeIncomplete(MIRType *type) const;
@@ -294,18 +328,18 @@ class MIRParser {
 
   // func for ParseExpr
   using FuncPtrParseExpr = bool (MIRParser::*)(BaseNodePtr &ptr);
-  static std::map<TokenKind, FuncPtrParseExpr> funcPtrMapForParseExpr;
-  static std::map<TokenKind, FuncPtrParseExpr> InitFuncPtrMapForParseExpr();
+  static TokenDispatchTable<FuncPtrParseExpr> funcPtrMapForParseExpr;
+  static TokenDispatchTable<FuncPtrParseExpr> InitFuncPtrMapForParseExpr();
 
   // func and param for ParseStmt
   using FuncPtrParseStmt = bool (MIRParser::*)(StmtNodePtr &stmt);
-  static std::map<TokenKind, FuncPtrParseStmt> funcPtrMapForParseStmt;
-  static std::map<TokenKind, FuncPtrParseStmt> InitFuncPtrMapForParseStmt();
+  static TokenDispatchTable<FuncPtrParseStmt> funcPtrMapForParseStmt;
+  static TokenDispatchTable<FuncPtrParseStmt> InitFuncPtrMapForParseStmt();
 
   // func and param for ParseStmtBlock
   using FuncPtrParseStmtBlock = bool (MIRParser::*)();
-  static std::map<TokenKind, FuncPtrParseStmtBlock> funcPtrMapForParseStmtBlock;
-  static std::map<TokenKind, FuncPtrParseStmtBlock> InitFuncPtrMapForParseStmtBlock();
+  static TokenDispatchTable<FuncPtrParseStmtBlock> funcPtrMapForParseStmtBlock;
+  static TokenDispatchTable<FuncPtrParseStmtBlock> InitFuncPtrMapForParseStmtBlock();
   void ParseStmtBlockForSeenComment(BlockNodePtr blk, uint32 mplNum);
   bool ParseStmtBlockForVar(TokenKind stmtTK);
   bool ParseStmtBlockForVar();
@@ -352,6 +386,10 @@ class MIRParser {
   TokenKind paramTokenKind = TK_invalid;
   std::vector<std::string> paramImportFileList;
   std::stack<bool> safeRegionFlag;
+  uint32 parseThreads = 1;
+  std::vector<DeferredFuncBody> deferredFuncBodies;
+  // serializes the creation of global symbols, functions and type names by parallel body parsing
+  static std::mutex globalDeclMtx;
 };
 }  // namespace maple
 #endif  // MAPLE_IR_INCLUDE_MIR_PARSER_H
@@ -92,6 +92,7 @@ class Options {
   static bool useCrossModuleInline;
   static std::string inlineMpltDir;
   static bool importInlineMplt;
+  static bool inlineDb;
   static bool ignorePreferInline;
   static uint32 numOfCloneVersions;
   static uint32 numOfImpExprLowBound;
@@ -169,6 +170,8 @@ class Options {
   static std::string profile;
   static bool profileGen;
   static bool profileUse;
+  static bool profileValues;
+  static std::string sampleProfile;
   static bool stackProtectorStrong;
   static bool stackProtectorAll;
   static std::string appPackageName;
@@ -18,6 +18,21 @@
 #include "types_def.h"
 
 namespace maple {
+// the call site a statement was inlined from, kept out of line since few statements have one
+struct InlinedSrcPos {
+  uint32 lineNum = 0;
+  uint32 fileNum = 0;
+  GStrIdx funcStrIdx;
+};
+
+// process-wide and deduplicated, every statement cloned from the same call site shares one entry
+class InlinedSrcPosTable {
+ public:
+  static uint32 GetOrCreate(uint32 lineNum, uint32 fileNum, const GStrIdx &funcStrIdx);
+  static InlinedSrcPos Get(uint32 idx);
+  static size_t Size();
+};
+
 // to store source position information
 class SrcPosition {
  public:
@@ -33,7 +48,7 @@ class SrcPosition {
     u.fileColumn.column = cnum;
   }
 
-  virtual ~SrcPosition() = default;
+  ~SrcPosition() = default;
 
   uint32 RawData() const {
     return u.word0;
@@ -156,28 +171,20 @@ class SrcPosition {
     return loc;
   }
 
-  void SetInlinedLineNum(uint32 line) {
-    inlinedLineNum = line;
-  }
-
-  void SetInlinedFileNum(uint32 line) {
-    inlinedFileNum = line;
-  }
-
-  void SetInlinedFuncStrIdx(const GStrIdx &idx) {
-    strIdx = idx;
+  void SetInlinedPos(uint32 line, uint32 file, const GStrIdx &idx) {
+    inlinedPosIdx = (line == 0 && file == 0 && idx.GetIdx() == 0) ? 0 : InlinedSrcPosTable::GetOrCreate(line, file, idx);
   }
 
   uint32 GetInlinedLineNum() const {
-    return inlinedLineNum;
+    return inlinedPosIdx == 0 ? 0 : InlinedSrcPosTable::Get(inlinedPosIdx).lineNum;
   }
 
   uint32 GetInlinedFileNum() const {
-    return inlinedFileNum;
+    return inlinedPosIdx == 0 ? 0 : InlinedSrcPosTable::Get(inlinedPosIdx).fileNum;
   }
 
-  const GStrIdx &GetInlinedFuncStrIdx() const {
-    return strIdx;
+  GStrIdx GetInlinedFuncStrIdx() const {
+    return inlinedPosIdx == 0 ? GStrIdx(0) : InlinedSrcPosTable::Get(inlinedPosIdx).funcStrIdx;
   }
 
  private:
@@ -193,9 +200,7 @@ class SrcPosition {
   } u;
   uint32 lineNum;     // line number of original src file, like foo.java
   uint32 mplLineNum;  // line number of mpl file
-  uint32 inlinedLineNum = 0;
-  uint32 inlinedFileNum = 0;
-  GStrIdx strIdx;
+  uint32 inlinedPosIdx = 0;  // into InlinedSrcPosTable, 0 if not inlined
 };
 }  // namespace maple
 #endif  // MAPLE_IR_INCLUDE_SRC_POSITION_H
@@ -14,6 +14,7 @@
  */
 #ifndef MAPLE_IR_INCLUDE_TOKENS_H
 #define MAPLE_IR_INCLUDE_TOKENS_H
+#include <cstddef>
 
 namespace maple {
 enum TokenKind {
@@ -60,5 +61,7 @@ enum TokenKind {
   TK_string,     // a literal string enclosed between "
   TK_eof
 };
+
+constexpr size_t kTokenKindNum = TK_eof + 1;
 }  // namespace maple
 #endif  // MAPLE_IR_INCLUDE_TOKENS_H
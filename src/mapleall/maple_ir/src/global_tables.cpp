@@ -43,6 +43,10 @@ TypeTable::TypeTable() {
 }
 
 void TypeTable::SetTypeWithTyIdx(const TyIdx &tyIdx, MIRType &type) {
+  std::unique_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+  if (ThreadEnv::IsMeParallel()) {
+    lock.lock();
+  }
   CHECK_FATAL(tyIdx < typeTable.size(), "array index out of range");
   MIRType *oldType = typeTable.at(tyIdx);
   typeTable.at(tyIdx) = &type;
@@ -129,10 +133,15 @@ MIRType* TypeTable::GetOrCreateMIRTypeNode(MIRType &pType) {
         std::shared_lock<std::shared_timed_mutex> lock(mtx);
         const auto it = pMap->find(type.GetPointedTyIdx());
         if (it != pMap->end()) {
-          return GetTypeFromTyIdx(it->second);
+          return typeTable[it->second];
         }
       }
       std::unique_lock<std::shared_timed_mutex> lock(mtx);
+      // another thread may have created the type since the lookup
+      const auto it = pMap->find(type.GetPointedTyIdx());
+      if (it != pMap->end()) {
+        return typeTable[it->second];
+      }
       CHECK_FATAL(!(type.GetPointedTyIdx().GetIdx() >= kPtyDerived && type.GetPrimType() == PTY_ref &&
                     otherPMap->find(type.GetPointedTyIdx()) != otherPMap->end()),
                   "GetOrCreateMIRType: ref pointed-to type %d has previous ptr occurrence",
@@ -148,6 +157,10 @@ MIRType* TypeTable::GetOrCreateMIRTypeNode(MIRType &pType) {
     }
   }
   std::unique_lock<std::shared_timed_mutex> lock(mtx);
+  const auto it = typeHashTable.find(&pType);
+  if (it != typeHashTable.end()) {
+    return *it;
+  }
   return CreateAndUpdateMirTypeNode(pType);
 }
 
@@ -157,8 +170,7 @@ MIRType *TypeTable::GetOrCreatePointerType(const TyIdx &pointedTyIdx, PrimType p
   MIRPtrType type(pointedTyIdx, primType);
   type.SetTypeAttrs(attrs);
   TyIdx tyIdx = GetOrCreateMIRType(&type);
-  ASSERT(tyIdx < typeTable.size(), "index out of range in TypeTable::GetOrCreatePointerType");
-  return typeTable.at(tyIdx);
+  return TypeAt(tyIdx);
 }
 
 MIRType *TypeTable::GetOrCreatePointerType(const MIRType &pointTo, PrimType primType, const TypeAttrs &attrs) {
@@ -193,7 +205,7 @@ MIRArrayType *TypeTable::GetOrCreateArrayType(const MIRType &elem, uint8 dim, co
   MIRArrayType arrayType(elem.GetTypeIndex(), sizeVector);
   arrayType.SetTypeAttrs(attrs);
   TyIdx tyIdx = GetOrCreateMIRType(&arrayType);
-  return static_cast<MIRArrayType*>(typeTable[tyIdx]);
+  return static_cast<MIRArrayType*>(TypeAt(tyIdx));
 }
 
 // For one dimension array
@@ -205,16 +217,14 @@ MIRType *TypeTable::GetOrCreateFarrayType(const MIRType &elem) {
   MIRFarrayType type;
   type.SetElemtTyIdx(elem.GetTypeIndex());
   TyIdx tyIdx = GetOrCreateMIRType(&type);
-  ASSERT(tyIdx < typeTable.size(), "index out of range in TypeTable::GetOrCreateFarrayType");
-  return typeTable.at(tyIdx);
+  return TypeAt(tyIdx);
 }
 
 MIRType *TypeTable::GetOrCreateJarrayType(const MIRType &elem) {
   MIRJarrayType type;
   type.SetElemtTyIdx(elem.GetTypeIndex());
   TyIdx tyIdx = GetOrCreateMIRType(&type);
-  ASSERT(tyIdx < typeTable.size(), "index out of range in TypeTable::GetOrCreateJarrayType");
-  return typeTable.at(tyIdx);
+  return TypeAt(tyIdx);
 }
 
 MIRType *TypeTable::GetOrCreateFunctionType(const TyIdx &retTyIdx,
@@ -224,8 +234,7 @@ MIRType *TypeTable::GetOrCreateFunctionType(const TyIdx &retTyIdx,
                                             const TypeAttrs &retAttrs) {
   MIRFuncType funcType(retTyIdx, vecType, vecAttrs, funcAttrs, retAttrs);
   TyIdx tyIdx = GetOrCreateMIRType(&funcType);
-  ASSERT(tyIdx < typeTable.size(), "index out of range in TypeTable::GetOrCreateFunctionType");
-  return typeTable.at(tyIdx);
+  return TypeAt(tyIdx);
 }
 
 
@@ -252,8 +261,7 @@ MIRType *TypeTable::GetOrCreateStructOrUnion(const std::string &name, const Fiel
   // Global?
   module.GetTypeNameTab()->SetGStrIdxToTyIdx(strIdx, tyIdx);
   module.PushbackTypeDefOrder(strIdx);
-  ASSERT(tyIdx < typeTable.size(), "index out of range in TypeTable::GetOrCreateStructOrUnion");
-  return typeTable.at(tyIdx);
+  return TypeAt(tyIdx);
 }
 
 void TypeTable::PushIntoFieldVector(FieldVector &fields, const std::string &name, const MIRType &type) const {
@@ -274,12 +282,11 @@ MIRType *TypeTable::GetOrCreateClassOrInterface(const std::string &name, MIRModu
     }
     module.PushbackTypeDefOrder(strIdx);
     module.GetTypeNameTab()->SetGStrIdxToTyIdx(strIdx, tyIdx);
-    if (typeTable[tyIdx]->GetNameStrIdx() == 0u) {
-      typeTable[tyIdx]->SetNameStrIdx(strIdx);
+    if (TypeAt(tyIdx)->GetNameStrIdx() == 0u) {
+      TypeAt(tyIdx)->SetNameStrIdx(strIdx);
     }
   }
-  ASSERT(tyIdx < typeTable.size(), "index out of range in TypeTable::GetOrCreateClassOrInterface");
-  return typeTable.at(tyIdx);
+  return TypeAt(tyIdx);
 }
 
 void TypeTable::AddFieldToStructType(MIRStructType &structType, const std::string &fieldName,
@@ -559,6 +566,10 @@ GSymbolTable::~GSymbolTable() {
 }
 
 MIRSymbol *GSymbolTable::CreateSymbol(uint8 scopeID) {
+  std::unique_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+  if (ThreadEnv::IsMeParallel()) {
+    lock.lock();
+  }
   auto *st = new MIRSymbol(symbolTable.size(), scopeID);
   CHECK_FATAL(st != nullptr, "CreateSymbol failure");
   symbolTable.push_back(st);
@@ -567,6 +578,10 @@ MIRSymbol *GSymbolTable::CreateSymbol(uint8 scopeID) {
 }
 
 bool GSymbolTable::AddToStringSymbolMap(const MIRSymbol &st) {
+  std::unique_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+  if (ThreadEnv::IsMeParallel()) {
+    lock.lock();
+  }
   GStrIdx strIdx = st.GetNameStrIdx();
   if (strIdxToStIdxMap[strIdx].FullIdx() != 0) {
     return false;
@@ -576,6 +591,10 @@ bool GSymbolTable::AddToStringSymbolMap(const MIRSymbol &st) {
 }
 
 bool GSymbolTable::RemoveFromStringSymbolMap(const MIRSymbol &st) {
+  std::unique_lock<std::shared_timed_mutex> lock(mtx, std::defer_lock);
+  if (ThreadEnv::IsMeParallel()) {
+    lock.lock();
+  }
   const auto it = strIdxToStIdxMap.find(st.GetNameStrIdx());
   if (it != strIdxToStIdxMap.cend()) {
     strIdxToStIdxMap.erase(it);
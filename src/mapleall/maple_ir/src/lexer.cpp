@@ -13,8 +13,17 @@
  * See the Mulan PSL v2 for more details.
  */
 #include "lexer.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "mpl_logging.h"
 #include "debug_info.h"
 #include "mir_module.h"
@@ -34,6 +43,106 @@ static uint8 Char2num(char c) {
   return ret;
 }
 
+namespace {
+// Perfect hash of the MIR keywords, built once by hash and displace: the keywords are distributed into buckets,
+// and for each bucket, biggest first, a displacement is searched so that all its keywords land in free slots.
+// A lookup is then two hashes and one string compare.
+class KeywordTable {
+ public:
+  KeywordTable() {
+    KeywordVec keywords;
+    std::unordered_map<std::string_view, size_t> keywordIdx;
+#define KEYWORD(STR) AddKeyword(keywords, keywordIdx, #STR, TK_##STR);
+#include "keywords.def"
+#undef KEYWORD
+    Build(keywords);
+  }
+  ~KeywordTable() = default;
+
+  TokenKind Find(std::string_view str) const {
+    uint32 disp = displacements[Hash(str, 0) % displacements.size()];
+    const auto &slot = slots[Hash(str, disp) % slots.size()];
+    return slot.first == str ? slot.second : TK_invalid;
+  }
+
+ private:
+  using KeywordVec = std::vector<std::pair<std::string_view, TokenKind>>;
+
+  // a keyword defined twice keeps the last token kind
+  static void AddKeyword(KeywordVec &keywords, std::unordered_map<std::string_view, size_t> &keywordIdx,
+                         std::string_view str, TokenKind tk) {
+    auto it = keywordIdx.emplace(str, keywords.size()).first;
+    if (it->second == keywords.size()) {
+      keywords.emplace_back(str, tk);
+    } else {
+      keywords[it->second].second = tk;
+    }
+  }
+
+  // FNV-1a, seed 0 selects the bucket and the displacement of the bucket selects the slot
+  static uint32 Hash(std::string_view str, uint32 seed) {
+    uint32 hash = 2166136261U ^ seed;
+    for (char c : str) {
+      hash = (hash ^ static_cast<uint8>(c)) * 16777619U;
+    }
+    return hash;
+  }
+
+  void Build(const KeywordVec &keywords) {
+    constexpr size_t kKeywordsPerBucket = 4;
+    displacements.resize(keywords.size() / kKeywordsPerBucket + 1, 0);
+    slots.resize(keywords.size() + keywords.size() / kKeywordsPerBucket + 1, {std::string_view(), TK_invalid});
+    std::vector<std::vector<size_t>> buckets(displacements.size());
+    for (size_t i = 0; i < keywords.size(); ++i) {
+      buckets[Hash(keywords[i].first, 0) % buckets.size()].push_back(i);
+    }
+    std::vector<size_t> order(buckets.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) {
+      return buckets[a].size() > buckets[b].size();
+    });
+    std::vector<bool> used(slots.size(), false);
+    std::vector<size_t> placed;
+    for (size_t bucketIdx : order) {
+      const std::vector<size_t> &bucket = buckets[bucketIdx];
+      if (bucket.empty()) {
+        break;
+      }
+      for (uint32 disp = 1;; ++disp) {
+        placed.clear();
+        for (size_t keywordIdx : bucket) {
+          size_t slotIdx = Hash(keywords[keywordIdx].first, disp) % slots.size();
+          if (used[slotIdx] || std::find(placed.begin(), placed.end(), slotIdx) != placed.end()) {
+            break;
+          }
+          placed.push_back(slotIdx);
+        }
+        if (placed.size() != bucket.size()) {
+          CHECK_FATAL(disp != UINT32_MAX, "no perfect hash for the MIR keywords");
+          continue;
+        }
+        for (size_t i = 0; i < bucket.size(); ++i) {
+          used[placed[i]] = true;
+          slots[placed[i]] = keywords[bucket[i]];
+        }
+        displacements[bucketIdx] = disp;
+        break;
+      }
+    }
+  }
+
+  std::vector<uint32> displacements;
+  std::vector<std::pair<std::string_view, TokenKind>> slots;
+};
+
+const KeywordTable &GetKeywordTable() {
+  static const KeywordTable keywordTable;
+  return keywordTable;
+}
+}  // namespace
+
 // Read (next) line from the MIR (text) file, and return the read
 // number of chars.
 // if the line is empty (nothing but a newline), returns 0.
@@ -46,7 +155,23 @@ int MIRLexer::ReadALine() {
   }
 
   curIdx = 0;
-  if (!std::getline(*airFile, line)) {  // EOF
+  if (airFile == &airFileInternal && mapBase != nullptr) {
+    if (mapPos >= mapSize) {  // EOF
+      line = "";
+      airFile = nullptr;
+      currentLineSize = 0;
+      return -1;
+    }
+    lineStartPos = mapPos;
+    const char *lineStart = mapBase + mapPos;
+    size_t restSize = mapSize - mapPos;
+    const void *lineEnd = memchr(lineStart, '\n', restSize);
+    size_t lineSize = (lineEnd == nullptr) ? restSize :
+        static_cast<size_t>(static_cast<const char*>(lineEnd) - lineStart);
+    // line keeps its buffer from one line to the next, assign copies without any allocation once it is grown
+    line.assign(lineStart, lineSize);
+    mapPos += lineSize + 1;
+  } else if (!std::getline(*airFile, line)) {  // EOF
     line = "";
     airFile = nullptr;
     currentLineSize = 0;
@@ -60,24 +185,53 @@ int MIRLexer::ReadALine() {
 
 MIRLexer::MIRLexer(DebugInfo *debugInfo,  MapleAllocator &alloc)
     : dbgInfo(debugInfo),
-      seenComments(alloc.Adapter()),
-      keywordMap(alloc.Adapter()) {
-  // initialize keywordMap
-  keywordMap.clear();
-#define KEYWORD(STR)            \
-  {                             \
-    std::string str;            \
-    str = #STR;                 \
-    keywordMap[str] = TK_##STR; \
+      seenComments(alloc.Adapter()) {
+  (void)GetKeywordTable();
+}
+
+bool MIRLexer::MapFile(const std::string &filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+    (void)close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(fileStat.st_size);
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+  (void)madvise(addr, size, MADV_SEQUENTIAL);
+  mapBase = static_cast<const char*>(addr);
+  mapSize = size;
+  mapPos = 0;
+  ownsMap = true;
+  return true;
+}
+
+void MIRLexer::UnmapFile() {
+  if (mapBase != nullptr) {
+    if (ownsMap) {
+      (void)munmap(const_cast<char*>(mapBase), mapSize);
+    }
+    ownsMap = false;
+    mapBase = nullptr;
+    mapSize = 0;
+    mapPos = 0;
   }
-#include "keywords.def"
-#undef KEYWORD
 }
 
 void MIRLexer::PrepareForFile(const std::string &filename) {
-  // open MIR file
-  airFileInternal.open(filename);
-  CHECK_FATAL(airFileInternal.is_open(), "cannot open MIR file %s\n", &filename);
+  // map the whole MIR file, read it through a stream if it cannot be mapped (empty file, pipe)
+  UnmapFile();
+  if (!MapFile(filename)) {
+    airFileInternal.open(filename);
+    CHECK_FATAL(airFileInternal.is_open(), "cannot open MIR file %s\n", &filename);
+  }
 
   airFile = &airFileInternal;
   // try to read the first line
@@ -90,6 +244,66 @@ void MIRLexer::PrepareForFile(const std::string &filename) {
   kind = TK_invalid;
 }
 
+void MIRLexer::PrepareForMappedLine(const MIRLexer &mainLexer, size_t lineStart, uint32 col, uint32 line) {
+  UnmapFile();
+  CHECK_FATAL(mainLexer.mapBase != nullptr && lineStart < mainLexer.mapSize, "line out of the mapped MIR file");
+  mapBase = mainLexer.mapBase;
+  mapSize = mainLexer.mapSize;
+  mapPos = lineStart;
+  airFile = &airFileInternal;
+  // the debug message belongs to the lexer of the main thread
+  dbgInfo = nullptr;
+  (void)ReadALine();
+  curIdx = col;
+  lineNum = line;
+  kind = TK_invalid;
+}
+
+void MIRLexer::PrepareForBuffer(const char *buf, size_t size) {
+  UnmapFile();
+  mapBase = buf;
+  mapSize = size;
+  mapPos = 0;
+  airFile = &airFileInternal;
+  if (ReadALine() < 0) {
+    lineNum = 0;
+  } else {
+    lineNum = 1;
+  }
+  kind = TK_invalid;
+}
+
+bool MIRLexer::SkipBlock() {
+  uint32 depth = 1;
+  while (true) {
+    char c = GetCurrentCharWithUpperCheck();
+    if (c == 0 || c == '#') {
+      if (ReadALine() < 0) {
+        return false;
+      }
+      ++lineNum;
+      continue;
+    }
+    ++curIdx;
+    if (c == '\"') {
+      // string literal, a \ escapes the next char
+      for (c = GetCurrentCharWithUpperCheck(); c != 0 && c != '\"'; c = GetCurrentCharWithUpperCheck()) {
+        curIdx += (c == '\\' && curIdx + 1 < currentLineSize) ? 2 : 1;
+      }
+      if (c == '\"') {
+        ++curIdx;
+      }
+    } else if (c == '\'' && GetCharAtWithUpperCheck(curIdx + 1) == '\'') {
+      curIdx += 2;  // char constant like '{'
+    } else if (c == '{') {
+      ++depth;
+    } else if (c == '}' && --depth == 0) {
+      UpdateDbgMsg(lineNum);
+      return true;
+    }
+  }
+}
+
 void MIRLexer::UpdateDbgMsg(uint32 dbgLineNum) {
   if (dbgInfo) {
     dbgInfo->UpdateMsg(dbgLineNum, line.c_str());
@@ -117,7 +331,7 @@ void MIRLexer::GenName() {
          c == '@') {
     c = GetNextCurrentCharWithUpperCheck();
   }
-  name = line.substr(startIdx, curIdx - startIdx);
+  name.assign(line, startIdx, curIdx - startIdx);
 }
 
 // get the constant value
@@ -194,7 +408,7 @@ TokenKind MIRLexer::GetSpecialFloatConst() {
 TokenKind MIRLexer::GetHexConst(uint32 valStart, bool negative) {
   char c = GetCharAtWithUpperCheck(curIdx);
   if (!isxdigit(c)) {
-    name = line.substr(valStart, curIdx - valStart);
+    name.assign(line, valStart, curIdx - valStart);
     return TK_invalid;
   }
   IntVal tmp(static_cast<uint64>(HexCharToDigit(c)), kInt128BitSize, negative);
@@ -214,14 +428,14 @@ TokenKind MIRLexer::GetHexConst(uint32 valStart, bool negative) {
     theDoubleVal = -theDoubleVal;
   }
   theInt128Val.Assign(tmp);
-  name = line.substr(valStart, curIdx - valStart);
+  name.assign(line, valStart, curIdx - valStart);
   return TK_intconst;
 }
 
 TokenKind MIRLexer::GetLongHexConst(uint32 valStart, bool negative) {
   char c = GetCharAtWithUpperCheck(curIdx);
   if (!isxdigit(c)) {
-    name = line.substr(valStart, curIdx - valStart);
+    name.assign(line, valStart, curIdx - valStart);
     return TK_invalid;
   }
   unsigned __int128 tmp = 0;
@@ -243,14 +457,14 @@ TokenKind MIRLexer::GetLongHexConst(uint32 valStart, bool negative) {
     theFloatVal = -theFloatVal;
     theDoubleVal = -theDoubleVal;
   }
-  name = line.substr(valStart, curIdx - valStart);
+  name.assign(line, valStart, curIdx - valStart);
   return TK_intconst;
 }
 
 TokenKind MIRLexer::GetIntConst(uint32 valStart, bool negative) {
   char c = GetCharAtWithUpperCheck(curIdx);
   if (!isxdigit(c)) {
-    name = line.substr(valStart, curIdx - valStart);
+    name.assign(line, valStart, curIdx - valStart);
     return TK_invalid;
   }
   uint64 radix = HexCharToDigit(c) == 0 ? 8 : 10;
@@ -274,7 +488,7 @@ TokenKind MIRLexer::GetIntConst(uint32 valStart, bool negative) {
     }
   }
 
-  name = line.substr(valStart, curIdx - valStart);
+  name.assign(line, valStart, curIdx - valStart);
 
   if (negative) {
     tmp = -tmp;
@@ -310,7 +524,7 @@ TokenKind MIRLexer::GetFloatConst(uint32 valStart, uint32 startIdx, bool negativ
   if (c == 'e' || c == 'E') {
     c = GetNextCurrentCharWithUpperCheck();
     if (!isdigit(c) && c != '-' && c != '+') {
-      name = line.substr(valStart, curIdx - valStart);
+      name.assign(line, valStart, curIdx - valStart);
       return TK_invalid;
     }
     if (c == '-' || c == '+') {
@@ -342,7 +556,7 @@ TokenKind MIRLexer::GetFloatConst(uint32 valStart, uint32 startIdx, bool negativ
     if (negative && fabs(theFloatVal) <= 1e-6) {
       theDoubleVal = -theDoubleVal;
     }
-    name = line.substr(valStart, curIdx - valStart);
+    name.assign(line, valStart, curIdx - valStart);
     return TK_floatconst;
   } else {
     int eNum = sscanf_s(floatStr.c_str(), "%le", &theDoubleVal);
@@ -356,7 +570,7 @@ TokenKind MIRLexer::GetFloatConst(uint32 valStart, uint32 startIdx, bool negativ
     if (negative && fabs(theDoubleVal) <= 1e-15) {
       theFloatVal = -theFloatVal;
     }
-    name = line.substr(valStart, curIdx - valStart);
+    name.assign(line, valStart, curIdx - valStart);
     return TK_doubleconst;
   }
 }
@@ -370,7 +584,7 @@ TokenKind MIRLexer::GetTokenWithPrefixDollar() {
   } else {
     // for error reporting.
     const uint32 printLength = 2;
-    name = line.substr(curIdx - 1, printLength);
+    name.assign(line, curIdx - 1, printLength);
     return TK_invalid;
   }
 }
@@ -387,7 +601,7 @@ TokenKind MIRLexer::GetTokenWithPrefixPercent() {
       ASSERT(theIntVal >= 0, "int value overflow");
       c = GetNextCurrentCharWithUpperCheck();
     }
-    name = line.substr(valStart, curIdx - valStart);
+    name.assign(line, valStart, curIdx - valStart);
     return TK_preg;
   }
   if (utils::IsAlpha(c) || c == '_' || c == '$') {
@@ -411,7 +625,7 @@ TokenKind MIRLexer::GetTokenWithPrefixAmpersand() {
   }
   // for error reporting.
   constexpr uint32 printLength = 2;
-  name = line.substr(curIdx - 1, printLength);
+  name.assign(line, curIdx - 1, printLength);
   return TK_invalid;
 }
 
@@ -441,7 +655,7 @@ TokenKind MIRLexer::GetTokenWithPrefixExclamation() {
   }
   // for error reporting.
   const uint32 printLength = 2;
-  name = line.substr(curIdx - 1, printLength);
+  name.assign(line, curIdx - 1, printLength);
   return TK_invalid;
 }
 
@@ -549,7 +763,7 @@ TokenKind MIRLexer::GetTokenWithPrefixDoubleQuotation() {
   if (startIdx == curIdx) {
     name = "";
   } else {
-    name = line.substr(startIdx, curIdx - startIdx - shift);
+    name.assign(line, startIdx, curIdx - startIdx - shift);
   }
   ++curIdx;
   return TK_string;
@@ -560,7 +774,7 @@ TokenKind MIRLexer::GetTokenSpecial() {
   char c = GetCharAtWithLowerCheck(curIdx);
   if (utils::IsAlpha(c) || c < 0 || c == '_') {
     GenName();
-    TokenKind tk = keywordMap[name];
+    TokenKind tk = GetKeywordTable().Find(name);
     switch (tk) {
       case TK_nanf:
         theFloatVal = NAN;
@@ -17,11 +17,11 @@
 #include "mir_parser.h"
 
 namespace maple {
-std::map<TokenKind, MIRParser::FuncPtrParseExpr> MIRParser::funcPtrMapForParseExpr =
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseExpr> MIRParser::funcPtrMapForParseExpr =
     MIRParser::InitFuncPtrMapForParseExpr();
-std::map<TokenKind, MIRParser::FuncPtrParseStmt> MIRParser::funcPtrMapForParseStmt =
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseStmt> MIRParser::funcPtrMapForParseStmt =
     MIRParser::InitFuncPtrMapForParseStmt();
-std::map<TokenKind, MIRParser::FuncPtrParseStmtBlock> MIRParser::funcPtrMapForParseStmtBlock =
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseStmtBlock> MIRParser::funcPtrMapForParseStmtBlock =
     MIRParser::InitFuncPtrMapForParseStmtBlock();
 
 bool MIRParser::GetStIdxForStmtDassignOrDassignoffNode(StIdx &stidx) {
@@ -764,6 +764,7 @@ PUIdx MIRParser::EnterUndeclaredFunction(bool isMcount) {
     funcName = lexer.GetName();
   }
   GStrIdx strIdx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName(funcName);
+  ParallelGuard guard(globalDeclMtx, ThreadEnv::IsMeParallel());
   MIRSymbol *funcSt = GlobalTables::GetGsymTable().CreateSymbol(kScopeGlobal);
   funcSt->SetNameStrIdx(strIdx);
   (void)GlobalTables::GetGsymTable().AddToStringSymbolMap(*funcSt);
@@ -1810,9 +1811,9 @@ bool MIRParser::ParseStatement(StmtNodePtr &stmt) {
   uint32 lnum = lastLineNum;
   uint32 fnum = lastFileNum;
   uint16 cnum = lastColumnNum;
-  std::map<TokenKind, FuncPtrParseStmt>::iterator itFuncPtr = funcPtrMapForParseStmt.find(paramTokenKindForStmt);
-  if (itFuncPtr != funcPtrMapForParseStmt.end()) {
-    if (!(this->*(itFuncPtr->second))(stmt)) {
+  FuncPtrParseStmt funcPtr = funcPtrMapForParseStmt[paramTokenKindForStmt];
+  if (funcPtr != nullptr) {
+    if (!(this->*funcPtr)(stmt)) {
       return false;
     }
   } else {
@@ -1888,8 +1889,8 @@ bool MIRParser::ParseStmtBlock(BlockNodePtr &blk) {
         first = false;
       }
     } else {
-      std::map<TokenKind, FuncPtrParseStmtBlock>::iterator itFuncPtr = funcPtrMapForParseStmtBlock.find(stmtTk);
-      if (itFuncPtr == funcPtrMapForParseStmtBlock.end()) {
+      FuncPtrParseStmtBlock funcPtr = funcPtrMapForParseStmtBlock[stmtTk];
+      if (funcPtr == nullptr) {
         if (stmtTk == TK_rbrace) {
           ParseStmtBlockForSeenComment(blk, mplNum);
           lexer.NextToken();
@@ -1899,7 +1900,7 @@ bool MIRParser::ParseStmtBlock(BlockNodePtr &blk) {
         }
         break;
       } else {
-        if (!(this->*(itFuncPtr->second))()) {
+        if (!(this->*funcPtr)()) {
           break;
         }
       }
@@ -2222,6 +2223,7 @@ bool MIRParser::ParseDeclaredSt(StIdx &stidx) {
   stidx.SetFullIdx(0);
   GStrIdx stridx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName(lexer.GetName());
   if (varTk == TK_gname) {
+    ParallelGuard guard(globalDeclMtx, ThreadEnv::IsMeParallel());
     stidx = GlobalTables::GetGsymTable().GetStIdxFromStrIdx(stridx);
     if (stidx.FullIdx() == 0) {
       MIRSymbol *st = GlobalTables::GetGsymTable().CreateSymbol(kScopeGlobal);
@@ -2266,6 +2268,7 @@ bool MIRParser::ParseDeclaredFunc(PUIdx &puidx) {
   if (stridx == 0u) {
     stridx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName(lexer.GetName());
   }
+  ParallelGuard guard(globalDeclMtx, ThreadEnv::IsMeParallel());
   StIdx stidx = GlobalTables::GetGsymTable().GetStIdxFromStrIdx(stridx);
   if (stidx.FullIdx() == 0) {
     CreateFuncMIRSymbol(puidx, stridx);
@@ -3200,8 +3203,11 @@ bool MIRParser::ParseConstAddrLeafExpr(MIRConstPtr &cexpr) {
     auto *currFn = static_cast<MIRFunction*>(mod.CurFunction());
     MIRSymbol *var = currFn->GetLocalOrGlobalSymbol(anode->GetStIdx());
     ASSERT(var != nullptr, "null ptr check");
-    var->SetNeedForwDecl();
-    mod.SetSomeSymbolNeedForDecl(true);
+    {
+      ParallelGuard guard(globalDeclMtx, ThreadEnv::IsMeParallel());
+      var->SetNeedForwDecl();
+      mod.SetSomeSymbolNeedForDecl(true);
+    }
     TyIdx ptyIdx = var->GetTyIdx();
     MIRPtrType ptrType(ptyIdx, (mod.IsJavaModule() ? PTY_ref : GetExactPtrPrimType()));
     ptyIdx = GlobalTables::GetTypeTable().GetOrCreateMIRType(&ptrType);
@@ -3270,20 +3276,20 @@ bool MIRParser::ParseConstAddrLeafExpr(MIRConstPtr &cexpr) {
 
 bool MIRParser::ParseExpression(BaseNodePtr &expr) {
   TokenKind tk = lexer.GetTokenKind();
-  std::map<TokenKind, MIRParser::FuncPtrParseExpr>::iterator itFuncPtr = funcPtrMapForParseExpr.find(tk);
-  if (itFuncPtr == funcPtrMapForParseExpr.end()) {
+  FuncPtrParseExpr funcPtr = funcPtrMapForParseExpr[tk];
+  if (funcPtr == nullptr) {
     Error("expect expression but get ");
     return false;
   } else {
-    if (!(this->*(itFuncPtr->second))(expr)) {
+    if (!(this->*funcPtr)(expr)) {
       return false;
     }
   }
   return true;
 }
 
-std::map<TokenKind, MIRParser::FuncPtrParseExpr> MIRParser::InitFuncPtrMapForParseExpr() {
-  std::map<TokenKind, MIRParser::FuncPtrParseExpr> funcPtrMap;
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseExpr> MIRParser::InitFuncPtrMapForParseExpr() {
+  TokenDispatchTable<FuncPtrParseExpr> funcPtrMap{};
   funcPtrMap[TK_addrof] = &MIRParser::ParseExprAddrof;
   funcPtrMap[TK_addrofoff] = &MIRParser::ParseExprAddrofoff;
   funcPtrMap[TK_addroffunc] = &MIRParser::ParseExprAddroffunc;
@@ -3357,8 +3363,8 @@ std::map<TokenKind, MIRParser::FuncPtrParseExpr> MIRParser::InitFuncPtrMapForPar
   return funcPtrMap;
 }
 
-std::map<TokenKind, MIRParser::FuncPtrParseStmt> MIRParser::InitFuncPtrMapForParseStmt() {
-  std::map<TokenKind, MIRParser::FuncPtrParseStmt> funcPtrMap;
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseStmt> MIRParser::InitFuncPtrMapForParseStmt() {
+  TokenDispatchTable<FuncPtrParseStmt> funcPtrMap{};
   funcPtrMap[TK_dassign] = &MIRParser::ParseStmtDassign;
   funcPtrMap[TK_dassignoff] = &MIRParser::ParseStmtDassignoff;
   funcPtrMap[TK_iassign] = &MIRParser::ParseStmtIassign;
@@ -3458,8 +3464,8 @@ std::map<TokenKind, MIRParser::FuncPtrParseStmt> MIRParser::InitFuncPtrMapForPar
   return funcPtrMap;
 }
 
-std::map<TokenKind, MIRParser::FuncPtrParseStmtBlock> MIRParser::InitFuncPtrMapForParseStmtBlock() {
-  std::map<TokenKind, MIRParser::FuncPtrParseStmtBlock> funcPtrMap;
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseStmtBlock> MIRParser::InitFuncPtrMapForParseStmtBlock() {
+  TokenDispatchTable<FuncPtrParseStmtBlock> funcPtrMap{};
   funcPtrMap[TK_var] = &MIRParser::ParseStmtBlockForVar;
   funcPtrMap[TK_tempvar] = &MIRParser::ParseStmtBlockForTempVar;
   funcPtrMap[TK_reg] = &MIRParser::ParseStmtBlockForReg;
@@ -42,6 +42,7 @@ bool Options::useInline = true;             // Enabled by default
 bool Options::enableGInline = true;
 bool Options::useCrossModuleInline = true;  // Enabled by default
 bool Options::importInlineMplt = false;  // Disabled by default
+bool Options::inlineDb = false;
 bool Options::ignorePreferInline = false;  // Disabled by default
 std::string Options::noInlineFuncList = "";
 std::string Options::noIpaCloneFuncList = "";
@@ -90,6 +91,8 @@ bool Options::skipVirtualMethod = false;
 #endif
 bool Options::profileGen = false;
 bool Options::profileUse = false;
+bool Options::profileValues = false;
+std::string Options::sampleProfile = "";
 bool Options::stackProtectorStrong = false;
 bool Options::stackProtectorAll = false;
 bool Options::genLMBC = false;
@@ -224,6 +227,7 @@ bool Options::SolveOptions(bool isDebug) const {
   maplecl::CopyIfEnabled(numOfConstpropValue, opts::mpl2mpl::numOfConstpropValue);
   maplecl::CopyIfEnabled(useCrossModuleInline, opts::mpl2mpl::crossModuleInline);
   maplecl::CopyIfEnabled(importInlineMplt, opts::importMpltInline);
+  maplecl::CopyIfEnabled(inlineDb, opts::inlineDb);
   maplecl::CopyIfEnabled(inlineSmallFunctionThreshold, opts::mpl2mpl::inlineSmallFunctionThreshold);
   maplecl::CopyIfEnabled(inlineHotFunctionThreshold, opts::mpl2mpl::inlineHotFunctionThreshold);
   maplecl::CopyIfEnabled(inlineRecursiveFunctionThreshold, opts::mpl2mpl::inlineRecursiveFunctionThreshold);
@@ -353,6 +357,11 @@ bool Options::SolveOptions(bool isDebug) const {
   }
 
   maplecl::CopyIfEnabled(profileUse, opts::profileUse);
+  maplecl::CopyIfEnabled(profileValues, opts::profileValues);
+  maplecl::CopyIfEnabled(sampleProfile, opts::sampleProfile);
+  if (!sampleProfile.empty()) {
+    profileUse = true;
+  }
   maplecl::CopyIfEnabled(stackProtectorStrong, opts::stackProtectorStrong);
   maplecl::CopyIfEnabled(stackProtectorAll, opts::stackProtectorAll);
   maplecl::CopyIfEnabled(genLMBC, opts::genLMBC);
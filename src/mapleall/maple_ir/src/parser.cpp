@@ -28,6 +28,7 @@
 #include "string_utils.h"
 #include "debug_info.h"
 #include "mir_enum.h"
+#include "mpl_scheduler.h"
 
 namespace {
 using namespace maple;
@@ -69,8 +70,26 @@ const std::map<TokenKind, PragmaValueType> tkPragmaValType = { { TK_i8, kValueBy
 }  // namespace
 
 namespace maple {
-std::map<TokenKind, MIRParser::FuncPtrParseMIRForElem> MIRParser::funcPtrMapForParseMIR =
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseMIRForElem> MIRParser::funcPtrMapForParseMIR =
     MIRParser::InitFuncPtrMapForParseMIR();
+std::mutex MIRParser::globalDeclMtx;
+
+class FuncBodyParseTask : public MplTask {
+ public:
+  FuncBodyParseTask(const MIRParser &parser, MIRParser::DeferredFuncBody &deferred)
+      : parser(parser), deferred(deferred) {}
+  ~FuncBodyParseTask() override = default;
+
+ protected:
+  int RunImpl(MplTaskParam*) override {
+    parser.ParseDeferredFuncBody(deferred);
+    return 0;
+  }
+
+ private:
+  const MIRParser &parser;
+  MIRParser::DeferredFuncBody &deferred;
+};
 
 MIRFunction *MIRParser::CreateDummyFunction() {
   GStrIdx strIdx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName("__$$__");
@@ -1240,6 +1259,7 @@ bool MIRParser::ParseDefinedTypename(TyIdx &definedTyIdx, MIRTypeKind kind) {
   }
   std::string nameStr = lexer.GetName();
   GStrIdx strIdx = GlobalTables::GetStrTable().GetOrCreateStrIdxFromName(nameStr);
+  ParallelGuard guard(globalDeclMtx, ThreadEnv::IsMeParallel());
   // check if type already exist
   definedTyIdx = mod.GetTypeNameTab()->GetTyIdxFromGStrIdx(strIdx);
   TyIdx prevTypeIdx(0);
@@ -2292,46 +2312,134 @@ bool MIRParser::ParseFunction(uint32 fileIdx) {
     if ((options & kParseInlineFuncBody) != 0) {
       funcSymbol->SetIsTmpUnused(true);
     }
-    definedLabels.clear();
     mod.SetCurFunction(func);
     mod.AddFunction(func);
     // set line number for function
     SetSrcPos(funcSymbol->GetSrcPosition(), lexer.GetLineNum());
-    // initialize source line number to be 0
-    // to avoid carrying over info from previous function
-    firstLineNum = 0;
-    lastLineNum = 0;
-    lastColumnNum = 0;
     func->NewBody();
-    BlockNode *block = nullptr;
-    safeRegionFlag.push(curFunc->IsSafe());
-    auto isParseSucc = ParseStmtBlock(block);
-    safeRegionFlag.pop();
+    bool isParseSucc = CanDeferFuncBody() ? DeferFuncBody(*func) : ParseFunctionBody(*func);
     if (!isParseSucc) {
-      Error("ParseFunction failed when parsing stmt block");
       ResetCurrentFunction();
       return false;
     }
-    func->SetBody(block);
-    // check if any local type name is undefined
-    for (auto it : func->GetGStrIdxToTyIdxMap()) {
-      MIRType *type = GlobalTables::GetTypeTable().GetTypeFromTyIdx(it.second);
-      if (type->GetKind() == kTypeByName) {
-        std::string strStream;
-        const std::string &name = GlobalTables::GetStrTable().GetStringFromStrIdx(it.first);
-        strStream += "type %";
-        strStream += name;
-        strStream += " used but not defined\n";
-        message += strStream;
-        ResetCurrentFunction();
-        return false;
-      }
-    }
   }
   ResetCurrentFunction();
   return true;
 }
 
+bool MIRParser::ParseFunctionBody(MIRFunction &func) {
+  definedLabels.clear();
+  // initialize source line number to be 0
+  // to avoid carrying over info from previous function
+  firstLineNum = 0;
+  lastLineNum = 0;
+  lastColumnNum = 0;
+  BlockNode *block = nullptr;
+  safeRegionFlag.push(func.IsSafe());
+  auto isParseSucc = ParseStmtBlock(block);
+  safeRegionFlag.pop();
+  if (!isParseSucc) {
+    Error("ParseFunction failed when parsing stmt block");
+    return false;
+  }
+  func.SetBody(block);
+  // check if any local type name is undefined
+  for (auto it : func.GetGStrIdxToTyIdxMap()) {
+    MIRType *type = GlobalTables::GetTypeTable().GetTypeFromTyIdx(it.second);
+    if (type->GetKind() == kTypeByName) {
+      std::string strStream;
+      const std::string &name = GlobalTables::GetStrTable().GetStringFromStrIdx(it.first);
+      strStream += "type %";
+      strStream += name;
+      strStream += " used but not defined\n";
+      message += strStream;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MIRParser::CanDeferFuncBody() const {
+  // only the main input is parsed in two passes, the optimized and to-be-inlined function files are parsed in one
+  return parseThreads > 1 && !mod.IsJavaModule() && (options & (kParseOptFunc | kParseInlineFuncBody)) == 0 &&
+         lexer.IsReadingMappedFile();
+}
+
+// Record where the body starts in the mapped file and skip it, its statements are parsed by
+// ParseDeferredFuncBodies once all the declarations of the file are known.
+bool MIRParser::DeferFuncBody(MIRFunction &func) {
+  DeferredFuncBody deferred;
+  deferred.func = &func;
+  deferred.lineStart = lexer.GetLineStartPos();
+  deferred.col = lexer.GetCurIdx() - 1;
+  deferred.lineNum = lexer.GetLineNum();
+  deferred.lastFileNum = lastFileNum;
+  deferred.comments.assign(lexer.seenComments.begin(), lexer.seenComments.end());
+  lexer.seenComments.clear();
+  if (!lexer.SkipBlock()) {
+    Error("expect } for func body but get ");
+    return false;
+  }
+  (void)lexer.NextToken();
+  deferredFuncBodies.push_back(std::move(deferred));
+  return true;
+}
+
+// Runs on a worker thread, with a parser of its own reading the mapped file of this parser.
+void MIRParser::ParseDeferredFuncBody(DeferredFuncBody &deferred) const {
+  MIRParser parser(mod);
+  parser.options = options;
+  parser.paramFileIdx = paramFileIdx;
+  parser.paramIsIPA = paramIsIPA;
+  parser.paramIsComb = paramIsComb;
+  parser.lastFileNum = deferred.lastFileNum;
+  parser.curFunc = deferred.func;
+  parser.lexer.PrepareForMappedLine(lexer, deferred.lineStart, deferred.col, deferred.lineNum);
+  for (const std::string &comment : deferred.comments) {
+    parser.lexer.seenComments.push_back(comment);
+  }
+  (void)parser.lexer.NextToken();
+  mod.SetCurFunction(deferred.func);
+  deferred.succeeded = parser.ParseFunctionBody(*deferred.func);
+  parser.ResetCurrentFunction();
+  deferred.message = std::move(parser.message);
+  deferred.warningMessage = std::move(parser.warningMessage);
+}
+
+bool MIRParser::ParseDeferredFuncBodies() {
+  if (deferredFuncBodies.empty()) {
+    return true;
+  }
+  MplScheduler scheduler("parse func bodies");
+  scheduler.Init();
+  std::vector<std::unique_ptr<FuncBodyParseTask>> tasks;
+  tasks.reserve(deferredFuncBodies.size());
+  for (DeferredFuncBody &deferred : deferredFuncBodies) {
+    tasks.emplace_back(std::make_unique<FuncBodyParseTask>(*this, deferred));
+    scheduler.AddTask(*tasks.back());
+  }
+  // the string, type, const and global symbol tables and CurFunction() are thread safe in parallel mode, the nodes
+  // of a body go to the code mempool of its function, the other allocations to the module mempool, which is a
+  // ThreadShareMemPool locking each allocation then
+  bool isParallel = ThreadEnv::IsMeParallel();
+  ThreadEnv::SetMeParallel(true);
+  uint32 threads = std::min(parseThreads, static_cast<uint32>(deferredFuncBodies.size()));
+  (void)scheduler.RunTask(threads, false);
+  ThreadEnv::SetMeParallel(isParallel);
+  bool succeeded = true;
+  // report the first error in file order, as the serial parsing does
+  for (DeferredFuncBody &deferred : deferredFuncBodies) {
+    warningMessage += deferred.warningMessage;
+    if (!deferred.succeeded) {
+      message += deferred.message;
+      succeeded = false;
+      break;
+    }
+  }
+  deferredFuncBodies.clear();
+  return succeeded;
+}
+
 bool MIRParser::ParseInitValue(MIRConstPtr &theConst, TyIdx tyIdx, bool allowEmpty) {
   TokenKind tokenKind = lexer.GetTokenKind();
   MIRType &type = *GlobalTables::GetTypeTable().GetTypeFromTyIdx(tyIdx);
@@ -2882,6 +2990,18 @@ bool MIRParser::ParseInlineFuncBody(std::ifstream &mplFile) {
   return status;
 }
 
+bool MIRParser::ParseInlineFuncBody(const std::string &src) {
+  // the lexer of this parser may still map the main input, src is lexed by a parser of its own
+  MIRParser parser(mod);
+  parser.dummyFunction = dummyFunction;
+  parser.lexer.PrepareForBuffer(src.data(), src.size());
+  bool status = parser.ParseMIR(0, kParseOptFunc | kParseInlineFuncBody);
+  if (!status) {
+    message += parser.message;
+  }
+  return status;
+}
+
 bool MIRParser::ParseSrcLang(MIRSrcLang &srcLang) {
   PrepareParsingMIR();
   bool atEof = false;
@@ -2921,8 +3041,8 @@ bool MIRParser::ParseMIR(uint32 fileIdx, uint32 option, bool isIPA, bool isComb)
   lexer.NextToken();
   while (!atEof) {
     paramTokenKind = lexer.GetTokenKind();
-    std::map<TokenKind, FuncPtrParseMIRForElem>::iterator itFuncPtr = funcPtrMapForParseMIR.find(paramTokenKind);
-    if (itFuncPtr == funcPtrMapForParseMIR.end()) {
+    FuncPtrParseMIRForElem funcPtr = funcPtrMapForParseMIR[paramTokenKind];
+    if (funcPtr == nullptr) {
       if (paramTokenKind == TK_eof) {
         atEof = true;
       } else {
@@ -2930,11 +3050,14 @@ bool MIRParser::ParseMIR(uint32 fileIdx, uint32 option, bool isIPA, bool isComb)
         return false;
       }
     } else {
-      if (!(this->*(itFuncPtr->second))()) {
+      if (!(this->*funcPtr)()) {
         return false;
       }
     }
   }
+  if (!ParseDeferredFuncBodies()) {
+    return false;
+  }
   // fix the typedef type
   FixupForwardReferencedTypeByMap();
   // check if any global type name is undefined
@@ -2978,8 +3101,8 @@ bool MIRParser::ParseMIR(uint32 fileIdx, uint32 option, bool isIPA, bool isComb)
   return true;
 }
 
-std::map<TokenKind, MIRParser::FuncPtrParseMIRForElem> MIRParser::InitFuncPtrMapForParseMIR() {
-  std::map<TokenKind, MIRParser::FuncPtrParseMIRForElem> funcPtrMap;
+MIRParser::TokenDispatchTable<MIRParser::FuncPtrParseMIRForElem> MIRParser::InitFuncPtrMapForParseMIR() {
+  TokenDispatchTable<FuncPtrParseMIRForElem> funcPtrMap{};
   funcPtrMap[TK_func] = &MIRParser::ParseMIRForFunc;
   funcPtrMap[TK_tempvar] = &MIRParser::ParseMIRForVar;
   funcPtrMap[TK_var] = &MIRParser::ParseMIRForVar;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "src_position.h"
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace maple {
+namespace {
+struct InlinedSrcPosData {
+  std::mutex mtx;
+  std::vector<InlinedSrcPos> positions { InlinedSrcPos() };  // entry 0 stands for not inlined
+  std::map<std::tuple<uint32, uint32, uint32>, uint32> posToIdx;
+};
+
+InlinedSrcPosData &GetInlinedSrcPosData() {
+  static InlinedSrcPosData data;
+  return data;
+}
+}  // namespace
+
+uint32 InlinedSrcPosTable::GetOrCreate(uint32 lineNum, uint32 fileNum, const GStrIdx &funcStrIdx) {
+  InlinedSrcPosData &data = GetInlinedSrcPosData();
+  std::lock_guard<std::mutex> guard(data.mtx);
+  auto key = std::make_tuple(lineNum, fileNum, funcStrIdx.GetIdx());
+  auto it = data.posToIdx.find(key);
+  if (it != data.posToIdx.end()) {
+    return it->second;
+  }
+  uint32 idx = static_cast<uint32>(data.positions.size());
+  InlinedSrcPos pos;
+  pos.lineNum = lineNum;
+  pos.fileNum = fileNum;
+  pos.funcStrIdx = funcStrIdx;
+  data.positions.push_back(pos);
+  (void)data.posToIdx.emplace(key, idx);
+  return idx;
+}
+
+InlinedSrcPos InlinedSrcPosTable::Get(uint32 idx) {
+  InlinedSrcPosData &data = GetInlinedSrcPosData();
+  std::lock_guard<std::mutex> guard(data.mtx);
+  CHECK_FATAL(idx < data.positions.size(), "invalid inlined source position index");
+  return data.positions[idx];
+}
+
+size_t InlinedSrcPosTable::Size() {
+  InlinedSrcPosData &data = GetInlinedSrcPosData();
+  std::lock_guard<std::mutex> guard(data.mtx);
+  return data.positions.size() - 1;
+}
+}  // namespace maple
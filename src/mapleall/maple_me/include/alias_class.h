@@ -17,6 +17,7 @@
 #include "mempool.h"
 #include "mempool_allocator.h"
 #include "ssa_tab.h"
+#include "maple_sparse_bitvector.h"
 #include "union_find.h"
 
 namespace maple {
@@ -68,6 +69,7 @@ class AliasClass : public AnalysisResult {
         globalsMayAffectedByClinitCheck(acAlloc.Adapter()),
         aggsToUnion(acAlloc.Adapter()),
         nadsOsts(acAlloc.Adapter()),
+        nadsOstIdxs(acAlloc),
         ostWithUndefinedOffsets(acAlloc.Adapter()),
         assignSetOfVst(acAlloc.Adapter()),
         aliasSetOfOst(acAlloc.Adapter()),
@@ -81,9 +83,9 @@ class AliasClass : public AnalysisResult {
 
   ~AliasClass() override = default;
 
-  using AssignSet = MapleSet<unsigned>; // value is VersionSt index
+  using AssignSet = MapleSparseBitVector<>; // bit is VersionSt index
   using VstIdx2AssignSet = MapleVector<AssignSet*>; // index is VersionSt index
-  using AliasSet = MapleSet<unsigned>; // value is OStIdx
+  using AliasSet = MapleSparseBitVector<>; // bit is OStIdx
   using OstIdx2AliasSet = MapleVector<AliasSet*>; // index is OStIdx
   using AliasAttrVec = MapleVector<bool>; // index is OStIdx/VersionSt index
 
@@ -131,7 +133,7 @@ class AliasClass : public AnalysisResult {
   void UnionForNotAllDefsSeenCLang();
   void ApplyUnionForStorageOverlaps();
   void UnionForAggAndFields();
-  void CollectAliasGroups(std::map<unsigned int, std::set<unsigned int>> &aliasGroups);
+  void CollectAliasGroups(MapleMap<unsigned int, AliasSet*> &aliasGroups, MapleAllocator &groupAlloc);
   bool AliasAccordingToType(TyIdx tyIdxA, TyIdx tyIdxB);
   bool AliasAccordingToFieldID(const OriginalSt &ostA, const OriginalSt &ostB) const;
   void ReconstructAliasGroups();
@@ -208,39 +210,44 @@ class AliasClass : public AnalysisResult {
   void CollectMayDefForMustDefs(const StmtNode &stmt, OstPtrSet &mayDefOsts);
   void CollectMayUseForNextLevel(const VersionSt &vst, OstPtrSet &mayUseOsts,
                                  const StmtNode &stmt, bool isFirstOpnd);
-  void CollectMayUseForIntrnCallOpnd(const StmtNode &stmt, OstPtrSet &mayDefOsts, OstPtrSet &mayUseOsts);
+  void CollectMayUseForIntrnCallOpnd(const StmtNode &stmt, AliasSet &mayDefOstIdxs, AliasSet &mayUseOstIdxs);
   void CollectMayDefUseForIthOpnd(const VersionSt &vstOfIthOpnd, OstPtrSet &mayUseOsts,
                                   const StmtNode &stmt, bool isFirstOpnd);
   void CollectMayDefUseForCallOpnd(const StmtNode &stmt,
                                    OstPtrSet &mayDefOsts, OstPtrSet &mayUseOsts,
                                    OstPtrSet &mustNotDefOsts, OstPtrSet &mustNotUseOsts);
-  void InsertMayDefNodeForCall(OstPtrSet &mayDefOsts, AccessSSANodes *ssaPart,
+  void UnionNadsExcept(const OstPtrSet &excludedOsts, AliasSet &ostIdxs, MapleAllocator &localAlloc) const;
+  void InsertMayDefNodeForCall(const AliasSet &mayDefOstIdxs, AccessSSANodes *ssaPart,
                                StmtNode &stmt, BBId bbid, bool hasNoPrivateDefEffect);
   void InsertMayUseExpr(BaseNode &expr);
   void CollectMayUseFromFormals(OstPtrSet &mayUseOsts, bool needToBeRestrict);
   void CollectMayUseFromGlobalsAffectedByCalls(OstPtrSet &mayUseOsts);
   void CollectMayUseFromDefinedFinalField(OstPtrSet &mayUseOsts);
   void InsertMayUseNode(OstPtrSet &mayUseOsts, AccessSSANodes *ssaPart);
+  void InsertMayUseNode(const AliasSet &mayUseOstIdxs, AccessSSANodes *ssaPart);
   void InsertMayUseReturn(const StmtNode &stmt);
   void CollectPtsToOfReturnOpnd(const VersionSt &vst, OstPtrSet &mayUseOsts);
   void InsertReturnOpndMayUse(const StmtNode &stmt);
   void InsertMayUseAll(const StmtNode &stmt);
   void CollectMayDefForDassign(const StmtNode &stmt, OstPtrSet &mayDefOsts);
   void InsertMayDefNode(OstPtrSet &mayDefOsts, AccessSSANodes *ssaPart, StmtNode &stmt, BBId bbid);
+  void InsertMayDefNode(const AliasSet &mayDefOstIdxs, AccessSSANodes *ssaPart, StmtNode &stmt, BBId bbid);
   void InsertMayDefDassign(StmtNode &stmt, BBId bbid);
   bool IsEquivalentField(const TyIdx &tyIdxA, FieldID fieldA, const TyIdx &tyIdxB, FieldID fieldB) const;
   bool IsAliasInfoEquivalentToExpr(const AliasInfo &ai, const BaseNode *expr);
-  void CollectMayDefForIassign(StmtNode &stmt, OstPtrSet &mayDefOsts);
+  void CollectMayDefForIassign(StmtNode &stmt, AliasSet &mayDefOstIdxs);
   void InsertMayDefNodeExcludeFinalOst(OstPtrSet &mayDefOsts, AccessSSANodes *ssaPart,
                                        StmtNode &stmt, BBId bbid);
+  void InsertMayDefNodeExcludeFinalOst(const AliasSet &mayDefOstIdxs, AccessSSANodes *ssaPart,
+                                       StmtNode &stmt, BBId bbid);
   void InsertMayDefIassign(StmtNode &stmt, BBId bbid);
   void InsertMayDefUseSyncOps(StmtNode &stmt, BBId bbid);
-  void InsertMayUseNodeExcludeFinalOst(const OstPtrSet &mayUseOsts, AccessSSANodes *ssaPart);
+  void InsertMayUseNodeExcludeFinalOst(const AliasSet &mayUseOstIdxs, AccessSSANodes *ssaPart);
   void InsertMayDefUseIntrncall(StmtNode &stmt, BBId bbid);
   void InsertMayDefUseClinitCheck(IntrinsiccallNode &stmt, BBId bbid);
   void InsertMayDefUseAsm(StmtNode &stmt, const BBId bbID);
   virtual BB *GetBB(BBId id) = 0;
-  void ProcessIdsAliasWithRoot(const std::set<unsigned int> &idsAliasWithRoot, std::vector<unsigned int> &newGroups);
+  void ProcessIdsAliasWithRoot(const AliasSet &idsAliasWithRoot, std::vector<unsigned int> &newGroups);
   int GetOffset(const Klass &super, const Klass &base) const;
   void UnionAllNodes(MapleVector<OriginalSt *> *nextLevOsts);
 
@@ -319,6 +326,7 @@ class AliasClass : public AnalysisResult {
   // aggs are copied, their fields should be unioned
   MapleUnorderedMultiMap<OriginalSt*, OriginalSt*, OstHash> aggsToUnion;
   MapleSet<OriginalSt*, OriginalSt::OriginalStPtrComparator> nadsOsts;
+  AliasSet nadsOstIdxs; // OStIdx of nadsOsts, for bulk union with alias sets
   MapleVector<OriginalSt*> ostWithUndefinedOffsets;
   VstIdx2AssignSet assignSetOfVst;
   OstIdx2AliasSet aliasSetOfOst;
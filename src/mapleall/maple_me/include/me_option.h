@@ -189,6 +189,7 @@ class MeOption {
   static uint8 rematLevel;
   static bool layoutWithPredict;
   static bool layoutColdPath;
+  static bool layoutExtTsp;
   static bool unifyRets;
   static bool dumpCfgOfPhases;
   static bool epreUseProfile;
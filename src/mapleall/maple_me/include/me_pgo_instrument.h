@@ -69,6 +69,12 @@ class BBEdge {
   bool isFake;
 };
 
+// Value profile sites are numbered per ValueProfKind in the order of the valid BBs of the cfg, alike by the
+// instrumentation on MeStmts and by the profile use on StmtNodes. Memops of a constant size are expanded by
+// simplify already and are no sites. kValueProfKindNum is returned for any other statement.
+ValueProfKind GetValueProfSiteKind(const StmtNode &stmt);
+ValueProfKind GetValueProfSiteKind(const MeStmt &stmt);
+
 template <class Edge>
 class PGOInstrument {
  public:
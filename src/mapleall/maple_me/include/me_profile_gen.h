@@ -37,6 +37,12 @@ class MeProfGen : public PGOInstrument<BBEdge> {
   void Init();
   void InstrumentBB(BB &bb);
   void SaveProfile() const;
+  MIRSymbol *CreateProfCtrTbl(const std::string &suffix, uint32 nCtrs) const;
+  MIRSymbol *GetOrCreateTlsDecl(const std::string &name) const;
+  void InstrumentValueSites();
+  void InstrumentMemOpSite(MeStmt &stmt, MIRSymbol &ctrTbl, uint32 siteIdx) const;
+  void InstrumentIcallSite(MeStmt &stmt, MIRSymbol &ctrTbl, uint32 siteIdx) const;
+  void InstrumentIcallCallee() const;
   MeFunction *func;
   MeIRMap *hMap;
   static uint64 counterIdx;
@@ -138,6 +138,7 @@ class MeProfUse : public PGOInstrument<BBUseEdge> {
     return succCalcuAllEdgeFreq;
   }
   bool MapleProfRun();
+  bool SampleProfRun();
   void CheckSumFail(const uint64 hash, const uint32 expectedCheckSum, const std::string &tag) const;
  private:
   bool IsAllZero(Profile::BBInfo &result) const;
@@ -147,6 +148,8 @@ class MeProfUse : public PGOInstrument<BBUseEdge> {
   void InitBBEdgeInfo();
   void ComputeBBFreq(BBUseInfo &bbInfo, bool &changed) const;
   FuncProfInfo *GetFuncData() const;
+  void AttachValueProfiles(FuncProfInfo &funcData) const;
+  void ComputeSampledBBWeights(const FuncProfInfo &funcData, std::vector<FreqType> &weights) const;
 
   FreqType SumEdgesCount(const MapleVector<BBUseEdge*> &edges) const;
   BBUseInfo *GetBBUseInfo(const BB &bb) const;
@@ -541,6 +541,133 @@ class ValueRange {
   bool isAccurate = false;
 };
 
+// The value ranges recorded in one bb, keyed by expr id. The entries live in heap arrays, organized as an
+// open-addressing hash table while the recorded ids are sparse, and as an array indexed by expr id once they become
+// dense, up to kMaxDenseSize ids. An entry holding nullptr means the expr is known to have no valid value range in
+// the bb. Clear releases the value ranges and empties the arrays, Rehash moves the entries to newly allocated ones.
+class ValueRangeCache {
+ public:
+  ValueRangeCache() = default;
+  ValueRangeCache(ValueRangeCache &&other) noexcept
+      : keys(std::move(other.keys)), values(std::move(other.values)), numOfEntries(other.numOfEntries),
+        maxExprID(other.maxExprID), isDense(other.isDense) {
+    other.keys.clear();
+    other.values.clear();
+    other.numOfEntries = 0;
+  }
+  ValueRangeCache(const ValueRangeCache&) = delete;
+  ValueRangeCache &operator=(const ValueRangeCache&) = delete;
+  ~ValueRangeCache() {
+    Clear();
+  }
+
+  // return whether exprID has been recorded, the recorded value range is returned by valueRange
+  bool Find(int32 exprID, ValueRange *&valueRange) const {
+    if (numOfEntries == 0) {
+      return false;
+    }
+    size_t slot = 0;
+    if (isDense) {
+      if (static_cast<size_t>(exprID) >= keys.size() || keys[exprID] != exprID) {
+        return false;
+      }
+      slot = static_cast<size_t>(exprID);
+    } else {
+      slot = FindSlot(exprID);
+      if (keys[slot] != exprID) {
+        return false;
+      }
+    }
+    valueRange = values[slot];
+    return true;
+  }
+
+  // record the value range of exprID, the old one is released
+  void Set(int32 exprID, std::unique_ptr<ValueRange> valueRange) {
+    bool inserted = false;
+    size_t slot = FindOrInsertSlot(exprID, inserted);
+    delete values[slot];
+    values[slot] = valueRange.release();
+  }
+
+  // record the value range of exprID only if exprID has not been recorded, return whether it is recorded
+  bool Insert(int32 exprID, std::unique_ptr<ValueRange> valueRange) {
+    bool inserted = false;
+    size_t slot = FindOrInsertSlot(exprID, inserted);
+    if (inserted) {
+      values[slot] = valueRange.release();
+    }
+    return inserted;
+  }
+
+  void Clear() {
+    for (auto *valueRange : values) {
+      delete valueRange;
+    }
+    keys.clear();
+    values.clear();
+    numOfEntries = 0;
+    maxExprID = kEmptyKey;
+    isDense = false;
+  }
+
+  size_t Size() const {
+    return numOfEntries;
+  }
+
+  // visit the entries in ascending order of expr id
+  template <typename Func>
+  void ForEach(const Func &func) const {
+    std::vector<std::pair<int32, const ValueRange*>> entries;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] != kEmptyKey) {
+        entries.emplace_back(keys[i], values[i]);
+      }
+    }
+    if (!isDense) {
+      std::sort(entries.begin(), entries.end(),
+                [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    }
+    for (auto &entry : entries) {
+      func(entry.first, entry.second);
+    }
+  }
+
+ private:
+  static constexpr int32 kEmptyKey = -1;
+  static constexpr size_t kInitCapacity = 8;
+  // switch to the dense array when there are at least kMinDenseEntries entries
+  // and at least one of every kDenseRatio ids in [0, maxExprID] is recorded
+  static constexpr size_t kMinDenseEntries = 32;
+  static constexpr size_t kDenseRatio = 4;
+  // the dense array never grows beyond kMaxDenseSize ids, larger ids go back to the hash table
+  static constexpr size_t kMaxDenseSize = 1U << 16;
+
+  size_t FindSlot(int32 exprID) const {
+    size_t mask = keys.size() - 1;
+    // fibonacci hashing spreads the consecutive expr ids
+    size_t slot = (static_cast<uint32>(exprID) * 2654435761U) & mask;
+    while (keys[slot] != exprID && keys[slot] != kEmptyKey) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  bool FitsDense(size_t maxID, size_t entryNum) const {
+    return maxID < kMaxDenseSize && maxID < entryNum * kDenseRatio;
+  }
+
+  size_t FindOrInsertSlot(int32 exprID, bool &inserted);
+  void Grow();
+  void Rehash(size_t newSize);
+
+  std::vector<int32> keys;
+  std::vector<ValueRange*> values; // owned by the cache
+  size_t numOfEntries = 0;
+  int32 maxExprID = kEmptyKey;
+  bool isDense = false;
+};
+
 // return nullptr means cannot merge, intersect = true : intersection set, intersect = false : union set
 std::unique_ptr<ValueRange> MergeVR(const ValueRange &vr1, const ValueRange &vr2, bool intersect = false);
 // give expr and its value range, use irmap to create a cmp expr
@@ -555,10 +682,14 @@ class ValueRangePropagation {
                         std::map<OStIdx, std::unique_ptr<std::set<BBId>>> &candsTem, LoopScalarAnalysisResult &currSA,
                         bool dealWithAssertArg, bool onlyProp = false)
       : func(meFunc), irMap(argIRMap), dom(argDom), memPool(pool), mpAllocator(&pool), loops(argLoops),
-        caches(meFunc.GetCfg()->GetAllBBs().size()), analysisedLowerBoundChecks(meFunc.GetCfg()->GetAllBBs().size()),
-        analysisedUpperBoundChecks(meFunc.GetCfg()->GetAllBBs().size()),
-        analysisedAssignBoundChecks(meFunc.GetCfg()->GetAllBBs().size()),
+        analysisedLowerBoundChecks(meFunc.GetCfg()->GetAllBBs().size(), BoundCheckTable(mpAllocator.Adapter())),
+        analysisedUpperBoundChecks(meFunc.GetCfg()->GetAllBBs().size(), BoundCheckTable(mpAllocator.Adapter())),
+        analysisedAssignBoundChecks(meFunc.GetCfg()->GetAllBBs().size(), BoundCheckTable(mpAllocator.Adapter())),
         cands(candsTem), sa(currSA), dealWithAssert(dealWithAssertArg), onlyPropVR(onlyProp) {
+    for (size_t i = 0; i < meFunc.GetCfg()->GetAllBBs().size(); ++i) {
+      caches.emplace_back();
+      tempCaches.emplace_back();
+    }
     onlyRecordValueRangeInTempCache.push(false);
   }
   ~ValueRangePropagation() = default;
@@ -642,12 +773,15 @@ class ValueRangePropagation {
     }
   };
 
+  // map the bound of the boundary checks to their indexes
+  using BoundCheckTable = MapleMap<MeExpr*, MapleSet<MeExpr*, CompareExpr>, CompareExpr>;
+
   bool Insert2Caches(const BBId &bbID, int32 exprID, std::unique_ptr<ValueRange> valueRange,
       const MeExpr *opnd = nullptr);
 
   ValueRange *FindValueRangeInCurrentBB(BBId bbID, int32 exprID) {
-    auto it = caches.at(bbID).find(exprID);
-    return it != caches.at(bbID).end() ? it->second.get() : nullptr;
+    ValueRange *vr = nullptr;
+    return caches.at(bbID).Find(exprID, vr) ? vr : nullptr;
   }
 
   ValueRange *GetVRAfterCvt(ValueRange &vr, PrimType pty) const;
@@ -657,19 +791,12 @@ class ValueRangePropagation {
     if (numberOfRecursions++ > maxThreshold) {
       return nullptr;
     }
-    auto it = caches.at(bbID).find(exprID);
-    if (it != caches.at(bbID).end()) {
-      auto vr = it->second.get();
+    ValueRange *vr = nullptr;
+    if (caches.at(bbID).Find(exprID, vr)) {
       return (vr == nullptr) ? nullptr : GetVRAfterCvt(*vr, pty);
     }
-    if (onlyRecordValueRangeInTempCache.top()) {
-      auto itOfTemp = tempCaches.find(bbID);
-      if (itOfTemp != tempCaches.end()) {
-        auto itOfVR = itOfTemp->second.find(exprID);
-        if (itOfVR != itOfTemp->second.end()) {
-          return itOfVR->second.get();
-        }
-      }
+    if (onlyRecordValueRangeInTempCache.top() && tempCaches.at(bbID).Find(exprID, vr)) {
+      return vr;
     }
     auto *domBB = dom.GetDom(static_cast<Dominance::NodeId>(bbID.GetIdx()));
     return (domBB == nullptr || domBB->GetID() == 0) ?
@@ -679,12 +806,12 @@ class ValueRangePropagation {
   void Insert2AnalysisedArrayChecks(BBId bbID, MeExpr &array, MeExpr &index, Opcode op) {
     auto &analysisedArrayChecks = kOpcodeInfo.IsAssertLowerBoundary(op) ? analysisedLowerBoundChecks :
         kOpcodeInfo.IsAssertLeBoundary(op) ? analysisedAssignBoundChecks : analysisedUpperBoundChecks;
-    if (analysisedArrayChecks.at(bbID).empty() ||
-        analysisedArrayChecks.at(bbID).find(&array) == analysisedArrayChecks.at(bbID).end()) {
-      analysisedArrayChecks.at(bbID)[&array] = std::set<MeExpr*>{ &index };
-    } else {
-      analysisedArrayChecks.at(bbID)[&array].insert(&index);
+    auto &checks = analysisedArrayChecks.at(bbID);
+    auto it = checks.find(&array);
+    if (it == checks.end()) {
+      it = checks.emplace(&array, MapleSet<MeExpr*, CompareExpr>(mpAllocator.Adapter())).first;
     }
+    (void)it->second.insert(&index);
   }
 
   void Insert2NewMergeBB2Opnd(BB &bb, const MeExpr &opnd) {
@@ -719,10 +846,11 @@ class ValueRangePropagation {
   }
 
   void ResizeWhenCreateNewBB() {
-    caches.resize(caches.size() + 1);
-    analysisedLowerBoundChecks.resize(analysisedLowerBoundChecks.size() + 1);
-    analysisedUpperBoundChecks.resize(analysisedUpperBoundChecks.size() + 1);
-    analysisedAssignBoundChecks.resize(analysisedAssignBoundChecks.size() + 1);
+    caches.emplace_back();
+    tempCaches.emplace_back();
+    analysisedLowerBoundChecks.emplace_back(mpAllocator.Adapter());
+    analysisedUpperBoundChecks.emplace_back(mpAllocator.Adapter());
+    analysisedAssignBoundChecks.emplace_back(mpAllocator.Adapter());
   }
 
   bool IsGotoOrFallthruBB(const BB &bb) const {
@@ -972,12 +1100,13 @@ class ValueRangePropagation {
   MemPool &memPool;
   MapleAllocator mpAllocator;
   IdentifyLoops *loops;
-  std::vector<std::map<int32, std::unique_ptr<ValueRange>>> caches;
-  std::map<BBId, std::map<int32, std::unique_ptr<ValueRange>>> tempCaches;
+  std::vector<ValueRangeCache> caches; // index is bb id
+  std::vector<ValueRangeCache> tempCaches; // index is bb id
+  std::vector<BBId> usedTempCaches; // bbs whose tempCaches are not empty
   std::set<MeExpr*> lengthSet;
-  std::vector<std::map<MeExpr*, std::set<MeExpr*>>> analysisedLowerBoundChecks;
-  std::vector<std::map<MeExpr*, std::set<MeExpr*>>> analysisedUpperBoundChecks;
-  std::vector<std::map<MeExpr*, std::set<MeExpr*>>> analysisedAssignBoundChecks;
+  std::vector<BoundCheckTable> analysisedLowerBoundChecks;
+  std::vector<BoundCheckTable> analysisedUpperBoundChecks;
+  std::vector<BoundCheckTable> analysisedAssignBoundChecks;
   std::map<MeExpr*, MeExpr*> length2Def;
   std::set<BB*> unreachableBBs;
   std::map<OStIdx, std::unique_ptr<std::set<BBId>>> &cands;
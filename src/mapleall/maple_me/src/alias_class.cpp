@@ -88,14 +88,9 @@ inline BaseNode *RemoveTypeConversionIfExist(BaseNode *expr) {
   return expr;
 }
 
-// result = first - second => elements in first and not in second
-template <typename FirstOstPtrSetType, typename SecondOstPtrSetType, typename ResOstPtrSetType>
-inline void OstPtrSetSub(const FirstOstPtrSetType &first, const SecondOstPtrSetType &second, ResOstPtrSetType &result) {
-  if (second.empty()) {
-    result.insert(first.begin(), first.end());
-  } else {
-    std::set_difference(first.begin(), first.end(), second.begin(), second.end(),
-                        std::inserter(result, result.end()), OriginalSt::OriginalStPtrComparator());
+inline void AddOstsToAliasSet(const OstPtrSet &osts, AliasClass::AliasSet &ostIdxs) {
+  for (OriginalSt *ost : osts) {
+    ostIdxs.Set(ost->GetIndex());
   }
 }
 }  // namespace
@@ -1235,10 +1230,10 @@ void AliasClass::CreateAssignSets() {
         assignSetOfVst.insert(assignSetOfVst.end(), incNum, nullptr);
       }
       if (assignSetOfVst[vstIdxOfRoot] == nullptr) {
-        assignSetOfVst[vstIdxOfRoot] = acMemPool.New<AliasSet>(acAlloc.Adapter());
+        assignSetOfVst[vstIdxOfRoot] = acMemPool.New<AssignSet>(acAlloc);
       }
       assignSetOfVst[vstIdx] = assignSetOfVst[vstIdxOfRoot];
-      assignSetOfVst[vstIdxOfRoot]->insert(vstIdx);
+      assignSetOfVst[vstIdxOfRoot]->Set(static_cast<unsigned>(vstIdx));
     }
   }
 }
@@ -1287,7 +1282,9 @@ void AliasClass::GetValueAliasSetOfVst(size_t vstIdx, std::set<size_t> &result)
   if (assignSet == nullptr) {
     result.insert(vstIdx);
   } else {
-    result.insert(assignSet->begin(), assignSet->end());
+    for (auto valueAliasVstIdx : *assignSet) {
+      (void)result.insert(valueAliasVstIdx);
+    }
   }
 }
 
@@ -1759,7 +1756,7 @@ void AliasClass::ApplyUnionForStorageOverlaps() {
 
 // TBAA
 // Collect the alias groups. Each alias group is a map that maps the rootId to the ids aliasing with the root.
-void AliasClass::CollectAliasGroups(std::map<unsigned, std::set<unsigned>> &aliasGroups) {
+void AliasClass::CollectAliasGroups(MapleMap<unsigned, AliasSet*> &aliasGroups, MapleAllocator &groupAlloc) {
   // key is the root id. The set contains ids of aes that alias with the root.
   for (auto *ost : ssaTab.GetOriginalStTable()) {
     auto ostId = ost->GetIndex();
@@ -1768,11 +1765,11 @@ void AliasClass::CollectAliasGroups(std::map<unsigned, std::set<unsigned>> &alia
       continue;
     }
 
-    if (aliasGroups.find(rootID) == aliasGroups.end()) {
-      std::set<unsigned int> idsAliasWithRoot;
-      (void)aliasGroups.insert(make_pair(rootID, idsAliasWithRoot));
+    auto *&idsAliasWithRoot = aliasGroups[rootID];
+    if (idsAliasWithRoot == nullptr) {
+      idsAliasWithRoot = groupAlloc.New<AliasSet>(groupAlloc);
     }
-    (void)aliasGroups[rootID].insert(ostId);
+    idsAliasWithRoot->Set(ostId);
   }
 }
 
@@ -1844,8 +1841,7 @@ bool AliasClass::AliasAccordingToFieldID(const OriginalSt &ostA, const OriginalS
   return fieldA == ostB.GetFieldID();
 }
 
-void AliasClass::ProcessIdsAliasWithRoot(const std::set<uint32> &idsAliasWithRoot,
-                                         std::vector<uint32> &newGroups) {
+void AliasClass::ProcessIdsAliasWithRoot(const AliasSet &idsAliasWithRoot, std::vector<uint32> &newGroups) {
   for (uint32 ostIdxA : idsAliasWithRoot) {
     bool unioned = false;
     OriginalSt *ostA = ssaTab.GetOriginalStFromID(OStIdx(ostIdxA));
@@ -1868,16 +1864,17 @@ void AliasClass::ProcessIdsAliasWithRoot(const std::set<uint32> &idsAliasWithRoo
 
 void AliasClass::ReconstructAliasGroups() {
   // map the root id to the set contains the aliasElem-id that alias with the root.
-  std::map<uint32, std::set<uint32>> aliasGroups;
-  CollectAliasGroups(aliasGroups);
+  StackMemPool groupMp(memPoolCtrler, "alias groups mempool");
+  MapleAllocator groupAlloc(&groupMp);
+  MapleMap<uint32, AliasSet*> aliasGroups(groupAlloc.Adapter());
+  CollectAliasGroups(aliasGroups, groupAlloc);
   unionFind.Reinit();
   // kv.first is the root id. kv.second is the id the alias with the root.
   for (const auto &oneGroup : aliasGroups) {
     std::vector<uint32> newGroups;  // contains one id of each new alias group.
     uint32 rootId = oneGroup.first;
-    const std::set<uint32> &idsAliasWithRoot = oneGroup.second;
     newGroups.push_back(rootId);
-    ProcessIdsAliasWithRoot(idsAliasWithRoot, newGroups);
+    ProcessIdsAliasWithRoot(*oneGroup.second, newGroups);
   }
 }
 
@@ -1885,6 +1882,7 @@ void AliasClass::CollectNotAllDefsSeenAes() {
   for (auto *ost : ssaTab.GetOriginalStTable()) {
     if (IsNotAllDefsSeen(ost->GetIndex())) {
       nadsOsts.insert(ost);
+      nadsOstIdxs.Set(ost->GetIndex());
     }
   }
 }
@@ -1900,11 +1898,11 @@ void AliasClass::CreateClassSets() {
     if (unionFind.GetElementsNumber(rootID) > 1) {
       auto *aliasSet = GetAliasSet(OStIdx(rootID));
       if (aliasSet == nullptr) {
-        aliasSet = acMemPool.New<AliasSet>(acAlloc.Adapter());
+        aliasSet = acMemPool.New<AliasSet>(acAlloc);
         SetAliasSet(OStIdx(rootID), aliasSet);
       }
       SetAliasSet(ost->GetIndex(), aliasSet);
-      (void)aliasSet->insert(ost->GetIndex());
+      aliasSet->Set(ost->GetIndex());
     }
   }
   CollectNotAllDefsSeenAes();
@@ -1913,7 +1911,7 @@ void AliasClass::CreateClassSets() {
     if (unionFind.Find(ost->GetIndex()) &&
         unionFind.Root(ost->GetIndex()) == ost->GetIndex() &&
         GetAliasSet(ost->GetIndex()) != nullptr) {
-      CHECK_FATAL(GetAliasSet(ost->GetIndex())->size() == unionFind.GetElementsNumber(ost->GetIndex()),
+      CHECK_FATAL(GetAliasSet(ost->GetIndex())->Count() == unionFind.GetElementsNumber(ost->GetIndex()),
                   "AliasClass::CreateClassSets: wrong result");
     }
   }
@@ -1934,7 +1932,7 @@ void AliasClass::DumpClassSets(bool onlyDumpRoot) {
     }
 
     auto *aliasSet = GetAliasSet(*ost);
-    if (aliasSet == nullptr || aliasSet->size() == 1) {
+    if (aliasSet == nullptr || aliasSet->Count() == 1) {
       LogInfo::MapleLogger() << "Alone: ";
       ost->Dump();
       if (IsNotAllDefsSeen(ostIdx)) {
@@ -2050,7 +2048,7 @@ bool AliasClass::MayAlias(const OriginalSt *ostA, const OriginalSt *ostB) const
   if (aliasSet == nullptr) {
     return false;
   }
-  return (aliasSet->find(ostB->GetIndex()) != aliasSet->end());
+  return aliasSet->Test(ostB->GetIndex());
 }
 
 // here starts pass 2 code
@@ -2105,6 +2103,14 @@ void AliasClass::InsertMayUseNode(OstPtrSet &mayUseOsts, AccessSSANodes *ssaPart
   }
 }
 
+void AliasClass::InsertMayUseNode(const AliasSet &mayUseOstIdxs, AccessSSANodes *ssaPart) {
+  for (uint32 ostIdx : mayUseOstIdxs) {
+    OriginalSt *ost = ssaTab.GetOriginalStFromID(OStIdx(ostIdx));
+    ssaPart->InsertMayUseNode(MayUseNode(
+        ssaTab.GetVersionStTable().GetVersionStVectorItem(ost->GetZeroVersionIndex())));
+  }
+}
+
 void AliasClass::CollectMayUseFromFormals(OstPtrSet &mayUseOsts, bool needToBeRestrict) {
   auto *curFunc = mirModule.CurFunction();
   for (size_t formalId = 0; formalId < curFunc->GetFormalCount(); ++formalId) {
@@ -2263,6 +2269,16 @@ void AliasClass::InsertMayDefNode(OstPtrSet &mayDefOsts, AccessSSANodes *ssaPart
   }
 }
 
+void AliasClass::InsertMayDefNode(const AliasSet &mayDefOstIdxs, AccessSSANodes *ssaPart,
+                                  StmtNode &stmt, BBId bbid) {
+  for (uint32 ostIdx : mayDefOstIdxs) {
+    OriginalSt *mayDefOst = ssaTab.GetOriginalStFromID(OStIdx(ostIdx));
+    ssaPart->InsertMayDefNode(MayDefNode(
+        ssaTab.GetVersionStTable().GetVersionStVectorItem(mayDefOst->GetZeroVersionIndex()), &stmt));
+    ssaTab.AddDefBB4Ost(mayDefOst->GetIndex(), bbid);
+  }
+}
+
 void AliasClass::InsertMayDefDassign(StmtNode &stmt, BBId bbid) {
   OstPtrSet mayDefOsts;
   CollectMayDefForDassign(stmt, mayDefOsts);
@@ -2296,7 +2312,7 @@ bool AliasClass::IsAliasInfoEquivalentToExpr(const AliasInfo &ai, const BaseNode
   }
 }
 
-void AliasClass::CollectMayDefForIassign(StmtNode &stmt, OstPtrSet &mayDefOsts) {
+void AliasClass::CollectMayDefForIassign(StmtNode &stmt, AliasSet &mayDefOstIdxs) {
   auto &iassignNode = static_cast<IassignNode&>(stmt);
   bool isNextLevelArrayType = iassignNode.GetLHSType()->GetKind() == kTypeArray;
   VersionSt *lhsVst = FindOrCreateVstOfExtraLevOst(
@@ -2307,7 +2323,7 @@ void AliasClass::CollectMayDefForIassign(StmtNode &stmt, OstPtrSet &mayDefOsts)
 
   // lhsAe does not alias with any aliasElem
   if (aliasSet == nullptr) {
-    (void)mayDefOsts.insert(ostOfLhs);
+    mayDefOstIdxs.Set(ostOfLhs->GetIndex());
     return;
   }
 
@@ -2336,7 +2352,7 @@ void AliasClass::CollectMayDefForIassign(StmtNode &stmt, OstPtrSet &mayDefOsts)
         continue;
       }
     }
-    (void)mayDefOsts.insert(aliasedOst);
+    mayDefOstIdxs.Set(aliasOstIdx);
   }
 }
 
@@ -2352,14 +2368,28 @@ void AliasClass::InsertMayDefNodeExcludeFinalOst(OstPtrSet &mayDefOsts,
   }
 }
 
+void AliasClass::InsertMayDefNodeExcludeFinalOst(const AliasSet &mayDefOstIdxs, AccessSSANodes *ssaPart,
+                                                 StmtNode &stmt, BBId bbid) {
+  for (uint32 ostIdx : mayDefOstIdxs) {
+    OriginalSt *mayDefOst = ssaTab.GetOriginalStFromID(OStIdx(ostIdx));
+    if (!mayDefOst->IsFinal()) {
+      ssaPart->InsertMayDefNode(MayDefNode(
+          ssaTab.GetVersionStTable().GetVersionStVectorItem(mayDefOst->GetZeroVersionIndex()), &stmt));
+      ssaTab.AddDefBB4Ost(mayDefOst->GetIndex(), bbid);
+    }
+  }
+}
+
 void AliasClass::InsertMayDefIassign(StmtNode &stmt, BBId bbid) {
-  OstPtrSet mayDefOsts;
-  CollectMayDefForIassign(stmt, mayDefOsts);
+  StackMemPool localMp(memPoolCtrler, "iassign maydef mempool");
+  MapleAllocator localAlloc(&localMp);
+  AliasSet mayDefOstIdxs(localAlloc);
+  CollectMayDefForIassign(stmt, mayDefOstIdxs);
   auto *ssaPart = ssaTab.GetStmtsSSAPart().SSAPartOf(stmt);
-  if (mayDefOsts.size() == 1) {
-    InsertMayDefNode(mayDefOsts, ssaPart, stmt, bbid);
+  if (mayDefOstIdxs.Count() == 1) {
+    InsertMayDefNode(mayDefOstIdxs, ssaPart, stmt, bbid);
   } else {
-    InsertMayDefNodeExcludeFinalOst(mayDefOsts, ssaPart, stmt, bbid);
+    InsertMayDefNodeExcludeFinalOst(mayDefOstIdxs, ssaPart, stmt, bbid);
   }
 
   TypeOfMayDefList &mayDefNodes = ssaTab.GetStmtsSSAPart().GetMayDefNodesOf(stmt);
@@ -2375,8 +2405,10 @@ void AliasClass::InsertMayDefIassign(StmtNode &stmt, BBId bbid) {
 }
 
 void AliasClass::InsertMayDefUseSyncOps(StmtNode &stmt, BBId bbid) {
-  std::set<uint32> aliasSet;
-  // collect the full alias set first
+  StackMemPool localMp(memPoolCtrler, "sync ops alias mempool");
+  MapleAllocator localAlloc(&localMp);
+  AliasSet aliasSet(localAlloc);
+  // collect the full alias set first, alias classes are merged word by word
   for (size_t i = 0; i < stmt.NumOpnds(); ++i) {
     BaseNode *addrBase = stmt.Opnd(i);
     if (addrBase->IsSSANode()) {
@@ -2386,9 +2418,7 @@ void AliasClass::InsertMayDefUseSyncOps(StmtNode &stmt, BBId bbid) {
         if (aliasSetOfCurOSt == nullptr) {
           return;
         }
-        for (uint32 aliasOstIdx : *aliasSetOfCurOSt) {
-          aliasSet.insert(aliasOstIdx);
-        }
+        (void)(aliasSet |= *aliasSetOfCurOSt);
       };
 
       if (addrBase->GetOpCode() == OP_addrof) {
@@ -2402,9 +2432,7 @@ void AliasClass::InsertMayDefUseSyncOps(StmtNode &stmt, BBId bbid) {
         }
       }
     } else {
-      for (auto *nadsOst : nadsOsts) {
-        aliasSet.insert(nadsOst->GetIndex());
-      }
+      (void)(aliasSet |= nadsOstIdxs);
     }
   }
   // do the insertion according to aliasSet
@@ -2519,16 +2547,18 @@ void AliasClass::CollectMayDefUseForIthOpnd(const VersionSt &vstOfIthOpnd, OstPt
 }
 
 void AliasClass::CollectMayUseForIntrnCallOpnd(const StmtNode &stmt,
-                                               OstPtrSet &mayDefOsts, OstPtrSet &mayUseOsts) {
+                                               AliasSet &mayDefOstIdxs, AliasSet &mayUseOstIdxs) {
   auto &intrinNode = static_cast<const IntrinsiccallNode&>(stmt);
   IntrinDesc *intrinDesc = &IntrinDesc::intrinTable[intrinNode.GetIntrinsic()];
   if (intrinDesc->IsMemoryBarrier()) {
     // No matter which memorder is selected or whether the atomic operation defines ost or not,
     // args or globals will be considered as being rewritten by other threads and hence need to be reloaded
-    CollectMayUseFromGlobalsAffectedByCalls(mayDefOsts);
-    CollectMayUseFromFormals(mayDefOsts, false);
-    mayDefOsts.insert(nadsOsts.begin(), nadsOsts.end());
-    mayUseOsts.insert(nadsOsts.begin(), nadsOsts.end());
+    OstPtrSet rewrittenOsts;
+    CollectMayUseFromGlobalsAffectedByCalls(rewrittenOsts);
+    CollectMayUseFromFormals(rewrittenOsts, false);
+    AddOstsToAliasSet(rewrittenOsts, mayDefOstIdxs);
+    (void)(mayDefOstIdxs |= nadsOstIdxs);
+    (void)(mayUseOstIdxs |= nadsOstIdxs);
   }
   for (uint32 opndId = 0; opndId < stmt.NumOpnds(); ++opndId) {
     BaseNode *expr = stmt.Opnd(opndId);
@@ -2546,10 +2576,10 @@ void AliasClass::CollectMayUseForIntrnCallOpnd(const StmtNode &stmt,
     OstPtrSet mayDefUseOsts;
     CollectMayDefUseForIthOpnd(*vst, mayDefUseOsts, stmt, opndId == 0);
     if (intrinDesc->WriteNthOpnd(opndId)) {
-      mayDefOsts.insert(mayDefUseOsts.begin(), mayDefUseOsts.end());
+      AddOstsToAliasSet(mayDefUseOsts, mayDefOstIdxs);
     }
     if (intrinDesc->ReadNthOpnd(opndId)) {
-      mayUseOsts.insert(mayDefUseOsts.begin(), mayDefUseOsts.end());
+      AddOstsToAliasSet(mayDefUseOsts, mayUseOstIdxs);
     }
   }
 }
@@ -2607,10 +2637,24 @@ void AliasClass::CollectMayDefUseForCallOpnd(const StmtNode &stmt,
   }
 }
 
-void AliasClass::InsertMayDefNodeForCall(OstPtrSet &mayDefOsts, AccessSSANodes *ssaPart,
+// ostIdxs |= nadsOsts - excludedOsts
+void AliasClass::UnionNadsExcept(const OstPtrSet &excludedOsts, AliasSet &ostIdxs, MapleAllocator &localAlloc) const {
+  if (excludedOsts.empty()) {
+    (void)(ostIdxs |= nadsOstIdxs);
+    return;
+  }
+  AliasSet excludedOstIdxs(localAlloc);
+  AddOstsToAliasSet(excludedOsts, excludedOstIdxs);
+  AliasSet nadsOstIdxsLeft(nadsOstIdxs, localAlloc);
+  (void)nadsOstIdxsLeft.Diff(excludedOstIdxs);
+  (void)(ostIdxs |= nadsOstIdxsLeft);
+}
+
+void AliasClass::InsertMayDefNodeForCall(const AliasSet &mayDefOstIdxs, AccessSSANodes *ssaPart,
                                          StmtNode &stmt, BBId bbid,
                                          bool hasNoPrivateDefEffect) {
-  for (OriginalSt *mayDefOst : mayDefOsts) {
+  for (uint32 ostIdx : mayDefOstIdxs) {
+    OriginalSt *mayDefOst = ssaTab.GetOriginalStFromID(OStIdx(ostIdx));
     if (!hasNoPrivateDefEffect || !mayDefOst->IsPrivate()) {
       ssaPart->InsertMayDefNode(MayDefNode(
           ssaTab.GetVersionStTable().GetVersionStVectorItem(mayDefOst->GetZeroVersionIndex()), &stmt));
@@ -2631,25 +2675,33 @@ void AliasClass::InsertMayDefUseCall(StmtNode &stmt, BBId bbid, bool isDirectCal
     hasSideEffect = desc->GetFuncInfo() < FI::kNoDirectGlobleAccess;
   }
   auto *ssaPart = ssaTab.GetStmtsSSAPart().SSAPartOf(stmt);
-  OstPtrSet mayDefOstsA;
-  OstPtrSet mayUseOstsA;
+  StackMemPool localMp(memPoolCtrler, "call alias mempool");
+  MapleAllocator localAlloc(&localMp);
+  AliasSet mayDefOstIdxsA(localAlloc);
+  AliasSet mayUseOstIdxsA(localAlloc);
   OstPtrSet mustNotDefOsts;
   OstPtrSet mustNotUseOsts;
   bool mayUseNads = desc == nullptr || (!desc->NoDirectGlobleAccess() && !desc->IsConst());
   bool mayDefNads = hasSideEffect;
   // 1. collect mayDefs and mayUses caused by callee-opnds
-  CollectMayDefUseForCallOpnd(stmt, mayDefOstsA, mayUseOstsA, mustNotDefOsts, mustNotUseOsts);
+  {
+    OstPtrSet mayDefOstsA;
+    OstPtrSet mayUseOstsA;
+    CollectMayDefUseForCallOpnd(stmt, mayDefOstsA, mayUseOstsA, mustNotDefOsts, mustNotUseOsts);
+    AddOstsToAliasSet(mayDefOstsA, mayDefOstIdxsA);
+    AddOstsToAliasSet(mayUseOstsA, mayUseOstIdxsA);
+  }
   // 2. collect mayDefs and mayUses caused by not_all_def_seen_ae
   if (mayUseNads) {
-    OstPtrSetSub(nadsOsts, mustNotUseOsts, mayUseOstsA);
+    UnionNadsExcept(mustNotUseOsts, mayUseOstIdxsA, localAlloc);
   }
   if (mayDefNads) {
-    OstPtrSetSub(nadsOsts, mustNotDefOsts, mayDefOstsA);
+    UnionNadsExcept(mustNotDefOsts, mayDefOstIdxsA, localAlloc);
   }
   // insert mayuse node caused by opnd and not_all_def_seen_ae.
-  InsertMayUseNode(mayUseOstsA, ssaPart);
+  InsertMayUseNode(mayUseOstIdxsA, ssaPart);
   // insert maydef node caused by opnd and not_all_def_seen_ae.
-  InsertMayDefNodeForCall(mayDefOstsA, ssaPart, stmt, bbid, hasNoPrivateDefEffect);
+  InsertMayDefNodeForCall(mayDefOstIdxsA, ssaPart, stmt, bbid, hasNoPrivateDefEffect);
 
   // 3. insert mayDefs and mayUses caused by globalsAffectedByCalls
   OstPtrSet mayDefUseOfGOsts;
@@ -2669,9 +2721,10 @@ void AliasClass::InsertMayDefUseCall(StmtNode &stmt, BBId bbid, bool isDirectCal
   }
 }
 
-void AliasClass::InsertMayUseNodeExcludeFinalOst(const OstPtrSet &mayUseOsts,
+void AliasClass::InsertMayUseNodeExcludeFinalOst(const AliasSet &mayUseOstIdxs,
                                                  AccessSSANodes *ssaPart) {
-  for (OriginalSt *mayUseOst : mayUseOsts) {
+  for (uint32 ostIdx : mayUseOstIdxs) {
+    OriginalSt *mayUseOst = ssaTab.GetOriginalStFromID(OStIdx(ostIdx));
     if (!mayUseOst->IsFinal()) {
       ssaPart->InsertMayUseNode(MayUseNode(
           ssaTab.GetVersionStTable().GetVersionStVectorItem(mayUseOst->GetZeroVersionIndex())));
@@ -2684,24 +2737,28 @@ void AliasClass::InsertMayUseNodeExcludeFinalOst(const OstPtrSet &mayUseOsts,
 // opnds, not_all_def_seen_ae, globalsAffectedByCalls, and mustDefs.
 void AliasClass::InsertMayDefUseIntrncall(StmtNode &stmt, BBId bbid) {
   auto *ssaPart = ssaTab.GetStmtsSSAPart().SSAPartOf(stmt);
-  OstPtrSet mayUseOsts;
-  OstPtrSet mayDefOsts;
+  StackMemPool localMp(memPoolCtrler, "intrinsiccall alias mempool");
+  MapleAllocator localAlloc(&localMp);
+  AliasSet mayUseOstIdxs(localAlloc);
+  AliasSet mayDefOstIdxs(localAlloc);
   // 1. collect mayDefs and mayUses caused by opnds
   if (!mirModule.IsCModule()) {
     for (uint32 i = 0; i < stmt.NumOpnds(); ++i) {
       InsertMayUseExpr(*stmt.Opnd(i));
     }
-    CollectMayUseFromGlobalsAffectedByCalls(mayUseOsts);
+    OstPtrSet globalOsts;
+    CollectMayUseFromGlobalsAffectedByCalls(globalOsts);
+    AddOstsToAliasSet(globalOsts, mayUseOstIdxs);
     auto &intrinNode = static_cast<const IntrinsiccallNode&>(stmt);
     IntrinDesc *intrinDesc = &IntrinDesc::intrinTable[intrinNode.GetIntrinsic()];
     if (!intrinDesc->HasNoSideEffect()) {
-      CollectMayUseFromGlobalsAffectedByCalls(mayDefOsts);
+      AddOstsToAliasSet(globalOsts, mayDefOstIdxs);
     }
   } else {
-    CollectMayUseForIntrnCallOpnd(stmt, mayDefOsts, mayUseOsts);
+    CollectMayUseForIntrnCallOpnd(stmt, mayDefOstIdxs, mayUseOstIdxs);
   }
-  InsertMayUseNodeExcludeFinalOst(mayUseOsts, ssaPart);
-  InsertMayDefNodeExcludeFinalOst(mayDefOsts, ssaPart, stmt, bbid);
+  InsertMayUseNodeExcludeFinalOst(mayUseOstIdxs, ssaPart);
+  InsertMayDefNodeExcludeFinalOst(mayDefOstIdxs, ssaPart, stmt, bbid);
 
   if (kOpcodeInfo.IsCallAssigned(stmt.GetOpCode())) {
     // 4. insert maydefs caused by the mustdefs
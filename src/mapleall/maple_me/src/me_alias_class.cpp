@@ -67,17 +67,15 @@ void MeAliasClass::PerformTBAAForC() {
         alias = TypeBasedAliasAnalysis::MayAliasTBAAForC(ost, aliasedOst);
       } else {
         auto aliasSetOfAliasedOst = GetAliasSet(OStIdx(aliasedOstIdx));
-        alias = aliasSetOfAliasedOst == nullptr ||
-                (aliasSetOfAliasedOst->find(ost->GetIndex()) != aliasSetOfAliasedOst->end());
+        alias = aliasSetOfAliasedOst == nullptr || aliasSetOfAliasedOst->Test(ost->GetIndex());
       }
       if (alias) {
         continue;
       }
       if (newAliasSet == nullptr) {
-        newAliasSet = GetMapleAllocator().GetMemPool()->New<AliasSet>(GetMapleAllocator().Adapter());
-        newAliasSet->insert(oldAliasSet->cbegin(), oldAliasSet->cend());
+        newAliasSet = GetMapleAllocator().GetMemPool()->New<AliasSet>(*oldAliasSet, GetMapleAllocator());
       }
-      (void)newAliasSet->erase(aliasedOstIdx);
+      newAliasSet->Reset(aliasedOstIdx);
     }
     if (newAliasSet != nullptr) {
       SetAliasSet(ost->GetIndex(), newAliasSet);
@@ -110,16 +108,13 @@ void MeAliasClass::PerformDemandDrivenAliasAnalysis() {
           alias = ddAlias.MayAlias(ost, aliasedOst);
         } else {
           auto aliasSetOfAliasedOst = GetAliasSet(OStIdx(aliasedOstIdx));
-          alias = aliasSetOfAliasedOst == nullptr ||
-                  (aliasSetOfAliasedOst->find(ost->GetIndex()) != aliasSetOfAliasedOst->end());
+          alias = aliasSetOfAliasedOst == nullptr || aliasSetOfAliasedOst->Test(ost->GetIndex());
         }
         if (!alias) {
           if (newAliasSet == nullptr) {
-            newAliasSet =
-                GetMapleAllocator().GetMemPool()->New<AliasSet>(GetMapleAllocator().Adapter());
-            newAliasSet->insert(oldAliasSet->cbegin(), oldAliasSet->cend());
+            newAliasSet = GetMapleAllocator().GetMemPool()->New<AliasSet>(*oldAliasSet, GetMapleAllocator());
           }
-          newAliasSet->erase(aliasedOstIdx);
+          newAliasSet->Reset(aliasedOstIdx);
         }
       }
       if (newAliasSet != nullptr) {
@@ -137,6 +137,7 @@ bool MeOption::enableLFO = true;
 uint8 MeOption::rematLevel = 2;
 bool MeOption::layoutWithPredict = true;  // optimize output layout using branch prediction
 bool MeOption::layoutColdPath = false;  // layout cold blocks (such as unlikely) out of hot path
+bool MeOption::layoutExtTsp = false;  // order blocks by ext-TSP score instead of building chains greedily
 SafetyCheckMode MeOption::npeCheckMode = SafetyCheckMode::kNoCheck;
 bool MeOption::isNpeCheckAll = false;
 SafetyCheckMode MeOption::boundaryCheckMode = SafetyCheckMode::kNoCheck;
@@ -436,6 +437,7 @@ bool MeOption::SolveOptions(bool isDebug) {
   maplecl::CopyIfEnabled(rematLevel, opts::me::remat);
   maplecl::CopyIfEnabled(layoutWithPredict, opts::me::layoutwithpredict);
   maplecl::CopyIfEnabled(layoutColdPath, opts::me::layoutColdPath);
+  maplecl::CopyIfEnabled(layoutExtTsp, opts::me::layoutExtTsp);
   maplecl::CopyIfEnabled(vecLoopLimit, opts::me::veclooplimit);
   maplecl::CopyIfEnabled(ivoptsLimit, opts::me::ivoptslimit);
   maplecl::CopyIfEnabled(unifyRets, opts::me::unifyrets);
@@ -528,6 +528,12 @@ maplecl::Option<bool> layoutColdPath({"--layout-cold-path"},
     "  --no-layout-cold-path       \tDisable layouting cold blocks (such as unlikely) out of hot path\n",
     {meCategory}, maplecl::DisableWith("--no-layout-cold-path"));
 
+maplecl::Option<bool> layoutExtTsp({"--layout-ext-tsp"},
+    "  --layout-ext-tsp            \tOrder blocks by ext-TSP score (fallthroughs and short jumps weighted by\n"
+    "                              \tedge frequency) in the layout with prediction\n"
+    "  --no-layout-ext-tsp         \tBuild block chains greedily in the layout with prediction\n",
+    {meCategory}, maplecl::DisableWith("--no-layout-ext-tsp"));
+
 maplecl::Option<uint32_t> veclooplimit({"--veclooplimit"},
     "  --veclooplimit              \tApply vectorize loops only up to NUM \n"
     "                              \t--veclooplimit=NUM\n",
@@ -596,7 +602,8 @@ maplecl::Option<bool> epreUseProfile({"--epreuseprofile"},
 #ifdef ENABLE_MAPLE_SAN
 maplecl::Option<uint32_t> asanFlags({"--sanitizer", "--san", "-san"},
     "  --sanitizer=FLAGS           \tEnable instrumenting sanitizer according to the given FLAGS\n"
-    "  --sanitizer=0               \tDisable instrumenting sanitizer\n",
+    "  --sanitizer=0               \tDisable instrumenting sanitizer\n"
+    "                              \tFLAGS bit 0x08 keeps every sanitizer check (no redundant check elimination)\n",
     {meCategory});
 #endif
 }
@@ -32,9 +32,69 @@
  * The count of edge on spanning tree can be derived from
  * those edges not on the spanning tree. Knuth proves this method instruments
  * the minimum number of edges.
+ *
+ * With --profile-values, the callees of indirect calls and the sizes of memcpy/memset are profiled as well, by the
+ * value profilers of libgcov (GCC 7.5 ABI): the interval profiler for sizes, and the topn indirect call profiler,
+ * where the caller publishes its counters and the called address in thread local variables and each function
+ * records its profile id at entry if it is the published callee.
  */
 
 namespace maple {
+namespace {
+constexpr char kGcovIntervalProfiler[] = "__gcov_interval_profiler";
+constexpr char kGcovIcallTopNProfiler[] = "__gcov_indirect_call_topn_profiler";
+constexpr char kGcovIcallTopNCounters[] = "__gcov_indirect_call_topn_counters";
+constexpr char kGcovIcallTopNCallee[] = "__gcov_indirect_call_topn_callee";
+constexpr size_t kMemOpSizeOpndIdx = 2;  // memcpy(dst, src, size) and memset(dst, val, size)
+
+bool IsProfiledMemOpFunc(PUIdx puIdx) {
+  const std::string &name = GlobalTables::GetFunctionTable().GetFunctionFromPuidx(puIdx)->GetName();
+  return name == "memcpy" || name == "memset";
+}
+
+bool IsProfiledMemOpIntrinsic(MIRIntrinsicID intrinsic) {
+  return intrinsic == INTRN_C_memcpy || intrinsic == INTRN_C_memset;
+}
+
+bool IsIcallOp(Opcode op) {
+  return op == OP_icall || op == OP_icallassigned || op == OP_icallproto || op == OP_icallprotoassigned;
+}
+}  // namespace
+
+ValueProfKind GetValueProfSiteKind(const StmtNode &stmt) {
+  Opcode op = stmt.GetOpCode();
+  if (IsIcallOp(op)) {
+    return kValueProfIcallTopN;
+  }
+  bool isMemOp = false;
+  if (op == OP_call || op == OP_callassigned) {
+    isMemOp = IsProfiledMemOpFunc(static_cast<const CallNode&>(stmt).GetPUIdx());
+  } else if (op == OP_intrinsiccall) {
+    isMemOp = IsProfiledMemOpIntrinsic(static_cast<const IntrinsiccallNode&>(stmt).GetIntrinsic());
+  }
+  if (!isMemOp || stmt.NumOpnds() <= kMemOpSizeOpndIdx) {
+    return kValueProfKindNum;
+  }
+  return stmt.Opnd(kMemOpSizeOpndIdx)->GetOpCode() == OP_constval ? kValueProfKindNum : kValueProfMemOpSize;
+}
+
+ValueProfKind GetValueProfSiteKind(const MeStmt &stmt) {
+  Opcode op = stmt.GetOp();
+  if (IsIcallOp(op)) {
+    return kValueProfIcallTopN;
+  }
+  bool isMemOp = false;
+  if (op == OP_call || op == OP_callassigned) {
+    isMemOp = IsProfiledMemOpFunc(static_cast<const CallMeStmt&>(stmt).GetPUIdx());
+  } else if (op == OP_intrinsiccall) {
+    isMemOp = IsProfiledMemOpIntrinsic(static_cast<const IntrinsiccallMeStmt&>(stmt).GetIntrinsic());
+  }
+  if (!isMemOp || stmt.NumMeStmtOpnds() <= kMemOpSizeOpndIdx) {
+    return kValueProfKindNum;
+  }
+  return stmt.GetOpnd(kMemOpSizeOpndIdx)->GetMeOp() == kMeOpConst ? kValueProfKindNum : kValueProfMemOpSize;
+}
+
 uint64 MeProfGen::counterIdx = 0;
 uint64 MeProfGen::totalBB = 0;
 uint64 MeProfGen::instrumentBB = 0;
@@ -99,6 +159,123 @@ void MeProfGen::SaveProfile() const {
   }
 }
 
+MIRSymbol *MeProfGen::CreateProfCtrTbl(const std::string &suffix, uint32 nCtrs) const {
+  MIRType *arrOfInt64Ty =
+      GlobalTables::GetTypeTable().GetOrCreateArrayType(*GlobalTables::GetTypeTable().GetInt64(), nCtrs);
+  // flatten the counter table name
+  std::string ctrTblName = namemangler::kprefixProfCtrTbl +
+                           func->GetMIRModule().GetFileName() + "_" +
+                           func->GetMirFunc()->GetName() + suffix;
+  std::replace(ctrTblName.begin(), ctrTblName.end(), '.', '_');
+  std::replace(ctrTblName.begin(), ctrTblName.end(), '-', '_');
+  std::replace(ctrTblName.begin(), ctrTblName.end(), '/', '_');
+
+  MIRSymbol *ctrTblSym = func->GetMIRModule().GetMIRBuilder()->CreateGlobalDecl(ctrTblName, *arrOfInt64Ty, kScFstatic);
+  ctrTblSym->SetSKind(kStVar);
+  return ctrTblSym;
+}
+
+// thread local variable of libgcov
+MIRSymbol *MeProfGen::GetOrCreateTlsDecl(const std::string &name) const {
+  MIRSymbol *sym = func->GetMIRModule().GetMIRBuilder()->GetOrCreateGlobalDecl(
+      name, *GlobalTables::GetTypeTable().GetPtr());
+  sym->SetStorageClass(kScExtern);
+  sym->SetAttr(ATTR_tls_static);
+  return sym;
+}
+
+// __gcov_interval_profiler(&ctrs[site], size, 0, kMemOpSizeSteps)
+void MeProfGen::InstrumentMemOpSite(MeStmt &stmt, MIRSymbol &ctrTbl, uint32 siteIdx) const {
+  MIRFunction *profiler = func->GetMIRModule().GetMIRBuilder()->GetOrCreateFunction(kGcovIntervalProfiler,
+                                                                                     TyIdx(PTY_void));
+  int64 offset = static_cast<int64>(siteIdx) * kMemOpSizeCounters * GetPrimTypeSize(PTY_i64);
+  MeExpr *ctrTblAddr = hMap->CreateAddrofMeExprFromSymbol(ctrTbl, func->GetMirFunc()->GetPuidx());
+  MeExpr *ctrs = hMap->CreateMeExprBinary(OP_add, PTY_ptr, *ctrTblAddr, *hMap->CreateIntConstMeExpr(offset, PTY_ptr));
+  MeExpr *size = stmt.GetOpnd(kMemOpSizeOpndIdx);
+  if (size->GetPrimType() != PTY_i64) {
+    size = hMap->CreateMeExprTypeCvt(PTY_i64, size->GetPrimType(), *size);
+  }
+  auto *profCall = hMap->NewInPool<CallMeStmt>(OP_call, profiler->GetPuidx());
+  profCall->PushBackOpnd(ctrs);
+  profCall->PushBackOpnd(size);
+  profCall->PushBackOpnd(hMap->CreateIntConstMeExpr(0, PTY_i32));
+  profCall->PushBackOpnd(hMap->CreateIntConstMeExpr(kMemOpSizeSteps, PTY_u32));
+  profCall->SetSrcPos(stmt.GetSrcPosition());
+  stmt.GetBB()->InsertMeStmtBefore(&stmt, profCall);
+}
+
+// __gcov_indirect_call_topn_counters = &ctrs[site]; __gcov_indirect_call_topn_callee = fp
+void MeProfGen::InstrumentIcallSite(MeStmt &stmt, MIRSymbol &ctrTbl, uint32 siteIdx) const {
+  int64 offset = static_cast<int64>(siteIdx) * kIcallTopNCounters * GetPrimTypeSize(PTY_i64);
+  MeExpr *ctrTblAddr = hMap->CreateAddrofMeExprFromSymbol(ctrTbl, func->GetMirFunc()->GetPuidx());
+  MeExpr *ctrs = hMap->CreateMeExprBinary(OP_add, PTY_ptr, *ctrTblAddr, *hMap->CreateIntConstMeExpr(offset, PTY_ptr));
+  std::pair<const char*, MeExpr*> stores[] = {
+      { kGcovIcallTopNCounters, ctrs }, { kGcovIcallTopNCallee, stmt.GetOpnd(0) } };
+  for (auto &store : stores) {
+    MIRSymbol *tlsSym = GetOrCreateTlsDecl(store.first);
+    OriginalSt *ost = func->GetMeSSATab()->FindOrCreateSymbolOriginalSt(*tlsSym, func->GetMirFunc()->GetPuidx(), 0);
+    VarMeExpr *lhs = hMap->CreateVarMeExprVersion(ost);
+    AssignMeStmt *assign = hMap->CreateAssignMeStmt(*lhs, *store.second, *stmt.GetBB());
+    assign->SetSrcPos(stmt.GetSrcPosition());
+    stmt.GetBB()->InsertMeStmtBefore(&stmt, assign);
+  }
+}
+
+// __gcov_indirect_call_topn_profiler(profileId, &self) at function entry
+void MeProfGen::InstrumentIcallCallee() const {
+  MeCFG *cfg = func->GetCfg();
+  BB *entryBB = cfg->GetFirstBB();
+  // the profiler must run once per call, not on every iteration of a loop starting at the entry
+  if (entryBB == nullptr || std::any_of(entryBB->GetPred().begin(), entryBB->GetPred().end(),
+                                        [cfg](const BB *pred) { return pred != cfg->GetCommonEntryBB(); })) {
+    return;
+  }
+  MIRFunction *profiler = func->GetMIRModule().GetMIRBuilder()->GetOrCreateFunction(kGcovIcallTopNProfiler,
+                                                                                     TyIdx(PTY_void));
+  MIRFunction *mirFunc = func->GetMirFunc();
+  auto *profCall = hMap->NewInPool<CallMeStmt>(OP_call, profiler->GetPuidx());
+  profCall->PushBackOpnd(hMap->CreateIntConstMeExpr(GetValueProfFuncId(mirFunc->GetName()), PTY_i64));
+  profCall->PushBackOpnd(hMap->CreateAddroffuncMeExpr(mirFunc->GetPuidx()));
+  entryBB->AddMeStmtFirst(profCall);
+}
+
+void MeProfGen::InstrumentValueSites() {
+  std::array<std::vector<MeStmt*>, kValueProfKindNum> sites;
+  MeCFG *cfg = func->GetCfg();
+  auto eIt = cfg->valid_end();
+  for (auto bIt = cfg->valid_begin(); bIt != eIt; ++bIt) {
+    if (bIt == cfg->common_entry() || bIt == cfg->common_exit()) {
+      continue;
+    }
+    for (auto &stmt : (*bIt)->GetMeStmts()) {
+      ValueProfKind kind = GetValueProfSiteKind(stmt);
+      if (kind != kValueProfKindNum) {
+        sites[kind].push_back(&stmt);
+      }
+    }
+  }
+  const char *ctrTblSuffix[kValueProfKindNum] = { "_memop", "_icall" };
+  for (uint32 kind = 0; kind < kValueProfKindNum; ++kind) {
+    if (sites[kind].empty()) {
+      continue;
+    }
+    uint32 nCtrs = static_cast<uint32>(sites[kind].size()) * GetValueProfSiteCounterNum(ValueProfKind(kind));
+    MIRSymbol *ctrTbl = CreateProfCtrTbl(ctrTblSuffix[kind], nCtrs);
+    func->GetMirFunc()->SetValueProfCtrTbl(kind, ctrTbl, nCtrs);
+    for (uint32 i = 0; i < sites[kind].size(); ++i) {
+      if (kind == kValueProfMemOpSize) {
+        InstrumentMemOpSite(*sites[kind][i], *ctrTbl, i);
+      } else {
+        InstrumentIcallSite(*sites[kind][i], *ctrTbl, i);
+      }
+    }
+    if (dump) {
+      LogInfo::MapleLogger() << "value profile kind " << kind << ": " << sites[kind].size() << " sites\n";
+    }
+  }
+  InstrumentIcallCallee();
+}
+
 void MeProfGen::InstrumentFunc() {
   FindInstrumentEdges();
   std::vector<BB*> instrumentBBs;
@@ -106,23 +283,13 @@ void MeProfGen::InstrumentFunc() {
 
   if (Options::profileGen) {
     counterIdx = 0;
-    MIRModule *mod = func->GetMirFunc()->GetModule();
     uint32 nCtrs = static_cast<uint32>(instrumentBBs.size());
     func->GetMirFunc()->SetNumCtrs(nCtrs);
     if (nCtrs != 0) {
-      MIRType *arrOfInt64Ty =
-          GlobalTables::GetTypeTable().GetOrCreateArrayType(*GlobalTables::GetTypeTable().GetInt64(), nCtrs);
-      // flatten the counter table name
-      std::string ctrTblName = namemangler::kprefixProfCtrTbl +
-                               func->GetMIRModule().GetFileName() + "_" +
-                               func->GetMirFunc()->GetName();
-      std::replace(ctrTblName.begin(), ctrTblName.end(), '.', '_');
-      std::replace(ctrTblName.begin(), ctrTblName.end(), '-', '_');
-      std::replace(ctrTblName.begin(), ctrTblName.end(), '/', '_');
-
-      MIRSymbol *ctrTblSym = mod->GetMIRBuilder()->CreateGlobalDecl(ctrTblName, *arrOfInt64Ty, kScFstatic);
-      ctrTblSym->SetSKind(kStVar);
-      func->GetMirFunc()->SetProfCtrTbl(ctrTblSym);
+      func->GetMirFunc()->SetProfCtrTbl(CreateProfCtrTbl("", nCtrs));
+    }
+    if (Options::profileValues) {
+      InstrumentValueSites();
     }
     for (auto *bb : instrumentBBs) {
       InstrumentBB(*bb);
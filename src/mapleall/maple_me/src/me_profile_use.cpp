@@ -14,7 +14,9 @@
  */
 #include "me_profile_use.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include "me_cfg.h"
 #include "me_function.h"
@@ -311,6 +313,51 @@ void MeProfUse::CheckSumFail(const uint64 hash, const uint32 expectedCheckSum, c
               func->GetName().c_str(), tag.c_str(), curCheckSum, expectedCheckSum);
 }
 
+// turn the raw value counters of the function into a ValueProfInfo per site, keyed by the original stmt id which
+// survives the emission and the cloning of the statement until the consumer of the profile is run
+void MeProfUse::AttachValueProfiles(FuncProfInfo &funcData) const {
+  std::array<std::vector<std::pair<StmtNode*, FreqType>>, kValueProfKindNum> sites;
+  MeCFG *cfg = func->GetCfg();
+  auto eIt = cfg->valid_end();
+  for (auto bIt = cfg->valid_begin(); bIt != eIt; ++bIt) {
+    if (bIt == cfg->common_entry() || bIt == cfg->common_exit()) {
+      continue;
+    }
+    for (auto &stmt : (*bIt)->GetStmtNodes()) {
+      ValueProfKind kind = GetValueProfSiteKind(stmt);
+      if (kind != kValueProfKindNum) {
+        sites[kind].emplace_back(&stmt, (*bIt)->GetFrequency());
+      }
+    }
+  }
+  // the sites are matched by their order only, any other count means the counters belong to other statements
+  for (uint32 kind = 0; kind < kValueProfKindNum; ++kind) {
+    size_t counterNum = funcData.valueCounts[kind].size();
+    size_t siteCounterNum = sites[kind].size() * GetValueProfSiteCounterNum(ValueProfKind(kind));
+    if (counterNum != 0 && counterNum != siteCounterNum) {
+      WARN(kLncWarn, "%s() value profile kind %u has %zu counters for %zu sites, the value profile is dropped",
+           func->GetName().c_str(), kind, counterNum, sites[kind].size());
+      for (auto &counts : funcData.valueCounts) {
+        counts.clear();
+      }
+      return;
+    }
+  }
+  MapleAllocator &alloc = func->GetMIRModule().GetMPAllocator();
+  for (uint32 kind = 0; kind < kValueProfKindNum; ++kind) {
+    if (funcData.valueCounts[kind].empty()) {
+      continue;
+    }
+    for (size_t i = 0; i < sites[kind].size(); ++i) {
+      ValueProfInfo *valueProf = funcData.DecodeValueProf(ValueProfKind(kind), i, sites[kind][i].second, alloc);
+      if (valueProf == nullptr) {
+        continue;
+      }
+      funcData.SetValueProf(sites[kind][i].first->GetOriginalID(), valueProf);
+    }
+  }
+}
+
 bool MeProfUse::MapleProfRun() {
   FuncProfInfo *funcData = GetFuncData();
   if (!funcData) {
@@ -347,6 +394,120 @@ bool MeProfUse::MapleProfRun() {
   // save edge frequence to bb
   SetFuncEdgeInfo();
   func->GetCfg()->ConstructStmtFreq();
+  AttachValueProfiles(*funcData);
+  return true;
+}
+
+// A bb weighs the largest sample count of its source lines. The weight of a bb without any line is the one
+// flowing through its single edge with a weighed neighbour if any, else the lighter of its heaviest neighbours.
+void MeProfUse::ComputeSampledBBWeights(const FuncProfInfo &funcData, std::vector<FreqType> &weights) const {
+  MeCFG *cfg = func->GetCfg();
+  BB *commonEntry = cfg->GetCommonEntryBB();
+  BB *commonExit = cfg->GetCommonExitBB();
+  auto eIt = cfg->valid_end();
+  for (auto bIt = cfg->valid_begin(); bIt != eIt; ++bIt) {
+    auto *bb = *bIt;
+    for (auto &stmt : bb->GetStmtNodes()) {
+      const SrcPosition &pos = stmt.GetSrcPos();
+      if (pos.LineNum() == 0) {
+        continue;
+      }
+      auto it = funcData.lineSamples.find(GetSampleLineKey(pos.FileNum(), pos.LineNum()));
+      weights[bb->GetBBId()] = std::max(weights[bb->GetBBId()], it == funcData.lineSamples.end() ? 0 : it->second);
+    }
+  }
+  auto isWeighed = [&weights, commonEntry, commonExit](const BB *bb) {
+    return bb != commonEntry && bb != commonExit && weights[bb->GetBBId()] >= 0;
+  };
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto bIt = cfg->valid_begin(); bIt != eIt; ++bIt) {
+      auto *bb = *bIt;
+      if (bb == commonEntry || bb == commonExit || weights[bb->GetBBId()] >= 0) {
+        continue;
+      }
+      for (auto *pred : bb->GetPred()) {
+        if (isWeighed(pred) && pred->GetSucc().size() == 1) {
+          weights[bb->GetBBId()] = weights[pred->GetBBId()];
+        }
+      }
+      for (auto *succ : bb->GetSucc()) {
+        if (weights[bb->GetBBId()] < 0 && isWeighed(succ) && succ->GetPred().size() == 1) {
+          weights[bb->GetBBId()] = weights[succ->GetBBId()];
+        }
+      }
+      changed = changed || weights[bb->GetBBId()] >= 0;
+    }
+  }
+  for (auto bIt = cfg->valid_begin(); bIt != eIt; ++bIt) {
+    auto *bb = *bIt;
+    if (bb == commonEntry || bb == commonExit || weights[bb->GetBBId()] >= 0) {
+      continue;
+    }
+    FreqType predMax = -1;
+    FreqType succMax = -1;
+    for (auto *pred : bb->GetPred()) {
+      predMax = isWeighed(pred) ? std::max(predMax, weights[pred->GetBBId()]) : predMax;
+    }
+    for (auto *succ : bb->GetSucc()) {
+      succMax = isWeighed(succ) ? std::max(succMax, weights[succ->GetBBId()]) : succMax;
+    }
+    weights[bb->GetBBId()] = (predMax < 0 || succMax < 0) ? std::max<FreqType>(std::max(predMax, succMax), 0) :
+        std::min(predMax, succMax);
+  }
+}
+
+// --sample-profile: the frequencies come from the samples of the source lines rather than from counters, each bb
+// distributes its weight over its successors in proportion to theirs so that its out edges sum up to it
+bool MeProfUse::SampleProfRun() {
+  FuncProfInfo *funcData = GetFuncData();
+  if (funcData == nullptr) {
+    return false;
+  }
+  func->GetMirFunc()->SetFuncProfData(funcData);
+  MeCFG *cfg = func->GetCfg();
+  BB *commonEntry = cfg->GetCommonEntryBB();
+  BB *commonExit = cfg->GetCommonExitBB();
+  std::vector<FreqType> weights(cfg->GetAllBBs().size(), -1);
+  ComputeSampledBBWeights(*funcData, weights);
+  // a function with samples is entered
+  FreqType entryFreq = 0;
+  for (auto *entry : commonEntry->GetSucc()) {
+    weights[entry->GetBBId()] = std::max<FreqType>(weights[entry->GetBBId()], 1);
+    entryFreq += weights[entry->GetBBId()];
+  }
+  weights[commonEntry->GetBBId()] = entryFreq;
+  weights[commonExit->GetBBId()] = 0;
+  auto eIt = cfg->valid_end();
+  for (auto bIt = cfg->valid_begin(); bIt != eIt; ++bIt) {
+    auto *bb = *bIt;
+    FreqType weight = weights[bb->GetBBId()];
+    bb->SetFrequency(weight);
+    if (bb == commonEntry || bb == commonExit) {
+      continue;
+    }
+    bb->InitEdgeFreq();
+    FreqType succSum = 0;
+    for (auto *succ : bb->GetSucc()) {
+      succSum += succ == commonExit ? 0 : weights[succ->GetBBId()];
+    }
+    FreqType remain = weight;
+    for (size_t i = 0; i < bb->GetSucc().size(); ++i) {
+      FreqType edgeFreq = remain;
+      if (i + 1 < bb->GetSucc().size()) {
+        FreqType succWeight = bb->GetSucc(i) == commonExit ? 0 : weights[bb->GetSucc(i)->GetBBId()];
+        edgeFreq = succSum == 0 ? weight / static_cast<FreqType>(bb->GetSucc().size()) :
+            static_cast<FreqType>(static_cast<double>(weight) * succWeight / succSum);
+        edgeFreq = std::min(edgeFreq, remain);
+      }
+      bb->SetSuccFreq(static_cast<int>(i), edgeFreq);
+      remain -= edgeFreq;
+    }
+  }
+  func->SetProfValid(true);
+  func->SetFrequency(entryFreq);
+  succCalcuAllEdgeFreq = true;
+  cfg->ConstructStmtFreq();
   return true;
 }
 
@@ -359,7 +520,7 @@ bool MEProfUse::PhaseRun(maple::MeFunction &f) {
   MeProfUse profUse(f, *GetPhaseMemPool(), DEBUGFUNC_NEWPM(f));
   bool result = true;
   if (Options::profileUse) {
-    result = profUse.MapleProfRun();
+    result = Options::sampleProfile.empty() ? profUse.MapleProfRun() : profUse.SampleProfRun();
     if (result) {
       result = f.GetCfg()->VerifyBBFreq() != 0 ? true : false;
       if (result && (DEBUGFUNC_NEWPM(f))) {
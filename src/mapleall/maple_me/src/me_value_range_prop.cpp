@@ -2872,13 +2872,79 @@ void ValueRangePropagation::CalculateVROfSubOpnd(const BBId bbID, const MeExpr &
       opMeExpr.GetPrimType(), antiOp, valueRange, rhsConstant), opnd0);
 }
 
+size_t ValueRangeCache::FindOrInsertSlot(int32 exprID, bool &inserted) {
+  CHECK_FATAL(exprID != kEmptyKey, "invalid expr id");
+  inserted = false;
+  if (!isDense && (numOfEntries + 1) * 4 > keys.size() * 3) {  // keep the load factor of the hash table under 3/4
+    Grow();
+  }
+  if (isDense && static_cast<size_t>(exprID) >= keys.size() &&
+      !FitsDense(static_cast<size_t>(exprID), numOfEntries + 1)) {
+    // the id is too far away, go back to the hash table
+    isDense = false;
+    size_t newSize = kInitCapacity;
+    while ((numOfEntries + 1) * 4 > newSize * 3) {
+      newSize *= 2;
+    }
+    Rehash(newSize);
+  }
+  size_t slot = 0;
+  if (isDense) {
+    if (static_cast<size_t>(exprID) >= keys.size()) {
+      size_t newSize = std::min(std::max(static_cast<size_t>(exprID) + 1, keys.size() * 2), kMaxDenseSize);
+      keys.resize(newSize, kEmptyKey);
+      values.resize(newSize, nullptr);
+    }
+    slot = static_cast<size_t>(exprID);
+  } else {
+    slot = FindSlot(exprID);
+  }
+  if (keys[slot] == kEmptyKey) {
+    keys[slot] = exprID;
+    values[slot] = nullptr;
+    ++numOfEntries;
+    maxExprID = std::max(maxExprID, exprID);
+    inserted = true;
+  }
+  return slot;
+}
+
+// Either switch to the dense array or double the capacity of the hash table, then move the entries over.
+void ValueRangeCache::Grow() {
+  size_t newSize = keys.empty() ? kInitCapacity : keys.size() * 2;
+  if (numOfEntries >= kMinDenseEntries && FitsDense(static_cast<size_t>(maxExprID), numOfEntries)) {
+    isDense = true;
+    newSize = static_cast<size_t>(maxExprID) + 1;
+  }
+  Rehash(newSize);
+}
+
+// Move the entries to new arrays of newSize laid out as isDense says, the old arrays are released.
+void ValueRangeCache::Rehash(size_t newSize) {
+  std::vector<int32> oldKeys(std::move(keys));
+  std::vector<ValueRange*> oldValues(std::move(values));
+  keys.assign(newSize, kEmptyKey);
+  values.assign(newSize, nullptr);
+  for (size_t i = 0; i < oldKeys.size(); ++i) {
+    if (oldKeys[i] == kEmptyKey) {
+      continue;
+    }
+    size_t slot = isDense ? static_cast<size_t>(oldKeys[i]) : FindSlot(oldKeys[i]);
+    keys[slot] = oldKeys[i];
+    values[slot] = oldValues[i];
+  }
+}
+
 bool ValueRangePropagation::Insert2Caches(
     const BBId &bbID, int32 exprID, std::unique_ptr<ValueRange> valueRange, const MeExpr *opnd) {
   if (valueRange == nullptr) {
     if (onlyRecordValueRangeInTempCache.top()) {
-      tempCaches[bbID].insert(std::make_pair(exprID, nullptr));
+      if (tempCaches.at(bbID).Size() == 0) {
+        usedTempCaches.push_back(bbID);
+      }
+      (void)tempCaches.at(bbID).Insert(exprID, nullptr);
     } else {
-      caches.at(bbID)[exprID] = nullptr;
+      caches.at(bbID).Set(exprID, nullptr);
     }
     return true;
   }
@@ -2892,12 +2958,15 @@ bool ValueRangePropagation::Insert2Caches(
   }
 
   if (onlyRecordValueRangeInTempCache.top()) {
-    tempCaches[bbID][exprID] = std::move(valueRange);
+    if (tempCaches.at(bbID).Size() == 0) {
+      usedTempCaches.push_back(bbID);
+    }
+    tempCaches.at(bbID).Set(exprID, std::move(valueRange));
   } else {
     if (valueRange->IsConstantLowerAndUpper() && IsInvalidVR(*valueRange)) {
       return false;
     }
-    caches.at(bbID)[exprID] = std::move(valueRange);
+    caches.at(bbID).Set(exprID, std::move(valueRange));
   }
   if (opnd != nullptr) {
     CalculateVROfSubOpnd(bbID, *opnd, *tempVR);
@@ -3246,7 +3315,10 @@ void ValueRangePropagation::DealWithPhi(const BB &bb) {
   CreateVRForPhi(*loop);
   MergeValueRangeOfPhiOperands(*loop, bb, valueRangeOfInitExprs, indexOfInitExpr);
   onlyRecordValueRangeInTempCache.pop();
-  tempCaches.clear();
+  for (BBId bbID : usedTempCaches) {
+    tempCaches.at(bbID).Clear();
+  }
+  usedTempCaches.clear();
 }
 
 // Return the max of leftBound or rightBound.
@@ -5464,55 +5536,54 @@ void ValueRangePropagation::DumpCaches() {
   LogInfo::MapleLogger() << "================Dump value range===================" << "\n";
   for (size_t i = 0; i < caches.size(); ++i) {
     LogInfo::MapleLogger() << "BBId: " << i << "\n";
-    auto &it = caches[i];
-    for (auto bIt = it.begin(), eIt = it.end(); bIt != eIt; ++bIt) {
-      if (bIt->second == nullptr) {
-        continue;
+    caches[i].ForEach([](int32 exprID, const ValueRange *vr) {
+      if (vr == nullptr) {
+        return;
       }
-      if (bIt->second->GetRangeType() == kLowerAndUpper ||
-          bIt->second->GetRangeType() == kSpecialLowerForLoop ||
-          bIt->second->GetRangeType() == kSpecialUpperForLoop) {
-        std::string lower = (bIt->second->GetLower().GetVar() == nullptr) ?
-            std::to_string(bIt->second->GetLower().GetConstant()) :
-            "mx" + std::to_string(bIt->second->GetLower().GetVar()->GetExprID()) + " " +
-            std::to_string(bIt->second->GetLower().GetConstant());
-        std::string upper = (bIt->second->GetUpper().GetVar() == nullptr) ?
-            std::to_string(bIt->second->GetUpper().GetConstant()) :
-            "mx" + std::to_string(bIt->second->GetUpper().GetVar()->GetExprID()) + " " +
-            std::to_string(bIt->second->GetUpper().GetConstant());
-        LogInfo::MapleLogger() << "mx" << bIt->first << " lower: " << lower << " upper: " << upper;
-        if (bIt->second->GetRangeType() == kLowerAndUpper) {
+      if (vr->GetRangeType() == kLowerAndUpper ||
+          vr->GetRangeType() == kSpecialLowerForLoop ||
+          vr->GetRangeType() == kSpecialUpperForLoop) {
+        std::string lower = (vr->GetLower().GetVar() == nullptr) ?
+            std::to_string(vr->GetLower().GetConstant()) :
+            "mx" + std::to_string(vr->GetLower().GetVar()->GetExprID()) + " " +
+            std::to_string(vr->GetLower().GetConstant());
+        std::string upper = (vr->GetUpper().GetVar() == nullptr) ?
+            std::to_string(vr->GetUpper().GetConstant()) :
+            "mx" + std::to_string(vr->GetUpper().GetVar()->GetExprID()) + " " +
+            std::to_string(vr->GetUpper().GetConstant());
+        LogInfo::MapleLogger() << "mx" << exprID << " lower: " << lower << " upper: " << upper;
+        if (vr->GetRangeType() == kLowerAndUpper) {
           LogInfo::MapleLogger() << " kLowerAndUpper\n";
-        } else if (bIt->second->GetRangeType() == kSpecialLowerForLoop) {
+        } else if (vr->GetRangeType() == kSpecialLowerForLoop) {
           LogInfo::MapleLogger() << " kSpecialLowerForLoop\n";
         } else {
           LogInfo::MapleLogger() << " kSpecialUpperForLoop\n";
         }
-      } else if (bIt->second->GetRangeType() == kOnlyHasLowerBound) {
-        std::string lower = (bIt->second->GetBound().GetVar() == nullptr) ?
-            std::to_string(bIt->second->GetBound().GetConstant()) :
-            "mx" + std::to_string(bIt->second->GetBound().GetVar()->GetExprID()) + " " +
-            std::to_string(bIt->second->GetBound().GetConstant());
-        LogInfo::MapleLogger() << "mx" << bIt->first << " lower: " << lower << " upper: max " << "kOnlyHasLowerBound\n";
-      } else if (bIt->second->GetRangeType() == kOnlyHasUpperBound) {
-        std::string upper = (bIt->second->GetBound().GetVar() == nullptr) ?
-            std::to_string(bIt->second->GetBound().GetConstant()) :
-            "mx" + std::to_string(bIt->second->GetBound().GetVar()->GetExprID()) + " " +
-            std::to_string(bIt->second->GetBound().GetConstant());
-        LogInfo::MapleLogger() << "mx" << bIt->first << " lower: min upper: " << upper << "kOnlyHasUpperBound\n";
-      } else if (bIt->second->GetRangeType() == kEqual || bIt->second->GetRangeType() == kNotEqual) {
-        std::string lower = (bIt->second->GetBound().GetVar() == nullptr) ?
-            std::to_string(bIt->second->GetBound().GetConstant()) :
-            "mx" + std::to_string(bIt->second->GetBound().GetVar()->GetExprID()) + " " +
-            std::to_string(bIt->second->GetBound().GetConstant());
-        LogInfo::MapleLogger() << "mx" << bIt->first << " lower and upper: " << lower;
-        if (bIt->second->GetRangeType() == kEqual) {
+      } else if (vr->GetRangeType() == kOnlyHasLowerBound) {
+        std::string lower = (vr->GetBound().GetVar() == nullptr) ?
+            std::to_string(vr->GetBound().GetConstant()) :
+            "mx" + std::to_string(vr->GetBound().GetVar()->GetExprID()) + " " +
+            std::to_string(vr->GetBound().GetConstant());
+        LogInfo::MapleLogger() << "mx" << exprID << " lower: " << lower << " upper: max " << "kOnlyHasLowerBound\n";
+      } else if (vr->GetRangeType() == kOnlyHasUpperBound) {
+        std::string upper = (vr->GetBound().GetVar() == nullptr) ?
+            std::to_string(vr->GetBound().GetConstant()) :
+            "mx" + std::to_string(vr->GetBound().GetVar()->GetExprID()) + " " +
+            std::to_string(vr->GetBound().GetConstant());
+        LogInfo::MapleLogger() << "mx" << exprID << " lower: min upper: " << upper << "kOnlyHasUpperBound\n";
+      } else if (vr->GetRangeType() == kEqual || vr->GetRangeType() == kNotEqual) {
+        std::string lower = (vr->GetBound().GetVar() == nullptr) ?
+            std::to_string(vr->GetBound().GetConstant()) :
+            "mx" + std::to_string(vr->GetBound().GetVar()->GetExprID()) + " " +
+            std::to_string(vr->GetBound().GetConstant());
+        LogInfo::MapleLogger() << "mx" << exprID << " lower and upper: " << lower;
+        if (vr->GetRangeType() == kEqual) {
           LogInfo::MapleLogger() << " kEqual\n";
         } else {
           LogInfo::MapleLogger() << " kNotEqual\n";
         }
       }
-    }
+    });
   }
   LogInfo::MapleLogger() << "================Dump value range===================" << "\n";
 }
@@ -20,7 +20,8 @@
 #include "mir_function.h"
 
 namespace maple {
-MIRSymbol *GetOrCreateFuncCounter(MIRFunction &func, uint32 elemCnt, uint32 cfgHash);
+/* shards > 1 allocates the rows of sharded counters, counter_num in the function info stays elemCnt */
+MIRSymbol *GetOrCreateFuncCounter(MIRFunction &func, uint32 elemCnt, uint32 cfgHash, uint32 shards = 1);
 
 template<typename BB>
 class BBEdge {
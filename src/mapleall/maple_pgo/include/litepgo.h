@@ -58,6 +58,7 @@ class LiteProfile {
   bool debugPrint = false;
   std::unordered_map<std::string, BBInfo> funcBBProfData;
   std::set<std::string> extremelyColdFuncs;
+  bool HandleBinaryProfile(const std::string &fileName, const std::string &moduleName);
   void ParseFuncProfile(MIRLexer &fdLexer, const std::string &moduleName);
   void ParseCounters(MIRLexer &fdLexer, const std::string &funcName, uint32 cfghash);
 };
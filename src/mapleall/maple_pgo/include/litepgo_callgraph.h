@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef OPENARKCOMPILER_LITEPGO_CALLGRAPH_H
+#define OPENARKCOMPILER_LITEPGO_CALLGRAPH_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include "types_def.h"
+
+namespace maple {
+/*
+ * Call graph weighted by lite-pgo counts. mplcg writes the one of each module it compiles with a profile
+ * (--lite-pgo-call-graph-dir), mplprofdata merges those of a whole program into the input of
+ * ReorderAccordingProfile and into a linker script packing the hot function sections together.
+ * Text format, one line per function and per caller/callee pair:
+ *   func <name> <entry count> <size in bytes>
+ *   call <caller> <callee> <count>
+ */
+class LitePgoCallGraph {
+ public:
+  /* counts are summed, a function defined by several modules (e.g. static ones) keeps the largest size */
+  void AddFunction(const std::string &name, uint64 count, uint64 size);
+  void AddCall(const std::string &caller, const std::string &callee, uint64 count);
+  /* adds the functions and calls of other to this one */
+  void Merge(const LitePgoCallGraph &other);
+  /* merges the call graph of fileName into this one */
+  bool Read(const std::string &fileName, std::string &err);
+  bool Write(const std::string &fileName, std::string &err) const;
+  /* in the format of ReorderAccordingProfile, calls to functions defined by none of the modules are dropped */
+  void DumpReorderProfile(std::ostream &os) const;
+  /*
+   * order maps function names to their 1-based rank as computed by ReorderAccordingProfile, the functions with
+   * a count but no rank follow by decreasing count. Needs objects compiled with -ffunction-sections.
+   */
+  void DumpLinkerScript(const std::map<std::string, uint32> &order, std::ostream &os) const;
+
+  size_t GetFuncNum() const {
+    return funcs.size();
+  }
+
+  size_t GetCallNum() const {
+    return calls.size();
+  }
+
+ private:
+  struct FuncInfo {
+    uint64 count = 0;
+    uint64 size = 0;
+  };
+
+  std::map<std::string, FuncInfo> funcs;
+  std::map<std::pair<std::string, std::string>, uint64> calls;
+};
+}
+#endif // OPENARKCOMPILER_LITEPGO_CALLGRAPH_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef OPENARKCOMPILER_LITEPGO_FORMAT_H
+#define OPENARKCOMPILER_LITEPGO_FORMAT_H
+/*
+ * Binary lite-pgo profile, shared by the runtime (pgo_lib, plain C without libc headers, which must define
+ * uint32_t/uint64_t before including this file), the compiler and mplprofdata. All fields are little endian.
+ *
+ *   Mpl_Lite_Pgo_BinHeader
+ *   Mpl_Lite_Pgo_BinFuncEntry[funcNum]   sorted by (modHash, nameHash, name)
+ *   function names                       '\0' terminated, at nameOffset
+ *   uint64_t counters[]                  at counterOffset, 8 bytes aligned
+ *
+ * A reader only interested in one module binary searches the index for its modHash and reads the names and
+ * counters of that range only. Functions whose counters are all zero are kept, they are extremely cold.
+ */
+#ifdef __cplusplus
+#include <cstdint>
+#endif
+
+/* "\xffMPLPGO\x01" read as a little endian uint64, never the start of a text profile */
+#define MPL_LITE_PGO_BIN_MAGIC 0x014f47504c504dffULL
+#define MPL_LITE_PGO_BIN_VERSION 1u
+
+struct Mpl_Lite_Pgo_BinHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t funcNum;
+  uint64_t runCount;        /* number of profiled runs merged into this file, weights included */
+  uint64_t indexOffset;     /* file offset of the function index */
+  uint64_t nameOffset;      /* file offset of the name table */
+  uint64_t counterOffset;   /* file offset of the counter table */
+};
+
+struct Mpl_Lite_Pgo_BinFuncEntry {
+  uint32_t modHash;         /* DJB hash of the flattened module name, the funcid of the text format */
+  uint32_t nameHash;        /* DJB hash of the function name */
+  uint32_t cfgHash;
+  uint32_t counterNum;
+  uint32_t nameOffset;      /* relative to the name table */
+  uint32_t nameLen;         /* without the terminating '\0' */
+  uint64_t counterIndex;    /* index of the first counter in the counter table */
+};
+
+/*
+ * Sharded counters (--lite-pgo-counter-mode=sharded): the counter array of a function holds one row of counters
+ * per shard, each row starting on its own cache line so that threads incrementing different shards never share
+ * a line. The instrumented code picks the row from a hash of the thread pointer, the runtime sums the rows when
+ * dumping. The shard count of an object file is recorded in its Mpl_Lite_Pgo_ObjectFileInfo, 0 means unsharded.
+ */
+#define MPL_LITE_PGO_SHARD_BITS 3u
+#define MPL_LITE_PGO_SHARDS (1u << MPL_LITE_PGO_SHARD_BITS)
+#define MPL_LITE_PGO_SHARD_ALIGN 64u
+
+/* distance in bytes between the rows of a sharded counter array, a power of 2 to index the row by a shift */
+static inline uint32_t Mpl_Lite_Pgo_ShardStride(uint32_t counterNum) {
+  uint32_t stride = MPL_LITE_PGO_SHARD_ALIGN;
+  while (stride < counterNum * (uint32_t)sizeof(uint64_t)) {
+    stride <<= 1;
+  }
+  return stride;
+}
+
+/* number of uint64_t in the counter array of a function */
+static inline uint64_t Mpl_Lite_Pgo_CounterSlots(uint32_t counterNum, uint32_t shards) {
+  if (shards <= 1) {
+    return counterNum;
+  }
+  return (uint64_t)(shards - 1) * (Mpl_Lite_Pgo_ShardStride(counterNum) / sizeof(uint64_t)) + counterNum;
+}
+
+#endif // OPENARKCOMPILER_LITEPGO_FORMAT_H
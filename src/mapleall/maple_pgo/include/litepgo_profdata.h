@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef OPENARKCOMPILER_LITEPGO_PROFDATA_H
+#define OPENARKCOMPILER_LITEPGO_PROFDATA_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "types_def.h"
+
+namespace maple {
+/*
+ * A whole lite-pgo profile in memory, used by mplprofdata to merge the profiles of many runs.
+ * Reads the binary format of litepgo_format.h and the text format written by older runtimes,
+ * writes the binary format only. Functions are identified by their module hash and name.
+ */
+class LitePgoProfData {
+ public:
+  struct FuncProfile {
+    uint32 modHash = 0;
+    uint32 cfgHash = 0;
+    std::string name;
+    std::vector<uint64> counters;
+  };
+
+  static bool IsBinaryFile(const std::string &fileName);
+  /* reads the functions of module modHash only, by a binary search of the index of a binary profile */
+  static bool ReadModule(const std::string &fileName, uint32 modHash, std::vector<FuncProfile> &result,
+                         std::string &err);
+
+  bool Read(const std::string &fileName, std::string &err);
+  bool WriteBinary(const std::string &fileName, std::string &err) const;
+  /* in the text format, without the all zero counters like the runtime did */
+  void DumpText(std::ostream &os) const;
+  /*
+   * Adds the counters of other multiplied by weight, saturating. A function whose cfg hash or counter number
+   * differs from the one already merged was profiled with another build, it is dropped and counted in the result.
+   */
+  size_t Merge(const LitePgoProfData &other, uint64 weight);
+  void Scale(double factor);
+
+  uint64 GetRunCount() const {
+    return runCount;
+  }
+
+  size_t GetFuncNum() const {
+    return funcs.size();
+  }
+
+ private:
+  using FuncKey = std::pair<uint32, std::string>;
+
+  bool ReadBinary(const std::string &fileName, std::string &err);
+  bool ReadText(const std::string &fileName, std::string &err);
+
+  std::map<FuncKey, FuncProfile> funcs;
+  uint64 runCount = 0;
+};
+}
+#endif // OPENARKCOMPILER_LITEPGO_PROFDATA_H
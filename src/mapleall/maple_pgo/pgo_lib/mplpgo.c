@@ -7,72 +7,176 @@ __attribute__((weak)) char __mpl_pgo_wait_forks = 0;
 __attribute__((weak)) char *__mpl_pgo_dump_filename = "./";
 pthread_rwlock_t rwlock;
 
-static inline int CheckAllZero(const struct Mpl_Lite_Pgo_FuncInfo *funcPtr) {
-  const uint64_t *cptr = funcPtr->counters;
-  for (size_t i = 0; cptr && i < funcPtr->counterNum; ++i, cptr++) {
-    if (*cptr != 0) {
-      return 0;
+struct Mpl_Lite_Pgo_SortEntry {
+  struct Mpl_Lite_Pgo_BinFuncEntry entry;
+  const struct Mpl_Lite_Pgo_FuncInfo *funcPtr;
+  uint32_t shards;
+};
+
+/* buffered writer, the dump happens at exit or in the watcher process and must not depend on stdio */
+struct Mpl_Lite_Pgo_Writer {
+  int fd;
+  int failed;
+  size_t used;
+  char buf[WRITEBUFSIZE];
+};
+
+static inline void FlushWriter(struct Mpl_Lite_Pgo_Writer *writer) {
+  size_t done = 0;
+  while (done < writer->used && !writer->failed) {
+    long ret = write(writer->fd, writer->buf + done, writer->used - done);
+    if (ret <= 0) {
+      writer->failed = 1;
+      break;
     }
+    done += (size_t)ret;
   }
-  return 1;
+  writer->used = 0;
 }
 
-static inline struct Mpl_Lite_Pgo_DumpInfo *CreateDumpNode(char *inStr) {
-  struct Mpl_Lite_Pgo_DumpInfo *di = malloc(sizeof(struct Mpl_Lite_Pgo_DumpInfo));
-  if (di == NULL) {
-    return NULL;
+static inline void EmitBytes(struct Mpl_Lite_Pgo_Writer *writer, const void *data, size_t size) {
+  const char *src = (const char*)data;
+  while (size != 0) {
+    if (writer->used == WRITEBUFSIZE) {
+      FlushWriter(writer);
+    }
+    size_t len = WRITEBUFSIZE - writer->used;
+    len = len < size ? len : size;
+    memcpy(writer->buf + writer->used, src, len);
+    writer->used += len;
+    src += len;
+    size -= len;
   }
-  memset(di, 0, sizeof(struct Mpl_Lite_Pgo_DumpInfo));
-  di->pgoFormatStr = inStr;
-  di->next = NULL;
 }
 
-static inline void EmitFunctionDesc(unsigned int modHash, const struct Mpl_Lite_Pgo_FuncInfo *funcPtr, int fd) {
-  /* skip function without counters */
-  if (funcPtr->counterNum == 0) {
+/* the rows of sharded counters are summed up */
+static inline void EmitCounters(struct Mpl_Lite_Pgo_Writer *writer, const struct Mpl_Lite_Pgo_SortEntry *sortEntry) {
+  const uint64_t *counters = sortEntry->funcPtr->counters;
+  uint32_t counterNum = sortEntry->entry.counterNum;
+  if (sortEntry->shards <= 1) {
+    EmitBytes(writer, counters, sizeof(uint64_t) * counterNum);
     return;
   }
-  const uint64_t *cptr = funcPtr->counters;
-  char lineBuf[BUFFSIZE];
-  size_t emitSz = sprintf(lineBuf,"func &%s funcid %u,counterSz %lu,cfghash %u,\n\0",
-      funcPtr->funcName, modHash, funcPtr->counterNum, funcPtr->cfgHash);
-  write(fd, lineBuf,  emitSz);
-  if (!CheckAllZero(funcPtr)) {
-    for (size_t i = 0; cptr && i < funcPtr->counterNum; ++i) {
-      char counterBuf[BUFFSIZE];
-      size_t sizeOfCounter = sprintf(counterBuf, "%lu\n\0", *cptr);
-      write(fd, counterBuf,  sizeOfCounter);
-      cptr++;
+  uint32_t rowSize = Mpl_Lite_Pgo_ShardStride(counterNum) / sizeof(uint64_t);
+  for (uint32_t i = 0; i != counterNum; ++i) {
+    uint64_t sum = 0;
+    for (uint32_t shard = 0; shard != sortEntry->shards; ++shard) {
+      sum += counters[shard * rowSize + i];
     }
+    EmitBytes(writer, &sum, sizeof(sum));
+  }
+}
+
+/* same as DJBHash in maple_util */
+static inline uint32_t NameHash(const char *str) {
+  uint32_t hash = 5381;
+  while (*str != 0) {
+    hash += (hash << 5) + (unsigned char)(*str++);
   }
-  return;
+  return hash & 0x7FFFFFFF;
 }
 
-static inline void EmitFlavor(int fd) {
-  char flavorBuf[BUFFSIZE];
-  char timeBuf[TIMEBUFSIZE];
-  current_time_to_buf(timeBuf);
-  size_t emitSz = sprintf(flavorBuf,"flavor %s\n\0", timeBuf);
-  write(fd, flavorBuf, emitSz);
+static int CompareEntry(const void *lhs, const void *rhs) {
+  const struct Mpl_Lite_Pgo_SortEntry *a = (const struct Mpl_Lite_Pgo_SortEntry*)lhs;
+  const struct Mpl_Lite_Pgo_SortEntry *b = (const struct Mpl_Lite_Pgo_SortEntry*)rhs;
+  if (a->entry.modHash != b->entry.modHash) {
+    return a->entry.modHash < b->entry.modHash ? -1 : 1;
+  }
+  if (a->entry.nameHash != b->entry.nameHash) {
+    return a->entry.nameHash < b->entry.nameHash ? -1 : 1;
+  }
+  return strcmp(a->funcPtr->funcName, b->funcPtr->funcName);
+}
+
+static inline uint32_t CountFunctions(const struct Mpl_Lite_Pgo_ObjectFileInfo *fInfo) {
+  uint32_t funcNum = 0;
+  for (; fInfo; fInfo = fInfo->next) {
+    for (unsigned int i = 0; i != fInfo->funcNum; ++i) {
+      /* skip function without counters */
+      const struct Mpl_Lite_Pgo_FuncInfo *funcPtr = fInfo->funcInfos[i];
+      funcNum += (funcPtr->counterNum != 0 && funcPtr->counters != NULL) ? 1 : 0;
+    }
+  }
+  return funcNum;
 }
 
+/* see litepgo_format.h for the layout */
 static inline void WriteToFile(const struct Mpl_Lite_Pgo_ObjectFileInfo *fInfo) {
-  size_t txtLen = 0;
-  struct Mpl_Lite_Pgo_DumpInfo *head = NULL;
   int fd = open(__mpl_pgo_dump_filename, O_RDWR | O_TRUNC | O_CREAT, 0640);
   if (fd == -1) {
     perror("Error opening mpl_pgo_dump file");
     return;
   }
   pthread_rwlock_wrlock(&rwlock);
-  EmitFlavor(fd);
-  while (fInfo) {
+  uint32_t funcNum = CountFunctions(fInfo);
+  struct Mpl_Lite_Pgo_SortEntry *entries = malloc(sizeof(struct Mpl_Lite_Pgo_SortEntry) * (funcNum + 1));
+  struct Mpl_Lite_Pgo_Writer *writer = malloc(sizeof(struct Mpl_Lite_Pgo_Writer));
+  if (entries == NULL || writer == NULL) {
+    perror("Error allocating mpl_pgo_dump buffer");
+    free(entries);
+    free(writer);
+    pthread_rwlock_unlock(&rwlock);
+    close(fd);
+    return;
+  }
+  uint32_t idx = 0;
+  for (; fInfo; fInfo = fInfo->next) {
     for (unsigned int i = 0; i != fInfo->funcNum; ++i) {
       const struct Mpl_Lite_Pgo_FuncInfo *funcPtr = fInfo->funcInfos[i];
-      EmitFunctionDesc (fInfo->modHash, funcPtr, fd);
+      if (funcPtr->counterNum == 0 || funcPtr->counters == NULL) {
+        continue;
+      }
+      memset(&entries[idx], 0, sizeof(struct Mpl_Lite_Pgo_SortEntry));
+      entries[idx].entry.modHash = fInfo->modHash;
+      entries[idx].entry.nameHash = NameHash(funcPtr->funcName);
+      entries[idx].entry.cfgHash = funcPtr->cfgHash;
+      entries[idx].entry.counterNum = funcPtr->counterNum;
+      entries[idx].entry.nameLen = (uint32_t)strlen(funcPtr->funcName);
+      entries[idx].funcPtr = funcPtr;
+      entries[idx].shards = fInfo->counterShards;
+      ++idx;
     }
-    fInfo = fInfo->next;
   }
+  qsort(entries, funcNum, sizeof(struct Mpl_Lite_Pgo_SortEntry), CompareEntry);
+  uint64_t nameSize = 0;
+  uint64_t counterIndex = 0;
+  for (idx = 0; idx != funcNum; ++idx) {
+    entries[idx].entry.nameOffset = (uint32_t)nameSize;
+    entries[idx].entry.counterIndex = counterIndex;
+    nameSize += entries[idx].entry.nameLen + 1;
+    counterIndex += entries[idx].entry.counterNum;
+  }
+  struct Mpl_Lite_Pgo_BinHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = MPL_LITE_PGO_BIN_MAGIC;
+  header.version = MPL_LITE_PGO_BIN_VERSION;
+  header.funcNum = funcNum;
+  header.runCount = 1;
+  header.indexOffset = sizeof(header);
+  header.nameOffset = header.indexOffset + sizeof(struct Mpl_Lite_Pgo_BinFuncEntry) * funcNum;
+  header.counterOffset = (header.nameOffset + nameSize + 7) & ~7ull;
+
+  writer->fd = fd;
+  writer->failed = 0;
+  writer->used = 0;
+  EmitBytes(writer, &header, sizeof(header));
+  for (idx = 0; idx != funcNum; ++idx) {
+    EmitBytes(writer, &entries[idx].entry, sizeof(struct Mpl_Lite_Pgo_BinFuncEntry));
+  }
+  for (idx = 0; idx != funcNum; ++idx) {
+    EmitBytes(writer, entries[idx].funcPtr->funcName, entries[idx].entry.nameLen + 1);
+  }
+  const uint64_t padding = 0;
+  EmitBytes(writer, &padding, header.counterOffset - header.nameOffset - nameSize);
+  for (idx = 0; idx != funcNum; ++idx) {
+    EmitCounters(writer, &entries[idx]);
+  }
+  FlushWriter(writer);
+  if (writer->failed) {
+    perror("Error writing mpl_pgo_dump file");
+  }
+  free(writer);
+  free(entries);
   pthread_rwlock_unlock(&rwlock);
   close(fd);
 }
@@ -144,7 +248,8 @@ static inline void FlushCounters(struct Mpl_Lite_Pgo_ObjectFileInfo *fInfo) {
     for (unsigned int i = 0; i != fInfo->funcNum; ++i) {
       struct Mpl_Lite_Pgo_FuncInfo *funcPtr = fInfo->funcInfos[i];
       uint64_t *cptr = funcPtr->counters;
-      for (size_t i = 0; cptr && i < funcPtr->counterNum; ++i) {
+      uint64_t slotNum = Mpl_Lite_Pgo_CounterSlots(funcPtr->counterNum, fInfo->counterShards);
+      for (size_t i = 0; cptr && i < slotNum; ++i) {
         *cptr = 0;
         cptr++;
       }
@@ -15,8 +15,19 @@
 #ifndef MPLPGO_C_LIBRARY_H
 #define MPLPGO_C_LIBRARY_H
 #include "common_util.h"
+#include "litepgo_format.h"
 
 #define BUFFSIZE 1024
+#define WRITEBUFSIZE 65536
+
+/* common_util.h replaces the libc headers, declare the few libc functions used by the dump */
+void *malloc(size_t size);
+void free(void *ptr);
+void *memcpy(void *dest, const void *src, size_t n);
+void *memset(void *s, int c, size_t n);
+size_t strlen(const char *s);
+int strcmp(const char *s1, const char *s2);
+void qsort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *));
 
 struct Mpl_Lite_Pgo_DumpInfo {
   char *pgoFormatStr;
@@ -33,6 +44,7 @@ struct Mpl_Lite_Pgo_FuncInfo {
 /* information about all function profile instrumentation in an object file */
 struct Mpl_Lite_Pgo_ObjectFileInfo {
   unsigned int modHash;
+  unsigned int counterShards; /* rows of the counter arrays, 0 or 1 if not sharded */
   struct Mpl_Lite_Pgo_ObjectFileInfo *next; /* build list for all object file info */
   uint64_t funcNum;
   const struct Mpl_Lite_Pgo_FuncInfo *const *funcInfos;
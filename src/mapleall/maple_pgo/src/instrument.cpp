@@ -15,6 +15,7 @@
 
 #include "instrument.h"
 #include "cgbb.h"
+#include "litepgo_format.h"
 #include "mir_builder.h"
 #include "mpl_logging.h"
 
@@ -43,7 +44,7 @@ static inline void RegisterInFuncInfo(MIRFunction &func, const MIRSymbol &counte
   funcInfoMirConst->SetItem(3, counterConst, 4);
 }
 
-MIRSymbol *GetOrCreateFuncCounter(MIRFunction &func, uint32 elemCnt, uint32 cfgHash) {
+MIRSymbol *GetOrCreateFuncCounter(MIRFunction &func, uint32 elemCnt, uint32 cfgHash, uint32 shards) {
   auto *mirModule = func.GetModule();
   std::string name = GetProfCntSymbolName(func.GetName(), func.GetPuidx());
   auto nameStrIdx = GlobalTables::GetStrTable().GetStrIdxFromName(name);
@@ -52,16 +53,21 @@ MIRSymbol *GetOrCreateFuncCounter(MIRFunction &func, uint32 elemCnt, uint32 cfgH
     return sym;
   }
   auto *elemType = GlobalTables::GetTypeTable().GetUInt64();
+  /* one row of elemCnt counters per shard */
+  auto slotCnt = static_cast<uint32>(Mpl_Lite_Pgo_CounterSlots(elemCnt, shards));
   MIRArrayType &arrayType =
-      *GlobalTables::GetTypeTable().GetOrCreateArrayType(*elemType, elemCnt);
+      *GlobalTables::GetTypeTable().GetOrCreateArrayType(*elemType, slotCnt);
   sym = mirModule->GetMIRBuilder()->CreateGlobalDecl(name.c_str(), arrayType);
   auto *profTab = mirModule->GetMemPool()->New<MIRAggConst>(*mirModule, arrayType);
   MIRIntConst *indexConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(0, *elemType);
-  for (uint32 i = 0; i < elemCnt; ++i) {
+  for (uint32 i = 0; i < slotCnt; ++i) {
     profTab->AddItem(indexConst, i);
   }
   sym->SetKonst(profTab);
   sym->SetStorageClass(kScFstatic);
+  if (shards > 1) {
+    sym->GetAttrs().SetAlign(MPL_LITE_PGO_SHARD_ALIGN);
+  }
   sym->sectionAttr = GlobalTables::GetUStrTable().GetOrCreateStrIdxFromName("mpl_counter");
   RegisterInFuncInfo(func, *sym, elemCnt, cfgHash);
   return sym;
@@ -13,9 +13,11 @@
  * See the Mulan PSL v2 for more details.
  */
 #include "litepgo.h"
+#include <algorithm>
 #include <string>
 #include "itab_util.h"
 #include "lexer.h"
+#include "litepgo_profdata.h"
 #include "mempool.h"
 #include "mempool_allocator.h"
 #include "mir_module.h"
@@ -47,6 +49,9 @@ bool LiteProfile::HandleLitePGOFile(const std::string &fileName, MIRModule &m) {
   }
   loaded = true;
   const std::string moduleName = m.GetFileName();
+  if (LitePgoProfData::IsBinaryFile(fileName)) {
+    return HandleBinaryProfile(fileName, moduleName);
+  }
   /* init a lexer for parsing lite-pgo function data */
   MIRLexer funcDataLexer(nullptr, m.GetMPAllocator());
   funcDataLexer.PrepareForFile(fileName);
@@ -74,6 +79,33 @@ bool LiteProfile::HandleLitePGOFile(const std::string &fileName, MIRModule &m) {
   return true;
 }
 
+/* only the functions of this module are read, the other modules of the profile are skipped by its index */
+bool LiteProfile::HandleBinaryProfile(const std::string &fileName, const std::string &moduleName) {
+  uint32 modHash = DJBHash(FlatenName(moduleName).c_str());
+  std::vector<LitePgoProfData::FuncProfile> funcs;
+  std::string err;
+  if (!LitePgoProfData::ReadModule(fileName, modHash, funcs, err)) {
+    LogInfo::MapleLogger() << "LITEPGO log : " << err << '\n';
+    return false;
+  }
+  for (auto &func : funcs) {
+    if (std::all_of(func.counters.begin(), func.counters.end(), [](uint64 val) { return val == 0; })) {
+      if (debugPrint) {
+        LogInfo::MapleLogger() << "LITEPGO log : func " << func.name << " ---  extremely cold" << '\n';
+      }
+      (void)extremelyColdFuncs.emplace(func.name);
+      continue;
+    }
+    std::vector<uint32> counters;
+    counters.reserve(func.counters.size());
+    for (uint64 val : func.counters) {
+      counters.emplace_back(static_cast<uint32>(std::min<uint64>(val, UINT32_MAX)));
+    }
+    (void)funcBBProfData.emplace(func.name, BBInfo(func.cfgHash, std::move(counters)));
+  }
+  return true;
+}
+
 /* lite-pgo keyword format ";${keyword}" */
 static inline void ParseLitePgoKeyWord(MIRLexer &fdLexer, const std::string &keyWord) {
   /* parse counterSz */
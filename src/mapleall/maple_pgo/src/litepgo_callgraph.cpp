@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "litepgo_callgraph.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace maple {
+namespace {
+uint64 SaturatingAdd(uint64 a, uint64 b) {
+  return a > std::numeric_limits<uint64>::max() - b ? std::numeric_limits<uint64>::max() : a + b;
+}
+}
+
+void LitePgoCallGraph::AddFunction(const std::string &name, uint64 count, uint64 size) {
+  FuncInfo &info = funcs[name];
+  info.count = SaturatingAdd(info.count, count);
+  info.size = std::max(info.size, size);
+}
+
+void LitePgoCallGraph::AddCall(const std::string &caller, const std::string &callee, uint64 count) {
+  uint64 &weight = calls[std::make_pair(caller, callee)];
+  weight = SaturatingAdd(weight, count);
+}
+
+void LitePgoCallGraph::Merge(const LitePgoCallGraph &other) {
+  for (auto &func : other.funcs) {
+    AddFunction(func.first, func.second.count, func.second.size);
+  }
+  for (auto &call : other.calls) {
+    AddCall(call.first.first, call.first.second, call.second);
+  }
+}
+
+bool LitePgoCallGraph::Read(const std::string &fileName, std::string &err) {
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  std::string line;
+  size_t lineNum = 0;
+  while (std::getline(in, line)) {
+    ++lineNum;
+    std::istringstream ss(line);
+    std::string kind;
+    if (!(ss >> kind)) {
+      continue;
+    }
+    std::string name;
+    std::string callee;
+    uint64 count = 0;
+    uint64 size = 0;
+    if (kind == "func" && (ss >> name >> count >> size)) {
+      AddFunction(name, count, size);
+    } else if (kind == "call" && (ss >> name >> callee >> count)) {
+      AddCall(name, callee, count);
+    } else {
+      err = fileName + ":" + std::to_string(lineNum) + ": unexpected line";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LitePgoCallGraph::Write(const std::string &fileName, std::string &err) const {
+  std::ofstream out(fileName, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  for (auto &func : funcs) {
+    out << "func " << func.first << ' ' << func.second.count << ' ' << func.second.size << '\n';
+  }
+  for (auto &call : calls) {
+    out << "call " << call.first.first << ' ' << call.first.second << ' ' << call.second << '\n';
+  }
+  out.close();
+  if (!out) {
+    err = "failed to write " + fileName;
+    return false;
+  }
+  return true;
+}
+
+void LitePgoCallGraph::DumpReorderProfile(std::ostream &os) const {
+  for (auto &call : calls) {
+    auto caller = funcs.find(call.first.first);
+    auto callee = funcs.find(call.first.second);
+    if (call.second == 0 || caller == funcs.end() || callee == funcs.end()) {
+      continue;
+    }
+    os << callee->first << ' ' << callee->second.count << ' ' << callee->second.size << ' ' <<
+        caller->first << ' ' << caller->second.count << ' ' << caller->second.size << ' ' << call.second << '\n';
+  }
+}
+
+void LitePgoCallGraph::DumpLinkerScript(const std::map<std::string, uint32> &order, std::ostream &os) const {
+  std::vector<std::pair<uint32, std::string>> ranked;
+  std::vector<std::pair<uint64, std::string>> unranked;
+  for (auto &func : funcs) {
+    auto it = order.find(func.first);
+    if (it != order.end()) {
+      ranked.emplace_back(it->second, func.first);
+    } else if (func.second.count != 0) {
+      unranked.emplace_back(func.second.count, func.first);
+    }
+  }
+  std::sort(ranked.begin(), ranked.end());
+  std::stable_sort(unranked.begin(), unranked.end(),
+                   [](const std::pair<uint64, std::string> &a, const std::pair<uint64, std::string> &b) {
+                     return a.first > b.first;
+                   });
+  /* the hot functions go to an output section of their own placed right before .text */
+  os << "SECTIONS\n{\n  .text.mpl_hot :\n  {\n";
+  for (auto &func : ranked) {
+    os << "    *(.text." << func.second << ")\n";
+  }
+  for (auto &func : unranked) {
+    os << "    *(.text." << func.second << ")\n";
+  }
+  os << "  }\n}\nINSERT BEFORE .text;\n";
+}
+}
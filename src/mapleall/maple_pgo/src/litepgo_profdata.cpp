@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "litepgo_profdata.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "itab_util.h"
+#include "litepgo_format.h"
+
+namespace maple {
+namespace {
+constexpr uint64 kCounterSize = sizeof(uint64);
+constexpr uint64 kEntrySize = sizeof(Mpl_Lite_Pgo_BinFuncEntry);
+
+uint64 SaturatingAdd(uint64 a, uint64 b) {
+  return a > std::numeric_limits<uint64>::max() - b ? std::numeric_limits<uint64>::max() : a + b;
+}
+
+uint64 SaturatingMul(uint64 a, uint64 b) {
+  return (b != 0 && a > std::numeric_limits<uint64>::max() / b) ? std::numeric_limits<uint64>::max() : a * b;
+}
+
+bool ReadAt(std::ifstream &in, uint64 offset, void *buf, uint64 size) {
+  if (size == 0) {
+    return true;
+  }
+  in.seekg(static_cast<std::streamoff>(offset));
+  (void)in.read(static_cast<char*>(buf), static_cast<std::streamsize>(size));
+  return in.good();
+}
+
+/* opens fileName and checks the header and that the tables it describes are inside the file */
+bool OpenBinary(const std::string &fileName, std::ifstream &in, Mpl_Lite_Pgo_BinHeader &header, std::string &err) {
+  in.open(fileName, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  in.seekg(0, std::ios::end);
+  uint64 fileSize = static_cast<uint64>(in.tellg());
+  if (!ReadAt(in, 0, &header, sizeof(header)) || header.magic != MPL_LITE_PGO_BIN_MAGIC) {
+    err = fileName + " is not a binary lite-pgo profile";
+    return false;
+  }
+  if (header.version != MPL_LITE_PGO_BIN_VERSION) {
+    err = fileName + ": unsupported profile version " + std::to_string(header.version);
+    return false;
+  }
+  if (header.indexOffset > fileSize || header.funcNum > (fileSize - header.indexOffset) / kEntrySize ||
+      header.nameOffset > fileSize || header.counterOffset > fileSize) {
+    err = fileName + " is truncated";
+    return false;
+  }
+  return true;
+}
+
+/* reads the entries [begin, end) with their names and counters */
+bool ReadEntries(std::ifstream &in, const Mpl_Lite_Pgo_BinHeader &header, uint32 begin, uint32 end,
+                 std::vector<LitePgoProfData::FuncProfile> &result, std::string &err) {
+  if (begin == end) {
+    return true;
+  }
+  std::vector<Mpl_Lite_Pgo_BinFuncEntry> entries(end - begin);
+  if (!ReadAt(in, header.indexOffset + begin * kEntrySize, entries.data(), entries.size() * kEntrySize)) {
+    err = "truncated function index";
+    return false;
+  }
+  /* names and counters are laid out in index order, the range of entries maps to one block of each */
+  const Mpl_Lite_Pgo_BinFuncEntry &last = entries.back();
+  uint64 nameBegin = entries.front().nameOffset;
+  uint64 nameEnd = static_cast<uint64>(last.nameOffset) + last.nameLen + 1;
+  uint64 counterBegin = entries.front().counterIndex;
+  uint64 counterEnd = last.counterIndex + last.counterNum;
+  if (nameEnd < nameBegin || counterEnd < counterBegin) {
+    err = "corrupted function index";
+    return false;
+  }
+  std::vector<char> names(nameEnd - nameBegin);
+  std::vector<uint64> counters(counterEnd - counterBegin);
+  if (!ReadAt(in, header.nameOffset + nameBegin, names.data(), names.size()) ||
+      !ReadAt(in, header.counterOffset + counterBegin * kCounterSize, counters.data(), counters.size() * kCounterSize)) {
+    err = "truncated name or counter table";
+    return false;
+  }
+  for (const Mpl_Lite_Pgo_BinFuncEntry &entry : entries) {
+    uint64 namePos = entry.nameOffset - nameBegin;
+    uint64 counterPos = entry.counterIndex - counterBegin;
+    if (entry.nameOffset < nameBegin || namePos + entry.nameLen >= names.size() ||
+        entry.counterIndex < counterBegin || counterPos + entry.counterNum > counters.size()) {
+      err = "corrupted function index";
+      return false;
+    }
+    LitePgoProfData::FuncProfile func;
+    func.modHash = entry.modHash;
+    func.cfgHash = entry.cfgHash;
+    func.name.assign(&names[namePos], entry.nameLen);
+    func.counters.assign(counters.begin() + static_cast<std::ptrdiff_t>(counterPos),
+                         counters.begin() + static_cast<std::ptrdiff_t>(counterPos + entry.counterNum));
+    result.emplace_back(std::move(func));
+  }
+  return true;
+}
+}
+
+bool LitePgoProfData::IsBinaryFile(const std::string &fileName) {
+  std::ifstream in(fileName, std::ios::in | std::ios::binary);
+  uint64 magic = 0;
+  return in.is_open() && ReadAt(in, 0, &magic, sizeof(magic)) && magic == MPL_LITE_PGO_BIN_MAGIC;
+}
+
+bool LitePgoProfData::ReadModule(const std::string &fileName, uint32 modHash, std::vector<FuncProfile> &result,
+                                 std::string &err) {
+  std::ifstream in;
+  Mpl_Lite_Pgo_BinHeader header;
+  if (!OpenBinary(fileName, in, header, err)) {
+    return false;
+  }
+  /* lower and upper bound of modHash in the index, one entry read per probe */
+  auto bound = [&in, &header, modHash](bool upper, uint32 &pos) {
+    uint32 lo = 0;
+    uint32 hi = header.funcNum;
+    while (lo < hi) {
+      uint32 mid = lo + (hi - lo) / 2;
+      Mpl_Lite_Pgo_BinFuncEntry entry;
+      if (!ReadAt(in, header.indexOffset + mid * kEntrySize, &entry, kEntrySize)) {
+        return false;
+      }
+      if (entry.modHash < modHash || (upper && entry.modHash == modHash)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    pos = lo;
+    return true;
+  };
+  uint32 begin = 0;
+  uint32 end = 0;
+  if (!bound(false, begin) || !bound(true, end)) {
+    err = fileName + ": truncated function index";
+    return false;
+  }
+  if (!ReadEntries(in, header, begin, end, result, err)) {
+    err = fileName + ": " + err;
+    return false;
+  }
+  return true;
+}
+
+bool LitePgoProfData::Read(const std::string &fileName, std::string &err) {
+  return IsBinaryFile(fileName) ? ReadBinary(fileName, err) : ReadText(fileName, err);
+}
+
+bool LitePgoProfData::ReadBinary(const std::string &fileName, std::string &err) {
+  std::ifstream in;
+  Mpl_Lite_Pgo_BinHeader header;
+  if (!OpenBinary(fileName, in, header, err)) {
+    return false;
+  }
+  std::vector<FuncProfile> result;
+  if (!ReadEntries(in, header, 0, header.funcNum, result, err)) {
+    err = fileName + ": " + err;
+    return false;
+  }
+  funcs.clear();
+  for (FuncProfile &func : result) {
+    FuncKey key(func.modHash, func.name);
+    funcs[key] = std::move(func);
+  }
+  runCount = header.runCount;
+  return true;
+}
+
+/*
+ * text format written by older runtimes
+ * flavor <time>
+ * func &<funcname> funcid <modhash>,counterSz <num>,cfghash <hash>,
+ * counters, one per line, omitted if all zero
+ */
+bool LitePgoProfData::ReadText(const std::string &fileName, std::string &err) {
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  funcs.clear();
+  runCount = 1;
+  FuncProfile *cur = nullptr;
+  size_t counterNum = 0;
+  auto finishFunc = [&cur, &counterNum]() {
+    if (cur != nullptr) {
+      cur->counters.resize(counterNum, 0);
+    }
+  };
+  std::string line;
+  size_t lineNum = 0;
+  while (std::getline(in, line)) {
+    ++lineNum;
+    if (line.empty() || line.compare(0, strlen("flavor"), "flavor") == 0) {
+      continue;
+    }
+    if (line.compare(0, strlen("func &"), "func &") == 0) {
+      finishFunc();
+      size_t nameEnd = line.find(' ', strlen("func &"));
+      unsigned int modHash = 0;
+      unsigned long counterSz = 0;
+      unsigned int cfgHash = 0;
+      if (nameEnd == std::string::npos ||
+          sscanf(line.c_str() + nameEnd, " funcid %u,counterSz %lu,cfghash %u,", &modHash, &counterSz, &cfgHash) != 3) {
+        err = fileName + ":" + std::to_string(lineNum) + ": bad function header";
+        return false;
+      }
+      FuncProfile func;
+      func.modHash = modHash;
+      func.cfgHash = cfgHash;
+      func.name = line.substr(strlen("func &"), nameEnd - strlen("func &"));
+      FuncKey key(func.modHash, func.name);
+      cur = &(funcs[key] = std::move(func));
+      counterNum = counterSz;
+      continue;
+    }
+    char *endPtr = nullptr;
+    uint64 val = std::strtoull(line.c_str(), &endPtr, 10);
+    if (cur == nullptr || endPtr == line.c_str() || cur->counters.size() == counterNum) {
+      err = fileName + ":" + std::to_string(lineNum) + ": unexpected counter";
+      return false;
+    }
+    cur->counters.push_back(val);
+  }
+  finishFunc();
+  return true;
+}
+
+bool LitePgoProfData::WriteBinary(const std::string &fileName, std::string &err) const {
+  struct SortedFunc {
+    uint32 nameHash;
+    const FuncProfile *func;
+  };
+  std::vector<SortedFunc> sorted;
+  sorted.reserve(funcs.size());
+  for (auto &item : funcs) {
+    sorted.push_back({ DJBHash(item.second.name.c_str()), &item.second });
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const SortedFunc &a, const SortedFunc &b) {
+    if (a.func->modHash != b.func->modHash) {
+      return a.func->modHash < b.func->modHash;
+    }
+    if (a.nameHash != b.nameHash) {
+      return a.nameHash < b.nameHash;
+    }
+    return a.func->name < b.func->name;
+  });
+  std::vector<Mpl_Lite_Pgo_BinFuncEntry> entries(sorted.size());
+  uint64 nameSize = 0;
+  uint64 counterNum = 0;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    const FuncProfile &func = *sorted[i].func;
+    if (nameSize > std::numeric_limits<uint32>::max() || func.counters.size() > std::numeric_limits<uint32>::max()) {
+      err = "profile too large";
+      return false;
+    }
+    entries[i].modHash = func.modHash;
+    entries[i].nameHash = sorted[i].nameHash;
+    entries[i].cfgHash = func.cfgHash;
+    entries[i].counterNum = static_cast<uint32>(func.counters.size());
+    entries[i].nameOffset = static_cast<uint32>(nameSize);
+    entries[i].nameLen = static_cast<uint32>(func.name.size());
+    entries[i].counterIndex = counterNum;
+    nameSize += func.name.size() + 1;
+    counterNum += func.counters.size();
+  }
+  Mpl_Lite_Pgo_BinHeader header;
+  header.magic = MPL_LITE_PGO_BIN_MAGIC;
+  header.version = MPL_LITE_PGO_BIN_VERSION;
+  header.funcNum = static_cast<uint32>(entries.size());
+  header.runCount = runCount;
+  header.indexOffset = sizeof(header);
+  header.nameOffset = header.indexOffset + entries.size() * kEntrySize;
+  header.counterOffset = (header.nameOffset + nameSize + kCounterSize - 1) & ~(kCounterSize - 1);
+
+  std::ofstream out(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  (void)out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  (void)out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * kEntrySize));
+  for (const SortedFunc &item : sorted) {
+    (void)out.write(item.func->name.c_str(), static_cast<std::streamsize>(item.func->name.size() + 1));
+  }
+  const char padding[kCounterSize] = { 0 };
+  (void)out.write(padding, static_cast<std::streamsize>(header.counterOffset - header.nameOffset - nameSize));
+  for (const SortedFunc &item : sorted) {
+    (void)out.write(reinterpret_cast<const char*>(item.func->counters.data()),
+                    static_cast<std::streamsize>(item.func->counters.size() * kCounterSize));
+  }
+  out.close();
+  if (!out) {
+    err = "error writing " + fileName;
+    return false;
+  }
+  return true;
+}
+
+void LitePgoProfData::DumpText(std::ostream &os) const {
+  os << "flavor merged " << runCount << " runs\n";
+  for (auto &item : funcs) {
+    const FuncProfile &func = item.second;
+    os << "func &" << func.name << " funcid " << func.modHash << ",counterSz " << func.counters.size() <<
+        ",cfghash " << func.cfgHash << ",\n";
+    if (std::all_of(func.counters.begin(), func.counters.end(), [](uint64 val) { return val == 0; })) {
+      continue;
+    }
+    for (uint64 val : func.counters) {
+      os << val << '\n';
+    }
+  }
+}
+
+size_t LitePgoProfData::Merge(const LitePgoProfData &other, uint64 weight) {
+  size_t mismatched = 0;
+  for (auto &item : other.funcs) {
+    const FuncProfile &src = item.second;
+    auto it = funcs.find(item.first);
+    if (it == funcs.end()) {
+      FuncProfile &dst = funcs[item.first] = src;
+      for (uint64 &val : dst.counters) {
+        val = SaturatingMul(val, weight);
+      }
+      continue;
+    }
+    FuncProfile &dst = it->second;
+    if (dst.cfgHash != src.cfgHash || dst.counters.size() != src.counters.size()) {
+      ++mismatched;
+      continue;
+    }
+    for (size_t i = 0; i < src.counters.size(); ++i) {
+      dst.counters[i] = SaturatingAdd(dst.counters[i], SaturatingMul(src.counters[i], weight));
+    }
+  }
+  runCount = SaturatingAdd(runCount, SaturatingMul(other.runCount, weight));
+  return mismatched;
+}
+
+void LitePgoProfData::Scale(double factor) {
+  constexpr double kMaxCounter = static_cast<double>(std::numeric_limits<uint64>::max());
+  for (auto &item : funcs) {
+    for (uint64 &val : item.second.counters) {
+      double scaled = std::round(static_cast<double>(val) * factor);
+      val = scaled >= kMaxCounter ? std::numeric_limits<uint64>::max() : static_cast<uint64>(scaled);
+    }
+  }
+}
+}
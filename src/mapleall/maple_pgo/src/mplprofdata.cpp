@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "litepgo_profdata.h"
+#include "litepgo_callgraph.h"
+#include "cg_callgraph_reorder.h"
+
+/*
+ * mplprofdata, offline tool for lite-pgo profiles
+ *   merge: sums the profiles of many runs, each optionally weighted, and scales the result
+ *   show:  prints a profile in the text format, which the compiler accepts as well
+ *   order: merges the call graphs written by mplcg (--lite-pgo-call-graph-dir) into the profile of
+ *          --function-reorder-profile, and optionally into a linker script ordering the function sections
+ */
+using namespace maple;
+
+namespace {
+void Usage(const char *pgm) {
+  std::cerr << "usage: " << pgm << " merge -o <output> [--scale=<factor>] [--weighted-input=<weight>,<file>]... " <<
+      "[<file>...]\n" << "       " << pgm << " show <file>\n" << "       " << pgm <<
+      " order -o <output> [--linker-script=<file>] <call graph file>...\n";
+}
+
+bool StartsWith(const char *arg, const char *prefix) {
+  return strncmp(arg, prefix, strlen(prefix)) == 0;
+}
+
+bool ParseWeight(const std::string &str, uint64 &weight) {
+  char *endPtr = nullptr;
+  weight = std::strtoull(str.c_str(), &endPtr, 10);
+  return !str.empty() && *endPtr == '\0' && weight != 0;
+}
+
+int Merge(int argc, const char *argv[]) {
+  std::string output;
+  double scale = 1.0;
+  std::vector<std::pair<std::string, uint64>> inputs;
+  for (int i = 2; i < argc; ++i) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (StartsWith(argv[i], "--scale=")) {
+      char *endPtr = nullptr;
+      scale = std::strtod(argv[i] + strlen("--scale="), &endPtr);
+      if (*endPtr != '\0' || !(scale > 0)) {
+        std::cerr << "invalid scale factor " << argv[i] << '\n';
+        return 1;
+      }
+    } else if (StartsWith(argv[i], "--weighted-input=")) {
+      std::string arg = argv[i] + strlen("--weighted-input=");
+      size_t comma = arg.find(',');
+      uint64 weight = 0;
+      if (comma == std::string::npos || !ParseWeight(arg.substr(0, comma), weight)) {
+        std::cerr << "expect --weighted-input=<weight>,<file> with a positive weight\n";
+        return 1;
+      }
+      inputs.emplace_back(arg.substr(comma + 1), weight);
+    } else if (argv[i][0] != '-') {
+      inputs.emplace_back(argv[i], 1);
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (output.empty() || inputs.empty()) {
+    Usage(argv[0]);
+    return 1;
+  }
+  LitePgoProfData merged;
+  for (auto &input : inputs) {
+    LitePgoProfData profile;
+    std::string err;
+    if (!profile.Read(input.first, err)) {
+      std::cerr << "error: " << err << '\n';
+      return 1;
+    }
+    size_t mismatched = merged.Merge(profile, input.second);
+    if (mismatched != 0) {
+      std::cerr << "warning: " << input.first << ": " << mismatched <<
+          " functions dropped, their cfg hash differs from the previous inputs\n";
+    }
+  }
+  if (scale != 1.0) {
+    merged.Scale(scale);
+  }
+  std::string err;
+  if (!merged.WriteBinary(output, err)) {
+    std::cerr << "error: " << err << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+int Show(int argc, const char *argv[]) {
+  constexpr int kShowArgc = 3;
+  if (argc != kShowArgc) {
+    Usage(argv[0]);
+    return 1;
+  }
+  LitePgoProfData profile;
+  std::string err;
+  if (!profile.Read(argv[2], err)) {
+    std::cerr << "error: " << err << '\n';
+    return 1;
+  }
+  profile.DumpText(std::cout);
+  return 0;
+}
+
+int Order(int argc, const char *argv[]) {
+  std::string output;
+  std::string linkerScript;
+  std::vector<std::string> inputs;
+  for (int i = 2; i < argc; ++i) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (StartsWith(argv[i], "--linker-script=")) {
+      linkerScript = argv[i] + strlen("--linker-script=");
+    } else if (argv[i][0] != '-') {
+      inputs.emplace_back(argv[i]);
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (output.empty() || inputs.empty()) {
+    Usage(argv[0]);
+    return 1;
+  }
+  LitePgoCallGraph callGraph;
+  for (auto &input : inputs) {
+    std::string err;
+    if (!callGraph.Read(input, err)) {
+      std::cerr << "error: " << err << '\n';
+      return 1;
+    }
+  }
+  {
+    std::ofstream out(output, std::ios::out | std::ios::trunc);
+    callGraph.DumpReorderProfile(out);
+    out.close();
+    if (!out) {
+      std::cerr << "error: failed to write " << output << '\n';
+      return 1;
+    }
+  }
+  if (linkerScript.empty()) {
+    return 0;
+  }
+  std::map<std::string, uint32> order = ReorderAccordingProfile(output);
+  std::ofstream script(linkerScript, std::ios::out | std::ios::trunc);
+  callGraph.DumpLinkerScript(order, script);
+  script.close();
+  if (!script) {
+    std::cerr << "error: failed to write " << linkerScript << '\n';
+    return 1;
+  }
+  return 0;
+}
+}
+
+int main(int argc, const char *argv[]) {
+  constexpr int kMinArgc = 2;
+  if (argc < kMinArgc) {
+    Usage(argv[0]);
+    return 1;
+  }
+  if (strcmp(argv[1], "merge") == 0) {
+    return Merge(argc, argv);
+  }
+  if (strcmp(argv[1], "show") == 0) {
+    return Show(argc, argv);
+  }
+  if (strcmp(argv[1], "order") == 0) {
+    return Order(argc, argv);
+  }
+  Usage(argv[0]);
+  return 1;
+}
@@ -0,0 +1,75 @@
+#ifdef ENABLE_MAPLE_SAN
+
+#ifndef MAPLE_SAN_INCLUDE_ASAN_CHECK_OPT_H
+#define MAPLE_SAN_INCLUDE_ASAN_CHECK_OPT_H
+#include <string>
+#include <utility>
+#include <vector>
+#include "asan_function.h"
+#include "mir_builder.h"
+#include "san_common.h"
+
+namespace maple {
+struct AsanCheckStats {
+  uint64 numAccesses = 0;   // interesting memory accesses found
+  uint64 numRedundant = 0;  // accesses covered by a check executed before them
+  uint64 numMerged = 0;     // accesses folded into the widened check of a neighbouring access
+  uint64 numChecked = 0;    // accesses still instrumented
+
+  void Add(const AsanCheckStats &other);
+  void Dump(const std::string &title) const;
+  static AsanCheckStats &GetModuleStats();
+};
+
+using StmtAccesses = std::pair<StmtNode*, std::vector<MemoryAccess>>;
+
+// Drops the shadow checks made redundant by an earlier check of the same memory and widens the check of an access
+// to cover its neighbours on the same base pointer, e.g. the fields of one struct written in a row.
+// The sanitizer runs on the lowered MIR body before the CFG is built, so a check is only known to dominate the
+// statements following it in its extended basic block: availability flows through the fallthrough of conditional
+// branches and is dropped at labels, calls (which may free memory) and any statement not understood here.
+// Checks are only widened within a straight-line region, where the later access executes whenever the check does.
+class AsanCheckOptimizer {
+ public:
+  AsanCheckOptimizer(MIRFunction &func, MIRBuilder &mirBuilder, const PreAnalysis *preAnalysis, size_t granularity)
+      : func(func), mirBuilder(mirBuilder), preAnalysis(preAnalysis), granularity(granularity),
+        maxWidenBytes(granularity * 2) {}
+  ~AsanCheckOptimizer() = default;
+
+  // Filters the accesses of each statement in place, only counts them when not enabled.
+  void Run(std::vector<StmtAccesses> &stmtAccesses, bool enabled);
+
+  const AsanCheckStats &GetStats() const {
+    return stats;
+  }
+
+ private:
+  struct AvailCheck {
+    MemoryAccess *access;  // check as emitted, updated when widened
+    BaseNode *base;        // pointer the checked range is relative to
+    int64 offset;          // checked range in bytes from base
+    int64 size;
+    size_t alignment;      // of the address at offset
+    uint32 region;         // straight-line region the check is emitted in
+  };
+
+  bool Decompose(const MemoryAccess &access, BaseNode *&base, int64 &offset) const;
+  bool ChecksWholeRange(int64 size, size_t alignment) const;
+  bool IsCovered(const AvailCheck &check, const BaseNode &base, int64 offset, int64 size) const;
+  bool TryWiden(AvailCheck &check, const MemoryAccess &access, const BaseNode &base, int64 offset, int64 size);
+  void KillAfter(const StmtNode &stmt);
+  bool IsPrivateVar(StIdx stIdx) const;
+
+  MIRFunction &func;
+  MIRBuilder &mirBuilder;
+  const PreAnalysis *preAnalysis;
+  size_t granularity;
+  size_t maxWidenBytes;
+  uint32 curRegion = 0;
+  std::vector<AvailCheck> availChecks;
+  AsanCheckStats stats;
+};
+}  // namespace maple
+#endif  // MAPLE_SAN_INCLUDE_ASAN_CHECK_OPT_H
+
+#endif
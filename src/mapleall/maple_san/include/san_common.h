@@ -2,6 +2,7 @@
 
 #ifndef MAPLE_SAN_INCLUDE_SAN_COMMON_H
 #define MAPLE_SAN_INCLUDE_SAN_COMMON_H
+#include <functional>
 #include "me_function.h"
 #include "me_phase_manager.h"
 #include "mir_builder.h"
@@ -136,6 +137,23 @@ MIRSymbol *getOrCreateSymbol(MIRBuilder *mirBuilder, const TyIdx tyIdx, const st
 
 ASanStackFrameLayout ComputeASanStackFrameLayout(std::vector<ASanStackVariableDescription> &Vars, size_t Granularity,
                                                  size_t MinHeaderSize);
+
+// bit of --sanitizer which keeps every check, i.e. turns the redundant check elimination of the sanitizers off
+constexpr uint32 kSanNoCheckOpt = 0x08;
+
+bool ExprUsesVar(const BaseNode &expr, StIdx stIdx);
+
+bool ExprUsesPreg(const BaseNode &expr, PregIdx regIdx);
+
+// Whether expr reads memory which a store may change, a variable is read from memory unless isPrivateVar says only
+// a direct assignment can change it.
+bool ExprMayReadMemory(const BaseNode &expr, const std::function<bool(StIdx)> &isPrivateVar);
+
+// Whether expr, computed before stmt, may have another value after it. The checks of the sanitizers stay available
+// along the statement list while no statement changes what they read, anything but an assignment, a store, a
+// conditional branch, an eval or a comment changes everything.
+bool StmtMayChangeExpr(const StmtNode &stmt, const BaseNode &expr, const std::function<bool(StIdx)> &isPrivateVar);
+
 // Start of Sanrazor
 int SANRAZOR_MODE();
 CallNode *retCallCOV(const MeFunction &func, int bb_id, int stmt_id, int br_true, int type_of_check);
@@ -9,6 +9,7 @@
 #include "me_phase_manager.h"
 #include "mir_builder.h"
 #include "mir_module.h"
+#include "ubsan_bounds_opt.h"
 
 namespace maple {
 
@@ -28,6 +29,14 @@ class ArrayInfo {
   std::string GetArrayTypeName(size_t dim);
 };
 
+// An index check emitted before, still valid while none of the variables the index reads is redefined
+struct AvailBoundCheck {
+  const MIRArrayType *arrayType;
+  size_t dim;
+  const BaseNode *index;
+  size_t neededSize;
+};
+
 class BoundCheck {
  public:
   BoundCheck(MeFunction *func);
@@ -37,6 +46,9 @@ class BoundCheck {
   void getBoundsCheckCond(ArrayInfo *arrayInfo, BlockNode *body, size_t dim);
 
   std::vector<ArrayInfo> getArrayInfo(StmtNode *stmtNode);
+  bool isIndexInBounds(ArrayInfo &arrayInfo, size_t dim, const BoundsRangeAnalysis &rangeAnalysis);
+  bool isCheckAvailable(ArrayInfo &arrayInfo, size_t dim, const BoundsRangeAnalysis &rangeAnalysis);
+  void killAvailChecks(const StmtNode &stmt, const BoundsRangeAnalysis &rangeAnalysis);
 
   MeFunction *func;
   MIRBuilder *mirBuilder;
@@ -52,6 +64,8 @@ class BoundCheck {
   MIRSymbol *sourceLoc;
   MIRSymbol *arrayType;
   MIRSymbol *indexType;
+
+  std::vector<AvailBoundCheck> availChecks;
 };
 }  // namespace maple
 #endif  // MAPLE_SAN_UBSAN_BOUNDS_H
@@ -0,0 +1,82 @@
+#ifdef ENABLE_MAPLE_SAN
+
+#ifndef MAPLE_SAN_INCLUDE_UBSAN_BOUNDS_OPT_H
+#define MAPLE_SAN_INCLUDE_UBSAN_BOUNDS_OPT_H
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "mir_function.h"
+#include "mir_nodes.h"
+
+namespace maple {
+struct IndexRange {
+  int64 lo;
+  int64 hi;
+
+  bool IsEmpty() const {
+    return lo > hi;
+  }
+
+  static IndexRange Full() {
+    return { INT64_MIN, INT64_MAX };
+  }
+
+  static IndexRange OfPrimType(PrimType primType);
+};
+
+// whether neededSize bytes accessed at any index of range stay within an array of dimension elements of elemSize
+bool IsIndexRangeInBounds(const IndexRange &range, uint64 elemSize, uint64 dimension, uint64 neededSize);
+
+// Interval range propagation over the lowered MIR body, used to prove array indices in bounds.
+// The sanitizers run before the ME CFG and SSA are built, so blocks are delimited by labels and the edges follow
+// the gotos and branches of the statement list. Only integer locals whose address is never taken and pregs are
+// tracked, ranges are narrowed on branch conditions comparing them, widened at loop heads and narrowed back by a
+// couple of descending passes. Bodies with control flow not understood here (igoto, try) are not analyzed.
+class BoundsRangeAnalysis {
+ public:
+  explicit BoundsRangeAnalysis(MIRFunction &func);
+  ~BoundsRangeAnalysis() = default;
+
+  // queries map a statement to the expressions whose range right before it is wanted
+  void Run(const std::unordered_map<const StmtNode*, std::vector<const BaseNode*>> &queries);
+
+  // returns false when nothing is known about expr
+  bool GetRange(const BaseNode &expr, IndexRange &range) const;
+
+  // integer locals whose address is never taken, only direct assignments change them
+  bool IsPrivateVar(StIdx stIdx) const;
+
+ private:
+  struct RangeEnv {
+    bool reachable = false;
+    std::map<uint64, IndexRange> ranges;  // keyed by GetKey, missing keys are not bounded beyond their type
+  };
+  using QueryMap = std::unordered_map<const StmtNode*, std::vector<const BaseNode*>>;
+
+  bool Init();
+  void ProcessBlock(size_t blockId, const QueryMap *queries);
+  void PropagateToLabel(LabelIdx label, const RangeEnv &env);
+  void Propagate(size_t blockId, const RangeEnv &env);
+  bool JoinInto(RangeEnv &target, const RangeEnv &env, bool widen) const;
+  void Transfer(const StmtNode &stmt, RangeEnv &env) const;
+  RangeEnv FilterByCond(const RangeEnv &env, const BaseNode &cond, bool isTrue) const;
+  IndexRange Eval(const BaseNode &expr, const RangeEnv &env) const;
+  IndexRange EvalBinary(const BaseNode &expr, const RangeEnv &env) const;
+  bool GetKey(const BaseNode &expr, uint64 &key) const;
+
+  MIRFunction &func;
+  std::set<uint32> addrTakenVars;  // FullIdx of the locals whose address is taken
+  std::vector<StmtNode*> stmts;
+  std::vector<size_t> blockStarts;  // index in stmts of the first statement of each block
+  std::unordered_map<LabelIdx, size_t> label2Block;
+  std::vector<RangeEnv> inEnvs;
+  std::vector<uint32> visits;
+  std::vector<size_t> worklist;
+  std::vector<RangeEnv> *collectEnvs = nullptr;  // edges are joined here instead of inEnvs when set
+  std::unordered_map<const BaseNode*, IndexRange> results;
+};
+}  // namespace maple
+#endif  // MAPLE_SAN_INCLUDE_UBSAN_BOUNDS_OPT_H
+
+#endif
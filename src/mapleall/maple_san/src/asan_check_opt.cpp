@@ -0,0 +1,201 @@
+#ifdef ENABLE_MAPLE_SAN
+
+#include "asan_check_opt.h"
+
+#include <algorithm>
+
+#include "mpl_logging.h"
+
+namespace maple {
+void AsanCheckStats::Add(const AsanCheckStats &other) {
+  numAccesses += other.numAccesses;
+  numRedundant += other.numRedundant;
+  numMerged += other.numMerged;
+  numChecked += other.numChecked;
+}
+
+void AsanCheckStats::Dump(const std::string &title) const {
+  LogInfo::MapleLogger() << title << ": " << numAccesses << " accesses, " << numRedundant << " redundant, "
+                         << numMerged << " merged, " << numChecked << " checked\n";
+}
+
+AsanCheckStats &AsanCheckStats::GetModuleStats() {
+  static AsanCheckStats moduleStats;
+  return moduleStats;
+}
+
+void AsanCheckOptimizer::Run(std::vector<StmtAccesses> &stmtAccesses, bool enabled) {
+  for (auto &stmtAccess : stmtAccesses) {
+    stats.numAccesses += stmtAccess.second.size();
+  }
+  if (!enabled) {
+    stats.numChecked = stats.numAccesses;
+    return;
+  }
+  // accesses are only erased at the end, availChecks points into the vectors
+  std::vector<std::vector<bool>> dropped(stmtAccesses.size());
+  for (size_t i = 0; i < stmtAccesses.size(); ++i) {
+    StmtNode &stmt = *stmtAccesses[i].first;
+    std::vector<MemoryAccess> &accesses = stmtAccesses[i].second;
+    if (stmt.GetOpCode() == OP_label) {
+      availChecks.clear();
+      ++curRegion;
+    }
+    dropped[i].resize(accesses.size(), false);
+    for (size_t j = 0; j < accesses.size(); ++j) {
+      BaseNode *base = nullptr;
+      int64 offset = 0;
+      if (!Decompose(accesses[j], base, offset)) {
+        continue;
+      }
+      int64 size = static_cast<int64>(accesses[j].typeSize >> 3);
+      auto covered = std::find_if(availChecks.begin(), availChecks.end(), [this, base, offset, size](
+          const AvailCheck &check) { return IsCovered(check, *base, offset, size); });
+      if (covered != availChecks.end()) {
+        dropped[i][j] = true;
+        ++stats.numRedundant;
+        continue;
+      }
+      auto widened = std::find_if(availChecks.begin(), availChecks.end(), [this, &accesses, j, base, offset, size](
+          AvailCheck &check) { return TryWiden(check, accesses[j], *base, offset, size); });
+      if (widened != availChecks.end()) {
+        dropped[i][j] = true;
+        ++stats.numMerged;
+        continue;
+      }
+      availChecks.push_back({ &accesses[j], base, offset, size, accesses[j].alignment, curRegion });
+    }
+    KillAfter(stmt);
+  }
+  for (size_t i = 0; i < stmtAccesses.size(); ++i) {
+    std::vector<MemoryAccess> &accesses = stmtAccesses[i].second;
+    size_t kept = 0;
+    for (size_t j = 0; j < accesses.size(); ++j) {
+      if (!dropped[i][j]) {
+        accesses[kept++] = accesses[j];
+      }
+    }
+    accesses.resize(kept);
+    stats.numChecked += kept;
+  }
+  availChecks.clear();
+}
+
+// Splits the checked address into a base pointer and a constant byte offset.
+bool AsanCheckOptimizer::Decompose(const MemoryAccess &access, BaseNode *&base, int64 &offset) const {
+  if (access.ptrOperand->GetOpCode() != OP_iaddrof || access.typeSize == 0 || access.typeSize % 8 != 0) {
+    return false;
+  }
+  auto *iaddrof = static_cast<IreadNode*>(access.ptrOperand);
+  offset = 0;
+  if (iaddrof->GetFieldID() != 0) {
+    MIRType *type = GlobalTables::GetTypeTable().GetTypeFromTyIdx(iaddrof->GetTyIdx());
+    if (type == nullptr || type->GetKind() != kTypePointer) {
+      return false;
+    }
+    MIRType *pointedTy = static_cast<MIRPtrType*>(type)->GetPointedType();
+    if (pointedTy == nullptr || !pointedTy->IsStructType()) {
+      return false;
+    }
+    auto *structTy = static_cast<MIRStructType*>(pointedTy);
+    MIRType *fieldTy = structTy->GetFieldType(iaddrof->GetFieldID());
+    int64 bitOffset = structTy->GetBitOffsetFromBaseAddr(iaddrof->GetFieldID());
+    if (fieldTy == nullptr || fieldTy->GetKind() == kTypeBitField || bitOffset < 0 || bitOffset % 8 != 0) {
+      return false;
+    }
+    offset = bitOffset / 8;
+  }
+  base = iaddrof->Opnd(0);
+  if (base->GetOpCode() == OP_add && base->Opnd(1)->GetOpCode() == OP_constval) {
+    auto *intConst = dynamic_cast<MIRIntConst*>(static_cast<ConstvalNode*>(base->Opnd(1))->GetConstVal());
+    if (intConst != nullptr) {
+      offset += intConst->GetExtValue();
+      base = base->Opnd(0);
+    }
+  }
+  return true;
+}
+
+// A check of unusual size or alignment only looks at the shadow of its first and last byte. It checks its whole
+// range only when the range spans at most two granules: one granule at most, or two from a granule boundary.
+bool AsanCheckOptimizer::ChecksWholeRange(int64 size, size_t alignment) const {
+  return size <= static_cast<int64>(granularity) ||
+         (size <= static_cast<int64>(maxWidenBytes) && alignment >= granularity);
+}
+
+bool AsanCheckOptimizer::IsCovered(const AvailCheck &check, const BaseNode &base, int64 offset, int64 size) const {
+  if (!check.base->IsSameContent(&base) || offset < check.offset || offset + size > check.offset + check.size) {
+    return false;
+  }
+  return (offset == check.offset && size == check.size) || ChecksWholeRange(check.size, check.alignment);
+}
+
+bool AsanCheckOptimizer::TryWiden(AvailCheck &check, const MemoryAccess &access, const BaseNode &base,
+                                  int64 offset, int64 size) {
+  if (check.region != curRegion || !check.base->IsSameContent(&base)) {
+    return false;
+  }
+  int64 start = std::min(check.offset, offset);
+  int64 end = std::max(check.offset + check.size, offset + size);
+  size_t startAlignment = 0;
+  if (start == check.offset) {
+    startAlignment = check.alignment;
+  }
+  if (start == offset) {
+    startAlignment = std::max(startAlignment, access.alignment);
+  }
+  if (!ChecksWholeRange(end - start, startAlignment)) {
+    return false;
+  }
+  MemoryAccess &checked = *check.access;
+  size_t alignment = 1;
+  if (start == check.offset && checked.alignment >= static_cast<size_t>(end - start)) {
+    alignment = checked.alignment;
+  } else if (start == offset && access.alignment >= static_cast<size_t>(end - start)) {
+    alignment = access.alignment;
+  }
+  if (start != check.offset) {
+    // rebuild the address from the base of the emitted check, the base of access belongs to a later statement
+    checked.ptrOperand = mirBuilder.CreateExprBinary(OP_add, *GlobalTables::GetTypeTable().GetUInt64(), check.base,
+                                                     mirBuilder.CreateIntConst(static_cast<uint64>(start), PTY_u64));
+  }
+  checked.typeSize = static_cast<uint64_t>(end - start) << 3;
+  checked.alignment = alignment;
+  check.offset = start;
+  check.size = end - start;
+  check.alignment = startAlignment;
+  return true;
+}
+
+void AsanCheckOptimizer::KillAfter(const StmtNode &stmt) {
+  auto isPrivateVar = [this](StIdx stIdx) { return IsPrivateVar(stIdx); };
+  (void)availChecks.erase(std::remove_if(availChecks.begin(), availChecks.end(), [&stmt, &isPrivateVar](
+      const AvailCheck &check) { return StmtMayChangeExpr(stmt, *check.base, isPrivateVar); }), availChecks.end());
+  switch (stmt.GetOpCode()) {
+    case OP_dassign:
+    case OP_regassign:
+    case OP_iassign:
+    case OP_iassignoff:
+    case OP_eval:
+    case OP_comment:
+      break;
+    default:
+      // the fallthrough of a branch is only reached from there, the checks left stay available but may not be
+      // widened past it
+      ++curRegion;
+      break;
+  }
+}
+
+// Locals whose address is never taken can only be changed by a direct assignment.
+bool AsanCheckOptimizer::IsPrivateVar(StIdx stIdx) const {
+  if (stIdx.IsGlobal() || preAnalysis == nullptr) {
+    return false;
+  }
+  const MIRSymbol *symbol = func.GetLocalOrGlobalSymbol(stIdx);
+  return symbol != nullptr && std::find(preAnalysis->usedInAddrof.begin(), preAnalysis->usedInAddrof.end(),
+                                        symbol) == preAnalysis->usedInAddrof.end();
+}
+}  // namespace maple
+
+#endif
@@ -7,10 +7,12 @@
 #include <stack>
 #include <typeinfo>
 
+#include "asan_check_opt.h"
 #include "asan_interfaces.h"
 #include "asan_stackvar.h"
 #include "me_cfg.h"
 #include "me_function.h"
+#include "me_option.h"
 #include "mir_builder.h"
 #include "mpl_logging.h"
 #include "opcode_info.h"
@@ -91,12 +93,24 @@ bool AddressSanitizer::instrumentFunction(MeFunction &mefunc) {
 
   int numInstrumented = 0;
 
+  std::vector<StmtAccesses> stmtAccesses;
+  std::vector<bool> isMemIntrinsicCand;
   for (auto stmt : toInstrument) {
-    std::vector<MemoryAccess> memAccVec = isInterestingMemoryAccess(stmt);
-    if (memAccVec.size() > 0) {
-      instrumentMop(stmt, memAccVec);
-    } else {
-      instrumentMemIntrinsic(dynamic_cast<IntrinsiccallNode *>(stmt));
+    stmtAccesses.emplace_back(stmt, isInterestingMemoryAccess(stmt));
+    isMemIntrinsicCand.push_back(stmtAccesses.back().second.empty());
+  }
+  AsanCheckOptimizer checkOpt(*mefunc.GetMirFunc(), *builder, preAnalysis, 1ULL << Mapping.Scale);
+  checkOpt.Run(stmtAccesses, (MeOption::asanFlags & kSanNoCheckOpt) == 0);
+  if (!MeOption::quiet && (MeOption::asanFlags & 0x01) > 0) {
+    checkOpt.GetStats().Dump("ASAN checks in " + mefunc.GetName());
+  }
+  AsanCheckStats::GetModuleStats().Add(checkOpt.GetStats());
+
+  for (size_t i = 0; i < stmtAccesses.size(); ++i) {
+    if (stmtAccesses[i].second.size() > 0) {
+      instrumentMop(stmtAccesses[i].first, stmtAccesses[i].second);
+    } else if (isMemIntrinsicCand[i]) {
+      instrumentMemIntrinsic(dynamic_cast<IntrinsiccallNode *>(stmtAccesses[i].first));
     }
     numInstrumented++;
   }
@@ -230,6 +230,83 @@ MIRSymbol *getOrCreateSymbol(MIRBuilder *mirBuilder, const TyIdx tyIdx, const st
 }
 
 // Code for Sanrazor
+bool ExprUsesVar(const BaseNode &expr, StIdx stIdx) {
+  if (expr.GetOpCode() == OP_dread && static_cast<const AddrofNode&>(expr).GetStIdx() == stIdx) {
+    return true;
+  }
+  if (expr.GetOpCode() == OP_dreadoff && static_cast<const DreadoffNode&>(expr).stIdx == stIdx) {
+    return true;
+  }
+  for (size_t i = 0; i < expr.NumOpnds(); ++i) {
+    if (ExprUsesVar(*expr.Opnd(i), stIdx)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ExprUsesPreg(const BaseNode &expr, PregIdx regIdx) {
+  if (expr.GetOpCode() == OP_regread && static_cast<const RegreadNode&>(expr).GetRegIdx() == regIdx) {
+    return true;
+  }
+  for (size_t i = 0; i < expr.NumOpnds(); ++i) {
+    if (ExprUsesPreg(*expr.Opnd(i), regIdx)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ExprMayReadMemory(const BaseNode &expr, const std::function<bool(StIdx)> &isPrivateVar) {
+  switch (expr.GetOpCode()) {
+    case OP_iread:
+    case OP_ireadoff:
+    case OP_ireadfpoff:
+    case OP_ireadpcoff:
+      return true;
+    case OP_dread:
+      if (!isPrivateVar(static_cast<const AddrofNode&>(expr).GetStIdx())) {
+        return true;
+      }
+      break;
+    case OP_dreadoff:
+      if (!isPrivateVar(static_cast<const DreadoffNode&>(expr).stIdx)) {
+        return true;
+      }
+      break;
+    default:
+      break;
+  }
+  for (size_t i = 0; i < expr.NumOpnds(); ++i) {
+    if (ExprMayReadMemory(*expr.Opnd(i), isPrivateVar)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StmtMayChangeExpr(const StmtNode &stmt, const BaseNode &expr, const std::function<bool(StIdx)> &isPrivateVar) {
+  switch (stmt.GetOpCode()) {
+    case OP_dassign: {
+      StIdx stIdx = static_cast<const DassignNode&>(stmt).GetStIdx();
+      return ExprUsesVar(expr, stIdx) || (!isPrivateVar(stIdx) && ExprMayReadMemory(expr, isPrivateVar));
+    }
+    case OP_regassign:
+      return ExprUsesPreg(expr, static_cast<const RegassignNode&>(stmt).GetRegIdx());
+    case OP_iassign:
+    case OP_iassignoff:
+      return ExprMayReadMemory(expr, isPrivateVar);
+    case OP_brtrue:
+    case OP_brfalse:
+    case OP_eval:
+    case OP_comment:
+      return false;
+    default:
+      // calls may free memory, anything else may transfer control or define variables behind our back
+      return true;
+  }
+}
+
 int SANRAZOR_MODE() {
   /*
   Sanrazor has several mode
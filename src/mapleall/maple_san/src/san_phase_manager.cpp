@@ -1,6 +1,7 @@
 #ifdef ENABLE_MAPLE_SAN
 
 #include "san_phase_manager.h"
+#include "asan_check_opt.h"
 #include "asan_phases.h"
 #include "ubsan_phases.h"
 
@@ -74,6 +75,9 @@ bool MEModuleDoAsan::PhaseRun(maple::MIRModule &m) {
       serialADM->EraseAllAnalysisPhase();
     }
   }
+  if (!IsQuiet() && (MeOption::asanFlags & 0x01) > 0) {
+    AsanCheckStats::GetModuleStats().Dump("ASAN checks in module");
+  }
   m.Emit("comb.san.mpl");
   return changed;
 }
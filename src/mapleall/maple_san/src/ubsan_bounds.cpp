@@ -4,7 +4,11 @@
 #ifdef ENABLE_MAPLE_SAN
 
 #include "ubsan_bounds.h"
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
 #include "me_function.h"
+#include "me_option.h"
 #include "mir_builder.h"
 #include "san_common.h"
 
@@ -433,20 +437,81 @@ namespace maple {
 
   }
 
+  bool BoundCheck::isIndexInBounds(ArrayInfo &arrayInfo, size_t dim, const BoundsRangeAnalysis &rangeAnalysis) {
+    IndexRange range;
+    if (!rangeAnalysis.GetRange(*arrayInfo.offset[dim], range)) {
+      return false;
+    }
+    return IsIndexRangeInBounds(range, arrayInfo.GetElementSize(), arrayInfo.dimensions[dim], arrayInfo.neededSize);
+  }
+
+  bool BoundCheck::isCheckAvailable(ArrayInfo &arrayInfo, size_t dim, const BoundsRangeAnalysis &rangeAnalysis) {
+    const BaseNode *index = arrayInfo.offset[dim];
+    for (const AvailBoundCheck &check : availChecks) {
+      if (check.arrayType == arrayInfo.arrayType && check.dim == dim && check.neededSize >= arrayInfo.neededSize &&
+          check.index->IsSameContent(index)) {
+        return true;
+      }
+    }
+    availChecks.push_back({arrayInfo.arrayType, dim, index, arrayInfo.neededSize});
+    return false;
+  }
+
+  // Same availability rules as the ASan check elimination: checks flow along the fallthrough of the statement
+  // list and are dropped at labels and at statements which may change what the index reads.
+  void BoundCheck::killAvailChecks(const StmtNode &stmt, const BoundsRangeAnalysis &rangeAnalysis) {
+    auto isPrivateVar = [&rangeAnalysis](StIdx stIdx) { return rangeAnalysis.IsPrivateVar(stIdx); };
+    (void)availChecks.erase(std::remove_if(availChecks.begin(), availChecks.end(),
+        [&stmt, &isPrivateVar](const AvailBoundCheck &check) {
+          return StmtMayChangeExpr(stmt, *check.index, isPrivateVar);
+        }), availChecks.end());
+  }
+
   bool BoundCheck::addBoundsChecking() {
+    std::vector<std::pair<StmtNode *, std::vector<ArrayInfo>>> stmtArrays;
+    std::unordered_map<const StmtNode *, std::vector<const BaseNode *>> indexQueries;
     for (auto &stmt : func->GetMirFunc()->GetBody()->GetStmtNodes()) {
-      std::vector<ArrayInfo> toBeChecked = getArrayInfo(&stmt);
-      if (toBeChecked.empty()) {
-        continue;
+      stmtArrays.emplace_back(&stmt, getArrayInfo(&stmt));
+      for (ArrayInfo &arrayInfo : stmtArrays.back().second) {
+        indexQueries[&stmt].insert(indexQueries[&stmt].end(), arrayInfo.offset.begin(), arrayInfo.offset.end());
+      }
+    }
+    bool optimize = (MeOption::asanFlags & kSanNoCheckOpt) == 0;
+    BoundsRangeAnalysis rangeAnalysis(*func->GetMirFunc());
+    if (optimize && !indexQueries.empty()) {
+      rangeAnalysis.Run(indexQueries);
+    }
+    size_t numIndices = 0;
+    size_t numInBounds = 0;
+    size_t numRedundant = 0;
+    availChecks.clear();
+    for (auto &stmtArray : stmtArrays) {
+      StmtNode *stmt = stmtArray.first;
+      if (stmt->GetOpCode() == OP_label) {
+        availChecks.clear();
       }
-      for (ArrayInfo arrayInfo: toBeChecked) {
-        if (arrayInfo.offset.size()) {
-          for (size_t i = 0; i < arrayInfo.offset.size(); i++) {
+      for (ArrayInfo arrayInfo : stmtArray.second) {
+        for (size_t i = 0; i < arrayInfo.offset.size(); i++) {
+          ++numIndices;
+          if (optimize && isIndexInBounds(arrayInfo, i, rangeAnalysis)) {
+            ++numInBounds;
+          } else if (optimize && isCheckAvailable(arrayInfo, i, rangeAnalysis)) {
+            ++numRedundant;
+          } else {
             getBoundsCheckCond(&arrayInfo, func->GetMirFunc()->GetBody(), i);
             insertBoundsCheck(&arrayInfo, i);
+            continue;
           }
+          // keep checks indexed by dim
+          arrayInfo.checks.push_back({});
         }
       }
+      killAvailChecks(*stmt, rangeAnalysis);
+    }
+    if (!MeOption::quiet && (MeOption::asanFlags & 0x01) > 0) {
+      LogInfo::MapleLogger() << "UBSAN bound checks in " << func->GetName() << ": " << numIndices << " indices, "
+                             << numInBounds << " in bounds, " << numRedundant << " redundant, "
+                             << (numIndices - numInBounds - numRedundant) << " checked\n";
     }
     return true;
   }
@@ -0,0 +1,576 @@
+#ifdef ENABLE_MAPLE_SAN
+
+#include "ubsan_bounds_opt.h"
+
+#include <algorithm>
+
+#include "mir_type.h"
+
+namespace maple {
+namespace {
+constexpr uint32 kWidenAfterVisits = 3;
+constexpr uint32 kNarrowPasses = 2;
+constexpr uint64 kVarKeyFlag = 1ULL << 32;
+constexpr uint32 kMaxBitsOfRange = 63;
+
+IndexRange SignedRangeOfBits(uint32 bits) {
+  if (bits == 0 || bits > kMaxBitsOfRange) {
+    return IndexRange::Full();
+  }
+  return { -(1LL << (bits - 1)), (1LL << (bits - 1)) - 1 };
+}
+
+IndexRange UnsignedRangeOfBits(uint32 bits) {
+  if (bits == 0 || bits > kMaxBitsOfRange) {
+    return IndexRange::Full();
+  }
+  return { 0, static_cast<int64>((1ULL << bits) - 1) };
+}
+
+bool IsWithin(const IndexRange &range, const IndexRange &limit) {
+  return range.lo >= limit.lo && range.hi <= limit.hi;
+}
+
+// a value out of the range of its type has wrapped around, nothing is known about it anymore
+IndexRange Clamp(const IndexRange &range, PrimType primType) {
+  IndexRange typeRange = IndexRange::OfPrimType(primType);
+  return IsWithin(range, typeRange) ? range : typeRange;
+}
+
+bool IsConst(const IndexRange &range, int64 &value) {
+  value = range.lo;
+  return range.lo == range.hi;
+}
+
+Opcode NegateCmp(Opcode op) {
+  switch (op) {
+    case OP_lt: return OP_ge;
+    case OP_le: return OP_gt;
+    case OP_gt: return OP_le;
+    case OP_ge: return OP_lt;
+    case OP_eq: return OP_ne;
+    case OP_ne: return OP_eq;
+    default: return op;
+  }
+}
+
+Opcode SwapCmp(Opcode op) {
+  switch (op) {
+    case OP_lt: return OP_gt;
+    case OP_le: return OP_ge;
+    case OP_gt: return OP_lt;
+    case OP_ge: return OP_le;
+    default: return op;
+  }
+}
+}  // anonymous namespace
+
+IndexRange IndexRange::OfPrimType(PrimType primType) {
+  if (!IsPrimitiveInteger(primType)) {
+    return Full();
+  }
+  uint32 bits = GetPrimTypeBitSize(primType);
+  return IsUnsignedInteger(primType) ? UnsignedRangeOfBits(bits) : SignedRangeOfBits(bits);
+}
+
+bool IsIndexRangeInBounds(const IndexRange &range, uint64 elemSize, uint64 dimension, uint64 neededSize) {
+  if (range.IsEmpty() || range.lo < 0 || elemSize == 0) {
+    return false;
+  }
+  // the conditions of the emitted check hold for the largest index
+  uint64 size = elemSize * dimension;
+  if (static_cast<uint64>(range.hi) > dimension) {
+    return false;
+  }
+  return size - static_cast<uint64>(range.hi) * elemSize >= neededSize;
+}
+
+BoundsRangeAnalysis::BoundsRangeAnalysis(MIRFunction &func) : func(func) {
+  std::vector<const BaseNode*> nodes;
+  for (StmtNode &stmt : func.GetBody()->GetStmtNodes()) {
+    nodes.push_back(&stmt);
+  }
+  while (!nodes.empty()) {
+    const BaseNode *node = nodes.back();
+    nodes.pop_back();
+    if (node->GetOpCode() == OP_addrof) {
+      (void)addrTakenVars.insert(static_cast<const AddrofNode*>(node)->GetStIdx().FullIdx());
+    } else if (node->GetOpCode() == OP_addrofoff) {
+      (void)addrTakenVars.insert(static_cast<const AddrofoffNode*>(node)->stIdx.FullIdx());
+    }
+    for (size_t i = 0; i < node->NumOpnds(); ++i) {
+      nodes.push_back(node->Opnd(i));
+    }
+  }
+}
+
+bool BoundsRangeAnalysis::IsPrivateVar(StIdx stIdx) const {
+  if (stIdx.IsGlobal() || addrTakenVars.count(stIdx.FullIdx()) != 0) {
+    return false;
+  }
+  const MIRSymbol *symbol = func.GetLocalOrGlobalSymbol(stIdx);
+  return symbol != nullptr && !symbol->IsVolatile() && symbol->GetType()->GetKind() == kTypeScalar &&
+         IsPrimitiveInteger(symbol->GetType()->GetPrimType());
+}
+
+bool BoundsRangeAnalysis::Init() {
+  for (StmtNode &stmt : func.GetBody()->GetStmtNodes()) {
+    switch (stmt.GetOpCode()) {
+      case OP_igoto:
+      case OP_multiway:
+      case OP_try:
+      case OP_cpptry:
+      case OP_jstry:
+      case OP_catch:
+      case OP_cppcatch:
+      case OP_jscatch:
+      case OP_gosub:
+      case OP_retsub:
+        return false;
+      default:
+        break;
+    }
+    stmts.push_back(&stmt);
+  }
+  if (stmts.empty()) {
+    return false;
+  }
+  blockStarts.push_back(0);
+  for (size_t i = 0; i < stmts.size(); ++i) {
+    if (stmts[i]->GetOpCode() != OP_label) {
+      continue;
+    }
+    if (i != 0) {
+      blockStarts.push_back(i);
+    }
+    label2Block[static_cast<LabelNode*>(stmts[i])->GetLabelIdx()] = blockStarts.size() - 1;
+  }
+  inEnvs.resize(blockStarts.size());
+  visits.resize(blockStarts.size(), 0);
+  return true;
+}
+
+void BoundsRangeAnalysis::Run(const QueryMap &queries) {
+  if (!Init()) {
+    return;
+  }
+  RangeEnv entryEnv;
+  entryEnv.reachable = true;
+  inEnvs[0] = entryEnv;
+  worklist.push_back(0);
+  while (!worklist.empty()) {
+    size_t blockId = worklist.back();
+    worklist.pop_back();
+    ProcessBlock(blockId, nullptr);
+  }
+  // descending passes recover the bounds lost to widening, each one stays above the least fixed point
+  for (uint32 pass = 0; pass < kNarrowPasses; ++pass) {
+    std::vector<RangeEnv> narrowedEnvs(inEnvs.size());
+    narrowedEnvs[0] = entryEnv;
+    collectEnvs = &narrowedEnvs;
+    for (size_t blockId = 0; blockId < inEnvs.size(); ++blockId) {
+      ProcessBlock(blockId, nullptr);
+    }
+    inEnvs.swap(narrowedEnvs);
+  }
+  std::vector<RangeEnv> discardedEnvs(inEnvs.size());
+  collectEnvs = &discardedEnvs;
+  for (size_t blockId = 0; blockId < inEnvs.size(); ++blockId) {
+    ProcessBlock(blockId, &queries);
+  }
+  collectEnvs = nullptr;
+}
+
+bool BoundsRangeAnalysis::GetRange(const BaseNode &expr, IndexRange &range) const {
+  auto it = results.find(&expr);
+  if (it == results.end()) {
+    return false;
+  }
+  range = it->second;
+  return true;
+}
+
+void BoundsRangeAnalysis::ProcessBlock(size_t blockId, const QueryMap *queries) {
+  RangeEnv env = inEnvs[blockId];
+  size_t end = blockId + 1 < blockStarts.size() ? blockStarts[blockId + 1] : stmts.size();
+  for (size_t i = blockStarts[blockId]; i < end && env.reachable; ++i) {
+    StmtNode &stmt = *stmts[i];
+    if (queries != nullptr) {
+      auto it = queries->find(&stmt);
+      if (it != queries->end()) {
+        for (const BaseNode *expr : it->second) {
+          results[expr] = Eval(*expr, env);
+        }
+      }
+    }
+    switch (stmt.GetOpCode()) {
+      case OP_brtrue:
+      case OP_brfalse: {
+        auto &condGoto = static_cast<CondGotoNode&>(stmt);
+        bool jumpIfTrue = stmt.GetOpCode() == OP_brtrue;
+        PropagateToLabel(condGoto.GetOffset(), FilterByCond(env, *condGoto.Opnd(0), jumpIfTrue));
+        env = FilterByCond(env, *condGoto.Opnd(0), !jumpIfTrue);
+        break;
+      }
+      case OP_goto:
+        PropagateToLabel(static_cast<GotoNode&>(stmt).GetOffset(), env);
+        env.reachable = false;
+        break;
+      case OP_switch: {
+        auto &switchNode = static_cast<SwitchNode&>(stmt);
+        PropagateToLabel(switchNode.GetDefaultLabel(), env);
+        for (const CasePair &casePair : switchNode.GetSwitchTable()) {
+          PropagateToLabel(casePair.second, env);
+        }
+        env.reachable = false;
+        break;
+      }
+      case OP_rangegoto:
+        for (const SmallCasePair &item : static_cast<RangeGotoNode&>(stmt).GetRangeGotoTable()) {
+          PropagateToLabel(item.second, env);
+        }
+        break;
+      case OP_return:
+      case OP_throw:
+        env.reachable = false;
+        break;
+      default:
+        Transfer(stmt, env);
+        break;
+    }
+  }
+  if (env.reachable && end < stmts.size()) {
+    Propagate(blockId + 1, env);
+  }
+}
+
+void BoundsRangeAnalysis::PropagateToLabel(LabelIdx label, const RangeEnv &env) {
+  auto it = label2Block.find(label);
+  if (it != label2Block.end()) {
+    Propagate(it->second, env);
+  }
+}
+
+void BoundsRangeAnalysis::Propagate(size_t blockId, const RangeEnv &env) {
+  if (!env.reachable) {
+    return;
+  }
+  if (collectEnvs != nullptr) {
+    (void)JoinInto((*collectEnvs)[blockId], env, false);
+    return;
+  }
+  if (JoinInto(inEnvs[blockId], env, visits[blockId] >= kWidenAfterVisits)) {
+    ++visits[blockId];
+    worklist.push_back(blockId);
+  }
+}
+
+bool BoundsRangeAnalysis::JoinInto(RangeEnv &target, const RangeEnv &env, bool widen) const {
+  if (!env.reachable) {
+    return false;
+  }
+  if (!target.reachable) {
+    target = env;
+    return true;
+  }
+  bool changed = false;
+  for (auto it = target.ranges.begin(); it != target.ranges.end();) {
+    auto found = env.ranges.find(it->first);
+    if (found == env.ranges.end()) {
+      it = target.ranges.erase(it);
+      changed = true;
+      continue;
+    }
+    IndexRange &range = it->second;
+    if (found->second.lo < range.lo) {
+      range.lo = widen ? INT64_MIN : found->second.lo;
+      changed = true;
+    }
+    if (found->second.hi > range.hi) {
+      range.hi = widen ? INT64_MAX : found->second.hi;
+      changed = true;
+    }
+    ++it;
+  }
+  return changed;
+}
+
+void BoundsRangeAnalysis::Transfer(const StmtNode &stmt, RangeEnv &env) const {
+  switch (stmt.GetOpCode()) {
+    case OP_dassign: {
+      auto &dassign = static_cast<const DassignNode&>(stmt);
+      if (dassign.GetFieldID() == 0 && IsPrivateVar(dassign.GetStIdx())) {
+        PrimType primType = func.GetLocalOrGlobalSymbol(dassign.GetStIdx())->GetType()->GetPrimType();
+        env.ranges[kVarKeyFlag | dassign.GetStIdx().FullIdx()] = Clamp(Eval(*dassign.GetRHS(), env), primType);
+      }
+      break;
+    }
+    case OP_regassign: {
+      auto &regassign = static_cast<const RegassignNode&>(stmt);
+      if (regassign.GetRegIdx() > 0) {
+        env.ranges[static_cast<uint64>(regassign.GetRegIdx())] =
+            Clamp(Eval(*regassign.Opnd(0), env), regassign.GetPrimType());
+      }
+      break;
+    }
+    // none of these can change a local whose address is not taken
+    case OP_iassign:
+    case OP_iassignoff:
+    case OP_call:
+    case OP_icall:
+    case OP_icallproto:
+    case OP_intrinsiccall:
+    case OP_intrinsiccallwithtype:
+    case OP_eval:
+    case OP_comment:
+    case OP_label:
+      break;
+    default:
+      env.ranges.clear();
+      break;
+  }
+}
+
+BoundsRangeAnalysis::RangeEnv BoundsRangeAnalysis::FilterByCond(const RangeEnv &env, const BaseNode &cond,
+                                                                bool isTrue) const {
+  RangeEnv result = env;
+  Opcode op = cond.GetOpCode();
+  if (op != OP_lt && op != OP_le && op != OP_gt && op != OP_ge && op != OP_eq && op != OP_ne) {
+    return result;
+  }
+  PrimType opndType = static_cast<const CompareNode&>(cond).GetOpndType();
+  if (!IsPrimitiveInteger(opndType)) {
+    return result;
+  }
+  bool isSigned = !IsUnsignedInteger(opndType);
+  uint32 bits = GetPrimTypeBitSize(opndType);
+  // values the other side must stay within for the comparison to order them as their ranges do
+  IndexRange cmpLimit = SignedRangeOfBits(bits);
+  if (!isSigned) {
+    cmpLimit.lo = 0;
+  }
+  Opcode relOp = isTrue ? op : NegateCmp(op);
+  for (size_t side = 0; side < 2; ++side) {
+    const BaseNode &opnd = *cond.Opnd(side);
+    uint64 key = 0;
+    if (!GetKey(opnd, key) || GetPrimTypeBitSize(opnd.GetPrimType()) != bits) {
+      continue;
+    }
+    IndexRange other = Eval(*cond.Opnd(1 - side), env);
+    IndexRange cur = Eval(opnd, env);
+    if (!IsWithin(other, cmpLimit) || (isSigned && !IsWithin(cur, cmpLimit))) {
+      continue;
+    }
+    IndexRange narrowed = cur;
+    // with an unsigned comparison a negative cur stands for a value above cmpLimit
+    switch (side == 0 ? relOp : SwapCmp(relOp)) {
+      case OP_lt:
+        narrowed.hi = std::min(cur.hi, other.hi - 1);
+        narrowed.lo = isSigned ? cur.lo : std::max<int64>(cur.lo, 0);
+        break;
+      case OP_le:
+        narrowed.hi = std::min(cur.hi, other.hi);
+        narrowed.lo = isSigned ? cur.lo : std::max<int64>(cur.lo, 0);
+        break;
+      case OP_gt:
+        if (isSigned || cur.lo >= 0) {
+          narrowed.lo = std::max(cur.lo, other.lo + 1);
+        }
+        break;
+      case OP_ge:
+        if (isSigned || cur.lo >= 0) {
+          narrowed.lo = std::max(cur.lo, other.lo);
+        }
+        break;
+      case OP_eq:
+        narrowed.lo = std::max(cur.lo, other.lo);
+        narrowed.hi = std::min(cur.hi, other.hi);
+        break;
+      default:
+        break;
+    }
+    if (narrowed.IsEmpty()) {
+      result.reachable = false;
+      return result;
+    }
+    result.ranges[key] = narrowed;
+  }
+  return result;
+}
+
+bool BoundsRangeAnalysis::GetKey(const BaseNode &expr, uint64 &key) const {
+  if (expr.GetOpCode() == OP_dread) {
+    auto &dread = static_cast<const AddrofNode&>(expr);
+    if (dread.GetFieldID() == 0 && IsPrivateVar(dread.GetStIdx())) {
+      key = kVarKeyFlag | dread.GetStIdx().FullIdx();
+      return true;
+    }
+  } else if (expr.GetOpCode() == OP_regread) {
+    PregIdx regIdx = static_cast<const RegreadNode&>(expr).GetRegIdx();
+    if (regIdx > 0) {
+      key = static_cast<uint64>(regIdx);
+      return true;
+    }
+  }
+  return false;
+}
+
+IndexRange BoundsRangeAnalysis::Eval(const BaseNode &expr, const RangeEnv &env) const {
+  PrimType primType = expr.GetPrimType();
+  switch (expr.GetOpCode()) {
+    case OP_constval: {
+      auto *intConst = dynamic_cast<const MIRIntConst*>(static_cast<const ConstvalNode&>(expr).GetConstVal());
+      if (intConst == nullptr) {
+        return IndexRange::Full();
+      }
+      if (IsUnsignedInteger(primType)) {
+        uint64 value = intConst->GetZXTValue();
+        return value > static_cast<uint64>(INT64_MAX) ? IndexRange::Full() :
+            IndexRange{ static_cast<int64>(value), static_cast<int64>(value) };
+      }
+      int64 value = intConst->GetExtValue();
+      return { value, value };
+    }
+    case OP_dread:
+    case OP_regread: {
+      uint64 key = 0;
+      if (GetKey(expr, key)) {
+        auto it = env.ranges.find(key);
+        if (it != env.ranges.end()) {
+          return Clamp(it->second, primType);
+        }
+      }
+      return IndexRange::OfPrimType(primType);
+    }
+    case OP_cvt: {
+      PrimType fromType = static_cast<const TypeCvtNode&>(expr).FromType();
+      if (!IsPrimitiveInteger(fromType)) {
+        return IndexRange::OfPrimType(primType);
+      }
+      return Clamp(Clamp(Eval(*expr.Opnd(0), env), fromType), primType);
+    }
+    case OP_sext:
+    case OP_zext:
+    case OP_extractbits: {
+      auto &extract = static_cast<const ExtractbitsNode&>(expr);
+      bool isZext = expr.GetOpCode() == OP_zext ||
+                    (expr.GetOpCode() == OP_extractbits && IsUnsignedInteger(primType));
+      IndexRange bitsRange = isZext ? UnsignedRangeOfBits(extract.GetBitsSize()) :
+                                      SignedRangeOfBits(extract.GetBitsSize());
+      if (expr.GetOpCode() != OP_extractbits || extract.GetBitsOffset() == 0) {
+        IndexRange range = Eval(*expr.Opnd(0), env);
+        if (IsWithin(range, bitsRange)) {
+          return range;
+        }
+      }
+      return Clamp(bitsRange, primType);
+    }
+    case OP_eq:
+    case OP_ne:
+    case OP_lt:
+    case OP_le:
+    case OP_gt:
+    case OP_ge:
+      return { 0, 1 };
+    case OP_add:
+    case OP_sub:
+    case OP_mul:
+    case OP_div:
+    case OP_rem:
+    case OP_shl:
+    case OP_lshr:
+    case OP_ashr:
+    case OP_band:
+    case OP_max:
+    case OP_min:
+      return EvalBinary(expr, env);
+    default:
+      return IndexRange::OfPrimType(primType);
+  }
+}
+
+IndexRange BoundsRangeAnalysis::EvalBinary(const BaseNode &expr, const RangeEnv &env) const {
+  PrimType primType = expr.GetPrimType();
+  IndexRange typeRange = IndexRange::OfPrimType(primType);
+  if (!IsPrimitiveInteger(primType)) {
+    return typeRange;
+  }
+  bool isUnsigned = IsUnsignedInteger(primType);
+  IndexRange a = Eval(*expr.Opnd(0), env);
+  IndexRange b = Eval(*expr.Opnd(1), env);
+  int64 c = 0;
+  __int128 lo = 0;
+  __int128 hi = 0;
+  switch (expr.GetOpCode()) {
+    case OP_add:
+      lo = static_cast<__int128>(a.lo) + b.lo;
+      hi = static_cast<__int128>(a.hi) + b.hi;
+      break;
+    case OP_sub:
+      lo = static_cast<__int128>(a.lo) - b.hi;
+      hi = static_cast<__int128>(a.hi) - b.lo;
+      break;
+    case OP_mul: {
+      __int128 corners[] = { static_cast<__int128>(a.lo) * b.lo, static_cast<__int128>(a.lo) * b.hi,
+                             static_cast<__int128>(a.hi) * b.lo, static_cast<__int128>(a.hi) * b.hi };
+      lo = *std::min_element(std::begin(corners), std::end(corners));
+      hi = *std::max_element(std::begin(corners), std::end(corners));
+      break;
+    }
+    case OP_shl:
+      if (!IsConst(b, c) || c < 0 || c >= static_cast<int64>(kMaxBitsOfRange)) {
+        return typeRange;
+      }
+      lo = static_cast<__int128>(a.lo) * (1LL << c);
+      hi = static_cast<__int128>(a.hi) * (1LL << c);
+      break;
+    case OP_div:
+      if (!IsConst(b, c) || c <= 0 || (isUnsigned && a.lo < 0)) {
+        return typeRange;
+      }
+      lo = a.lo / c;
+      hi = a.hi / c;
+      break;
+    case OP_rem:
+      if (!IsConst(b, c) || c <= 0) {
+        return typeRange;
+      }
+      if (a.lo >= 0) {
+        return { 0, std::min(a.hi, c - 1) };
+      }
+      return isUnsigned ? IndexRange{ 0, c - 1 } : IndexRange{ 1 - c, c - 1 };
+    case OP_lshr:
+    case OP_ashr:
+      if (!IsConst(b, c) || c < 0 || c > static_cast<int64>(kMaxBitsOfRange) ||
+          (a.lo < 0 && (isUnsigned || expr.GetOpCode() == OP_lshr))) {
+        return typeRange;
+      }
+      lo = a.lo >> c;
+      hi = a.hi >> c;
+      break;
+    case OP_band:
+      if (a.lo >= 0 && b.lo >= 0) {
+        return { 0, std::min(a.hi, b.hi) };
+      } else if (a.lo >= 0 || b.lo >= 0) {
+        return { 0, a.lo >= 0 ? a.hi : b.hi };
+      }
+      return typeRange;
+    case OP_max:
+      lo = std::max(a.lo, b.lo);
+      hi = std::max(a.hi, b.hi);
+      break;
+    case OP_min:
+      lo = std::min(a.lo, b.lo);
+      hi = std::min(a.hi, b.hi);
+      break;
+    default:
+      return typeRange;
+  }
+  if (lo < typeRange.lo || hi > typeRange.hi) {
+    return typeRange;
+  }
+  return { static_cast<int64>(lo), static_cast<int64>(hi) };
+}
+}  // namespace maple
+
+#endif
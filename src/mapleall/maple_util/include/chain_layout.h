@@ -188,6 +188,8 @@ class FuncWrapperBase {
   virtual NodeType *GetCommonExitNode() = 0;
   virtual NodeType *GetLayoutStartNode() = 0;
   virtual bool IsNodeInCFG(const NodeType *node) const = 0;
+  // estimated code size in bytes, for the jump distances of ext-TSP
+  virtual uint64 GetNodeSize(const NodeType &node) const = 0;
 
   bool IsMeFunc() const {
     return isMeFunc;
@@ -257,6 +259,24 @@ class MeFuncWrapper : public FuncWrapperBase {
     return true;
   }
 
+  // a statement is taken as two instructions
+  uint64 GetNodeSize(const NodeType &node) const override {
+    constexpr uint64 kBytesPerStmt = 8;
+    const auto &bb = static_cast<const BB&>(node);
+    uint64 numStmts = 0;
+    for (auto &stmt : bb.GetMeStmts()) {
+      (void)stmt;
+      ++numStmts;
+    }
+    if (numStmts == 0) {
+      for (auto &stmt : bb.GetStmtNodes()) {
+        (void)stmt;
+        ++numStmts;
+      }
+    }
+    return std::max<uint64>(numStmts, 1) * kBytesPerStmt;
+  }
+
   size_t size() const override {
     return func.GetCfg()->size();
   }
@@ -332,6 +352,12 @@ class CGFuncWrapper : public FuncWrapperBase {
     return true;
   }
 
+  uint64 GetNodeSize(const NodeType &node) const override {
+    constexpr uint64 kBytesPerInsn = 4;
+    const auto &cgBB = static_cast<const maplebe::BB&>(node);
+    return static_cast<uint64>(std::max(cgBB.NumInsn(), 1)) * kBytesPerInsn;
+  }
+
   size_t size() const override {
     return func.GetAllBBs().size();
   }
@@ -809,6 +835,7 @@ class ChainLayout {
       if (meLayoutColdPath) {
         layoutColdPath = true;
       }
+      useExtTsp = MeOption::layoutExtTsp;
     } else {
       CHECK_NULL_FATAL(cgLoop);
       InitLoopsForCG(cgLoop->GetLoops());
@@ -818,6 +845,7 @@ class ChainLayout {
       if (maplebe::CGOptions::DoEnableHotColdSplit()) {
         markNeverExe = true;
       }
+      useExtTsp = maplebe::CGOptions::DoLayoutExtTsp();
     }
   }
 
@@ -848,6 +876,8 @@ class ChainLayout {
   bool FindNodesToLayoutInLoop(const LoopWrapperBase &loop, ExeTemperature temperature,
       MapleVector<bool> &inBBs) const;
   void PostBuildChainForCGFunc(NodeChain &entryChain);
+  NodeChain *BuildChainByExtTsp();
+  bool IsLaidOutByPostBuild(const NodeType &node) const;
   void DoBuildChain(const NodeType &header, NodeChain &chain, uint32 range);
 
   NodeType *GetBestSucc(NodeType &node, const NodeChain &chain, uint32 range, bool considerBetterPredForSucc);
@@ -884,6 +914,7 @@ class ChainLayout {
   const bool cgLayoutColdPath = false;
   bool layoutColdPath = false;
   bool markNeverExe = false;  // whether mark nodes that will never be executed, for cg hotcoldsplit
+  bool useExtTsp = false;     // order the nodes by ext-TSP score instead of building chains by context
 };
 }  // namespace maple
 #endif  // MAPLE_UTIL_INCLUDE_CHAIN_LAYOUT_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MAPLE_UTIL_INCLUDE_EXT_TSP_LAYOUT_H
+#define MAPLE_UTIL_INCLUDE_EXT_TSP_LAYOUT_H
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+#include "types_def.h"
+
+namespace maple {
+/*
+ * Block ordering maximizing the extended TSP score (Newell and Pupyrev, "Improved Basic Block Reordering").
+ * An edge of frequency w scores w when its destination directly follows its source, and a part of w decreasing
+ * with the distance when the destination is a short forward or backward jump away:
+ *   fallthrough:   w
+ *   forward jump:  w * 0.1 * (1 - d / 1024), d < 1024 bytes
+ *   backward jump: w * 0.1 * (1 - d / 640), d < 640 bytes
+ * Starting from one chain per node, the pair of chains with the best gain is merged, trying the concatenations
+ * and the splits of the shorter chains, until no merge improves the score. The chains left are ordered by
+ * frequency density. The nodes are numbered in their current order, which is kept when it scores better.
+ */
+class ExtTspLayout {
+ public:
+  struct Edge {
+    uint32 src;
+    uint32 dst;
+    uint64 freq;
+  };
+
+  // node sizes in bytes, nodes 0 to numEntryNodes - 1 are laid out first in that order
+  ExtTspLayout(const std::vector<uint64> &nodeSizes, const std::vector<uint64> &nodeFreqs,
+               const std::vector<Edge> &edges, uint32 numEntryNodes);
+  ~ExtTspLayout() = default;
+
+  std::vector<uint32> ComputeOrder();
+  double Score(const std::vector<uint32> &order) const;
+
+ private:
+  struct Chain {
+    std::vector<uint32> nodes;
+    uint64 size = 0;
+    uint64 freq = 0;
+    double score = 0;
+    bool isEntry = false;
+    bool alive = true;
+  };
+
+  struct MergeResult {
+    double gain = 0;
+    std::vector<uint32> nodes;
+  };
+
+  using Segments = std::vector<std::pair<std::vector<uint32>::const_iterator, std::vector<uint32>::const_iterator>>;
+
+  static double EdgeScore(uint64 srcAddr, uint64 srcSize, uint64 dstAddr, uint64 freq);
+  double SegmentsScore(const Segments &segments, uint32 chainA, uint32 chainB);
+  void TryMerge(const Segments &segments, uint32 chainA, uint32 chainB, double baseScore, MergeResult &best);
+  const MergeResult &GetMergeResult(uint32 chainA, uint32 chainB);
+  void AddCandidate(uint32 chainA, uint32 chainB);
+  void RemoveCandidates(uint32 chain);
+  void MergeChains(uint32 chainA, uint32 chainB, std::vector<uint32> &nodes);
+
+  std::vector<uint64> sizes;
+  std::vector<uint64> freqs;
+  std::vector<Edge> edges;
+  std::vector<std::vector<uint32>> outEdges;  // edge indexes by source node
+  uint32 numEntryNodes = 0;
+  std::vector<Chain> chains;
+  std::vector<uint32> node2chain;
+  std::vector<uint64> addrs;  // scratch addresses of the nodes of a candidate merge
+  std::vector<std::set<uint32>> chainNeighbors;  // chains joined by an edge of non-zero frequency
+  std::map<std::pair<uint32, uint32>, MergeResult> mergeCache;
+  std::set<std::tuple<double, uint32, uint32>> candidates;  // merges with a gain, the best first
+};
+}  // namespace maple
+#endif  // MAPLE_UTIL_INCLUDE_EXT_TSP_LAYOUT_H
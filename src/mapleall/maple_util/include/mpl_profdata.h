@@ -15,8 +15,12 @@
 
 #ifndef MAPLE_UTIL_INCLUDE_MPL_PROFDATA_H
 #define MAPLE_UTIL_INCLUDE_MPL_PROFDATA_H
+#include <algorithm>
+#include <array>
 #include <unordered_map>
 #include <string>
+#include <utility>
+#include "itab_util.h"
 #include "mempool_allocator.h"
 #include "types_def.h"
 namespace maple {
@@ -96,6 +100,83 @@ class ProfileSummary {
   MapleVector<ProfileSummaryHistogram> histogram;  // record gcov_bucket_type histogram[GCOV_HISTOGRAM_SIZE];
 };
 
+// value profiles, collected by the gcov value profilers of libgcov
+enum ValueProfKind : uint32_t {
+  kValueProfMemOpSize = 0,  // interval counters of the size operand of memcpy/memset
+  kValueProfIcallTopN = 1,  // topn counters of the callee of an indirect call
+  kValueProfKindNum
+};
+
+// icall site counters: eviction number, then kIcallTopNTargets pairs of (callee profile id, count)
+constexpr uint32_t kIcallTopNTargets = 4;
+constexpr uint32_t kIcallTopNCounters = 2 * kIcallTopNTargets + 1;
+// memop site counters: one per size in [0, kMemOpSizeSteps), then the overflow and the underflow counter
+constexpr uint32_t kMemOpSizeSteps = 65;
+constexpr uint32_t kMemOpSizeCounters = kMemOpSizeSteps + 2;
+
+// the value recorded by the indirect call profiler when a function is entered, see ValueProfInfo
+inline uint32_t GetValueProfFuncId(const std::string &funcName) {
+  return DJBHash(funcName.c_str());
+}
+
+inline uint32_t GetValueProfSiteCounterNum(ValueProfKind kind) {
+  return kind == kValueProfMemOpSize ? kMemOpSizeCounters : kIcallTopNCounters;
+}
+
+// key of the samples of a source line in a sample-based profile, see FuncProfInfo::lineSamples
+inline uint64_t GetSampleLineKey(uint32_t fileNum, uint32_t lineNum) {
+  constexpr uint32_t kFileNumShift = 32;
+  return (static_cast<uint64_t>(fileNum) << kFileNumShift) | lineNum;
+}
+
+// profiled values of one site, the most frequent first
+class ValueProfInfo {
+ public:
+  ValueProfInfo(MapleAllocator *alloc, ValueProfKind valueKind) : kind(valueKind), values(alloc->Adapter()) {}
+  ~ValueProfInfo() = default;
+
+  ValueProfKind GetKind() const {
+    return kind;
+  }
+
+  FreqType GetTotal() const {
+    return total;
+  }
+
+  void SetTotal(FreqType count) {
+    total = count;
+  }
+
+  const MapleVector<std::pair<int64, FreqType>> &GetValues() const {
+    return values;
+  }
+
+  void AddValue(int64 value, FreqType count) {
+    values.emplace_back(value, count);
+  }
+
+  void SortValues() {
+    std::stable_sort(values.begin(), values.end(),
+        [](const std::pair<int64, FreqType> &a, const std::pair<int64, FreqType> &b) { return a.second > b.second; });
+  }
+
+  // the most frequent value if it was seen in at least percent% of all executions of the site
+  bool GetDominantValue(uint32_t percent, int64 &value, FreqType &count) const {
+    constexpr FreqType kPercentBase = 100;
+    if (values.empty() || total <= 0 || values[0].second * kPercentBase < total * percent) {
+      return false;
+    }
+    value = values[0].first;
+    count = values[0].second;
+    return true;
+  }
+
+ private:
+  ValueProfKind kind;
+  FreqType total = 0;
+  MapleVector<std::pair<int64, FreqType>> values;
+};
+
 class FuncProfInfo {
  public:
   FuncProfInfo(MapleAllocator *alloc, unsigned funcIdent, unsigned linenoCs, unsigned cfgCs, unsigned countnum = 0)
@@ -104,7 +185,10 @@ class FuncProfInfo {
         cfgChecksum(cfgCs),
         edgeCounts(countnum),
         counts(alloc->Adapter()),
-        stmtFreqs(alloc->Adapter()){};
+        stmtFreqs(alloc->Adapter()),
+        valueCounts{ MapleVector<FreqType>(alloc->Adapter()), MapleVector<FreqType>(alloc->Adapter()) },
+        valueProfs(alloc->Adapter()),
+        lineSamples(alloc->Adapter()) {};
   ~FuncProfInfo() = default;
 
   FreqType GetFuncFrequency() const {
@@ -161,6 +245,24 @@ class FuncProfInfo {
     return false;
   }
 
+  ValueProfInfo *GetValueProf(uint32_t stmtID) {
+    auto it = valueProfs.find(stmtID);
+    return it == valueProfs.end() ? nullptr : it->second;
+  }
+
+  void SetValueProf(uint32_t stmtID, ValueProfInfo *valueProf) {
+    valueProfs[stmtID] = valueProf;
+  }
+
+  // a value profile is consumed by the transformation it guides, so it is not applied twice
+  void EraseValueProf(uint32_t stmtID) {
+    (void)valueProfs.erase(stmtID);
+  }
+
+  // the profile of the site-th site of kind in valueCounts, siteFreq is the execution count of the site, nullptr if
+  // no value was recorded
+  ValueProfInfo *DecodeValueProf(ValueProfKind kind, size_t site, FreqType siteFreq, MapleAllocator &valueAlloc) const;
+
   void DumpFunctionProfile();
 
   unsigned ident;
@@ -173,6 +275,11 @@ class FuncProfInfo {
   FreqType entryFreq = 0;                            // record entry bb frequence
   MapleUnorderedMap<uint32_t, FreqType> stmtFreqs;  // stmt_id is key, counter value
   FreqType realEntryfreq = 0;                        // function prof data may be modified after clone/inline
+  // raw value counters of each ValueProfKind, in site order
+  std::array<MapleVector<FreqType>, kValueProfKindNum> valueCounts;
+  MapleUnorderedMap<uint32_t, ValueProfInfo*> valueProfs;  // original stmt id of the site is key
+  // samples of each source line of the function with --sample-profile, which has no counts
+  MapleUnorderedMap<uint64_t, FreqType> lineSamples;
 };
 
 class MplProfileData {
@@ -199,6 +306,14 @@ class MplProfileData {
   void DumpFunctionsProfile();
   bool IsHotCallSite(uint64_t freq);
 
+  bool HasValueProfile() const {
+    return hasValueProfile;
+  }
+
+  void SetHasValueProfile(bool has) {
+    hasValueProfile = has;
+  }
+
   MapleUnorderedMap<unsigned, FuncProfInfo*> funcsCounter;  // use puidx as key
   // record module profile information and statistics of count information
   ProfileSummary summary;
@@ -209,6 +324,7 @@ class MplProfileData {
 
   MemPool *mp;
   MapleAllocator *alloc;
+  bool hasValueProfile = false;
 };
 }  // namespace maple
 #endif  // MAPLE_UTIL_INCLUDE_MPL_PROFDATA_H
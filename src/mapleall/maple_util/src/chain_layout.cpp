@@ -15,6 +15,7 @@
 
 #include "chain_layout.h"
 #include "cg_option.h"
+#include "ext_tsp_layout.h"
 
 namespace maple {
 // Multiple loops may share the same header, we try to find the best unplaced node in the loop
@@ -319,6 +320,114 @@ void ChainLayout::PostBuildChainForCGFunc(NodeChain &entryChain) {
   }
 }
 
+// The cleanup BB and the labels only reached through switch tables, PostBuildChainForCGFunc appends them
+bool ChainLayout::IsLaidOutByPostBuild(const NodeType &node) const {
+  if (func.IsMeFunc()) {
+    return false;
+  }
+  maplebe::CGFunc &f = static_cast<CGFuncWrapper&>(func).GetFunc();
+  const auto &cgBB = static_cast<const maplebe::BB&>(node);
+  if (&cgBB == f.GetCleanupBB()) {
+    return true;
+  }
+  if (!cgBB.GetPreds().empty()) {
+    return false;
+  }
+  return maplebe::CGCFG::InSwitchTable(cgBB.GetLabIdx(), f) || (cgBB.GetSuccs().empty() && f.GetLastBB() == &cgBB);
+}
+
+// Orders the nodes reachable from the layout start node by ExtTspLayout, the other ones follow in their
+// original order. The cold section marks set by InitNodeTemperatures are kept.
+NodeChain *ChainLayout::BuildChainByExtTsp() {
+  NodeType *start = func.GetLayoutStartNode();
+  std::vector<bool> reachable(func.size(), false);
+  std::vector<NodeType*> worklist{ start };
+  reachable[start->GetID()] = true;
+  while (!worklist.empty()) {
+    NodeType *node = worklist.back();
+    worklist.pop_back();
+    std::vector<NodeType*> succVec;
+    node->GetOutNodes(succVec);
+    for (auto *succ : succVec) {
+      if (func.IsNodeInCFG(succ) && !reachable[succ->GetID()]) {
+        reachable[succ->GetID()] = true;
+        worklist.push_back(succ);
+      }
+    }
+  }
+  // dense indexes, the entry nodes first. The function entry of ME must follow the common entry.
+  std::vector<NodeType*> nodes{ start };
+  std::vector<NodeType*> others;
+  std::vector<uint32> id2idx(func.size(), UINT32_MAX);
+  id2idx[start->GetID()] = 0;
+  std::vector<NodeType*> startSuccs;
+  start->GetOutNodes(startSuccs);
+  if (func.IsMeFunc() && startSuccs.size() == 1 && func.IsNodeInCFG(startSuccs[0])) {
+    id2idx[startSuccs[0]->GetID()] = 1;
+    nodes.push_back(startSuccs[0]);
+  }
+  uint32 numEntryNodes = static_cast<uint32>(nodes.size());
+  const auto &end = func.end();
+  for (auto &it = func.begin(); it != end; ++it) {
+    auto *node = *it;
+    if (!func.IsNodeInCFG(node) || id2idx[node->GetID()] != UINT32_MAX) {
+      continue;
+    }
+    if (reachable[node->GetID()] && !IsLaidOutByPostBuild(*node)) {
+      id2idx[node->GetID()] = static_cast<uint32>(nodes.size());
+      nodes.push_back(node);
+    } else {
+      others.push_back(node);
+    }
+  }
+
+  std::vector<uint64> sizes;
+  std::vector<uint64> freqs;
+  std::vector<ExtTspLayout::Edge> edges;
+  for (uint32 i = 0; i < nodes.size(); ++i) {
+    sizes.push_back(func.GetNodeSize(*nodes[i]));
+    freqs.push_back(static_cast<uint64>(std::max<FreqType>(nodes[i]->GetNodeFrequency(), 0)));
+    std::vector<NodeType*> succVec;
+    nodes[i]->GetOutNodes(succVec);
+    for (size_t j = 0; j < succVec.size(); ++j) {
+      if (!func.IsNodeInCFG(succVec[j]) || id2idx[succVec[j]->GetID()] == UINT32_MAX) {
+        continue;
+      }
+      FreqType edgeFreq = nodes[i]->GetEdgeFrequency(j);
+      if (edgeFreq > 0) {
+        edges.push_back(ExtTspLayout::Edge{ i, id2idx[succVec[j]->GetID()], static_cast<uint64>(edgeFreq) });
+      }
+    }
+  }
+  ExtTspLayout extTsp(sizes, freqs, edges, numEntryNodes);
+  std::vector<uint32> order = extTsp.ComputeOrder();
+  CHECK_FATAL(order.size() == nodes.size() && order[0] == 0, "ext-TSP lost nodes");
+  if (debugChainLayout) {
+    std::vector<uint32> origOrder(nodes.size());
+    for (uint32 i = 0; i < origOrder.size(); ++i) {
+      origOrder[i] = i;
+    }
+    LogInfo::MapleLogger() << "[ext-TSP] " << func.GetName() << ": " << nodes.size() << " nodes, " << edges.size() <<
+        " edges, score " << extTsp.Score(origOrder) << " -> " << extTsp.Score(order) << std::endl;
+  }
+
+  NodeChain *entryChain = node2chain[start->GetID()];
+  for (size_t i = 1; i < order.size(); ++i) {
+    entryChain->MergeFrom(node2chain[nodes[order[i]]->GetID()]);
+  }
+  for (auto *node : others) {
+    if (IsLaidOutByPostBuild(*node)) {
+      (void)readyToLayoutChains.insert(node2chain[node->GetID()]);
+    } else {
+      entryChain->MergeFrom(node2chain[node->GetID()]);
+    }
+  }
+  if (debugChainLayout) {
+    entryChain->Dump();
+  }
+  return entryChain;
+}
+
 static void AddLayoutRange(uint32 &range, const std::initializer_list<LayoutRangeKind> &rangeKindList) {
   for (auto it = rangeKindList.begin(); it != rangeKindList.end(); ++it) {
     range |= static_cast<uint32>(*it);
@@ -356,6 +465,14 @@ void ChainLayout::BuildChainForFunc() {
   if (layoutColdPath || markNeverExe) {
     InitNodeTemperatures();
   }
+  // ext-TSP costs about n * log(n) merges evaluated in O(n), big functions keep the chain layout
+  constexpr uint32 kMaxExtTspNodeNum = 2048;
+  if (useExtTsp && validBBNum <= kMaxExtTspNodeNum) {
+    auto *entryChain = BuildChainByExtTsp();
+    PostBuildChainForCGFunc(*entryChain);
+    CHECK_FATAL(entryChain->size() == validBBNum, "has any BB not been laid out?");
+    return;
+  }
   const bool cgRealProfile = !func.IsMeFunc() && hasRealProfile;
   if (cgRealProfile) {
     InitFreqRpoNodeList();
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "ext_tsp_layout.h"
+#include <algorithm>
+#include <set>
+#include "mpl_logging.h"
+
+namespace maple {
+namespace {
+constexpr double kFallthroughWeight = 1.0;
+constexpr double kForwardWeight = 0.1;
+constexpr double kBackwardWeight = 0.1;
+constexpr uint64 kForwardDistance = 1024;
+constexpr uint64 kBackwardDistance = 640;
+constexpr size_t kMaxSplitChainSize = 64;  // longer chains are only concatenated, splits cost O(n^2)
+constexpr double kMinGain = 1e-9;
+}
+
+ExtTspLayout::ExtTspLayout(const std::vector<uint64> &nodeSizes, const std::vector<uint64> &nodeFreqs,
+                           const std::vector<Edge> &edges, uint32 numEntryNodes)
+    : sizes(nodeSizes),
+      freqs(nodeFreqs),
+      edges(edges),
+      outEdges(nodeSizes.size()),
+      numEntryNodes(numEntryNodes),
+      node2chain(nodeSizes.size(), 0),
+      addrs(nodeSizes.size(), 0) {
+  CHECK_FATAL(freqs.size() == sizes.size(), "one frequency per node");
+  CHECK_FATAL(numEntryNodes <= sizes.size(), "entry nodes out of range");
+  for (uint32 i = 0; i < this->edges.size(); ++i) {
+    const Edge &edge = this->edges[i];
+    CHECK_FATAL(edge.src < sizes.size() && edge.dst < sizes.size(), "edge out of range");
+    if (edge.freq == 0) {
+      continue;
+    }
+    outEdges[edge.src].push_back(i);
+  }
+}
+
+double ExtTspLayout::EdgeScore(uint64 srcAddr, uint64 srcSize, uint64 dstAddr, uint64 freq) {
+  uint64 srcEnd = srcAddr + srcSize;
+  if (srcEnd == dstAddr) {
+    return static_cast<double>(freq) * kFallthroughWeight;
+  }
+  if (dstAddr > srcEnd) {
+    uint64 dist = dstAddr - srcEnd;
+    if (dist < kForwardDistance) {
+      return static_cast<double>(freq) * kForwardWeight *
+          (1.0 - static_cast<double>(dist) / static_cast<double>(kForwardDistance));
+    }
+    return 0;
+  }
+  uint64 dist = srcEnd - dstAddr;
+  if (dist < kBackwardDistance) {
+    return static_cast<double>(freq) * kBackwardWeight *
+        (1.0 - static_cast<double>(dist) / static_cast<double>(kBackwardDistance));
+  }
+  return 0;
+}
+
+double ExtTspLayout::Score(const std::vector<uint32> &order) const {
+  std::vector<uint64> orderAddrs(sizes.size(), 0);
+  std::vector<bool> placed(sizes.size(), false);
+  uint64 addr = 0;
+  for (uint32 node : order) {
+    orderAddrs[node] = addr;
+    placed[node] = true;
+    addr += sizes[node];
+  }
+  double score = 0;
+  for (const Edge &edge : edges) {
+    if (edge.freq != 0 && placed[edge.src] && placed[edge.dst]) {
+      score += EdgeScore(orderAddrs[edge.src], sizes[edge.src], orderAddrs[edge.dst], edge.freq);
+    }
+  }
+  return score;
+}
+
+// score of the edges within chainA and chainB once laid out as segments
+double ExtTspLayout::SegmentsScore(const Segments &segments, uint32 chainA, uint32 chainB) {
+  uint64 addr = 0;
+  for (auto &segment : segments) {
+    for (auto it = segment.first; it != segment.second; ++it) {
+      addrs[*it] = addr;
+      addr += sizes[*it];
+    }
+  }
+  double score = 0;
+  for (auto &segment : segments) {
+    for (auto it = segment.first; it != segment.second; ++it) {
+      for (uint32 edgeIdx : outEdges[*it]) {
+        const Edge &edge = edges[edgeIdx];
+        if (node2chain[edge.dst] != chainA && node2chain[edge.dst] != chainB) {
+          continue;
+        }
+        score += EdgeScore(addrs[edge.src], sizes[edge.src], addrs[edge.dst], edge.freq);
+      }
+    }
+  }
+  return score;
+}
+
+void ExtTspLayout::TryMerge(const Segments &segments, uint32 chainA, uint32 chainB, double baseScore,
+                            MergeResult &best) {
+  if (chains[chainA].isEntry || chains[chainB].isEntry) {
+    // the entry nodes must stay in front, in their order
+    uint32 pos = 0;
+    for (auto &segment : segments) {
+      for (auto it = segment.first; it != segment.second && pos < numEntryNodes; ++it, ++pos) {
+        if (*it != pos) {
+          return;
+        }
+      }
+    }
+  }
+  double gain = SegmentsScore(segments, chainA, chainB) - baseScore;
+  if (gain <= best.gain + kMinGain) {
+    return;
+  }
+  best.gain = gain;
+  best.nodes.clear();
+  for (auto &segment : segments) {
+    best.nodes.insert(best.nodes.end(), segment.first, segment.second);
+  }
+}
+
+const ExtTspLayout::MergeResult &ExtTspLayout::GetMergeResult(uint32 chainA, uint32 chainB) {
+  auto key = std::make_pair(std::min(chainA, chainB), std::max(chainA, chainB));
+  auto it = mergeCache.find(key);
+  if (it != mergeCache.end()) {
+    return it->second;
+  }
+  MergeResult &best = mergeCache[key];
+  double baseScore = chains[chainA].score + chains[chainB].score;
+  const std::vector<uint32> &nodesA = chains[chainA].nodes;
+  const std::vector<uint32> &nodesB = chains[chainB].nodes;
+  TryMerge({ { nodesA.begin(), nodesA.end() }, { nodesB.begin(), nodesB.end() } }, chainA, chainB, baseScore, best);
+  TryMerge({ { nodesB.begin(), nodesB.end() }, { nodesA.begin(), nodesA.end() } }, chainA, chainB, baseScore, best);
+  // put one chain into the other one
+  auto trySplits = [this, chainA, chainB, baseScore, &best](const std::vector<uint32> &x, const std::vector<uint32> &y) {
+    if (x.size() > kMaxSplitChainSize) {
+      return;
+    }
+    for (auto split = x.begin() + 1; split < x.end(); ++split) {
+      TryMerge({ { x.begin(), split }, { y.begin(), y.end() }, { split, x.end() } }, chainA, chainB, baseScore, best);
+      TryMerge({ { y.begin(), y.end() }, { split, x.end() }, { x.begin(), split } }, chainA, chainB, baseScore, best);
+      TryMerge({ { split, x.end() }, { x.begin(), split }, { y.begin(), y.end() } }, chainA, chainB, baseScore, best);
+    }
+  };
+  trySplits(nodesA, nodesB);
+  trySplits(nodesB, nodesA);
+  return best;
+}
+
+void ExtTspLayout::AddCandidate(uint32 chainA, uint32 chainB) {
+  const MergeResult &result = GetMergeResult(chainA, chainB);
+  if (result.gain > kMinGain) {
+    (void)candidates.emplace(-result.gain, std::min(chainA, chainB), std::max(chainA, chainB));
+  }
+}
+
+void ExtTspLayout::RemoveCandidates(uint32 chain) {
+  for (uint32 neighbor : chainNeighbors[chain]) {
+    auto key = std::make_pair(std::min(chain, neighbor), std::max(chain, neighbor));
+    auto it = mergeCache.find(key);
+    if (it == mergeCache.end()) {
+      continue;
+    }
+    (void)candidates.erase(std::make_tuple(-it->second.gain, key.first, key.second));
+    (void)mergeCache.erase(it);
+  }
+}
+
+void ExtTspLayout::MergeChains(uint32 chainA, uint32 chainB, std::vector<uint32> &nodes) {
+  RemoveCandidates(chainA);
+  RemoveCandidates(chainB);
+  Chain &dst = chains[chainA];
+  Chain &src = chains[chainB];
+  for (uint32 node : src.nodes) {
+    node2chain[node] = chainA;
+  }
+  dst.nodes.swap(nodes);
+  dst.size += src.size;
+  dst.freq += src.freq;
+  dst.isEntry = dst.isEntry || src.isEntry;
+  src.nodes.clear();
+  src.alive = false;
+  dst.score = SegmentsScore({ { dst.nodes.cbegin(), dst.nodes.cend() } }, chainA, chainA);
+  for (uint32 neighbor : chainNeighbors[chainB]) {
+    (void)chainNeighbors[neighbor].erase(chainB);
+    if (neighbor != chainA) {
+      (void)chainNeighbors[neighbor].insert(chainA);
+      (void)chainNeighbors[chainA].insert(neighbor);
+    }
+  }
+  chainNeighbors[chainB].clear();
+  (void)chainNeighbors[chainA].erase(chainA);
+  for (uint32 neighbor : chainNeighbors[chainA]) {
+    AddCandidate(chainA, neighbor);
+  }
+}
+
+std::vector<uint32> ExtTspLayout::ComputeOrder() {
+  chains.clear();
+  mergeCache.clear();
+  candidates.clear();
+  for (uint32 node = 0; node < sizes.size(); ++node) {
+    if (node != 0 && node < numEntryNodes) {
+      chains[0].nodes.push_back(node);
+      chains[0].size += sizes[node];
+      chains[0].freq += freqs[node];
+      node2chain[node] = 0;
+      chains.emplace_back();  // keeps chain ids equal to the id of their first node
+      chains.back().alive = false;
+      continue;
+    }
+    chains.emplace_back();
+    Chain &chain = chains.back();
+    chain.nodes.push_back(node);
+    chain.size = sizes[node];
+    chain.freq = freqs[node];
+    chain.isEntry = (node == 0 && numEntryNodes != 0);
+    node2chain[node] = node;
+  }
+  chainNeighbors.assign(chains.size(), std::set<uint32>());
+  for (const Edge &edge : edges) {
+    uint32 src = node2chain[edge.src];
+    uint32 dst = node2chain[edge.dst];
+    if (edge.freq != 0 && src != dst) {
+      (void)chainNeighbors[src].insert(dst);
+      (void)chainNeighbors[dst].insert(src);
+    }
+  }
+  for (uint32 i = 0; i < chains.size(); ++i) {
+    if (chains[i].alive) {
+      chains[i].score = SegmentsScore({ { chains[i].nodes.cbegin(), chains[i].nodes.cend() } }, i, i);
+    }
+  }
+  for (uint32 i = 0; i < chains.size(); ++i) {
+    for (uint32 neighbor : chainNeighbors[i]) {
+      if (neighbor > i) {
+        AddCandidate(i, neighbor);
+      }
+    }
+  }
+
+  while (!candidates.empty()) {
+    uint32 chainA = std::get<1>(*candidates.begin());
+    uint32 chainB = std::get<2>(*candidates.begin());
+    std::vector<uint32> nodes = GetMergeResult(chainA, chainB).nodes;
+    MergeChains(chainA, chainB, nodes);
+  }
+
+  // the entry chain first, then the hottest code per byte
+  std::vector<uint32> liveChains;
+  for (uint32 i = 0; i < chains.size(); ++i) {
+    if (chains[i].alive) {
+      liveChains.push_back(i);
+    }
+  }
+  std::stable_sort(liveChains.begin(), liveChains.end(), [this](uint32 a, uint32 b) {
+    const Chain &chainA = chains[a];
+    const Chain &chainB = chains[b];
+    if (chainA.isEntry != chainB.isEntry) {
+      return chainA.isEntry;
+    }
+    double densityA = static_cast<double>(chainA.freq) / static_cast<double>(std::max<uint64>(chainA.size, 1));
+    double densityB = static_cast<double>(chainB.freq) / static_cast<double>(std::max<uint64>(chainB.size, 1));
+    return densityA > densityB;
+  });
+  std::vector<uint32> order;
+  order.reserve(sizes.size());
+  for (uint32 i : liveChains) {
+    order.insert(order.end(), chains[i].nodes.begin(), chains[i].nodes.end());
+  }
+  std::vector<uint32> origOrder(sizes.size());
+  for (uint32 i = 0; i < origOrder.size(); ++i) {
+    origOrder[i] = i;
+  }
+  // the greedy merges may lose to a layout already good, e.g. with the fallthroughs of the chain layout
+  return Score(order) > Score(origOrder) ? order : origOrder;
+}
+}  // namespace maple
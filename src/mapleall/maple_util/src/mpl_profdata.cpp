@@ -40,6 +40,51 @@ void FuncProfInfo::DumpFunctionProfile() {
     LogInfo::MapleLogger() << std::dec << "  " << counts[i];
   }
   LogInfo::MapleLogger() << "\n";
+  for (uint32 kind = 0; kind < kValueProfKindNum; ++kind) {
+    if (valueCounts[kind].empty()) {
+      continue;
+    }
+    LogInfo::MapleLogger() << "  value counts kind " << std::dec << kind << " num " << valueCounts[kind].size() << " : ";
+    for (auto count : valueCounts[kind]) {
+      LogInfo::MapleLogger() << "  " << count;
+    }
+    LogInfo::MapleLogger() << "\n";
+  }
+}
+
+ValueProfInfo *FuncProfInfo::DecodeValueProf(ValueProfKind kind, size_t site, FreqType siteFreq,
+                                             MapleAllocator &valueAlloc) const {
+  const MapleVector<FreqType> &siteCounts = valueCounts[kind];
+  size_t base = site * GetValueProfSiteCounterNum(kind);
+  CHECK_FATAL(base + GetValueProfSiteCounterNum(kind) <= siteCounts.size(), "value profile site out of range");
+  auto *valueProf = valueAlloc.New<ValueProfInfo>(&valueAlloc, kind);
+  FreqType total = 0;
+  if (kind == kValueProfMemOpSize) {
+    // sizes 0 .. kMemOpSizeSteps - 1, then the out of range ones which count in the total only
+    for (uint32 j = 0; j < kMemOpSizeCounters; ++j) {
+      FreqType count = siteCounts[base + j];
+      if (count > 0 && j < kMemOpSizeSteps) {
+        valueProf->AddValue(static_cast<int64>(j), count);
+      }
+      total += count > 0 ? count : 0;
+    }
+  } else {
+    for (uint32 j = 0; j < kIcallTopNTargets; ++j) {
+      FreqType count = siteCounts[base + 1 + 2 * j + 1];
+      if (count > 0) {
+        valueProf->AddValue(siteCounts[base + 1 + 2 * j], count);
+        total += count;
+      }
+    }
+    // only the top callees are tracked, the site frequency accounts for the others
+    total = std::max(total, siteFreq);
+  }
+  if (valueProf->GetValues().empty()) {
+    return nullptr;
+  }
+  valueProf->SetTotal(total);
+  valueProf->SortValues();
+  return valueProf;
 }
 
 void MplProfileData::DumpFunctionsProfile() {
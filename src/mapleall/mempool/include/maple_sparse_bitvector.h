@@ -36,6 +36,10 @@ template <unsigned bitVectorSize = 64> struct MapleSparseBitVectorElement {
     return bitVector[idx];
   }
 
+  void SetWord(unsigned idx, BitWord word) {
+    bitVector[idx] = word;
+  }
+
   unsigned GetIndex() const {
     return index;
   }
@@ -61,6 +65,28 @@ template <unsigned bitVectorSize = 64> struct MapleSparseBitVectorElement {
     return true;
   }
 
+  unsigned Count() const {
+    unsigned num = 0;
+    for (unsigned i = 0; i < kBitWordNum; i++) {
+      num += static_cast<unsigned>(__builtin_popcountll(bitVector[i]));
+    }
+    return num;
+  }
+
+  // return the position of the first set bit at or after startPos, or bitVectorSize if there is none
+  unsigned FindNext(unsigned startPos) const {
+    for (unsigned i = startPos / kBitWordSize; i < kBitWordNum; i++) {
+      BitWord tmp = bitVector[i];
+      if (i == startPos / kBitWordSize) {
+        tmp &= ~0ULL << (startPos % kBitWordSize);
+      }
+      if (tmp != 0) {
+        return i * kBitWordSize + static_cast<unsigned>(__builtin_ctzll(tmp));
+      }
+    }
+    return bitVectorSize;
+  }
+
   void ConvertToSet(MapleSet<uint32>& res, unsigned base) const {
     for (unsigned i = 0; i < kBitWordNum; i++) {
       BitWord tmp = bitVector[i];
@@ -160,6 +186,62 @@ class MapleSparseBitVector {
   using BitWord =  unsigned long long;
 
  public:
+  // forward iterator over the set bits in ascending order
+  class ConstIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = unsigned;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const unsigned*;
+    using reference = const unsigned&;
+
+    ConstIterator(ElementListConstIterator iter, ElementListConstIterator endIter)
+        : elemIter(iter), elemEnd(endIter) {
+      SkipToSetBit(0);
+    }
+
+    unsigned operator*() const {
+      return bitNO;
+    }
+
+    ConstIterator &operator++() {
+      SkipToSetBit(bitNO % bitVectorSize + 1);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator &rhs) const {
+      return elemIter == rhs.elemIter && (elemIter == elemEnd || bitNO == rhs.bitNO);
+    }
+
+    bool operator!=(const ConstIterator &rhs) const {
+      return !(*this == rhs);
+    }
+
+   private:
+    void SkipToSetBit(unsigned startPos) {
+      while (elemIter != elemEnd) {
+        unsigned pos = startPos < bitVectorSize ? elemIter->FindNext(startPos) : bitVectorSize;
+        if (pos < bitVectorSize) {
+          bitNO = elemIter->GetIndex() * bitVectorSize + pos;
+          return;
+        }
+        ++elemIter;
+        startPos = 0;
+      }
+    }
+
+    ElementListConstIterator elemIter;
+    ElementListConstIterator elemEnd;
+    unsigned bitNO = 0;
+  };
+  using const_iterator = ConstIterator;
+
   explicit MapleSparseBitVector(const MapleAllocator &alloc)
       : allocator(alloc),
         elementList(allocator.Adapter()),
@@ -221,6 +303,38 @@ class MapleSparseBitVector {
     return (iter->Test(bitNO % bitVectorSize));
   }
 
+  // word wordNO holds the bits [wordNO * kWordBits, (wordNO + 1) * kWordBits)
+  BitWord GetWord(unsigned wordNO) const {
+    if (elementList.empty()) {
+      return 0;
+    }
+    unsigned idx = wordNO * kWordBits / bitVectorSize;
+    ElementListConstIterator iter = LowerBoundForConst(idx);
+    if (iter == elementList.end() || iter->GetIndex() != idx) {
+      return 0;
+    }
+    return iter->GetWord(wordNO * kWordBits % bitVectorSize / kWordBits);
+  }
+
+  void SetWord(unsigned wordNO, BitWord word) {
+    unsigned idx = wordNO * kWordBits / bitVectorSize;
+    ElementListIterator iter = elementList.empty() ? elementList.end() : LowerBoundFor(idx);
+    if (iter == elementList.end() || iter->GetIndex() != idx) {
+      if (word == 0) {
+        return;
+      }
+      if (iter != elementList.end() && iter->GetIndex() < idx) {
+        ++iter;
+      }
+      iter = elementList.emplace(iter, idx);
+    }
+    iter->SetWord(wordNO * kWordBits % bitVectorSize / kWordBits, word);
+    if (iter->Empty()) {
+      iter = elementList.erase(iter);
+    }
+    currIter = iter;
+  }
+
   MapleSparseBitVector& operator=(const MapleSparseBitVector& rhs) {
     if (this == &rhs) {
       return *this;
@@ -385,6 +499,22 @@ class MapleSparseBitVector {
     return changed;
   }
 
+  unsigned Count() const {
+    unsigned num = 0;
+    for (auto &element : elementList) {
+      num += element.Count();
+    }
+    return num;
+  }
+
+  ConstIterator begin() const {
+    return ConstIterator(elementList.cbegin(), elementList.cend());
+  }
+
+  ConstIterator end() const {
+    return ConstIterator(elementList.cend(), elementList.cend());
+  }
+
   void ConvertToSet(MapleSet<uint32> &res) const {
     for (auto &element : elementList) {
       unsigned pos = bitVectorSize * element.GetIndex();
@@ -437,6 +567,8 @@ class MapleSparseBitVector {
     return LowerBoundForImpl(idx);
   }
 
+  static constexpr unsigned kWordBits = sizeof(BitWord) * CHAR_BIT;
+
   MapleAllocator allocator;
   ElementList elementList;
   mutable ElementListIterator currIter;
@@ -22,6 +22,8 @@
 #include <map>
 #include <string>
 #include <mutex>
+#include <typeindex>
+#include <unordered_map>
 #include "mir_config.h"
 #include "mpl_logging.h"
 #include "thread_env.h"
@@ -83,6 +85,7 @@ class MemPoolCtrler {
 
  public:
   static bool freeMemInTime;
+  static bool memStats;  // account the bytes held by each MemPool and allocated for each type, see DumpMemStats
   MemPoolCtrler() : sysMemoryMgr(new MallocSysMemoryManager()) {}
 
   ~MemPoolCtrler();
@@ -93,9 +96,15 @@ class MemPoolCtrler {
     return ThreadEnv::IsMeParallel() && (this == &maple::memPoolCtrler);
   }
 
+  void RegisterPool(const MemPool &pool, const std::string &name);
+  void UnregisterPool(const MemPool &pool);
+  void RecordNew(const std::type_info &type, size_t num, size_t bytes);
+  // MemPools by name with their peak and total block bytes, then the types taking the most bytes
+  void DumpMemStats(std::ostream &os);
+
   MemBlock *AllocMemBlock(const MemPool &pool, size_t size);
   MemBlock *AllocFixMemBlock(const MemPool &pool);
-  MemBlock *AllocBigMemBlock(const MemPool &pool, size_t size) const;
+  MemBlock *AllocBigMemBlock(const MemPool &pool, size_t size);
 
  private:
   struct MemBlockCmp {
@@ -107,9 +116,29 @@ class MemPoolCtrler {
   void FreeMem();
   void FreeMemBlocks(const MemPool &pool, MemBlock *fixedMemHead, MemBlock *bigMemHead);
 
+  struct PoolStat {
+    size_t numPools = 0;
+    size_t curBytes = 0;
+    size_t peakBytes = 0;
+    size_t totalBytes = 0;
+  };
+
+  struct TypeStat {
+    size_t num = 0;
+    size_t bytes = 0;
+  };
+
+  void AccountBlocks(const MemPool &pool, size_t bytes, bool isAlloc);
+
   std::mutex ctrlerMutex;  // this mutex is used to protect memPools
   MemBlock *fixedFreeMemBlocks = nullptr;
   std::unique_ptr<SysMemoryManager> sysMemoryMgr;
+  std::mutex statMutex;  // protects the stats below, only used with memStats
+  std::unordered_map<const MemPool*, std::string> poolNames;
+  std::map<std::string, PoolStat> poolStats;
+  std::unordered_map<std::type_index, TypeStat> typeStats;
+  size_t curBytes = 0;
+  size_t peakBytes = 0;
 };
 
 #ifdef MP_DEUG
@@ -144,9 +173,15 @@ class MemPool : private MemPoolStat {
  public:
   MemPool(MemPoolCtrler &ctl, const std::string &name) : ctrler(ctl) {
     SetName(name);
+    if (MemPoolCtrler::memStats) {
+      ctrler.RegisterPool(*this, name);
+    }
   }
   MemPool(MemPoolCtrler &ctl, const char *name) : ctrler(ctl) {
     SetName(name);
+    if (MemPoolCtrler::memStats) {
+      ctrler.RegisterPool(*this, name);
+    }
   }
 
   ~MemPool() override;
@@ -164,10 +199,18 @@ class MemPool : private MemPoolStat {
     return ctrler;
   }
 
+  template <class T>
+  void RecordNew(size_t num = 1) {
+    if (MemPoolCtrler::memStats) {
+      ctrler.RecordNew(typeid(T), num, sizeof(T) * num);
+    }
+  }
+
   template <class T>
   T *Clone(const T &t) {
     void *p = Malloc(sizeof(T));
     ASSERT(p != nullptr, "ERROR: New error");
+    RecordNew<T>();
     p = new (p) T(t);
     return static_cast<T *>(p);
   }
@@ -176,6 +219,7 @@ class MemPool : private MemPoolStat {
   T *New(Arguments &&... args) {
     void *p = Malloc(sizeof(T));
     ASSERT(p != nullptr, "ERROR: New error");
+    RecordNew<T>();
     p = new (p) T(std::forward<Arguments>(args)...);
     return static_cast<T *>(p);
   }
@@ -184,6 +228,7 @@ class MemPool : private MemPoolStat {
   T *NewArray(size_t num) {
     void *p = Malloc(sizeof(T) * num);
     ASSERT(p != nullptr, "ERROR: NewArray error");
+    RecordNew<T>(num);
     p = new (p) T[num];
     return static_cast<T *>(p);
   }
@@ -44,6 +44,7 @@ class MapleAllocator {
   T *New(Arguments &&... args) const {
     void *p = memPool->Malloc(sizeof(T));
     ASSERT(p != nullptr, "ERROR: New error");
+    memPool->RecordNew<T>();
     p = new (p) T(std::forward<Arguments>(args)...);
     return static_cast<T *>(p);
   }
@@ -13,6 +13,11 @@
  * See the Mulan PSL v2 for more details.
  */
 #include "mempool.h"
+#include <cxxabi.h>
+#include <cstdlib>
+#include <algorithm>
+#include <iomanip>
+#include <vector>
 #include "thread_env.h"
 #include "securec.h"
 #include "mpl_logging.h"
@@ -20,6 +25,7 @@
 namespace maple {
 MemPoolCtrler memPoolCtrler;
 bool MemPoolCtrler::freeMemInTime = false;
+bool MemPoolCtrler::memStats = false;
 
 size_t BitsAlign(size_t size) {
   size_t kAlign8FillSize = 7;
@@ -27,7 +33,16 @@ size_t BitsAlign(size_t size) {
 }
 
 void MemPoolCtrler::FreeMemBlocks(const MemPool &pool, MemBlock *fixedMemHead, MemBlock *bigMemHead) {
-  (void)(pool);
+  if (memStats) {
+    size_t bytes = 0;
+    for (MemBlock *block = fixedMemHead; block != nullptr; block = block->nextMemBlock) {
+      bytes += block->memSize;
+    }
+    for (MemBlock *block = bigMemHead; block != nullptr; block = block->nextMemBlock) {
+      bytes += block->memSize;
+    }
+    AccountBlocks(pool, bytes, false);
+  }
 
   MemBlock *fixedTail = nullptr;
 
@@ -95,7 +110,9 @@ MemBlock *MemPoolCtrler::AllocMemBlock(const MemPool &pool, size_t size) {
 }
 
 MemBlock *MemPoolCtrler::AllocFixMemBlock(const MemPool &pool) {
-  (void)(pool);
+  if (memStats) {
+    AccountBlocks(pool, kMemBlockSizeMin, true);
+  }
   ParallelGuard guard(ctrlerMutex, HaveRace());
   if (fixedFreeMemBlocks == nullptr) {
     uint8_t *ptr = sysMemoryMgr->RealAllocMemory(kMemBlockRealMallocSize);
@@ -113,17 +130,87 @@ MemBlock *MemPoolCtrler::AllocFixMemBlock(const MemPool &pool) {
   return ret;
 }
 
-MemBlock *MemPoolCtrler::AllocBigMemBlock(const MemPool &pool, size_t size) const {
+MemBlock *MemPoolCtrler::AllocBigMemBlock(const MemPool &pool, size_t size) {
   ASSERT(size > kMemBlockSizeMin, "Big memory block must be bigger than fixed memory block");
-  (void)(pool);
+  if (memStats) {
+    AccountBlocks(pool, size, true);
+  }
 
   uint8_t *block = reinterpret_cast<uint8_t*>(malloc(size + kMemBlockStructSize));
   CHECK_FATAL(block != nullptr, "malloc failed");
   return new (block) MemBlock(block + kMemBlockStructSize, size);
 }
 
+void MemPoolCtrler::RegisterPool(const MemPool &pool, const std::string &name) {
+  std::lock_guard<std::mutex> guard(statMutex);
+  poolNames[&pool] = name;
+  ++poolStats[name].numPools;
+}
+
+void MemPoolCtrler::UnregisterPool(const MemPool &pool) {
+  std::lock_guard<std::mutex> guard(statMutex);
+  (void)poolNames.erase(&pool);
+}
+
+void MemPoolCtrler::AccountBlocks(const MemPool &pool, size_t bytes, bool isAlloc) {
+  std::lock_guard<std::mutex> guard(statMutex);
+  auto it = poolNames.find(&pool);
+  // pools created before the option is parsed have no name
+  PoolStat &stat = poolStats[it == poolNames.end() ? "(unnamed)" : it->second];
+  if (isAlloc) {
+    stat.curBytes += bytes;
+    stat.totalBytes += bytes;
+    stat.peakBytes = std::max(stat.peakBytes, stat.curBytes);
+    curBytes += bytes;
+    peakBytes = std::max(peakBytes, curBytes);
+  } else {
+    stat.curBytes -= std::min(stat.curBytes, bytes);
+    curBytes -= std::min(curBytes, bytes);
+  }
+}
+
+void MemPoolCtrler::RecordNew(const std::type_info &type, size_t num, size_t bytes) {
+  std::lock_guard<std::mutex> guard(statMutex);
+  TypeStat &stat = typeStats[std::type_index(type)];
+  stat.num += num;
+  stat.bytes += bytes;
+}
+
+void MemPoolCtrler::DumpMemStats(std::ostream &os) {
+  constexpr size_t kKB = 1024;
+  constexpr size_t kMaxTypes = 40;
+  std::lock_guard<std::mutex> guard(statMutex);
+  std::vector<std::pair<std::string, PoolStat>> pools(poolStats.begin(), poolStats.end());
+  std::sort(pools.begin(), pools.end(), [](const auto &a, const auto &b) {
+    return a.second.peakBytes > b.second.peakBytes;
+  });
+  os << "=== mem-stats: MemPools, peak of all pools " << (peakBytes / kKB) << " KB ===\n";
+  os << std::setw(12) << "peak(KB)" << std::setw(12) << "total(KB)" << std::setw(8) << "pools" << "  name\n";
+  for (auto &pool : pools) {
+    os << std::setw(12) << (pool.second.peakBytes / kKB) << std::setw(12) << (pool.second.totalBytes / kKB) <<
+        std::setw(8) << pool.second.numPools << "  " << pool.first << '\n';
+  }
+  std::vector<std::pair<std::type_index, TypeStat>> types(typeStats.begin(), typeStats.end());
+  std::sort(types.begin(), types.end(), [](const auto &a, const auto &b) {
+    return a.second.bytes > b.second.bytes;
+  });
+  os << "=== mem-stats: allocated types, by bytes ===\n";
+  os << std::setw(12) << "bytes(KB)" << std::setw(12) << "number" << std::setw(8) << "size" << "  type\n";
+  for (size_t i = 0; i < types.size() && i < kMaxTypes; ++i) {
+    const TypeStat &stat = types[i].second;
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(types[i].first.name(), nullptr, nullptr, &status);
+    os << std::setw(12) << (stat.bytes / kKB) << std::setw(12) << stat.num << std::setw(8) <<
+        (stat.num == 0 ? 0 : stat.bytes / stat.num) << "  " << (status == 0 ? demangled : types[i].first.name()) << '\n';
+    free(demangled);
+  }
+}
+
 MemPool::~MemPool() {
   ctrler.FreeMemBlocks(*this, fixedMemHead, bigMemHead);
+  if (MemPoolCtrler::memStats) {
+    ctrler.UnregisterPool(*this);
+  }
 }
 
 void *MemPool::Malloc(size_t size) {
@@ -625,6 +625,7 @@ class CallGraph : public AnalysisResult {
   MIRType *GetFuncTypeFromFuncAddr(const BaseNode *base);
   void RecordLocalConstValue(const StmtNode *stmt);
   CallNode *ReplaceIcallToCall(BlockNode &body, IcallNode &icall, PUIdx newPUIdx) const;
+  IfStmtNode *PromoteIcallByValueProfile(MIRFunction &func, BlockNode &body, StmtNode &stmt);
   void CollectAddroffuncFromExpr(const BaseNode *expr);
   void CollectAddroffuncFromStmt(const StmtNode *stmt);
   void CollectAddroffuncFromConst(MIRConst *mirConst);
@@ -704,6 +705,8 @@ class CallGraph : public AnalysisResult {
   void RemoveFileStaticSCC();        // SCC can be removed if it has no caller and all its nodes is file static
   void SetCompilationFunclist() const;
   void IncrNodesCount(CGNode *cgNode, BaseNode *bn);
+  MIRFunction *GetFuncByValueProfId(uint32 profId);
+  bool IsPromotableIcallTarget(const IcallNode &icall, const MIRFunction &target) const;
 
   CallInfo *GenCallInfo(CallType type, MIRFunction *call, StmtNode *s, uint32 loopDepth, uint32 callsiteID) {
     MIRFunction *caller = mirModule->CurFunction();
@@ -729,6 +732,7 @@ class CallGraph : public AnalysisResult {
   MapleMap<StIdx, BaseNode*> localConstValueMap;  // used to record the local constant value
   MapleMap<TyIdx, MapleSet<Caller2Cands>*> icallToFix;
   MapleSet<PUIdx> addressTakenPuidxs;
+  MapleMap<uint32, MIRFunction*> valueProfIdToFunc;  // callees recorded by the icall value profile, built lazily
   CGNode *callExternal = nullptr;  // Auxiliary node used in icall/intrinsic call
   uint32 numOfNodes;
   uint32 numOfSccs;
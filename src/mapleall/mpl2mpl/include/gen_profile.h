@@ -27,6 +27,9 @@ static constexpr const uint32_t kGCCVersion = 0x4137352A;   // gcc v7.5 under to
 // static constexpr const uint32_t kGCCVersion = 0x4139342A; // GCC V9.3/9.4
 // anything other than merge_add will be supported supported in future
 static constexpr const uint32_t kMplFuncProfCtrInfoNum = 1;
+// gcov counter slots of the value profiles, one extra counter descriptor per function each with --profile-values
+static constexpr const uint32_t kGcovCounterInterval = 1;   // kValueProfMemOpSize
+static constexpr const uint32_t kGcovCounterIcallTopN = 8;  // kValueProfIcallTopN
 
 class ProfileGenPM : public SccPM {
  public:
@@ -55,6 +58,10 @@ class ProfileGen {
     return filteredName;
   }
 
+  static uint32 GetFuncProfCtrInfoNum() {
+    return Options::profileValues ? kMplFuncProfCtrInfoNum + kValueProfKindNum : kMplFuncProfCtrInfoNum;
+  }
+
   void CreateModProfDesc();
   void CreateFuncProfDesc();
   void CreateFuncProfDescTbl();
@@ -65,6 +72,9 @@ class ProfileGen {
   std::vector<MIRFunction *> GetValidFuncs() { return validFuncs; }
 
  private:
+    MIRFunction *GetOrCreateMergeFunc(const std::string &name, const MIRType &arg1Ty, const MIRType &arg2Ty) const;
+    MIRAggConst *CreateCtrDesc(MIRType &ctrDescTy, MIRSymbol *ctrTblSym, uint32 nCtrs) const;
+
     MIRModule &mod;
     MIRSymbol *modProfDesc = nullptr;
     // Keep order of funcs visited
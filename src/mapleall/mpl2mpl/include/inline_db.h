@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifndef MPL2MPL_INLINE_DB_H
+#define MPL2MPL_INLINE_DB_H
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "types_def.h"
+
+namespace maple {
+/*
+ * Cross-module inline database (-finline-db), the indexed alternative to the .mplt_inline files. Each module
+ * writes one file holding an index of the functions it exports, with their summaries, followed by the
+ * mplt_inline text of each function. The compiler reads the indexes only and parses the body of a function
+ * on demand, once the module calls it and its summary does not rule inlining out.
+ *   MPLINLDB <version>
+ *   <number of functions>
+ *   func <name> <content hash> <static insns> <flags> <body offset> <body size> <number of deps> <dep>...
+ *   <the bodies>
+ * The deps are the static functions of the module the body calls, they are exported along and imported first.
+ */
+struct InlineDBEntry {
+  static constexpr uint32 kStatic = 1;          // only imported as a dep of another function
+  static constexpr uint32 kDeclaredInline = 2;
+
+  std::string name;
+  uint64 hash = 0;  // of the body, the same function exported by several modules is imported once
+  uint32 staticInsns = 0;
+  uint32 flags = 0;
+  std::vector<std::string> deps;
+  size_t fileIdx = 0;
+  uint64 offset = 0;  // from the start of the bodies
+  uint64 size = 0;
+
+  bool IsStatic() const {
+    return (flags & kStatic) != 0;
+  }
+
+  bool IsDeclaredInline() const {
+    return (flags & kDeclaredInline) != 0;
+  }
+};
+
+class InlineDB {
+ public:
+  static constexpr const char *kFileSuffix = ".mplinldb";
+
+  static uint64 HashBody(const std::string &body);
+
+  /* writer side, the entry takes its hash, offset and size from body */
+  void AddFunction(InlineDBEntry entry, const std::string &body);
+  bool Write(const std::string &fileName, std::string &err) const;
+
+  /*
+   * reader side, merges the index of fileName into this one. A name exported with different bodies by two
+   * modules is dropped, none of them can be told to be the one the program links.
+   */
+  bool ReadIndex(const std::string &fileName, std::string &err);
+  const InlineDBEntry *Find(const std::string &name) const;
+  bool LoadBody(const InlineDBEntry &entry, std::string &body, std::string &err) const;
+  /*
+   * entry followed by the deps it needs imported, those of its deps included. Fails with the first dep missing
+   * from the index, e.g. dropped as a conflict, then none of them may be imported.
+   */
+  bool CollectImports(const InlineDBEntry &entry, std::vector<const InlineDBEntry*> &imports,
+                      std::string &missingDep) const;
+
+  size_t GetFuncNum() const {
+    return entries.size();
+  }
+
+ private:
+  struct DBFile {
+    std::string name;
+    uint64 bodiesStart = 0;
+  };
+
+  std::map<std::string, InlineDBEntry> entries;
+  std::set<std::string> conflicts;  // names dropped by ReadIndex
+  std::string bodies;               // writer side only
+  std::vector<DBFile> files;
+};
+}  // namespace maple
+#endif  // MPL2MPL_INLINE_DB_H
@@ -14,6 +14,9 @@
  */
 #ifndef MPL2MPL_INLINE_MPLT_H
 #define MPL2MPL_INLINE_MPLT_H
+#include <map>
+#include <ostream>
+#include <vector>
 #include "types_def.h"
 #include "mir_type.h"
 #include "mir_symbol.h"
@@ -45,11 +48,16 @@ class InlineMplt {
   void CollectTypesForSingleFunction(const MIRFunction &func);
   void CollectTypesForGlobalVar(const MIRSymbol &globalSymbol);
   void DumpInlineCandidateToFile(const std::string &fileNameStr);
+  void DumpInlineCandidate(std::ostream &os);
+  // one body per function for the inline database, see inline_db.h
+  bool DumpInlineCandidateToDB(const std::string &fileNameStr);
+  void DumpSingleFunction(MIRFunction &func, std::ostream &os) const;
   void DumpOptimizedFunctionTypes();
   uint32 GetFunctionSize(MIRFunction &mirFunc) const;
 
  private:
   std::set<MIRFunction*, FuncComparator> optimizedFuncs;
+  std::map<MIRFunction*, std::vector<MIRFunction*>> staticCallees;  // of the exported global functions
   std::set<TyIdx> optimizedFuncsType;
   std::set<uint32_t> inliningGlobals;
   MIRModule &mirModule;
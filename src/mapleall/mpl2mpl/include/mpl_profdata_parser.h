@@ -15,6 +15,10 @@
 
 #ifndef MAPLE_MPL2MPL_INCLUDE_GCOVPROFUSE_H
 #define MAPLE_MPL2MPL_INCLUDE_GCOVPROFUSE_H
+#include <istream>
+#include <map>
+#include <string>
+#include <utility>
 #include "bb.h"
 #include "maple_phase_manager.h"
 #include "mempool.h"
@@ -50,6 +54,19 @@ namespace maple {
 //    counts number in function 1
 //      count
 //      ...
+//  Value profile layout (optional, only with --profile-values, up to the end of file)
+//    function numbers
+//    function Ident
+//    value kind numbers
+//      counts number of value kind 0 (interval counters of memop sizes, kMemOpSizeCounters per site)
+//        count
+//        ...
+//      counts number of value kind 1 (topn counters of icall callees, kIcallTopNCounters per site)
+//        count
+//        ...
+//    function Ident            <-- another function
+//      ...
+//  value kinds unknown to the compiler are skipped
 // now only unsigned number in profile data, use ULEB128 to encode/decode value for file size
 
 const uint32_t kMapleProfDataMagicNumber = 0xA0EFEF;
@@ -98,6 +115,42 @@ class FunctionProfileImport : public ProfDataBinaryImportBase {
   int ReadFuncProfile(MplProfileData *profData);
 };
 
+class ValueProfileImport : public ProfDataBinaryImportBase {
+ public:
+  ValueProfileImport(std::string &inputFile, std::ifstream &input) : ProfDataBinaryImportBase(inputFile, input) {}
+  ~ValueProfileImport() override = default;
+  void ReadValueProfile(MplProfileData *profData);
+};
+
+// writes the value profile part, appended by the profile converter after the function profile part. The converter
+// from .gcda is out of tree, no .mprofdata written here has this part yet.
+class ValueProfileExport {
+ public:
+  static void WriteValueProfile(const MplProfileData &profData, std::ofstream &out);
+};
+
+// Samples of a perf script dump of instruction pointers with their source lines (perf script -F ip,sym,srcline):
+// a "<ip> <symbol>[+0x<offset>]" line followed by a "<file>:<line>" line per sample. Further source lines of a
+// sample, the inline stack printed with --inline, are ignored, so are the samples without symbol or line.
+class PerfSampleProfile {
+ public:
+  using LineKey = std::pair<std::string, uint32_t>;  // base name of the source file, line
+
+  void Read(std::istream &input);
+
+  const std::map<std::string, std::map<LineKey, uint64_t>> &GetFuncSamples() const {
+    return funcSamples;
+  }
+
+  uint64_t GetSampleNum() const {
+    return sampleNum;
+  }
+
+ private:
+  std::map<std::string, std::map<LineKey, uint64_t>> funcSamples;  // symbol name is key
+  uint64_t sampleNum = 0;
+};
+
 class MplProfDataParser : public AnalysisResult {
  public:
   MplProfDataParser(MIRModule &mirmod, MemPool *mp, bool debug)
@@ -112,6 +165,8 @@ class MplProfDataParser : public AnalysisResult {
   int ReadMapleProfileData();
 
  private:
+  int ReadSampleProfileData();
+
   MIRModule &m;
   MapleAllocator alloc;
   MemPool *mempool;
@@ -184,6 +184,7 @@ class SimplifyOp : public ProxyMemOp {
                     bool &isDstSizeConst) const;
   StmtNode *PartiallyExpandMemsetS(StmtNode &stmt, BlockNode &block) const;
   StmtNode *PartiallyExpandMemcpyS(StmtNode &stmt, BlockNode &block);
+  bool SpecializeMemOpBySizeProfile(StmtNode &stmt, BlockNode &block, OpKind opKind);
 
   static const uint32 thresholdMemsetExpand;
   static const uint32 thresholdMemsetSExpand;
@@ -395,6 +395,7 @@ CallGraph::CallGraph(MIRModule &m, MemPool &memPool, MemPool &templPool, const K
       localConstValueMap(tempAlloc.Adapter()),
       icallToFix(tempAlloc.Adapter()),
       addressTakenPuidxs(tempAlloc.Adapter()),
+      valueProfIdToFunc(tempAlloc.Adapter()),
       numOfNodes(0),
       numOfSccs(0) {}
 
@@ -668,6 +669,124 @@ CallNode *CallGraph::ReplaceIcallToCall(BlockNode &body, IcallNode &icall, PUIdx
   return newCall;
 }
 
+// the function of a profile id, nullptr if unknown or if several functions have the same id
+MIRFunction *CallGraph::GetFuncByValueProfId(uint32 profId) {
+  if (valueProfIdToFunc.empty()) {
+    for (MIRFunction *func : GlobalTables::GetFunctionTable().GetFuncTable()) {
+      if (func == nullptr) {
+        continue;
+      }
+      auto ret = valueProfIdToFunc.emplace(GetValueProfFuncId(func->GetName()), func);
+      if (!ret.second && ret.first->second != func) {
+        ret.first->second = nullptr;
+      }
+    }
+  }
+  auto it = valueProfIdToFunc.find(profId);
+  return it == valueProfIdToFunc.end() ? nullptr : it->second;
+}
+
+bool CallGraph::IsPromotableIcallTarget(const IcallNode &icall, const MIRFunction &target) const {
+  size_t argNum = icall.NumOpnds() - 1;
+  if (target.GetFormalCount() != argNum && !(target.IsVarargs() && target.GetFormalCount() <= argNum)) {
+    return false;
+  }
+  bool isAssigned = icall.GetOpCode() == OP_icallassigned || icall.GetOpCode() == OP_icallprotoassigned;
+  return !isAssigned || target.GetReturnType()->GetPrimType() != PTY_void;
+}
+
+// Indirect call promotion guided by the value profile of the site:
+//   icall (fp, args)  ==>  if (fp == &foo) { call &foo (args) } else { if (fp == &bar) {...} else { icall (fp, args) } }
+// for the callees taking a large part of the calls, the direct calls are candidates of the inliner then.
+IfStmtNode *CallGraph::PromoteIcallByValueProfile(MIRFunction &func, BlockNode &body, StmtNode &stmt) {
+  constexpr uint32 kPromoteMinPercent = 30;
+  constexpr size_t kPromoteMaxTargets = 2;
+  Opcode op = stmt.GetOpCode();
+  if (!Options::profileUse || !mirModule->IsCModule() ||
+      (op != OP_icall && op != OP_icallassigned && op != OP_icallproto && op != OP_icallprotoassigned)) {
+    return nullptr;
+  }
+  auto &icall = static_cast<IcallNode&>(stmt);
+  FuncProfInfo *profData = func.GetFuncProfData();
+  ValueProfInfo *valueProf = profData == nullptr ? nullptr : profData->GetValueProf(icall.GetOriginalID());
+  if (valueProf == nullptr || valueProf->GetKind() != kValueProfIcallTopN) {
+    return nullptr;
+  }
+  // consumed here whether promoted or not, the callgraph may be rebuilt
+  profData->EraseValueProf(icall.GetOriginalID());
+  std::vector<std::pair<MIRFunction*, FreqType>> targets;
+  for (auto &value : valueProf->GetValues()) {
+    constexpr FreqType kPercentBase = 100;
+    if (targets.size() == kPromoteMaxTargets || value.second < static_cast<FreqType>(HOTCALLSITEFREQ) ||
+        value.second * kPercentBase < valueProf->GetTotal() * kPromoteMinPercent) {
+      break;
+    }
+    MIRFunction *target = GetFuncByValueProfId(static_cast<uint32>(value.first));
+    if (target != nullptr && IsPromotableIcallTarget(icall, *target)) {
+      targets.emplace_back(target, value.second);
+    }
+  }
+  if (targets.empty()) {
+    return nullptr;
+  }
+  BaseNode *funcAddr = icall.GetNopndAt(0);
+  PrimType addrType = funcAddr->GetPrimType();
+  if (funcAddr->GetOpCode() != OP_regread && funcAddr->GetOpCode() != OP_dread) {
+    PregIdx pregIdx = func.GetPregTab()->CreatePreg(addrType);
+    RegassignNode *regassign = mirBuilder->CreateStmtRegassign(addrType, pregIdx, funcAddr);
+    regassign->SetSrcPos(icall.GetSrcPos());
+    body.InsertBefore(&icall, regassign);
+    funcAddr = mirBuilder->CreateExprRegread(addrType, pregIdx);
+    icall.SetNOpndAt(0, funcAddr);
+  }
+  FreqType remainFreq = profData->GetStmtFreq(icall.GetStmtID());
+  if (remainFreq < 0) {
+    remainFreq = valueProf->GetTotal();
+  }
+  bool isAssigned = op == OP_icallassigned || op == OP_icallprotoassigned;
+  MapleAllocator &codeAlloc = func.GetCodeMPAllocator();
+  MIRType &addrMirType = *GlobalTables::GetTypeTable().GetPrimType(addrType);
+  IfStmtNode *outerIf = nullptr;
+  IfStmtNode *innerIf = nullptr;
+  for (auto &target : targets) {
+    BaseNode *cond = mirBuilder->CreateExprCompare(OP_eq, *GlobalTables::GetTypeTable().GetUInt1(), addrMirType,
+        funcAddr->CloneTree(codeAlloc), mirBuilder->CreateExprAddroffunc(target.first->GetPuidx()));
+    IfStmtNode *ifStmt = mirBuilder->CreateStmtIfThenElse(cond);
+    MapleVector<BaseNode*> args(codeAlloc.Adapter());
+    for (size_t i = 1; i < icall.NumOpnds(); ++i) {
+      args.push_back(icall.GetNopndAt(i)->CloneTree(codeAlloc));
+    }
+    CallNode *call = mirBuilder->CreateStmtCall(target.first->GetPuidx(), args, isAssigned ? OP_callassigned : OP_call);
+    if (isAssigned) {
+      call->SetReturnVec(icall.GetReturnVec());
+    }
+    for (auto *stmt : std::initializer_list<StmtNode*>{ ifStmt, ifStmt->GetThenPart(), ifStmt->GetElsePart(), call }) {
+      stmt->SetSrcPos(icall.GetSrcPos());
+    }
+    ifStmt->GetThenPart()->AddStatement(call);
+    FreqType callFreq = std::min(target.second, remainFreq);
+    profData->SetStmtFreq(ifStmt->GetStmtID(), remainFreq);
+    profData->SetStmtFreq(ifStmt->GetThenPart()->GetStmtID(), callFreq);
+    profData->SetStmtFreq(call->GetStmtID(), callFreq);
+    remainFreq -= callFreq;
+    profData->SetStmtFreq(ifStmt->GetElsePart()->GetStmtID(), remainFreq);
+    if (innerIf != nullptr) {
+      innerIf->GetElsePart()->AddStatement(ifStmt);
+    } else {
+      outerIf = ifStmt;
+    }
+    innerIf = ifStmt;
+    if (debugFlag) {
+      LogInfo::MapleLogger() << "promote icall in " << func.GetName() << " to " << target.first->GetName()
+                             << ", count " << target.second << " of " << valueProf->GetTotal() << '\n';
+    }
+  }
+  body.ReplaceStmt1WithStmt2(&icall, outerIf);
+  innerIf->GetElsePart()->AddStatement(&icall);
+  profData->SetStmtFreq(icall.GetStmtID(), remainFreq);
+  return outerIf;
+}
+
 void CallGraph::HandleCall(BlockNode &body, CGNode &node, StmtNode &stmt, uint32 loopDepth) {
   PUIdx calleePUIdx = (static_cast<CallNode*>(&stmt))->GetPUIdx();
   MIRFunction *calleeFunc = GlobalTables::GetFunctionTable().GetFunctionFromPuidx(calleePUIdx);
@@ -915,6 +1034,10 @@ void CallGraph::HandleBody(MIRFunction &func, BlockNode &body, CGNode &node, uin
       if (n->GetElsePart() != nullptr) {
         HandleBody(func, *n->GetElsePart(), node, loopDepth);
       }
+    } else if (IfStmtNode *n = PromoteIcallByValueProfile(func, body, *stmt)) {
+      // the promoted calls and the remaining icall are handled in the if statement replacing the icall
+      HandleBody(func, *n->GetThenPart(), node, loopDepth);
+      HandleBody(func, *n->GetElsePart(), node, loopDepth);
     } else {
       node.IncrStmtCount();
       CallType ct = GetCallType(op);
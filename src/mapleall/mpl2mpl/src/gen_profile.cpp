@@ -19,6 +19,29 @@
 
 // namespace maple
 namespace maple {
+namespace {
+constexpr char kGcovMergeIcallTopN[] = "__gcov_merge_icall_topn";
+}
+
+// Ref: __gcov_merge_add (gcov_type *, unsigned)
+MIRFunction *ProfileGen::GetOrCreateMergeFunc(const std::string &name, const MIRType &arg1Ty,
+                                              const MIRType &arg2Ty) const {
+  bool isNewCreated = false;
+  MIRFunction *mergeFunc = mod.GetMIRBuilder()->GetOrCreateFunction(
+      name, GlobalTables::GetTypeTable().GetVoid()->GetTypeIndex(), &isNewCreated);
+  if (!isNewCreated) {
+    return mergeFunc;
+  }
+  mergeFunc->AllocSymTab();
+  MIRSymbol *arg1Sym = mergeFunc->GetSymTab()->CreateSymbol(kScopeLocal);
+  arg1Sym->SetTyIdx(arg1Ty.GetTypeIndex());
+  mergeFunc->AddArgument(arg1Sym);
+  MIRSymbol *arg2Sym = mergeFunc->GetSymTab()->CreateSymbol(kScopeLocal);
+  arg2Sym->SetTyIdx(arg2Ty.GetTypeIndex());
+  mergeFunc->AddArgument(arg2Sym);
+  return mergeFunc;
+}
+
 void ProfileGen::CreateModProfDesc() {
   // Ref gcov_info
   MIRBuilder *mirBuilder = mod.GetMIRBuilder();
@@ -39,7 +62,6 @@ void ProfileGen::CreateModProfDesc() {
   MIRType *u32Ty = GlobalTables::GetTypeTable().GetUInt32();
   TyIdx u32TyIdx = u32Ty->GetTypeIndex();
   TyIdx ptrTyIdx = GlobalTables::GetTypeTable().GetPtr()->GetTypeIndex();
-  MIRType *voidTy = GlobalTables::GetTypeTable().GetVoid();
   MIRType *voidPtrTy = GlobalTables::GetTypeTable().GetVoidPtr();
   TyIdx charPtrTyIdx = GlobalTables::GetTypeTable().GetOrCreatePointerType(TyIdx(PTY_u8))->GetTypeIndex();
 
@@ -111,28 +133,23 @@ void ProfileGen::CreateModProfDesc() {
   modProfDescSymMirConst->AddItem(profileFNMirConst, 6);
 
   // Additional profiling (in addition to frequency profiling) should be added here
-  MIRFunction *profFuncProtoTy =
-      mod.GetMIRBuilder()->GetOrCreateFunction(namemangler::kMplMergeFuncAdd, voidTy->GetTypeIndex());
-  profFuncProtoTy->AllocSymTab();
-  MIRSymbol *profFuncArg1Sym = profFuncProtoTy->GetSymTab()->CreateSymbol(kScopeLocal);
-  profFuncArg1Sym->SetTyIdx(arg1Ty->GetTypeIndex());
-  profFuncProtoTy->AddArgument(profFuncArg1Sym);
-  MIRSymbol *profFuncArg2Sym = profFuncProtoTy->GetSymTab()->CreateSymbol(kScopeLocal);
-  profFuncArg2Sym->SetTyIdx(arg2Ty->GetTypeIndex());
-  profFuncProtoTy->AddArgument(profFuncArg2Sym);
+  MIRFunction *profFuncProtoTy = GetOrCreateMergeFunc(namemangler::kMplMergeFuncAdd, *arg1Ty, *arg2Ty);
   MIRAddroffuncConst *profEdgeCountMirConst =
       modMP->New<MIRAddroffuncConst>(profFuncProtoTy->GetPuidx(), *funcPtrTy);
   MIRAggConst *mergeFuncsMirConst = modMP->New<MIRAggConst>(mod, *arrOfPtrsTy);
 
-  mergeFuncsMirConst->AddItem(profEdgeCountMirConst, 0);
-  mergeFuncsMirConst->AddItem(nextMirConst, 1);
-  mergeFuncsMirConst->AddItem(nextMirConst, 2);
-  mergeFuncsMirConst->AddItem(nextMirConst, 3);
-  mergeFuncsMirConst->AddItem(nextMirConst, 4);
-  mergeFuncsMirConst->AddItem(nextMirConst, 5);
-  mergeFuncsMirConst->AddItem(nextMirConst, 6);
-  mergeFuncsMirConst->AddItem(nextMirConst, 7);
-  mergeFuncsMirConst->AddItem(nextMirConst, 8);
+  // the counters of the value profiles are laid out in the order of their slots, libgcov skips the null ones
+  MIRConst *mergeFuncs[kMplModProfMergeFuncs] = {
+      profEdgeCountMirConst, nextMirConst, nextMirConst, nextMirConst, nextMirConst,
+      nextMirConst, nextMirConst, nextMirConst, nextMirConst };
+  if (Options::profileValues) {
+    mergeFuncs[kGcovCounterInterval] = profEdgeCountMirConst;
+    MIRFunction *mergeIcallTopN = GetOrCreateMergeFunc(kGcovMergeIcallTopN, *arg1Ty, *arg2Ty);
+    mergeFuncs[kGcovCounterIcallTopN] = modMP->New<MIRAddroffuncConst>(mergeIcallTopN->GetPuidx(), *funcPtrTy);
+  }
+  for (uint32 i = 0; i < kMplModProfMergeFuncs; ++i) {
+    mergeFuncsMirConst->AddItem(mergeFuncs[i], i);
+  }
 
   modProfDescSymMirConst->AddItem(mergeFuncsMirConst, 7);
 
@@ -152,6 +169,40 @@ void ProfileGen::CreateModProfDesc() {
   modProfDesc = modProfDescSym;
 }
 
+// a gcov_ctr_info, zero initializing the counter table
+MIRAggConst *ProfileGen::CreateCtrDesc(MIRType &ctrDescTy, MIRSymbol *ctrTblSym, uint32 nCtrs) const {
+  MemPool *modMP = mod.GetMemPool();
+  MIRType *u32Ty = GlobalTables::GetTypeTable().GetUInt32();
+  // Initialization of counter table
+  MIRType *u64Ty = GlobalTables::GetTypeTable().GetUInt64();
+  MIRIntConst *zeroMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(0, *u64Ty);
+  MIRType *arrOfUInt64Ty = GlobalTables::GetTypeTable().GetOrCreateArrayType(*u64Ty, nCtrs);
+  MIRAggConst *initCtrTblMirConst = modMP->New<MIRAggConst>(mod, *arrOfUInt64Ty);
+
+  if (ctrTblSym && nCtrs > 0) {
+    for (uint32 i = 0; i < nCtrs; ++i) {
+      initCtrTblMirConst->AddItem(zeroMirConst, i);
+    }
+    ctrTblSym->SetKonst(initCtrTblMirConst);
+  }
+
+  MIRAggConst *ctrDescMirConst = modMP->New<MIRAggConst>(mod, ctrDescTy);
+
+  MIRIntConst *nCtrMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(nCtrs, *u32Ty);
+  ctrDescMirConst->AddItem(nCtrMirConst, 1);
+
+  MIRAddrofConst *ctrTblMirConst;
+  if (ctrTblSym) {
+    ctrTblMirConst = modMP->New<MIRAddrofConst>(ctrTblSym->GetStIdx(), 0, *GlobalTables::GetTypeTable().GetPtr());
+    ctrDescMirConst->AddItem(ctrTblMirConst, 2);
+  } else {
+    MIRType *voidPtrTy = GlobalTables::GetTypeTable().GetVoidPtr();
+    MIRIntConst *nullPtrMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(0, *voidPtrTy);
+    ctrDescMirConst->AddItem(nullPtrMirConst, 2);
+  }
+  return ctrDescMirConst;
+}
+
 void ProfileGen::CreateFuncProfDesc() {
   // Ref: gcov_ctr_info
   //      gcov_fn_info
@@ -181,7 +232,7 @@ void ProfileGen::CreateFuncProfDesc() {
   GStrIdx ctrDescStrIdx = mirBuilder->GetOrCreateStringIndex("ctr_desc");    // 6
 
   MIRType *modProfDescPtrTy = GlobalTables::GetTypeTable().GetOrCreatePointerType(modProfDesc->GetTyIdx());
-  MIRType *arrOfCtrDescTy = GlobalTables::GetTypeTable().GetOrCreateArrayType(*ctrDescTy, kMplFuncProfCtrInfoNum);
+  MIRType *arrOfCtrDescTy = GlobalTables::GetTypeTable().GetOrCreateArrayType(*ctrDescTy, GetFuncProfCtrInfoNum());
 
   FieldVector funcProfDescFields;                                                                             // Field
   funcProfDescFields.emplace_back(
@@ -205,22 +256,6 @@ void ProfileGen::CreateFuncProfDesc() {
       continue;
     }
 
-    uint32 nCtrs = f->GetNumCtrs();
-    MIRSymbol *ctrTblSym = f->GetProfCtrTbl();
-
-    // Initialization of counter table
-    MIRType *u64Ty = GlobalTables::GetTypeTable().GetUInt64();
-    MIRIntConst *zeroMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(0, *u64Ty);
-    MIRType *arrOfUInt64Ty = GlobalTables::GetTypeTable().GetOrCreateArrayType(*u64Ty, nCtrs);
-    MIRAggConst *initCtrTblMirConst = modMP->New<MIRAggConst>(mod, *arrOfUInt64Ty);
-
-    if (ctrTblSym && nCtrs > 0) {
-      for (uint32 i = 0; i < nCtrs; ++i) {
-        initCtrTblMirConst->AddItem(zeroMirConst, i);
-      }
-      ctrTblSym->SetKonst(initCtrTblMirConst);
-    }
-
     PUIdx puID = f->GetPuidx();
 
     // Create const func profile descriptor
@@ -247,27 +282,13 @@ void ProfileGen::CreateFuncProfDesc() {
     MIRIntConst *pad4bMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(pad4b, *u32Ty);
     funcProfDescMirConst->AddItem(pad4bMirConst, 5);
 
-    MIRAggConst *ctrDescMirConst = modMP->New<MIRAggConst>(mod, *ctrDescTy);
-
-    MIRIntConst *nCtrMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(nCtrs, *u32Ty);
-    ctrDescMirConst->AddItem(nCtrMirConst, 1);
-
-    MIRAddrofConst *ctrTblMirConst;
-    if (ctrTblSym) {
-      ctrTblMirConst = modMP->New<MIRAddrofConst>(ctrTblSym->GetStIdx(), 0, *GlobalTables::GetTypeTable().GetPtr());
-      ctrDescMirConst->AddItem(ctrTblMirConst, 2);
-    } else {
-      MIRType *voidPtrTy = GlobalTables::GetTypeTable().GetVoidPtr();
-      MIRIntConst *nullPtrMirConst = GlobalTables::GetIntConstTable().GetOrCreateIntConst(0, *voidPtrTy);
-      ctrDescMirConst->AddItem(nullPtrMirConst, 2);
+    MIRAggConst *arrOfCtrDescMirConst = modMP->New<MIRAggConst>(mod, *arrOfCtrDescTy);
+    arrOfCtrDescMirConst->AddItem(CreateCtrDesc(*ctrDescTy, f->GetProfCtrTbl(), f->GetNumCtrs()), 0);
+    // value profile counters follow in ValueProfKind order, which is the order of their gcov counter slots
+    for (uint32 kind = 0; Options::profileValues && kind < kValueProfKindNum; ++kind) {
+      arrOfCtrDescMirConst->AddItem(
+          CreateCtrDesc(*ctrDescTy, f->GetValueProfCtrTbl(kind), f->GetValueProfNumCtrs(kind)), kind + 1);
     }
-
-    MIRType *mirType =
-        GlobalTables::GetTypeTable().GetOrCreateArrayType(*ctrDescTy, kMplFuncProfCtrInfoNum);
-    MIRAggConst *arrOfCtrDescMirConst = modMP->New<MIRAggConst>(mod, *mirType);
-
-    // if kMplFuncProfCtrInfoNum > 1, more counter descriptors need to add
-    arrOfCtrDescMirConst->AddItem(ctrDescMirConst, 0);
     funcProfDescMirConst->AddItem(arrOfCtrDescMirConst, 6);
 
     MIRSymbol *funcProfDescSym = mod.GetMIRBuilder()->CreateGlobalDecl(
@@ -869,6 +869,11 @@ bool M2MInline::PhaseRun(maple::MIRModule &m) {
     return false;
   }
   MemPool *memPool = ApplyTempMemPool();
+  // the callgraph promotes the hot icalls once the value profiles are attached by profileUse, rebuild it
+  if (Options::profileUse && m.GetMapleProfile() != nullptr && m.GetMapleProfile()->HasValueProfile()) {
+    GetAnalysisInfoHook()->ForceEraseAnalysisPhase(m.GetUniqueID(), &M2MCallGraph::id);
+    (void)GetAnalysisInfoHook()->ForceRunAnalysisPhase<MapleModulePhase, MIRModule>(&M2MCallGraph::id, m);
+  }
   CallGraph *cg = GET_ANALYSIS(M2MCallGraph, m);
   CHECK_FATAL(cg != nullptr, "Expecting a valid CallGraph, found nullptr");
   const bool onlyForAlwaysInline = m.IsCModule() && skipNormalInline;
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "inline_db.h"
+#include <fstream>
+#include <sstream>
+
+namespace maple {
+namespace {
+constexpr const char *kMagic = "MPLINLDB";
+constexpr uint32 kVersion = 1;
+}
+
+uint64 InlineDB::HashBody(const std::string &body) {
+  // FNV-1a
+  constexpr uint64 kOffsetBasis = 0xcbf29ce484222325ULL;
+  constexpr uint64 kPrime = 0x100000001b3ULL;
+  uint64 hash = kOffsetBasis;
+  for (unsigned char c : body) {
+    hash = (hash ^ c) * kPrime;
+  }
+  return hash;
+}
+
+void InlineDB::AddFunction(InlineDBEntry entry, const std::string &body) {
+  entry.hash = HashBody(body);
+  entry.offset = bodies.size();
+  entry.size = body.size();
+  bodies += body;
+  std::string name = entry.name;
+  entries[name] = std::move(entry);
+}
+
+bool InlineDB::Write(const std::string &fileName, std::string &err) const {
+  std::ofstream out(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!out.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  out << kMagic << ' ' << kVersion << '\n' << entries.size() << '\n';
+  for (auto &pair : entries) {
+    const InlineDBEntry &entry = pair.second;
+    out << "func " << entry.name << ' ' << std::hex << entry.hash << std::dec << ' ' << entry.staticInsns << ' ' <<
+        entry.flags << ' ' << entry.offset << ' ' << entry.size << ' ' << entry.deps.size();
+    for (auto &dep : entry.deps) {
+      out << ' ' << dep;
+    }
+    out << '\n';
+  }
+  out << bodies;
+  out.close();
+  if (!out) {
+    err = "failed to write " + fileName;
+    return false;
+  }
+  return true;
+}
+
+bool InlineDB::ReadIndex(const std::string &fileName, std::string &err) {
+  std::ifstream in(fileName, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    err = "cannot open " + fileName;
+    return false;
+  }
+  std::string magic;
+  uint32 version = 0;
+  size_t num = 0;
+  if (!(in >> magic >> version >> num) || magic != kMagic || version != kVersion) {
+    err = fileName + ": not an inline database of version " + std::to_string(kVersion);
+    return false;
+  }
+  std::string line;
+  (void)std::getline(in, line);  // the end of the number line
+  std::vector<InlineDBEntry> fileEntries(num);
+  for (auto &entry : fileEntries) {
+    std::string kind;
+    size_t numDeps = 0;
+    if (!std::getline(in, line)) {
+      err = fileName + ": truncated index";
+      return false;
+    }
+    std::istringstream ss(line);
+    if (!(ss >> kind >> entry.name >> std::hex >> entry.hash >> std::dec >> entry.staticInsns >> entry.flags >>
+          entry.offset >> entry.size >> numDeps) || kind != "func") {
+      err = fileName + ": unexpected line " + line;
+      return false;
+    }
+    entry.deps.resize(numDeps);
+    for (auto &dep : entry.deps) {
+      if (!(ss >> dep)) {
+        err = fileName + ": unexpected line " + line;
+        return false;
+      }
+    }
+    entry.fileIdx = files.size();
+  }
+  files.push_back(DBFile{ fileName, static_cast<uint64>(in.tellg()) });
+  for (auto &entry : fileEntries) {
+    if (conflicts.count(entry.name) != 0) {
+      continue;
+    }
+    auto it = entries.find(entry.name);
+    if (it == entries.end()) {
+      std::string name = entry.name;
+      entries[name] = std::move(entry);
+    } else if (it->second.hash != entry.hash) {
+      (void)conflicts.insert(entry.name);
+      (void)entries.erase(it);
+    }
+  }
+  return true;
+}
+
+const InlineDBEntry *InlineDB::Find(const std::string &name) const {
+  auto it = entries.find(name);
+  return it == entries.end() ? nullptr : &it->second;
+}
+
+bool InlineDB::LoadBody(const InlineDBEntry &entry, std::string &body, std::string &err) const {
+  const DBFile &file = files[entry.fileIdx];
+  std::ifstream in(file.name, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    err = "cannot open " + file.name;
+    return false;
+  }
+  body.resize(entry.size);
+  if (!in.seekg(static_cast<std::streamoff>(file.bodiesStart + entry.offset)) ||
+      !in.read(&body[0], static_cast<std::streamsize>(entry.size))) {
+    err = file.name + ": truncated body of " + entry.name;
+    return false;
+  }
+  if (HashBody(body) != entry.hash) {
+    err = file.name + ": the body of " + entry.name + " does not match its hash";
+    return false;
+  }
+  return true;
+}
+
+bool InlineDB::CollectImports(const InlineDBEntry &entry, std::vector<const InlineDBEntry*> &imports,
+                              std::string &missingDep) const {
+  imports.clear();
+  imports.push_back(&entry);
+  std::set<std::string> seen = { entry.name };
+  for (size_t i = 0; i < imports.size(); ++i) {
+    for (auto &dep : imports[i]->deps) {
+      if (!seen.insert(dep).second) {
+        continue;
+      }
+      const InlineDBEntry *depEntry = Find(dep);
+      if (depEntry == nullptr) {
+        missingDep = dep;
+        imports.clear();
+        return false;
+      }
+      imports.push_back(depEntry);
+    }
+  }
+  return true;
+}
+}  // namespace maple
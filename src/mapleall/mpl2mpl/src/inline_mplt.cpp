@@ -14,6 +14,8 @@
  */
 #include "inline_mplt.h"
 #include <fstream>
+#include <sstream>
+#include "inline_db.h"
 #include "stmt_cost_analyzer.h"
 
 namespace maple {
@@ -35,6 +37,7 @@ bool InlineMplt::CollectInlineInfo(uint32 inlineSize, uint32 level) {
     }
     (void)optimizedFuncs.emplace(func);
     optimizedFuncs.insert(tmpStaticFuncs.cbegin(), tmpStaticFuncs.cend());
+    staticCallees[func] = tmpStaticFuncs;
     inliningGlobals.insert(tmpInliningGlobals.cbegin(), tmpInliningGlobals.cend());
   }
   if (optimizedFuncs.empty()) {
@@ -168,10 +171,15 @@ void InlineMplt::CollectTypesForGlobalVar(const MIRSymbol &globalSymbol) {
 
 void InlineMplt::DumpInlineCandidateToFile(const std::string &fileNameStr) {
   std::ofstream file;
-  // Change cout's buffer to file.
-  std::streambuf *backup = LogInfo::MapleLogger().rdbuf();
-  (void)LogInfo::MapleLogger().rdbuf(file.rdbuf());
   file.open(fileNameStr, std::ios::trunc);
+  DumpInlineCandidate(file);
+  file.close();
+}
+
+void InlineMplt::DumpInlineCandidate(std::ostream &os) {
+  // Change cout's buffer to os.
+  std::streambuf *backup = LogInfo::MapleLogger().rdbuf();
+  (void)LogInfo::MapleLogger().rdbuf(os.rdbuf());
   DumpOptimizedFunctionTypes();
   // dump global variables needed for inlining file
   for (auto symbolIdx : inliningGlobals) {
@@ -208,7 +216,44 @@ void InlineMplt::DumpInlineCandidateToFile(const std::string &fileNameStr) {
   }
   // Restore cout's buffer.
   (void)LogInfo::MapleLogger().rdbuf(backup);
-  file.close();
+}
+
+bool InlineMplt::DumpInlineCandidateToDB(const std::string &fileNameStr) {
+  InlineDB db;
+  for (auto *func : optimizedFuncs) {
+    InlineDBEntry entry;
+    entry.name = func->GetName();
+    entry.staticInsns = GetFunctionSize(*func);
+    entry.flags = (func->IsStatic() ? InlineDBEntry::kStatic : 0) |
+        (func->IsInline() ? InlineDBEntry::kDeclaredInline : 0);
+    auto it = staticCallees.find(func);
+    if (it != staticCallees.end()) {
+      for (auto *callee : it->second) {
+        entry.deps.push_back(callee->GetName());
+      }
+    }
+    std::ostringstream body;
+    DumpSingleFunction(*func, body);
+    db.AddFunction(std::move(entry), body.str());
+  }
+  std::string err;
+  if (!db.Write(fileNameStr, err)) {
+    LogInfo::MapleLogger(kLlErr) << "Error: " << err << '\n';
+    return false;
+  }
+  return true;
+}
+
+// func alone, with the types and globals it refers to, the static functions it calls are only declared
+void InlineMplt::DumpSingleFunction(MIRFunction &func, std::ostream &os) const {
+  InlineMplt single(mirModule);
+  std::vector<MIRFunction*> tmpStaticFuncs;
+  // level 1 lets the static callees through, they have entries of their own
+  (void)single.Forbidden(func.GetBody(), std::make_pair(UINT32_MAX, 1U), tmpStaticFuncs, single.inliningGlobals);
+  (void)single.optimizedFuncs.emplace(&func);
+  single.CollectTypesForOptimizedFunctions();
+  single.CollectTypesForInliningGlobals();
+  single.DumpInlineCandidate(os);
 }
 
 void InlineMplt::DumpOptimizedFunctionTypes() {
@@ -15,6 +15,7 @@
 
 #include "mpl_profdata_parser.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <cstdarg>
@@ -23,6 +24,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <functional>
+#include <sstream>
+#include <vector>
 
 #include "mpl_logging.h"
 #include "option.h"
@@ -81,7 +85,178 @@ int FunctionProfileImport::ReadFuncProfile(MplProfileData *profData) {
   return 0;
 }
 
+void ValueProfileImport::ReadValueProfile(MplProfileData *profData) {
+  CHECK_FATAL(profData != nullptr, "sanity check");
+  uint32_t funcNums = ReadNum<uint32_t>();
+  for (uint32_t i = 0; i < funcNums; i++) {
+    uint32_t funcIdent = ReadNum<uint32_t>();
+    FuncProfInfo *funcProf = profData->GetFuncProfile(funcIdent);
+    uint32_t kindNum = ReadNum<uint32_t>();
+    for (uint32_t kind = 0; kind < kindNum; kind++) {
+      uint32_t countNum = ReadNum<uint32_t>();
+      bool keep = funcProf != nullptr && kind < kValueProfKindNum;
+      if (keep) {
+        funcProf->valueCounts[kind].resize(countNum);
+      }
+      for (uint32_t j = 0; j < countNum; j++) {
+        FreqType count = static_cast<FreqType>(ReadNum<uint64_t>());
+        if (keep) {
+          funcProf->valueCounts[kind][j] = count;
+        }
+      }
+    }
+  }
+  profData->SetHasValueProfile(funcNums != 0);
+}
+
+namespace {
+bool IsHexNumber(const std::string &str) {
+  size_t start = (str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) ? 2 : 0;
+  return start < str.size() && std::all_of(str.begin() + static_cast<std::ptrdiff_t>(start), str.end(),
+                                            [](char c) { return isxdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+// "<file>:<line>", the file reduced to its base name
+bool ParseSrcLine(const std::string &str, PerfSampleProfile::LineKey &key) {
+  size_t colon = str.find_last_of(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 == str.size() ||
+      !std::all_of(str.begin() + static_cast<std::ptrdiff_t>(colon) + 1, str.end(),
+                   [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; })) {
+    return false;
+  }
+  std::string file = str.substr(0, colon);
+  size_t slash = file.find_last_of('/');
+  key.first = slash == std::string::npos ? file : file.substr(slash + 1);
+  key.second = static_cast<uint32_t>(std::strtoul(str.c_str() + colon + 1, nullptr, 10));
+  return key.first != "??" && key.second != 0;
+}
+}
+
+void PerfSampleProfile::Read(std::istream &input) {
+  std::string line;
+  std::string symbol;  // of the sample waiting for its source line
+  while (std::getline(input, line)) {
+    std::istringstream ss(line);
+    std::vector<std::string> tokens;
+    for (std::string token; ss >> token;) {
+      tokens.push_back(token);
+    }
+    LineKey key;
+    if (tokens.size() == 1 && ParseSrcLine(tokens[0], key)) {
+      if (!symbol.empty()) {
+        ++funcSamples[symbol][key];
+        ++sampleNum;
+        symbol.clear();
+      }
+      continue;
+    }
+    symbol.clear();
+    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+      if (IsHexNumber(tokens[i])) {
+        symbol = tokens[i + 1].substr(0, tokens[i + 1].find("+0x"));
+        break;
+      }
+    }
+    if (symbol == "[unknown]") {
+      symbol.clear();
+    }
+  }
+}
+
+// a sample-based profile gives each function with samples the counts of its source lines, the functions
+// without samples, e.g. inlined at all their call sites in the profiled binary, keep the static estimates
+int MplProfDataParser::ReadSampleProfileData() {
+  std::ifstream input(Options::sampleProfile);
+  if (!input) {
+    if (opts::missingProfDataIsError) {
+      CHECK_FATAL(false, "Could not open sample profile %s, quit\n", Options::sampleProfile.c_str());
+    } else {
+      WARN(kLncWarn, "Could not open sample profile %s\n", Options::sampleProfile.c_str());
+    }
+    return 1;
+  }
+  PerfSampleProfile samples;
+  samples.Read(input);
+  profData = mempool->New<MplProfileData>(mempool, &alloc);
+  std::map<std::string, std::vector<uint32_t>> fileNums;  // base name of the source file is key
+  for (auto &info : m.GetSrcFileInfo()) {
+    const std::string &file = GlobalTables::GetStrTable().GetStringFromStrIdx(info.first);
+    size_t slash = file.find_last_of('/');
+    fileNums[slash == std::string::npos ? file : file.substr(slash + 1)].push_back(info.second);
+  }
+  std::vector<uint64_t> lineCounts;
+  for (MIRFunction *func : m.GetFunctionList()) {
+    auto funcIt = samples.GetFuncSamples().find(func->GetName());
+    if (func->GetBody() == nullptr || funcIt == samples.GetFuncSamples().end()) {
+      continue;
+    }
+    FuncProfInfo *funcProf = profData->AddNewFuncProfile(func->GetPuidx(), 0, 0, 0);
+    for (auto &lineSample : funcIt->second) {
+      auto fileIt = fileNums.find(lineSample.first.first);
+      if (fileIt == fileNums.end()) {
+        continue;
+      }
+      for (uint32_t fileNum : fileIt->second) {
+        funcProf->lineSamples[GetSampleLineKey(fileNum, lineSample.first.second)] +=
+            static_cast<FreqType>(lineSample.second);
+      }
+      lineCounts.push_back(lineSample.second);
+    }
+  }
+  // no count histogram here, the hot lines are those holding 90% of the samples
+  constexpr uint64_t kHotRatio = 90;
+  constexpr uint64_t kPercent = 100;
+  uint64_t total = 0;
+  for (uint64_t count : lineCounts) {
+    total += count;
+  }
+  std::sort(lineCounts.begin(), lineCounts.end(), std::greater<uint64_t>());
+  uint64_t covered = 0;
+  profData->hotCountThreshold = 1;
+  for (uint64_t count : lineCounts) {
+    covered += count;
+    profData->hotCountThreshold = std::max<uint64_t>(count, 1);
+    if (covered * kPercent >= total * kHotRatio) {
+      break;
+    }
+  }
+  if (Options::profileHotCountSeted) {
+    profData->hotCountThreshold = Options::profileHotCount;
+  }
+  if (dumpDetail) {
+    LogInfo::MapleLogger() << "sample profile " << Options::sampleProfile << ": " << samples.GetSampleNum() <<
+        " samples, " << profData->funcsCounter.size() << " functions of the module, hot threshold " <<
+        profData->hotCountThreshold << '\n';
+  }
+  return 0;
+}
+
+void ValueProfileExport::WriteValueProfile(const MplProfileData &profData, std::ofstream &out) {
+  std::vector<std::pair<unsigned, const FuncProfInfo*>> funcProfs;
+  for (auto &it : profData.funcsCounter) {
+    if (std::any_of(it.second->valueCounts.begin(), it.second->valueCounts.end(),
+                    [](const MapleVector<FreqType> &counts) { return !counts.empty(); })) {
+      funcProfs.emplace_back(it.first, it.second);
+    }
+  }
+  std::sort(funcProfs.begin(), funcProfs.end());
+  (void)namemangler::EncodeULEB128(funcProfs.size(), out);
+  for (auto &funcProf : funcProfs) {
+    (void)namemangler::EncodeULEB128(funcProf.first, out);
+    (void)namemangler::EncodeULEB128(kValueProfKindNum, out);
+    for (auto &counts : funcProf.second->valueCounts) {
+      (void)namemangler::EncodeULEB128(counts.size(), out);
+      for (FreqType count : counts) {
+        (void)namemangler::EncodeULEB128(static_cast<uint64_t>(count), out);
+      }
+    }
+  }
+}
+
 int MplProfDataParser::ReadMapleProfileData() {
+  if (!Options::sampleProfile.empty()) {
+    return ReadSampleProfileData();
+  }
   std::string mprofDataFile = Options::profile;
   if (mprofDataFile.empty()) {
     if (const char *envGcovprefix = std::getenv("GCOV_PREFIX")) {
@@ -163,6 +338,12 @@ int MplProfDataParser::ReadMapleProfileData() {
     LogInfo::MapleLogger() << "no function profile part\n";
     return 1;
   }
+  // read the optional 3rd part value profile data
+  if (funcImport.GetPosition() < static_cast<uint8_t*>(static_cast<void*>(buffer.get())) + length) {
+    ValueProfileImport valueImport(mprofDataFile, inputStream);
+    valueImport.SetPosition(funcImport.GetPosition());
+    valueImport.ReadValueProfile(profData);
+  }
   if (dumpDetail) {
     profData->DumpFunctionsProfile();
   }
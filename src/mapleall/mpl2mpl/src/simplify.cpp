@@ -49,6 +49,7 @@ constexpr uint32_t kMemOpDstOpndIdx = 0;
 constexpr uint32_t kMemOpSDstSizeOpndIdx = 1;
 constexpr uint32_t kMemOpSrcOpndIdx = 2;
 constexpr uint32_t kMemOpSSrcOpndIdx = 2;
+constexpr uint32_t kMemOpSizeOpndIdx = 2;
 constexpr uint32_t kMemOpSSrcSizeOpndIdx = 3;
 constexpr uint32_t kSprintfFmtOpndIdx = 1;
 constexpr uint32_t kSprintfOrigOpndIdx = 2;
@@ -1813,11 +1814,17 @@ bool SimplifyOp::AutoSimplify(StmtNode &stmt, BlockNode &block, bool isLowLevel)
   switch (opKind) {
     case kMemOpMemset:
     case kMemOpMemsetS: {
-      return SimplifyMemset(stmt, block, isLowLevel);
+      if (SimplifyMemset(stmt, block, isLowLevel)) {
+        return true;
+      }
+      return isLowLevel && opKind == kMemOpMemset && SpecializeMemOpBySizeProfile(stmt, block, opKind);
     }
     case kMemOpMemcpy:
     case kMemOpMemcpyS: {
-      return SimplifyMemcpy(stmt, block, isLowLevel);
+      if (SimplifyMemcpy(stmt, block, isLowLevel)) {
+        return true;
+      }
+      return isLowLevel && opKind == kMemOpMemcpy && SpecializeMemOpBySizeProfile(stmt, block, opKind);
     }
     case kSprintfOpSprintf:
     case kSprintfOpSprintfS:
@@ -1832,6 +1839,96 @@ bool SimplifyOp::AutoSimplify(StmtNode &stmt, BlockNode &block, bool isLowLevel)
   return false;
 }
 
+// A memset/memcpy of variable size whose profiled size is mostly one small value K is versioned:
+//   brfalse @other (eq size, K)
+//   <the call with size K, expanded>
+//   goto @join
+// @other:
+//   <a copy of the original call>
+// @join:
+// Only done at low level, the versioned code needs no further structuring then. Like the other expansions, stmt
+// itself is left out of block, callers restore its links to the enclosing block afterwards.
+bool SimplifyOp::SpecializeMemOpBySizeProfile(StmtNode &stmt, BlockNode &block, OpKind opKind) {
+  constexpr uint32 kSpecializeMinPercent = 80;
+  FuncProfInfo *profData = func->GetFuncProfData();
+  if (Options::optForSize || profData == nullptr) {
+    return false;
+  }
+  ValueProfInfo *valueProf = profData->GetValueProf(stmt.GetOriginalID());
+  if (valueProf == nullptr || valueProf->GetKind() != kValueProfMemOpSize) {
+    return false;
+  }
+  // consumed here, the expanded clone must not be specialized again
+  profData->EraseValueProf(stmt.GetOriginalID());
+  int64 dominantSize = 0;
+  FreqType dominantCount = 0;
+  uint32 thresholdExpand = opKind == kMemOpMemset ? thresholdMemsetExpand : thresholdMemcpyExpand;
+  if (!valueProf->GetDominantValue(kSpecializeMinPercent, dominantSize, dominantCount) || dominantSize <= 0 ||
+      static_cast<uint64>(dominantSize) > thresholdExpand) {
+    return false;
+  }
+  MIRBuilder *mirBuilder = func->GetModule()->GetMIRBuilder();
+  BaseNode *sizeExpr = stmt.Opnd(kMemOpSizeOpndIdx);
+  PrimType sizeType = sizeExpr->GetPrimType();
+  RegassignNode *sizeAssign = nullptr;
+  if (sizeExpr->GetOpCode() != OP_regread && sizeExpr->GetOpCode() != OP_dread) {
+    PregIdx pregIdx = func->GetPregTab()->CreatePreg(sizeType);
+    sizeAssign = mirBuilder->CreateStmtRegassign(sizeType, pregIdx, sizeExpr);
+    sizeAssign->SetSrcPos(stmt.GetSrcPos());
+    block.InsertBefore(&stmt, sizeAssign);
+    sizeExpr = mirBuilder->CreateExprRegread(sizeType, pregIdx);
+    stmt.SetOpnd(sizeExpr, kMemOpSizeOpndIdx);
+  }
+  MIRType &sizeMirType = *GlobalTables::GetTypeTable().GetPrimType(sizeType);
+  LabelIdx otherLabel = func->GetLabelTab()->CreateLabelWithPrefix('f');
+  LabelIdx joinLabel = func->GetLabelTab()->CreateLabelWithPrefix('f');
+  BaseNode *cond = mirBuilder->CreateExprCompare(OP_eq, *GlobalTables::GetTypeTable().GetUInt1(), sizeMirType,
+      sizeExpr->CloneTree(func->GetCodeMPAllocator()),
+      mirBuilder->CreateIntConst(static_cast<uint64>(dominantSize), sizeType));
+  CondGotoNode *condGoto = mirBuilder->CreateStmtCondGoto(cond, OP_brfalse, otherLabel);
+  condGoto->SetSrcPos(stmt.GetSrcPos());
+  block.InsertBefore(&stmt, condGoto);
+  StmtNode *clone = stmt.CloneTree(func->GetCodeMPAllocator());
+  clone->SetOpnd(mirBuilder->CreateIntConst(static_cast<uint64>(dominantSize), sizeType), kMemOpSizeOpndIdx);
+  block.InsertBefore(&stmt, clone);
+  bool expanded = opKind == kMemOpMemset ? SimplifyMemset(*clone, block, true) : SimplifyMemcpy(*clone, block, true);
+  FreqType freq = profData->GetStmtFreq(stmt.GetStmtID());
+  StmtNode *fallback = stmt.CloneTree(func->GetCodeMPAllocator());
+  block.ReplaceStmt1WithStmt2(&stmt, fallback);
+  if (!expanded) {
+    // e.g. memset of a non-const value, keep the call only
+    block.RemoveStmt(clone);
+    block.RemoveStmt(condGoto);
+    if (sizeAssign == nullptr) {
+      block.ReplaceStmt1WithStmt2(fallback, &stmt);
+      return false;
+    }
+    profData->SetStmtFreq(fallback->GetStmtID(), freq);
+    return true;
+  }
+  GotoNode *gotoJoin = mirBuilder->CreateStmtGoto(OP_goto, joinLabel);
+  LabelNode *otherLabelStmt = mirBuilder->CreateStmtLabel(otherLabel);
+  LabelNode *joinLabelStmt = mirBuilder->CreateStmtLabel(joinLabel);
+  block.InsertBefore(fallback, gotoJoin);
+  block.InsertBefore(fallback, otherLabelStmt);
+  block.InsertAfter(fallback, joinLabelStmt);
+  if (freq < 0) {
+    freq = valueProf->GetTotal();
+  }
+  FreqType otherFreq = freq > dominantCount ? freq - dominantCount : 0;
+  profData->SetStmtFreq(condGoto->GetStmtID(), freq);
+  profData->SetStmtFreq(gotoJoin->GetStmtID(), freq - otherFreq);
+  profData->SetStmtFreq(otherLabelStmt->GetStmtID(), otherFreq);
+  profData->SetStmtFreq(fallback->GetStmtID(), otherFreq);
+  profData->SetStmtFreq(joinLabelStmt->GetStmtID(), freq);
+  if (debug) {
+    LogInfo::MapleLogger() << "specialize " << (opKind == kMemOpMemset ? "memset" : "memcpy") << " in "
+                           << func->GetName() << " for size " << dominantSize << ", count " << dominantCount
+                           << " of " << valueProf->GetTotal() << '\n';
+  }
+  return true;
+}
+
 StmtNode *SprintfBaseOper::InsertMemcpyCallStmt(const MapleVector<BaseNode *> &args, StmtNode &stmt,
                                                 BlockNode &block, int32 retVal, bool isLowLevel) {
   MIRBuilder *mirBuilder = op.GetFunction()->GetModule()->GetMIRBuilder();
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifdef ENABLE_MAPLE_SAN
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "asan_check_opt.h"
+#include "mir_builder.h"
+
+using namespace maple;
+
+namespace {
+constexpr size_t kGranularity = 8;
+
+// Straight-line accesses to *(int*)%p, with the statements in between picked by each test.
+class AccessSeq {
+ public:
+  AccessSeq(MIRModule &mirModule, const std::string &name) : mirBuilder(*mirModule.GetMIRBuilder()) {
+    callee = mirBuilder.GetOrCreateFunction(name + "_callee", TyIdx(PTY_void));
+    func = mirBuilder.GetOrCreateFunction(name, TyIdx(PTY_void));
+    mirModule.SetCurFunction(func);
+    func->NewBody();
+    i32Type = GlobalTables::GetTypeTable().GetInt32();
+    ptrType = GlobalTables::GetTypeTable().GetOrCreatePointerType(*i32Type);
+    ptr = func->GetPregTab()->CreatePreg(PTY_a64);
+    var = mirBuilder.GetOrCreateLocalDecl("x", *i32Type);
+  }
+
+  // x = *(int*)%p
+  void AddLoad() {
+    BaseNode *addr = mirBuilder.CreateExprIaddrof(PTY_a64, ptrType->GetTypeIndex(), 0, PtrRead());
+    StmtNode *stmt = mirBuilder.CreateStmtDassign(*var, 0, mirBuilder.CreateExprIread(*i32Type, *ptrType, 0,
+                                                                                        PtrRead()));
+    AddAccess(stmt, false, addr);
+  }
+
+  // *(int*)%p = 0
+  void AddStore() {
+    BaseNode *addr = mirBuilder.CreateExprIaddrof(PTY_a64, ptrType->GetTypeIndex(), 0, PtrRead());
+    StmtNode *stmt = mirBuilder.CreateStmtIassign(*ptrType, 0, PtrRead(), mirBuilder.CreateIntConst(0, PTY_i32));
+    AddAccess(stmt, true, addr);
+  }
+
+  // %p = %p + 4
+  void AddPtrUpdate() {
+    BaseNode *next = mirBuilder.CreateExprBinary(OP_add, *GlobalTables::GetTypeTable().GetPtr(), PtrRead(),
+                                                 mirBuilder.CreateIntConst(sizeof(int32), PTY_a64));
+    AddStmt(mirBuilder.CreateStmtRegassign(PTY_a64, ptr, next));
+  }
+
+  void AddCall() {
+    MapleVector<BaseNode*> args(func->GetCodeMPAllocator().Adapter());
+    AddStmt(mirBuilder.CreateStmtCall(callee->GetPuidx(), args));
+  }
+
+  // the number of accesses still checked in each statement
+  std::vector<size_t> Optimize(AsanCheckStats &stats) {
+    AsanCheckOptimizer checkOpt(*func, mirBuilder, nullptr, kGranularity);
+    checkOpt.Run(stmtAccesses, true);
+    stats = checkOpt.GetStats();
+    std::vector<size_t> checked;
+    for (auto &stmtAccess : stmtAccesses) {
+      checked.push_back(stmtAccess.second.size());
+    }
+    return checked;
+  }
+
+ private:
+  BaseNode *PtrRead() {
+    return mirBuilder.CreateExprRegread(PTY_a64, ptr);
+  }
+
+  void AddStmt(StmtNode *stmt) {
+    func->GetBody()->AddStatement(stmt);
+    stmtAccesses.emplace_back(stmt, std::vector<MemoryAccess>());
+  }
+
+  void AddAccess(StmtNode *stmt, bool isWrite, BaseNode *addr) {
+    AddStmt(stmt);
+    stmtAccesses.back().second.push_back({ stmt, isWrite, i32Type->GetSize() * 8, i32Type->GetAlign(), addr });
+  }
+
+  MIRBuilder &mirBuilder;
+  MIRFunction *func = nullptr;
+  MIRFunction *callee = nullptr;
+  MIRType *i32Type = nullptr;
+  MIRType *ptrType = nullptr;
+  PregIdx ptr = 0;
+  MIRSymbol *var = nullptr;
+  std::vector<StmtAccesses> stmtAccesses;
+};
+}
+
+TEST(AsanCheckOpt, RedundantCheckRemoved) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("asan check opt test", false);
+  MIRModule *mirModule = memPool->New<MIRModule>();
+  AccessSeq seq(*mirModule, "asan_redundant");
+  seq.AddStore();
+  // neither the store nor the assignment of x change %p
+  seq.AddLoad();
+  seq.AddLoad();
+  AsanCheckStats stats;
+  std::vector<size_t> checked = seq.Optimize(stats);
+  ASSERT_EQ(checked, std::vector<size_t>({ 1, 0, 0 }));
+  ASSERT_EQ(stats.numAccesses, 3U);
+  ASSERT_EQ(stats.numRedundant, 2U);
+  ASSERT_EQ(stats.numChecked, 1U);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
+
+TEST(AsanCheckOpt, CheckPastKillKept) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("asan check opt test", false);
+  MIRModule *mirModule = memPool->New<MIRModule>();
+  AccessSeq seq(*mirModule, "asan_kill");
+  seq.AddLoad();
+  seq.AddPtrUpdate();
+  seq.AddLoad();
+  // the callee may free the memory
+  seq.AddCall();
+  seq.AddLoad();
+  AsanCheckStats stats;
+  std::vector<size_t> checked = seq.Optimize(stats);
+  ASSERT_EQ(checked, std::vector<size_t>({ 1, 0, 1, 0, 1 }));
+  ASSERT_EQ(stats.numRedundant, 0U);
+  ASSERT_EQ(stats.numChecked, 3U);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
+#endif  // ENABLE_MAPLE_SAN
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <dirent.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aarch64_cg.h"
+#include "aarch64_emitter.h"
+#include "cg_func_cache.h"
+#include "triple.h"
+
+using namespace maple;
+using namespace maplebe;
+
+namespace {
+const std::string kCacheDir = "cg_func_cache_test_dir";
+const std::string kAsmFile = "cg_func_cache_test.s";
+
+std::vector<std::string> ListCacheDir() {
+  std::vector<std::string> names;
+  DIR *dir = opendir(kCacheDir.c_str());
+  if (dir == nullptr) {
+    return names;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      names.push_back(name);
+    }
+  }
+  (void)closedir(dir);
+  return names;
+}
+
+size_t CountCachedFuncs() {
+  size_t num = 0;
+  for (const std::string &name : ListCacheDir()) {
+    if (name.size() > 2 && name.compare(name.size() - 2, 2, ".s") == 0) {
+      ++num;
+    }
+  }
+  return num;
+}
+
+size_t CountOccurrences(const std::string &text, const std::string &pattern) {
+  size_t num = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+    ++num;
+  }
+  return num;
+}
+
+// A module compiled to kAsmFile with the function cache in kCacheDir, the cache starts empty.
+class FuncCacheEnv {
+ public:
+  FuncCacheEnv() {
+    Triple::GetTriple().Init();
+    memPool = memPoolCtrler.NewMemPool("cg func cache test", false);
+    alloc = memPool->New<MapleAllocator>(memPool);
+    mirModule = memPool->New<MIRModule>();
+    opts = memPool->New<CGOptions>();
+    auto *nameVec = memPool->New<std::vector<std::string>>();
+    auto *patternMap = memPool->New<std::unordered_map<std::string, std::vector<std::string>>>();
+    cg = memPool->New<AArch64CG>(*mirModule, *opts, *nameVec, *patternMap);
+    beCommon = memPool->New<BECommon>(*mirModule);
+    stackMemPool = memPool->New<StackMemPool>(memPoolCtrler, "cg func cache stack");
+    emitter = memPool->New<AArch64AsmEmitter>(*cg, kAsmFile);
+    Globals::GetInstance()->SetTarget(*cg);
+    RemoveCacheDir();
+    CGOptions::SetFuncCacheDir(kCacheDir);
+    CGOptions::DisableIPARA();
+  }
+
+  ~FuncCacheEnv() {
+    CGOptions::SetFuncCacheDir("");
+    CGOptions::EnableIPARA();
+    emitter->CloseOutput();
+    (void)std::remove(kAsmFile.c_str());
+    RemoveCacheDir();
+    memPoolCtrler.DeleteMemPool(memPool);
+  }
+
+  // int name() { return val; }
+  MIRFunction &CreateFunc(const std::string &name, int64 val) {
+    MIRBuilder *mirBuilder = mirModule->GetMIRBuilder();
+    MIRFunction *func = mirBuilder->GetOrCreateFunction(name, TyIdx(PTY_i32));
+    mirModule->SetCurFunction(func);
+    func->NewBody();
+    func->GetBody()->AddStatement(mirBuilder->CreateStmtReturn(mirBuilder->CreateIntConst(val, PTY_i32)));
+    return *func;
+  }
+
+  CGFunc &CreateCGFunc(MIRFunction &func, uint32 funcId) {
+    return *memPool->New<AArch64CGFunc>(*mirModule, *cg, func, *beCommon, *memPool, *stackMemPool, *alloc, funcId);
+  }
+
+  CgFuncCache &CreateCache() {
+    return *memPool->New<CgFuncCache>(*mirModule, *opts);
+  }
+
+  // Goes through the cache as cg does, on a miss codegen runs and text is emitted as the assembly of the function.
+  bool Run(CgFuncCache &cache, CGFunc &cgFunc, const std::string &text,
+           const std::function<void()> &codegen = nullptr) {
+    if (cache.Reuse(cgFunc.GetFunction(), cgFunc.GetUniqueID(), *emitter, nullptr)) {
+      return true;
+    }
+    cache.BeginFunction(*emitter);
+    if (codegen != nullptr) {
+      codegen();
+    }
+    (void)emitter->Emit(text);
+    cache.EndFunction(*emitter, cgFunc, nullptr);
+    return false;
+  }
+
+  std::string CloseOutput() {
+    emitter->CloseOutput();
+    std::ifstream in(kAsmFile);
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    return oss.str();
+  }
+
+  MIRModule &GetModule() {
+    return *mirModule;
+  }
+
+ private:
+  void RemoveCacheDir() const {
+    for (const std::string &name : ListCacheDir()) {
+      (void)std::remove((kCacheDir + "/" + name).c_str());
+    }
+    (void)rmdir(kCacheDir.c_str());
+  }
+
+  MemPool *memPool = nullptr;
+  MapleAllocator *alloc = nullptr;
+  MIRModule *mirModule = nullptr;
+  CGOptions *opts = nullptr;
+  AArch64CG *cg = nullptr;
+  BECommon *beCommon = nullptr;
+  StackMemPool *stackMemPool = nullptr;
+  AArch64AsmEmitter *emitter = nullptr;
+};
+}
+
+TEST(CgFuncCache, HitAndMiss) {
+  FuncCacheEnv env;
+  MIRFunction &func = env.CreateFunc("cg_func_cache_hit", 1);
+  CGFunc &cgFunc = env.CreateCGFunc(func, 1);
+  CGFunc &movedCGFunc = env.CreateCGFunc(func, 2);
+  const std::string text = "\tmov\tw0, #1\n\tret\n";
+  CgFuncCache &firstBuild = env.CreateCache();
+  ASSERT_TRUE(firstBuild.IsEnabled());
+  ASSERT_FALSE(env.Run(firstBuild, cgFunc, text));
+  ASSERT_EQ(CountCachedFuncs(), 1U);
+
+  // the next build reuses the assembly, wherever the function is in the module since it does not name itself
+  CgFuncCache &nextBuild = env.CreateCache();
+  ASSERT_TRUE(env.Run(nextBuild, cgFunc, ""));
+  ASSERT_TRUE(env.Run(nextBuild, movedCGFunc, ""));
+  ASSERT_EQ(CountOccurrences(env.CloseOutput(), text), 3U);
+}
+
+TEST(CgFuncCache, OrdinalInKey) {
+  FuncCacheEnv env;
+  MIRFunction &func = env.CreateFunc("cg_func_cache_ordinal", 1);
+  CGFunc &cgFunc = env.CreateCGFunc(func, 1);
+  CGFunc &movedCGFunc = env.CreateCGFunc(func, 2);
+  // the short name of the function carries its ordinal
+  std::string text = std::string(".L.") + cgFunc.GetShortFuncName().c_str() + ":\n\tret\n";
+  ASSERT_FALSE(env.Run(env.CreateCache(), cgFunc, text));
+
+  CgFuncCache &nextBuild = env.CreateCache();
+  ASSERT_FALSE(env.Run(nextBuild, movedCGFunc, std::string(".L.") + movedCGFunc.GetShortFuncName().c_str() +
+                       ":\n\tret\n"));
+  ASSERT_TRUE(env.Run(nextBuild, cgFunc, ""));
+  ASSERT_EQ(CountCachedFuncs(), 2U);
+}
+
+TEST(CgFuncCache, Invalidation) {
+  FuncCacheEnv env;
+  MIRFunction &func = env.CreateFunc("cg_func_cache_changed", 1);
+  MIRFunction &other = env.CreateFunc("cg_func_cache_unchanged", 1);
+  CGFunc &cgFunc = env.CreateCGFunc(func, 1);
+  CGFunc &otherCGFunc = env.CreateCGFunc(other, 2);
+  CgFuncCache &firstBuild = env.CreateCache();
+  ASSERT_FALSE(env.Run(firstBuild, cgFunc, "\tmov\tw0, #1\n\tret\n"));
+  ASSERT_FALSE(env.Run(firstBuild, otherCGFunc, "\tmov\tw0, #1\n\tret\n"));
+
+  // an edit of the body misses, the functions left alone still hit
+  StmtNode *ret = func.GetBody()->GetFirst();
+  ret->SetOpnd(env.GetModule().GetMIRBuilder()->CreateIntConst(2, PTY_i32), 0);
+  CgFuncCache &editBuild = env.CreateCache();
+  ASSERT_FALSE(env.Run(editBuild, cgFunc, "\tmov\tw0, #2\n\tret\n"));
+  ASSERT_TRUE(env.Run(editBuild, otherCGFunc, ""));
+
+  // the key covers all the globals of the module, a new one misses even in the functions not using it
+  MIRSymbol *global = env.GetModule().GetMIRBuilder()->GetOrCreateGlobalDecl("cg_func_cache_new_global",
+                                                                             *GlobalTables::GetTypeTable().GetInt32());
+  env.GetModule().AddSymbol(global);
+  CgFuncCache &globalBuild = env.CreateCache();
+  ASSERT_FALSE(env.Run(globalBuild, otherCGFunc, "\tmov\tw0, #1\n\tret\n"));
+}
+
+TEST(CgFuncCache, SelfContained) {
+  FuncCacheEnv env;
+  const std::string literal = "cg_func_cache_literal";
+  CGFunc &defining = env.CreateCGFunc(env.CreateFunc("cg_func_cache_defining", 1), 1);
+  CGFunc &user = env.CreateCGFunc(env.CreateFunc("cg_func_cache_using", 1), 2);
+  CGFunc &plain = env.CreateCGFunc(env.CreateFunc("cg_func_cache_plain", 1), 3);
+  CgFuncCache &cache = env.CreateCache();
+  // a global created by cg is only emitted by the function creating it, neither function can be reused
+  ASSERT_FALSE(env.Run(cache, defining, "\tadrp\tx0, " + literal + "\n\tret\n", [&env, &literal]() {
+    (void)env.GetModule().GetMIRBuilder()->GetOrCreateGlobalDecl(literal, *GlobalTables::GetTypeTable().GetInt32());
+  }));
+  ASSERT_EQ(CountCachedFuncs(), 0U);
+  ASSERT_FALSE(env.Run(cache, user, "\tadrp\tx0, " + literal + "\n\tret\n"));
+  ASSERT_EQ(CountCachedFuncs(), 0U);
+  ASSERT_FALSE(env.Run(cache, plain, "\tmov\tw0, #1\n\tret\n"));
+  ASSERT_EQ(CountCachedFuncs(), 1U);
+}
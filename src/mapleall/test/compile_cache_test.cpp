@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include "gtest/gtest.h"
+#include "compile_cache.h"
+
+using namespace maple;
+
+namespace {
+const std::string kCacheDir = "compile_cache_test_dir";
+
+std::string KeyOf(std::initializer_list<std::string> strs) {
+  CompileCacheKey cacheKey;
+  for (const std::string &str : strs) {
+    cacheKey.AddString(str);
+  }
+  return cacheKey.Finish();
+}
+
+std::string EntryPath(const std::string &name) {
+  return kCacheDir + "/" + name + ".o";
+}
+
+// an entry of size bytes last used at lastUse seconds since the epoch
+void MakeEntry(const std::string &name, size_t size, time_t lastUse) {
+  std::ofstream(EntryPath(name), std::ios::binary | std::ios::trunc) << std::string(size, 'x');
+  struct utimbuf times = { lastUse, lastUse };
+  ASSERT_EQ(utime(EntryPath(name).c_str(), &times), 0);
+}
+
+bool Exists(const std::string &path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0;
+}
+}
+
+TEST(CompileCache, KeyStability) {
+  // the same strings give the same key in any run on any host, a change of the format invalidates the caches
+  ASSERT_EQ(KeyOf({ "maple", "aarch64-linux-gnu" }), KeyOf({ "maple", "aarch64-linux-gnu" }));
+  ASSERT_EQ(KeyOf({ "maple", "aarch64-linux-gnu" }), "3da20e6fb5c051586e28d387b6bb7374");
+  ASSERT_EQ(KeyOf({}).size(), 2 * kDigestHashLength);
+
+  // the boundaries of the strings are part of the key, empty strings included
+  ASSERT_NE(KeyOf({ "a", "", "b" }), KeyOf({ "a", "b" }));
+  ASSERT_NE(KeyOf({ "a", "b" }), KeyOf({ "ab" }));
+  ASSERT_NE(KeyOf({ "ab", "c" }), KeyOf({ "a", "bc" }));
+  ASSERT_NE(KeyOf({ "" }), KeyOf({}));
+
+  std::ofstream("compile_cache_test.c") << "int main() { return 0; }\n";
+  CompileCacheKey fileKey;
+  ASSERT_TRUE(fileKey.AddFile("compile_cache_test.c"));
+  CompileCacheKey sameFileKey;
+  ASSERT_TRUE(sameFileKey.AddFile("compile_cache_test.c"));
+  ASSERT_EQ(fileKey.Finish(), sameFileKey.Finish());
+  CompileCacheKey missingKey;
+  ASSERT_FALSE(missingKey.AddFile("compile_cache_test_missing.c"));
+  (void)std::remove("compile_cache_test.c");
+}
+
+TEST(CompileCache, Eviction) {
+  constexpr uint64 kLimit = 1000;
+  ASSERT_TRUE(mkdir(kCacheDir.c_str(), S_IRWXU) == 0 || errno == EEXIST);
+  const std::string logPath = kCacheDir + "/stored.log";
+  (void)std::remove(logPath.c_str());
+  MakeEntry("oldest", 400, 1000);
+  MakeEntry("middle", 400, 2000);
+  MakeEntry("newest", 400, 3000);
+
+  // a cache never scanned is scanned on the first store, the least recently used entry goes down to 90%
+  ASSERT_TRUE(CompileCache::AddStoredSize(kCacheDir, kLimit, 400));
+  CompileCache::Evict(kCacheDir, kLimit);
+  ASSERT_FALSE(Exists(EntryPath("oldest")));
+  ASSERT_TRUE(Exists(EntryPath("middle")));
+  ASSERT_TRUE(Exists(EntryPath("newest")));
+  ASSERT_TRUE(Exists(logPath));
+
+  // 800 bytes left, the next stores only scan once they may exceed the limit
+  ASSERT_FALSE(CompileCache::AddStoredSize(kCacheDir, kLimit, 60));
+  ASSERT_FALSE(CompileCache::AddStoredSize(kCacheDir, kLimit, 40));
+  MakeEntry("added", 250, 4000);
+  ASSERT_TRUE(CompileCache::AddStoredSize(kCacheDir, kLimit, 250));
+  CompileCache::Evict(kCacheDir, kLimit);
+  ASSERT_FALSE(Exists(EntryPath("middle")));
+  ASSERT_TRUE(Exists(EntryPath("newest")));
+  ASSERT_TRUE(Exists(EntryPath("added")));
+  // the log is not an entry
+  ASSERT_TRUE(Exists(logPath));
+
+  // 950 bytes, a scan under the limit keeps everything
+  MakeEntry("small", 300, 5000);
+  CompileCache::Evict(kCacheDir, kLimit);
+  ASSERT_TRUE(Exists(EntryPath("newest")));
+  ASSERT_TRUE(Exists(EntryPath("added")));
+  ASSERT_TRUE(Exists(EntryPath("small")));
+  // the 50 bytes above the low water already use part of the slack
+  ASSERT_FALSE(CompileCache::AddStoredSize(kCacheDir, kLimit, 50));
+  ASSERT_TRUE(CompileCache::AddStoredSize(kCacheDir, kLimit, 1));
+
+  for (const char *name : { "newest", "added", "small" }) {
+    (void)std::remove(EntryPath(name).c_str());
+  }
+  (void)std::remove(logPath.c_str());
+  (void)rmdir(kCacheDir.c_str());
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aarch64_cg.h"
+#include "chain_layout.h"
+#include "cg_dominance.h"
+#include "ext_tsp_layout.h"
+#include "loop.h"
+#include "triple.h"
+
+using namespace maple;
+using namespace maplebe;
+
+namespace {
+void AddEdge(maplebe::BB &from, maplebe::BB &to) {
+  from.PushBackSuccs(to);
+  to.PushBackPreds(from);
+}
+}
+
+TEST(ExtTspLayout, HotPathFallsThrough) {
+  // 0 -> 1 (cold) -> 3, 0 -> 2 (hot) -> 3
+  std::vector<uint64> sizes = { 16, 64, 16, 8 };
+  std::vector<uint64> freqs = { 100, 5, 95, 100 };
+  std::vector<ExtTspLayout::Edge> edges = { { 0, 1, 5 }, { 0, 2, 95 }, { 1, 3, 5 }, { 2, 3, 95 } };
+  ExtTspLayout layout(sizes, freqs, edges, 1);
+  std::vector<uint32> order = layout.ComputeOrder();
+  std::vector<uint32> expected = { 0, 2, 3, 1 };
+  ASSERT_EQ(order, expected);
+  std::vector<uint32> origOrder = { 0, 1, 2, 3 };
+  ASSERT_GT(layout.Score(order), layout.Score(origOrder));
+  // 0->2 and 2->3 fall through, 0->1 jumps 24 bytes forward and 1->3 72 bytes backward
+  ASSERT_DOUBLE_EQ(layout.Score(order), 190.0 + 5 * 0.1 * (1.0 - 24.0 / 1024) + 5 * 0.1 * (1.0 - 72.0 / 640));
+}
+
+TEST(ExtTspLayout, KeepsEntryNodes) {
+  std::vector<uint64> sizes = { 4, 4, 4 };
+  std::vector<uint64> freqs = { 10, 1, 9 };
+  std::vector<ExtTspLayout::Edge> edges = { { 0, 1, 1 }, { 0, 2, 9 } };
+  ExtTspLayout layout(sizes, freqs, edges, 2);
+  std::vector<uint32> order = layout.ComputeOrder();
+  std::vector<uint32> expected = { 0, 1, 2 };
+  ASSERT_EQ(order, expected);
+}
+
+TEST(ExtTspLayout, LoopStaysContiguous) {
+  // 0 -> 1 -> 2 -> 1 (back edge), 2 -> 4 (exit), 0 -> 3 (cold)
+  std::vector<uint64> sizes = { 8, 8, 8, 32, 8 };
+  std::vector<uint64> freqs = { 10, 1000, 1000, 0, 10 };
+  std::vector<ExtTspLayout::Edge> edges = {
+      { 0, 1, 10 }, { 1, 2, 1000 }, { 2, 1, 990 }, { 2, 4, 10 }, { 0, 3, 0 } };
+  ExtTspLayout layout(sizes, freqs, edges, 1);
+  std::vector<uint32> order = layout.ComputeOrder();
+  std::vector<uint32> expected = { 0, 1, 2, 4, 3 };
+  ASSERT_EQ(order, expected);
+}
+
+// entry -> cold -> ret, entry -> hot -> ret, laid out as entry, cleanup, cold, case, hot, ret where the case label is
+// only in a switch table
+TEST(ExtTspLayout, ChainLayoutOfCGFunc) {
+  Triple::GetTriple().Init();
+  MemPool *memPool = memPoolCtrler.NewMemPool("ext tsp layout test", false);
+  MapleAllocator alloc(memPool);
+  auto *mirModule = memPool->New<MIRModule>();
+  auto *opts = memPool->New<CGOptions>();
+  auto *nameVec = memPool->New<std::vector<std::string>>();
+  auto *patternMap = memPool->New<std::unordered_map<std::string, std::vector<std::string>>>();
+  auto *aarch64Cg = memPool->New<AArch64CG>(*mirModule, *opts, *nameVec, *patternMap);
+  MIRBuilder *mirBuilder = mirModule->GetMIRBuilder();
+  MIRFunction *mirFunc = mirBuilder->GetOrCreateFunction("ext_tsp_layout", TyIdx(PTY_void));
+  mirFunc->AllocSymTab();
+  mirFunc->AllocPregTab();
+  mirFunc->AllocLabelTab();
+  auto *beCommon = memPool->New<BECommon>(*mirModule);
+  auto *stackMemPool = memPool->New<StackMemPool>(memPoolCtrler, "ext tsp layout stack");
+  auto *cgFunc = memPool->New<AArch64CGFunc>(*mirModule, *aarch64Cg, *mirFunc, *beCommon, *memPool, *stackMemPool,
+                                             alloc, 0);
+  Globals::GetInstance()->SetTarget(*aarch64Cg);
+
+  maplebe::BB *entry = cgFunc->CreateNewBB(false, maplebe::BB::kBBIf, 100);
+  maplebe::BB *cleanup = cgFunc->CreateNewBB(false, maplebe::BB::kBBFallthru, 0);
+  maplebe::BB *cold = cgFunc->CreateNewBB(false, maplebe::BB::kBBGoto, 5);
+  LabelIdx caseLabel = mirBuilder->CreateLabIdx(*mirFunc);
+  maplebe::BB *caseBB = cgFunc->CreateNewBB(caseLabel, false, maplebe::BB::kBBFallthru, 0);
+  maplebe::BB *hot = cgFunc->CreateNewBB(false, maplebe::BB::kBBFallthru, 95);
+  maplebe::BB *ret = cgFunc->CreateNewBB(false, maplebe::BB::kBBReturn, 100);
+  std::vector<maplebe::BB*> origOrder = { entry, cleanup, cold, caseBB, hot, ret };
+  for (size_t i = 1; i < origOrder.size(); ++i) {
+    origOrder[i - 1]->SetNext(origOrder[i]);
+    origOrder[i]->SetPrev(origOrder[i - 1]);
+  }
+  cgFunc->SetFirstBB(*entry);
+  cgFunc->SetLastBB(*ret);
+  cgFunc->SetCleanupBB(*cleanup);
+  AddEdge(*entry, *cold);
+  AddEdge(*entry, *hot);
+  AddEdge(*cold, *ret);
+  AddEdge(*hot, *ret);
+  for (maplebe::BB *bb : origOrder) {
+    bb->InitEdgeFreq();
+  }
+  entry->SetEdgeFreq(*cold, 5);
+  entry->SetEdgeFreq(*hot, 95);
+  cold->SetEdgeFreq(*ret, 5);
+  hot->SetEdgeFreq(*ret, 95);
+
+  MIRType *etype = GlobalTables::GetTypeTable().GetTypeFromTyIdx(static_cast<TyIdx>(PTY_a64));
+  MIRArrayType *tableType = GlobalTables::GetTypeTable().GetOrCreateArrayType(*etype, 1);
+  auto *table = memPool->New<MIRAggConst>(*mirModule, *tableType);
+  table->AddItem(memPool->New<MIRLblConst>(caseLabel, mirFunc->GetPuidx(), *etype), 0);
+  MIRSymbol *tableSt = mirFunc->GetSymTab()->CreateSymbol(kScopeLocal);
+  tableSt->SetSKind(kStConst);
+  tableSt->SetKonst(table);
+  cgFunc->AddEmitSt(entry->GetId(), *tableSt);
+  cgFunc->AddCommonExitBB();
+
+  DomAnalysis dom(*cgFunc, *memPool, *memPool, cgFunc->GetAllBBs(), *cgFunc->GetCommonEntryBB(),
+                  *cgFunc->GetCommonExitBB());
+  LoopAnalysis loop(*cgFunc, *memPool, dom);
+  CGOptions::EnableLayoutExtTsp();
+  ChainLayout layout(*cgFunc, *memPool, false, dom, loop);
+  layout.BuildChainForFunc();
+  CGOptions::DisableLayoutExtTsp();
+
+  // the hot path falls through from the entry, the cleanup and the case label come last
+  std::vector<uint32> order;
+  for (auto *node : *layout.GetNode2Chain()[entry->GetId()]) {
+    order.push_back(node->GetID());
+  }
+  std::vector<uint32> expected = { entry->GetId(), hot->GetId(), ret->GetId(), cold->GetId(), cleanup->GetId(),
+                                   caseBB->GetId() };
+  ASSERT_EQ(order, expected);
+  ASSERT_EQ(caseBB->GetNext(), nullptr);
+  ASSERT_EQ(caseBB->GetPrev(), nullptr);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "inline_db.h"
+
+using namespace maple;
+
+namespace {
+InlineDBEntry MakeEntry(const std::string &name, uint32 staticInsns, uint32 flags) {
+  InlineDBEntry entry;
+  entry.name = name;
+  entry.staticInsns = staticInsns;
+  entry.flags = flags;
+  return entry;
+}
+}
+
+TEST(InlineDB, MergeModules) {
+  std::string err;
+  InlineDB moduleA;
+  InlineDBEntry foo = MakeEntry("foo", 12, InlineDBEntry::kDeclaredInline);
+  foo.deps.push_back("helper_a1b2");
+  moduleA.AddFunction(foo, "func &foo public () void {\n  call &helper_a1b2 ()\n}\n");
+  moduleA.AddFunction(MakeEntry("helper_a1b2", 3, InlineDBEntry::kStatic), "func &helper_a1b2 static () void {\n}\n");
+  moduleA.AddFunction(MakeEntry("max", 5, 0), "func &max public () i32 {\n  return (constval i32 1)\n}\n");
+  ASSERT_TRUE(moduleA.Write("inline_db_a.mplinldb", err)) << err;
+
+  /* foo is the same in both modules, max is not */
+  InlineDB moduleB;
+  moduleB.AddFunction(foo, "func &foo public () void {\n  call &helper_a1b2 ()\n}\n");
+  moduleB.AddFunction(MakeEntry("max", 5, 0), "func &max public () i32 {\n  return (constval i32 2)\n}\n");
+  moduleB.AddFunction(MakeEntry("bar", 40, 0), "func &bar public () void {\n}\n");
+  ASSERT_TRUE(moduleB.Write("inline_db_b.mplinldb", err)) << err;
+
+  InlineDB merged;
+  ASSERT_TRUE(merged.ReadIndex("inline_db_a.mplinldb", err)) << err;
+  ASSERT_TRUE(merged.ReadIndex("inline_db_b.mplinldb", err)) << err;
+  ASSERT_EQ(merged.GetFuncNum(), 3);
+  ASSERT_EQ(merged.Find("max"), nullptr);
+
+  const InlineDBEntry *entry = merged.Find("foo");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_EQ(entry->staticInsns, 12);
+  ASSERT_TRUE(entry->IsDeclaredInline());
+  ASSERT_EQ(entry->deps.size(), 1);
+  ASSERT_EQ(entry->deps[0], "helper_a1b2");
+  std::string body;
+  ASSERT_TRUE(merged.LoadBody(*entry, body, err)) << err;
+  ASSERT_EQ(body, "func &foo public () void {\n  call &helper_a1b2 ()\n}\n");
+
+  entry = merged.Find("helper_a1b2");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_TRUE(entry->IsStatic());
+  ASSERT_TRUE(merged.LoadBody(*entry, body, err)) << err;
+  ASSERT_EQ(body, "func &helper_a1b2 static () void {\n}\n");
+
+  entry = merged.Find("bar");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_TRUE(merged.LoadBody(*entry, body, err)) << err;
+  ASSERT_EQ(body, "func &bar public () void {\n}\n");
+
+  /* a body changed behind the index is refused */
+  std::fstream file("inline_db_b.mplinldb", std::ios::in | std::ios::out);
+  file.seekp(-2, std::ios::end);
+  file << 'x';
+  file.close();
+  ASSERT_FALSE(merged.LoadBody(*entry, body, err));
+
+  std::ofstream("inline_db_b.mplinldb") << "MPLINLDB 1\n1\nfunc bar 0\n";
+  ASSERT_FALSE(merged.ReadIndex("inline_db_b.mplinldb", err));
+  (void)std::remove("inline_db_a.mplinldb");
+  (void)std::remove("inline_db_b.mplinldb");
+}
+
+TEST(InlineDB, ImportNeedsAllDeps) {
+  std::string err;
+  /* both modules have a static helper_c3 of their own, the one foo calls is dropped as a conflict */
+  InlineDB moduleA;
+  InlineDBEntry foo = MakeEntry("foo", 12, InlineDBEntry::kDeclaredInline);
+  foo.deps.push_back("helper_c3");
+  moduleA.AddFunction(foo, "func &foo public () void {\n  call &helper_c3 ()\n}\n");
+  moduleA.AddFunction(MakeEntry("helper_c3", 3, InlineDBEntry::kStatic), "func &helper_c3 static () void {\n}\n");
+  /* bar calls outer_d4 which calls inner_e5, both static and only exported by this module */
+  InlineDBEntry bar = MakeEntry("bar", 8, 0);
+  bar.deps.push_back("outer_d4");
+  bar.deps.push_back("inner_e5");
+  InlineDBEntry outer = MakeEntry("outer_d4", 4, InlineDBEntry::kStatic);
+  outer.deps.push_back("inner_e5");
+  moduleA.AddFunction(bar, "func &bar public () void {\n  call &outer_d4 ()\n  call &inner_e5 ()\n}\n");
+  moduleA.AddFunction(outer, "func &outer_d4 static () void {\n  call &inner_e5 ()\n}\n");
+  moduleA.AddFunction(MakeEntry("inner_e5", 2, InlineDBEntry::kStatic), "func &inner_e5 static () void {\n}\n");
+  ASSERT_TRUE(moduleA.Write("inline_db_c.mplinldb", err)) << err;
+
+  InlineDB moduleB;
+  moduleB.AddFunction(MakeEntry("helper_c3", 3, InlineDBEntry::kStatic),
+                      "func &helper_c3 static () void {\n  return ()\n}\n");
+  ASSERT_TRUE(moduleB.Write("inline_db_d.mplinldb", err)) << err;
+
+  InlineDB merged;
+  ASSERT_TRUE(merged.ReadIndex("inline_db_c.mplinldb", err)) << err;
+  ASSERT_TRUE(merged.ReadIndex("inline_db_d.mplinldb", err)) << err;
+  ASSERT_EQ(merged.Find("helper_c3"), nullptr);
+
+  std::vector<const InlineDBEntry*> imports;
+  std::string missingDep;
+  const InlineDBEntry *entry = merged.Find("foo");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_FALSE(merged.CollectImports(*entry, imports, missingDep));
+  ASSERT_EQ(missingDep, "helper_c3");
+  ASSERT_TRUE(imports.empty());
+
+  /* the caller first, each dep once, and every body loads */
+  entry = merged.Find("bar");
+  ASSERT_NE(entry, nullptr);
+  ASSERT_TRUE(merged.CollectImports(*entry, imports, missingDep));
+  ASSERT_EQ(imports.size(), 3);
+  ASSERT_EQ(imports[0]->name, "bar");
+  ASSERT_EQ(imports[1]->name, "outer_d4");
+  ASSERT_EQ(imports[2]->name, "inner_e5");
+  std::string body;
+  for (auto *import : imports) {
+    ASSERT_TRUE(merged.LoadBody(*import, body, err)) << err;
+  }
+  ASSERT_EQ(body, "func &inner_e5 static () void {\n}\n");
+  (void)std::remove("inline_db_c.mplinldb");
+  (void)std::remove("inline_db_d.mplinldb");
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "litepgo_callgraph.h"
+
+using namespace maple;
+
+TEST(LitePgoCallGraph, MergeModules) {
+  std::string err;
+  LitePgoCallGraph moduleA;
+  moduleA.AddFunction("main", 1, 64);
+  moduleA.AddFunction("foo", 100, 32);
+  moduleA.AddCall("main", "foo", 100);
+  moduleA.AddCall("foo", "printf", 100);
+  ASSERT_TRUE(moduleA.Write("litepgo_callgraph_a.cgprof", err)) << err;
+  std::ofstream("litepgo_callgraph_b.cgprof") << "func bar 50 16\ncall foo bar 40\ncall main foo 10\n";
+
+  LitePgoCallGraph merged;
+  ASSERT_TRUE(merged.Read("litepgo_callgraph_a.cgprof", err)) << err;
+  ASSERT_TRUE(merged.Read("litepgo_callgraph_b.cgprof", err)) << err;
+  ASSERT_EQ(merged.GetFuncNum(), 3);
+  ASSERT_EQ(merged.GetCallNum(), 3);
+
+  /* printf is defined by no module, its call is dropped */
+  std::ostringstream profile;
+  merged.DumpReorderProfile(profile);
+  ASSERT_EQ(profile.str(), "bar 50 16 foo 100 32 40\nfoo 100 32 main 1 64 110\n");
+
+  std::ostringstream script;
+  merged.DumpLinkerScript({ { "foo", 1 }, { "bar", 2 } }, script);
+  ASSERT_EQ(script.str(), "SECTIONS\n{\n  .text.mpl_hot :\n  {\n    *(.text.foo)\n    *(.text.bar)\n"
+            "    *(.text.main)\n  }\n}\nINSERT BEFORE .text;\n");
+
+  std::ofstream("litepgo_callgraph_b.cgprof") << "call foo\n";
+  ASSERT_FALSE(merged.Read("litepgo_callgraph_b.cgprof", err));
+  (void)std::remove("litepgo_callgraph_a.cgprof");
+  (void)std::remove("litepgo_callgraph_b.cgprof");
+}
+
+/* the call graph of a function reused from the cg function cache is merged into the one of its module */
+TEST(LitePgoCallGraph, MergeFunction) {
+  LitePgoCallGraph module;
+  module.AddFunction("main", 1, 64);
+  module.AddCall("main", "foo", 10);
+  LitePgoCallGraph func;
+  func.AddFunction("foo", 100, 32);
+  func.AddCall("foo", "bar", 40);
+  module.Merge(func);
+  module.Merge(func);
+  ASSERT_EQ(module.GetFuncNum(), 2);
+  ASSERT_EQ(module.GetCallNum(), 2);
+  std::ostringstream profile;
+  module.DumpReorderProfile(profile);
+  ASSERT_EQ(profile.str(), "foo 200 32 main 1 64 10\n");
+}
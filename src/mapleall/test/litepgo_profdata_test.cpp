@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "litepgo_profdata.h"
+
+using namespace maple;
+
+namespace {
+std::string WriteTextProfile(const std::string &fileName) {
+  std::ofstream out(fileName);
+  out << "flavor Mon Oct 16 10:00:00 2023\n"
+      << "func &foo funcid 100,counterSz 3,cfghash 7,\n1\n2\n3\n"
+      << "func &cold funcid 100,counterSz 2,cfghash 8,\n"
+      << "func &bar funcid 200,counterSz 1,cfghash 9,\n5\n";
+  return fileName;
+}
+}
+
+TEST(LitePgoProfData, MergeAndReadModule) {
+  std::string err;
+  LitePgoProfData text;
+  ASSERT_TRUE(text.Read(WriteTextProfile("litepgo_profdata_test.txt"), err)) << err;
+  ASSERT_FALSE(LitePgoProfData::IsBinaryFile("litepgo_profdata_test.txt"));
+  ASSERT_EQ(text.GetFuncNum(), 3);
+
+  LitePgoProfData merged;
+  ASSERT_EQ(merged.Merge(text, 1), 0);
+  ASSERT_EQ(merged.Merge(text, 3), 0);
+  ASSERT_EQ(merged.GetRunCount(), 4);
+  const std::string binFile = "litepgo_profdata_test.bin";
+  ASSERT_TRUE(merged.WriteBinary(binFile, err)) << err;
+  ASSERT_TRUE(LitePgoProfData::IsBinaryFile(binFile));
+
+  std::vector<LitePgoProfData::FuncProfile> funcs;
+  ASSERT_TRUE(LitePgoProfData::ReadModule(binFile, 100, funcs, err)) << err;
+  ASSERT_EQ(funcs.size(), 2);
+  for (auto &func : funcs) {
+    ASSERT_EQ(func.modHash, 100);
+    if (func.name == "foo") {
+      ASSERT_EQ(func.cfgHash, 7);
+      ASSERT_EQ(func.counters, std::vector<uint64>({ 4, 8, 12 }));
+    } else {
+      ASSERT_EQ(func.name, "cold");
+      ASSERT_EQ(func.counters, std::vector<uint64>({ 0, 0 }));
+    }
+  }
+  funcs.clear();
+  ASSERT_TRUE(LitePgoProfData::ReadModule(binFile, 300, funcs, err)) << err;
+  ASSERT_TRUE(funcs.empty());
+
+  /* a function of another build is dropped rather than mixed */
+  LitePgoProfData other;
+  ASSERT_TRUE(other.Read(binFile, err)) << err;
+  std::ofstream("litepgo_profdata_test.txt") << "func &bar funcid 200,counterSz 2,cfghash 10,\n1\n1\n";
+  ASSERT_TRUE(text.Read("litepgo_profdata_test.txt", err)) << err;
+  ASSERT_EQ(other.Merge(text, 1), 1);
+  (void)std::remove("litepgo_profdata_test.txt");
+  (void)std::remove(binFile.c_str());
+}
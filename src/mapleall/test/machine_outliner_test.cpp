@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aarch64_cg.h"
+#include "aarch64_outliner.h"
+#include "triple.h"
+
+using namespace maple;
+using namespace maplebe;
+
+namespace {
+// Functions of a single bb saving lr to the stack, running a body and returning, outlined together.
+class OutlinerEnv {
+ public:
+  OutlinerEnv() {
+    Triple::GetTriple().Init();
+    memPool = memPoolCtrler.NewMemPool("machine outliner test", false);
+    alloc = memPool->New<MapleAllocator>(memPool);
+    mirModule = memPool->New<MIRModule>();
+    auto *opts = memPool->New<CGOptions>();
+    auto *nameVec = memPool->New<std::vector<std::string>>();
+    auto *patternMap = memPool->New<std::unordered_map<std::string, std::vector<std::string>>>();
+    cg = memPool->New<AArch64CG>(*mirModule, *opts, *nameVec, *patternMap);
+    beCommon = memPool->New<BECommon>(*mirModule);
+    stackMemPool = memPool->New<StackMemPool>(memPoolCtrler, "machine outliner stack");
+    Globals::GetInstance()->SetTarget(*cg);
+    outliner = memPool->New<AArch64MachineOutliner>(*mirModule, *memPool);
+    callee = mirModule->GetMIRBuilder()->GetOrCreateFunction("machine_outliner_callee", TyIdx(PTY_void));
+  }
+
+  ~OutlinerEnv() {
+    memPoolCtrler.DeleteMemPool(memPool);
+  }
+
+  // str x30, [sp, #8]; body; ldr x30, [sp, #8]; ret
+  maplebe::BB &AddFunction(const std::string &name,
+                           const std::function<void(AArch64CGFunc&, maplebe::BB&)> &buildBody) {
+    MIRFunction *mirFunc = mirModule->GetMIRBuilder()->GetOrCreateFunction(name, TyIdx(PTY_void));
+    mirFunc->AllocSymTab();
+    mirFunc->AllocPregTab();
+    mirFunc->AllocLabelTab();
+    auto *cgFunc = memPool->New<AArch64CGFunc>(*mirModule, *cg, *mirFunc, *beCommon, *memPool, *stackMemPool,
+                                               *alloc, static_cast<uint32>(cgFuncs.size() + 1));
+    maplebe::BB *bb = cgFunc->CreateNewBB(false, maplebe::BB::kBBReturn, 1);
+    cgFunc->SetFirstBB(*bb);
+    cgFunc->SetLastBB(*bb);
+    RegOperand &lr = Reg(*cgFunc, RLR);
+    bb->AppendInsn(cgFunc->GetInsnBuilder()->BuildInsn(MOP_xstr, lr,
+                                                       cgFunc->CreateMemOpnd(RSP, 8, maplebe::k64BitSize)));
+    buildBody(*cgFunc, *bb);
+    bb->AppendInsn(cgFunc->GetInsnBuilder()->BuildInsn(MOP_xldr, lr,
+                                                       cgFunc->CreateMemOpnd(RSP, 8, maplebe::k64BitSize)));
+    bb->AppendInsn(cgFunc->GetInsnBuilder()->BuildInsn<AArch64CG>(MOP_xret));
+    cgFuncs.push_back(cgFunc);
+    outliner->AddFunction(*cgFunc);
+    return *bb;
+  }
+
+  static RegOperand &Reg(AArch64CGFunc &cgFunc, AArch64reg reg) {
+    return cgFunc.GetOrCreatePhysicalRegisterOperand(reg, maplebe::k64BitSize, kRegTyInt);
+  }
+
+  static void AppendAlu(AArch64CGFunc &cgFunc, maplebe::BB &bb, MOperator mOp, AArch64reg dst, AArch64reg src0,
+                        AArch64reg src1) {
+    bb.AppendInsn(cgFunc.GetInsnBuilder()->BuildInsn(mOp, Reg(cgFunc, dst), Reg(cgFunc, src0), Reg(cgFunc, src1)));
+  }
+
+  // add x3, x0, x1; eor x4, x3, x2; then orr x5, x4, x0; and x6, x5, x1; sub x0, x6, x3 as the second half
+  static void AppendFirstHalf(AArch64CGFunc &cgFunc, maplebe::BB &bb) {
+    AppendAlu(cgFunc, bb, MOP_xaddrrr, R3, R0, R1);
+    AppendAlu(cgFunc, bb, MOP_xeorrrr, R4, R3, R2);
+  }
+
+  static void AppendSecondHalf(AArch64CGFunc &cgFunc, maplebe::BB &bb) {
+    AppendAlu(cgFunc, bb, MOP_xiorrrr, R5, R4, R0);
+    AppendAlu(cgFunc, bb, MOP_xandrrr, R6, R5, R1);
+    AppendAlu(cgFunc, bb, MOP_xsubrrr, R0, R6, R3);
+  }
+
+  void AppendCall(AArch64CGFunc &cgFunc, maplebe::BB &bb) const {
+    Operand &target = cgFunc.GetOrCreateFuncNameOpnd(*callee->GetFuncSymbol());
+    ListOperand *srcOpnds = cgFunc.CreateListOpnd(*cgFunc.GetFuncScopeAllocator());
+    bb.AppendInsn(cgFunc.GetInsnBuilder()->BuildInsn(MOP_xbl, target, *srcOpnds));
+  }
+
+  const MapleVector<MachineOutliner::OutlinedFunction*> &Run() {
+    outliner->Run();
+    return outliner->GetOutlinedFunctions();
+  }
+
+  static std::vector<MOperator> GetOpcodes(const maplebe::BB &bb) {
+    std::vector<MOperator> mOps;
+    FOR_BB_INSNS_CONST(insn, &bb) {
+      mOps.push_back(insn->GetMachineOpcode());
+    }
+    return mOps;
+  }
+
+ private:
+  MemPool *memPool = nullptr;
+  MapleAllocator *alloc = nullptr;
+  MIRModule *mirModule = nullptr;
+  AArch64CG *cg = nullptr;
+  BECommon *beCommon = nullptr;
+  StackMemPool *stackMemPool = nullptr;
+  AArch64MachineOutliner *outliner = nullptr;
+  MIRFunction *callee = nullptr;
+  std::vector<AArch64CGFunc*> cgFuncs;
+};
+}
+
+TEST(MachineOutliner, RepeatedSequenceOutlined) {
+  OutlinerEnv env;
+  auto body = [](AArch64CGFunc &cgFunc, maplebe::BB &bb) {
+    OutlinerEnv::AppendFirstHalf(cgFunc, bb);
+    OutlinerEnv::AppendSecondHalf(cgFunc, bb);
+  };
+  maplebe::BB &first = env.AddFunction("machine_outliner_first", body);
+  maplebe::BB &second = env.AddFunction("machine_outliner_second", body);
+  const auto &outlinedFuncs = env.Run();
+  ASSERT_EQ(outlinedFuncs.size(), 1U);
+  const MachineOutliner::OutlinedFunction &outlined = *outlinedFuncs.front();
+  ASSERT_EQ(outlined.symbol->GetName(), "OUTLINED_FUNCTION_0");
+  ASSERT_FALSE(outlined.isTailCall);
+  ASSERT_EQ(outlined.numOccurrences, 2U);
+  std::vector<MOperator> expectedBody = { MOP_xaddrrr, MOP_xeorrrr, MOP_xiorrrr, MOP_xandrrr, MOP_xsubrrr };
+  std::vector<MOperator> outlinedBody;
+  for (const Insn *insn : outlined.body) {
+    outlinedBody.push_back(insn->GetMachineOpcode());
+  }
+  ASSERT_EQ(outlinedBody, expectedBody);
+
+  // lr is saved on the stack, both sequences become a bl to the outlined function
+  std::vector<MOperator> expected = { MOP_xstr, MOP_xbl, MOP_xldr, MOP_xret };
+  for (maplebe::BB *bb : { &first, &second }) {
+    ASSERT_EQ(OutlinerEnv::GetOpcodes(*bb), expected);
+    const Insn *call = bb->GetFirstInsn()->GetNext();
+    ASSERT_EQ(static_cast<const FuncNameOperand&>(call->GetOperand(kInsnFirstOpnd)).GetName(),
+              "OUTLINED_FUNCTION_0");
+  }
+}
+
+TEST(MachineOutliner, SpRelativeAccessNotOutlined) {
+  OutlinerEnv env;
+  auto body = [](AArch64CGFunc &cgFunc, maplebe::BB &bb) {
+    OutlinerEnv::AppendFirstHalf(cgFunc, bb);
+    bb.AppendInsn(cgFunc.GetInsnBuilder()->BuildInsn(MOP_xldr, OutlinerEnv::Reg(cgFunc, R7),
+                                                     cgFunc.CreateMemOpnd(RSP, 16, maplebe::k64BitSize)));
+    OutlinerEnv::AppendSecondHalf(cgFunc, bb);
+  };
+  maplebe::BB &first = env.AddFunction("machine_outliner_sp_first", body);
+  (void)env.AddFunction("machine_outliner_sp_second", body);
+  // what is left on either side of the load is too short to be worth a call
+  ASSERT_TRUE(env.Run().empty());
+  ASSERT_EQ(OutlinerEnv::GetOpcodes(first).size(), 9U);
+}
+
+TEST(MachineOutliner, CallNotOutlined) {
+  OutlinerEnv env;
+  auto body = [&env](AArch64CGFunc &cgFunc, maplebe::BB &bb) {
+    OutlinerEnv::AppendFirstHalf(cgFunc, bb);
+    env.AppendCall(cgFunc, bb);
+    OutlinerEnv::AppendSecondHalf(cgFunc, bb);
+  };
+  maplebe::BB &first = env.AddFunction("machine_outliner_call_first", body);
+  (void)env.AddFunction("machine_outliner_call_second", body);
+  ASSERT_TRUE(env.Run().empty());
+  std::vector<MOperator> expected = { MOP_xstr, MOP_xaddrrr, MOP_xeorrrr, MOP_xbl, MOP_xiorrrr, MOP_xandrrr,
+                                      MOP_xsubrrr, MOP_xldr, MOP_xret };
+  ASSERT_EQ(OutlinerEnv::GetOpcodes(first), expected);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "gtest/gtest.h"
+#include <vector>
+#include "types_def.h"
+#include "maple_sparse_bitvector.h"
+
+using namespace maple;
+
+TEST(MapleSparseBitVector, IterateInAscendingOrder) {
+  StackMemPool mp(memPoolCtrler, "sparse bitvector test");
+  MapleAllocator alloc(&mp);
+  MapleSparseBitVector<> bv(alloc);
+  std::vector<unsigned> bits = { 0, 3, 63, 64, 65, 127, 128, 1000, 4095 };
+  for (auto it = bits.rbegin(); it != bits.rend(); ++it) {
+    bv.Set(*it);
+  }
+  std::vector<unsigned> result;
+  for (auto bit : bv) {
+    result.push_back(bit);
+  }
+  ASSERT_EQ(result, bits);
+  ASSERT_EQ(bv.Count(), bits.size());
+
+  MapleSparseBitVector<> empty(alloc);
+  ASSERT_TRUE(empty.begin() == empty.end());
+  ASSERT_EQ(empty.Count(), 0);
+}
+
+TEST(MapleSparseBitVector, CopyResetAndUnion) {
+  StackMemPool mp(memPoolCtrler, "sparse bitvector test");
+  MapleAllocator alloc(&mp);
+  MapleSparseBitVector<> bv(alloc);
+  bv.Set(1);
+  bv.Set(64);
+  bv.Set(200);
+  MapleSparseBitVector<> copy(bv, alloc);
+  copy.Reset(64);
+  ASSERT_TRUE(bv.Test(64));
+  ASSERT_FALSE(copy.Test(64));
+  ASSERT_EQ(copy.Count(), 2);
+
+  MapleSparseBitVector<> other(alloc);
+  other.Set(5);
+  other.Set(64);
+  ASSERT_TRUE(other |= copy);
+  std::vector<unsigned> result(other.begin(), other.end());
+  ASSERT_EQ(result, std::vector<unsigned>({ 1, 5, 64, 200 }));
+}
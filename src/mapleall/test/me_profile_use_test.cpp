@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "gtest/gtest.h"
+#include "me_cfg.h"
+#include "me_function.h"
+#include "me_profile_use.h"
+#include "mir_builder.h"
+
+using namespace maple;
+
+namespace {
+constexpr uint16 kFileNum = 1;
+
+void SetLine(StmtNode &stmt, uint32 lineNum) {
+  stmt.GetSrcPos().SetFileNum(kFileNum);
+  stmt.GetSrcPos().SetLineNum(lineNum);
+}
+}
+
+TEST(MeProfUse, SampledBBWeights) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("me profile use test", false);
+  MapleAllocator alloc(memPool);
+  MIRModule *mirModule = memPool->New<MIRModule>();
+  MIRBuilder *mirBuilder = mirModule->GetMIRBuilder();
+  MIRType *i32Type = GlobalTables::GetTypeTable().GetInt32();
+  MIRFunction *mirFunc = mirBuilder->GetOrCreateFunction("me_prof_use_sampled", i32Type->GetTypeIndex());
+  mirModule->SetCurFunction(mirFunc);
+  mirFunc->NewBody();
+  MIRSymbol *a = mirBuilder->GetOrCreateLocalDecl("a", *i32Type);
+  MIRSymbol *x = mirBuilder->GetOrCreateLocalDecl("x", *i32Type);
+  LabelIdx elseLabel = mirBuilder->CreateLabIdx(*mirFunc);
+  LabelIdx joinLabel = mirBuilder->CreateLabIdx(*mirFunc);
+  BlockNode *body = mirFunc->GetBody();
+  // line 10: if (a) {
+  //            x = 1;  (no line)
+  //          } else {
+  // line 13:   x = 2;
+  //          }
+  // line 15: return x;
+  StmtNode *condGoto = mirBuilder->CreateStmtCondGoto(mirBuilder->CreateExprDread(*a), OP_brfalse, elseLabel);
+  SetLine(*condGoto, 10);
+  body->AddStatement(condGoto);
+  body->AddStatement(mirBuilder->CreateStmtDassign(*x, 0, mirBuilder->CreateIntConst(1, PTY_i32)));
+  body->AddStatement(mirBuilder->CreateStmtGoto(OP_goto, joinLabel));
+  body->AddStatement(mirBuilder->CreateStmtLabel(elseLabel));
+  StmtNode *elseAssign = mirBuilder->CreateStmtDassign(*x, 0, mirBuilder->CreateIntConst(2, PTY_i32));
+  SetLine(*elseAssign, 13);
+  body->AddStatement(elseAssign);
+  body->AddStatement(mirBuilder->CreateStmtLabel(joinLabel));
+  StmtNode *ret = mirBuilder->CreateStmtReturn(mirBuilder->CreateExprDread(*x));
+  SetLine(*ret, 15);
+  body->AddStatement(ret);
+
+  auto *profData = memPool->New<MplProfileData>(memPool, &alloc);
+  FuncProfInfo *funcData = profData->AddNewFuncProfile(mirFunc->GetPuidx(), 0, 0, 0);
+  funcData->lineSamples[GetSampleLineKey(kFileNum, 10)] = 100;
+  funcData->lineSamples[GetSampleLineKey(kFileNum, 13)] = 10;
+  funcData->lineSamples[GetSampleLineKey(kFileNum, 15)] = 100;
+  mirModule->SetMapleProfile(profData);
+
+  StackMemPool stackMemPool(memPoolCtrler, "me profile use stack");
+  MemPool *versMemPool = memPoolCtrler.NewMemPool("me profile use vers", false);
+  auto *func = memPool->New<MeFunction>(mirModule, mirFunc, memPool, stackMemPool, versMemPool, "");
+  auto *cfg = memPool->New<MeCFG>(memPool, *func);
+  func->SetTheCfg(cfg);
+  cfg->CreateBasicBlocks();
+  cfg->BuildMirCFG();
+  MeProfUse profUse(*func, *memPool, false);
+  ASSERT_TRUE(profUse.SampleProfRun());
+
+  // the bbs in source order after the common entry and exit
+  ASSERT_EQ(cfg->NumBBs(), 6U);
+  BB *condBB = cfg->GetBBFromID(BBId(2));
+  BB *thenBB = cfg->GetBBFromID(BBId(3));
+  BB *elseBB = cfg->GetBBFromID(BBId(4));
+  BB *joinBB = cfg->GetBBFromID(BBId(5));
+  ASSERT_EQ(&condBB->GetStmtNodes().back(), condGoto);
+  ASSERT_EQ(&joinBB->GetStmtNodes().back(), ret);
+  // a bb weighs the samples of its lines, the then bb has none and takes the lighter of its heaviest neighbours
+  ASSERT_EQ(condBB->GetFrequency(), 100);
+  ASSERT_EQ(thenBB->GetFrequency(), 100);
+  ASSERT_EQ(elseBB->GetFrequency(), 10);
+  ASSERT_EQ(joinBB->GetFrequency(), 100);
+  ASSERT_EQ(cfg->GetCommonEntryBB()->GetFrequency(), 100);
+  ASSERT_EQ(func->GetFrequency(), 100);
+  // the out edges of the branch share its weight in proportion to the weights of the targets
+  ASSERT_EQ(condBB->GetEdgeFreq(thenBB), 90);
+  ASSERT_EQ(condBB->GetEdgeFreq(elseBB), 10);
+  ASSERT_EQ(thenBB->GetEdgeFreq(joinBB), 100);
+  ASSERT_EQ(elseBB->GetEdgeFreq(joinBB), 10);
+  memPoolCtrler.DeleteMemPool(versMemPool);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "becommon.h"
+#include "lower.h"
+#include "mir_builder.h"
+#include "mpl_profdata.h"
+#include "mpl_profdata_parser.h"
+
+using namespace maple;
+using namespace maplebe;
+
+namespace {
+constexpr unsigned kFuncIdent = 7;
+constexpr int64 kDominantSize = 16;
+
+// the value profile part of a .mprofdata, one memcpy site which copied 16 bytes 90 times out of 100
+MplProfileData *ReadFixtureProfile(MemPool &memPool, MapleAllocator &alloc) {
+  MplProfileData written(&memPool, &alloc);
+  FuncProfInfo *writtenFunc = written.AddNewFuncProfile(kFuncIdent, 0, 0, 0);
+  writtenFunc->valueCounts[kValueProfMemOpSize].resize(kMemOpSizeCounters, 0);
+  writtenFunc->valueCounts[kValueProfMemOpSize][kDominantSize] = 90;
+  writtenFunc->valueCounts[kValueProfMemOpSize][8] = 6;
+  writtenFunc->valueCounts[kValueProfMemOpSize][kMemOpSizeSteps] = 4;  // larger than the steps
+  std::ofstream out("memop_value_prof.bin", std::ios::out | std::ios::trunc | std::ios::binary);
+  ValueProfileExport::WriteValueProfile(written, out);
+  out.close();
+
+  std::string fileName = "memop_value_prof.bin";
+  std::ifstream in(fileName, std::ios::in | std::ios::binary);
+  std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  auto *profData = memPool.New<MplProfileData>(&memPool, &alloc);
+  (void)profData->AddNewFuncProfile(kFuncIdent, 0, 0, 0);
+  ValueProfileImport valueImport(fileName, in);
+  valueImport.SetPosition(buffer.data());
+  valueImport.ReadValueProfile(profData);
+  EXPECT_EQ(valueImport.GetPosition(), buffer.data() + buffer.size());
+  (void)std::remove(fileName.c_str());
+  return profData;
+}
+}
+
+TEST(MemOpValueProf, ProfileRoundTrip) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("memop value prof test", false);
+  MapleAllocator alloc(memPool);
+  MplProfileData *profData = ReadFixtureProfile(*memPool, alloc);
+  ASSERT_TRUE(profData->HasValueProfile());
+  FuncProfInfo *funcProf = profData->GetFuncProfile(kFuncIdent);
+  ASSERT_NE(funcProf, nullptr);
+  ASSERT_EQ(funcProf->valueCounts[kValueProfMemOpSize].size(), kMemOpSizeCounters);
+  ASSERT_TRUE(funcProf->valueCounts[kValueProfIcallTopN].empty());
+
+  ValueProfInfo *valueProf = funcProf->DecodeValueProf(kValueProfMemOpSize, 0, 100, alloc);
+  ASSERT_NE(valueProf, nullptr);
+  ASSERT_EQ(valueProf->GetTotal(), 100);
+  ASSERT_EQ(valueProf->GetValues().size(), 2);
+  int64 value = 0;
+  FreqType count = 0;
+  ASSERT_TRUE(valueProf->GetDominantValue(80, value, count));
+  ASSERT_EQ(value, kDominantSize);
+  ASSERT_EQ(count, 90);
+  ASSERT_FALSE(valueProf->GetDominantValue(95, value, count));
+  memPoolCtrler.DeleteMemPool(memPool);
+}
+
+// memcpy(dst, src, n) between two other statements, with the fixture profile attached to the call
+TEST(MemOpValueProf, SpecializeThroughLowerMemop) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("memop value prof test", false);
+  MapleAllocator alloc(memPool);
+  MIRModule *mirModule = memPool->New<MIRModule>();
+  MIRBuilder *mirBuilder = mirModule->GetMIRBuilder();
+  MIRFunction *memcpyFunc = mirBuilder->GetOrCreateFunction("memcpy", TyIdx(PTY_a64));
+  MIRFunction *func = mirBuilder->GetOrCreateFunction("copy_it", TyIdx(PTY_void));
+  mirModule->SetCurFunction(func);
+  func->NewBody();
+  PregIdx dst = func->GetPregTab()->CreatePreg(PTY_a64);
+  PregIdx src = func->GetPregTab()->CreatePreg(PTY_a64);
+  PregIdx size = func->GetPregTab()->CreatePreg(PTY_u64);
+  MapleVector<BaseNode*> args(mirModule->GetCurFuncCodeMPAllocator().Adapter());
+  args.push_back(mirBuilder->CreateExprRegread(PTY_a64, dst));
+  args.push_back(mirBuilder->CreateExprRegread(PTY_a64, src));
+  args.push_back(mirBuilder->CreateExprRegread(PTY_u64, size));
+  CallNode *call = mirBuilder->CreateStmtCall(memcpyFunc->GetPuidx(), args);
+  StmtNode *before = mirBuilder->CreateStmtComment("before");
+  StmtNode *after = mirBuilder->CreateStmtComment("after");
+  BlockNode *body = func->GetBody();
+  body->AddStatement(before);
+  body->AddStatement(call);
+  body->AddStatement(after);
+
+  FuncProfInfo *funcProf = ReadFixtureProfile(*memPool, alloc)->GetFuncProfile(kFuncIdent);
+  funcProf->SetValueProf(call->GetOriginalID(), funcProf->DecodeValueProf(kValueProfMemOpSize, 0, 100, alloc));
+  funcProf->SetStmtFreq(call->GetStmtID(), 100);
+  func->SetFuncProfData(funcProf);
+
+  BECommon beCommon(*mirModule);
+  CGLowerer lowerer(*mirModule, beCommon, *memPool, func);
+  BlockNode *blk = lowerer.LowerMemop(*call);
+  ASSERT_NE(blk, nullptr);
+  // the call keeps its place in the body, which the caller replaces with blk
+  ASSERT_EQ(call->GetPrev(), before);
+  ASSERT_EQ(call->GetNext(), after);
+  ASSERT_EQ(before->GetNext(), call);
+  ASSERT_EQ(after->GetPrev(), call);
+  ASSERT_EQ(body->GetLast(), after);
+
+  // brfalse @other, the expanded copy, goto @join, @other, the call, @join
+  ASSERT_EQ(blk->GetFirst()->GetOpCode(), OP_brfalse);
+  StmtNode *otherLabel = nullptr;
+  StmtNode *fallback = nullptr;
+  size_t stmtNum = 0;
+  for (StmtNode *stmt = blk->GetFirst(); stmt != nullptr; stmt = stmt->GetNext()) {
+    ASSERT_NE(stmt, call);
+    ASSERT_NE(stmt, after);
+    if (stmt->GetOpCode() == OP_label && otherLabel == nullptr) {
+      otherLabel = stmt;
+    }
+    if (stmt->GetOpCode() == OP_call) {
+      fallback = stmt;
+    }
+    ++stmtNum;
+    ASSERT_LT(stmtNum, 64);
+  }
+  ASSERT_NE(otherLabel, nullptr);
+  ASSERT_NE(fallback, nullptr);
+  ASSERT_EQ(otherLabel->GetNext(), fallback);
+  ASSERT_EQ(fallback->GetNext(), blk->GetLast());
+  ASSERT_EQ(blk->GetLast()->GetOpCode(), OP_label);
+  ASSERT_EQ(blk->GetLast()->GetNext(), nullptr);
+  ASSERT_EQ(funcProf->GetStmtFreq(fallback->GetStmtID()), 10);
+  // the profile is consumed, lowering the fallback call again leaves it alone
+  ASSERT_EQ(funcProf->GetValueProf(call->GetOriginalID()), nullptr);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
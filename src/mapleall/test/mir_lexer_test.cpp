@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <cctype>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "lexer.h"
+#include "mempool_allocator.h"
+
+using namespace maple;
+
+namespace {
+// the token kind of every keyword, a keyword defined twice keeps the last one as in the lexer
+std::map<std::string, TokenKind> GetKeywords() {
+  std::map<std::string, TokenKind> keywords;
+#define KEYWORD(STR) keywords[#STR] = TK_##STR;
+#include "keywords.def"
+#undef KEYWORD
+  return keywords;
+}
+
+// the special float constants are lexed as constants rather than as keywords
+TokenKind GetLexedKind(const std::string &keyword, TokenKind tk) {
+  if (keyword == "nanf" || keyword == "inff") {
+    return TK_floatconst;
+  }
+  if (keyword == "nan" || keyword == "inf") {
+    return TK_doubleconst;
+  }
+  return tk;
+}
+
+class LexerEnv {
+ public:
+  LexerEnv() : memPool(memPoolCtrler.NewMemPool("mir lexer test", true)), alloc(memPool) {
+    lexer = std::make_unique<MIRLexer>(nullptr, alloc);
+  }
+
+  ~LexerEnv() {
+    lexer.reset();
+    memPoolCtrler.DeleteMemPool(memPool);
+  }
+
+  MIRLexer &GetLexer() {
+    return *lexer;
+  }
+
+ private:
+  MemPool *memPool;
+  MapleAllocator alloc;
+  std::unique_ptr<MIRLexer> lexer;
+};
+
+// lex text as a mapped file, with nothing readable past its last byte
+bool SkipBlockInBuffer(const std::string &text, TokenKind &nextKind) {
+  LexerEnv env;
+  MIRLexer &lexer = env.GetLexer();
+  std::vector<char> buf(text.begin(), text.end());
+  lexer.PrepareForBuffer(buf.data(), buf.size());
+  EXPECT_EQ(lexer.NextToken(), TK_lbrace);
+  bool res = lexer.SkipBlock();
+  nextKind = lexer.NextToken();
+  return res;
+}
+}
+
+TEST(MIRLexer, AllKeywords) {
+  LexerEnv env;
+  MIRLexer &lexer = env.GetLexer();
+  std::map<std::string, TokenKind> keywords = GetKeywords();
+  ASSERT_FALSE(keywords.empty());
+  for (const auto &keyword : keywords) {
+    lexer.PrepareForString(keyword.first);
+    ASSERT_EQ(lexer.GetTokenKind(), GetLexedKind(keyword.first, keyword.second)) << keyword.first;
+  }
+}
+
+TEST(MIRLexer, NearMissKeywords) {
+  LexerEnv env;
+  MIRLexer &lexer = env.GetLexer();
+  std::map<std::string, TokenKind> keywords = GetKeywords();
+  std::vector<std::string> nearMisses = { "foo", "x", "_", "elsee", "els", "Else", "ELSE" };
+  for (const auto &keyword : keywords) {
+    const std::string &str = keyword.first;
+    // one char appended, dropped, changed or in another case
+    nearMisses.push_back(str + "_");
+    nearMisses.push_back(str + "1");
+    nearMisses.push_back(str.substr(0, str.size() - 1));
+    nearMisses.push_back(str.substr(1));
+    std::string changed = str;
+    changed.back() = changed.back() == 'z' ? 'y' : 'z';
+    nearMisses.push_back(changed);
+    std::string upper = str;
+    upper[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(upper[0])));
+    nearMisses.push_back(upper);
+  }
+  for (const std::string &str : nearMisses) {
+    if (str.empty() || keywords.find(str) != keywords.end() ||
+        !(std::isalpha(static_cast<unsigned char>(str[0])) || str[0] == '_')) {
+      continue;
+    }
+    lexer.PrepareForString(str);
+    ASSERT_EQ(lexer.GetTokenKind(), TK_invalid) << str;
+  }
+}
+
+TEST(MIRLexer, SkipBlockAtEndOfBuffer) {
+  TokenKind nextKind = TK_invalid;
+  // the closing brace is the last byte, with or without the newline
+  ASSERT_TRUE(SkipBlockInBuffer("{ a {\n b \"}\" '}' }\n}", nextKind));
+  ASSERT_EQ(nextKind, TK_eof);
+  ASSERT_TRUE(SkipBlockInBuffer("{ a {\n b }\n}\n", nextKind));
+  ASSERT_EQ(nextKind, TK_eof);
+  ASSERT_TRUE(SkipBlockInBuffer("{}", nextKind));
+  ASSERT_EQ(nextKind, TK_eof);
+  // the text after the block is still lexed
+  ASSERT_TRUE(SkipBlockInBuffer("{ a }\n}", nextKind));
+  ASSERT_EQ(nextKind, TK_rbrace);
+  // the buffer ends inside the block, or inside a string literal of the block
+  ASSERT_FALSE(SkipBlockInBuffer("{ a {\n b }", nextKind));
+  ASSERT_EQ(nextKind, TK_eof);
+  ASSERT_FALSE(SkipBlockInBuffer("{ \"}", nextKind));
+  ASSERT_EQ(nextKind, TK_eof);
+}
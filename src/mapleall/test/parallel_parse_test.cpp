@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "mir_function.h"
+#include "mir_module.h"
+#include "mir_parser.h"
+#include "triple.h"
+
+using namespace maple;
+
+namespace {
+constexpr uint32 kFuncNum = 48;
+
+// Functions creating array and pointer types and string constants of their own and shared with the others, which
+// are interned while the bodies are parsed in parallel. Each function calls the one before it.
+std::string GenerateMpl() {
+  std::ostringstream mpl;
+  for (uint32 i = 0; i < kFuncNum; ++i) {
+    mpl << "var $g" << i << " <[" << (i + 1) << "] i32>\n";
+  }
+  for (uint32 i = 0; i < kFuncNum; ++i) {
+    uint32 localSize = i % 8 + 2;
+    mpl << "func $f" << i << " (var %n i32) i32 {\n";
+    mpl << "  var %k i32\n";
+    mpl << "  var %s a64\n";
+    mpl << "  var %loc <[" << localSize << "] i32>\n";
+    mpl << "  var %p <* [" << (i + 3) << "] i64>\n";
+    mpl << "  dassign %s (conststr a64 \"str" << (i % 4) << "\")\n";
+    mpl << "  doloop %k (constval i32 0, lt i32 i32 (dread i32 %k, constval i32 " << localSize <<
+        "), add i32 (dread i32 %k, constval i32 1)) {\n";
+    mpl << "    iassign <* [" << localSize << "] i32> (array 1 a64 <* [" << localSize <<
+        "] i32> (addrof a64 %loc, dread i32 %k), dread i32 %n)\n";
+    mpl << "  }\n";
+    if (i > 0) {
+      mpl << "  callassigned &f" << (i - 1) << " (dread i32 %n) {\n";
+      mpl << "    dassign %n 0\n";
+      mpl << "  }\n";
+    }
+    mpl << "  return (add i32 (dread i32 %n, iread i32 <* [" << (i + 1) << "] i32> (array 1 a64 <* [" << (i + 1) <<
+        "] i32> (addrof a64 $g" << i << ", constval i32 0))))\n";
+    mpl << "}\n";
+  }
+  return mpl.str();
+}
+
+// the function bodies of mplFile parsed with threads, or the parse error
+std::string ParseAndDump(const std::string &mplFile, uint32 threads) {
+  auto *mod = new MIRModule(mplFile.c_str());
+  theMIRModule = mod;
+  MIRParser parser(*mod);
+  parser.SetParseThreads(threads);
+  if (!parser.ParseMIR()) {
+    return "error: " + parser.GetError();
+  }
+  std::ostringstream dump;
+  std::streambuf *backup = LogInfo::MapleLogger().rdbuf();
+  LogInfo::MapleLogger().rdbuf(dump.rdbuf());
+  for (MIRFunction *func : mod->GetFunctionList()) {
+    func->Dump();
+  }
+  LogInfo::MapleLogger().rdbuf(backup);
+  return dump.str();
+}
+
+// the global tables are shared by every module of the process, so each parse runs in a child process of its own
+std::string ParseInChild(const std::string &mplFile, uint32 threads) {
+  std::string dumpFile = mplFile + "." + std::to_string(threads) + ".dump";
+  pid_t pid = fork();
+  if (pid == 0) {
+    std::ofstream(dumpFile) << ParseAndDump(mplFile, threads);
+    _exit(0);
+  }
+  int status = 0;
+  if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    return "child failed";
+  }
+  std::ifstream in(dumpFile);
+  std::stringstream dump;
+  dump << in.rdbuf();
+  (void)std::remove(dumpFile.c_str());
+  return dump.str();
+}
+}
+
+TEST(ParallelParse, SameAsSerial) {
+  Triple::GetTriple().Init();
+  const std::string mplFile = "parallel_parse_test.mpl";
+  std::ofstream(mplFile) << GenerateMpl();
+  std::string serial = ParseInChild(mplFile, 1);
+  ASSERT_EQ(serial.find("error"), std::string::npos) << serial;
+  ASSERT_NE(serial.find("func &f" + std::to_string(kFuncNum - 1)), std::string::npos);
+  for (uint32 round = 0; round < 4; ++round) {
+    ASSERT_EQ(ParseInChild(mplFile, 8), serial);
+  }
+  (void)std::remove(mplFile.c_str());
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include "gtest/gtest.h"
+#include <sstream>
+#include "mpl_profdata_parser.h"
+
+using namespace maple;
+
+TEST(PerfSampleProfile, ReadPerfScript) {
+  std::istringstream input(
+      "            4005d6 main+0x16\n"
+      "  /home/user/src/test.c:12\n"
+      "            4005e0 main+0x20\n"
+      "  /home/user/src/test.c:12\n"
+      "  /home/user/src/test.c:30\n"
+      "            400610 foo\n"
+      "  test.c:5\n"
+      "            7f0012 [unknown]\n"
+      "  ??:0\n"
+      "            400620 bar+0x4\n"
+      "  ??:0\n");
+  PerfSampleProfile profile;
+  profile.Read(input);
+  ASSERT_EQ(profile.GetSampleNum(), 3);
+  auto &funcs = profile.GetFuncSamples();
+  ASSERT_EQ(funcs.size(), 2);
+  /* the second source line of a sample is an inline frame */
+  ASSERT_EQ(funcs.at("main").size(), 1);
+  ASSERT_EQ(funcs.at("main").at(PerfSampleProfile::LineKey("test.c", 12)), 2);
+  ASSERT_EQ(funcs.at("foo").at(PerfSampleProfile::LineKey("test.c", 5)), 1);
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "me_ir.h"
+#include "mempool.h"
+#include "mir_nodes.h"
+#include "src_position.h"
+
+using namespace maple;
+
+TEST(SrcPosition, InlinedPosSideTable) {
+  SrcPosition pos(1, 10, 2, 0);
+  ASSERT_EQ(pos.GetInlinedLineNum(), 0);
+  ASSERT_EQ(pos.GetInlinedFileNum(), 0);
+
+  size_t numPos = InlinedSrcPosTable::Size();
+  pos.SetInlinedPos(42, 3, GStrIdx(7));
+  SrcPosition other(1, 11, 0, 0);
+  other.SetInlinedPos(42, 3, GStrIdx(7));
+  ASSERT_EQ(InlinedSrcPosTable::Size(), numPos + 1);
+  ASSERT_EQ(other.GetInlinedLineNum(), 42);
+  ASSERT_EQ(other.GetInlinedFileNum(), 3);
+  ASSERT_EQ(other.GetInlinedFuncStrIdx(), GStrIdx(7));
+
+  SrcPosition copy = pos;
+  ASSERT_EQ(copy.GetInlinedLineNum(), 42);
+  ASSERT_EQ(copy.LineNum(), 10);
+  ASSERT_EQ(copy.Column(), 2);
+}
+
+TEST(MemPool, MemStats) {
+  MemPoolCtrler::memStats = true;
+  MemPoolCtrler ctrler;
+  {
+    MemPool pool(ctrler, "mem stats test pool");
+    for (int i = 0; i < 1000; ++i) {
+      (void)pool.New<SrcPosition>();
+    }
+  }
+  MemPoolCtrler::memStats = false;
+  std::ostringstream os;
+  ctrler.DumpMemStats(os);
+  std::string stats = os.str();
+  ASSERT_NE(stats.find("mem stats test pool"), std::string::npos);
+  // type rows are: bytes(KB) number size type
+  std::istringstream rows(stats);
+  std::string row;
+  bool found = false;
+  while (std::getline(rows, row)) {
+    std::istringstream fields(row);
+    size_t kBytes = 0;
+    size_t number = 0;
+    size_t size = 0;
+    std::string type;
+    if (!(fields >> kBytes >> number >> size >> type) || type != "maple::SrcPosition") {
+      continue;
+    }
+    ASSERT_EQ(number, 1000);
+    ASSERT_EQ(size, sizeof(SrcPosition));
+    found = true;
+  }
+  ASSERT_TRUE(found) << stats;
+}
+
+// the node layouts on LP64 hosts, a node growing back shows up here
+TEST(SrcPosition, NodeSizes) {
+  if (sizeof(void*) != sizeof(uint64)) {
+    return;
+  }
+  ASSERT_EQ(sizeof(SrcPosition), 16);
+  ASSERT_EQ(sizeof(BaseNode), 16);
+  ASSERT_EQ(sizeof(StmtNode), 88);
+  ASSERT_EQ(sizeof(DassignNode), 104);
+  ASSERT_EQ(sizeof(CallNode), 232);
+  ASSERT_EQ(sizeof(MeStmt), 88);
+}
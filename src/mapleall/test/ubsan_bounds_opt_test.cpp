@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifdef ENABLE_MAPLE_SAN
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mir_builder.h"
+#include "ubsan_bounds_opt.h"
+
+using namespace maple;
+
+namespace {
+constexpr uint32 kArraySize = 10;
+
+// a[i] = 0 for i from 0 while i < limit, on an int a[10], lowered the way the sanitizer sees it
+class BoundsLoop {
+ public:
+  BoundsLoop(MIRModule &mirModule, const std::string &name, int64 limit) {
+    MIRBuilder *mirBuilder = mirModule.GetMIRBuilder();
+    func = mirBuilder->GetOrCreateFunction(name, TyIdx(PTY_void));
+    mirModule.SetCurFunction(func);
+    func->NewBody();
+    MIRType *i32Type = GlobalTables::GetTypeTable().GetInt32();
+    MIRType *u1Type = GlobalTables::GetTypeTable().GetUInt1();
+    MIRArrayType *arrayType = GlobalTables::GetTypeTable().GetOrCreateArrayType(*i32Type, kArraySize);
+    MIRSymbol *array = mirBuilder->GetOrCreateLocalDecl("a", *arrayType);
+    MIRSymbol *iv = mirBuilder->GetOrCreateLocalDecl("i", *i32Type);
+    LabelIdx head = mirBuilder->CreateLabIdx(*func);
+    LabelIdx done = mirBuilder->CreateLabIdx(*func);
+
+    BlockNode *body = func->GetBody();
+    body->AddStatement(mirBuilder->CreateStmtDassign(*iv, 0, mirBuilder->CreateIntConst(0, PTY_i32)));
+    body->AddStatement(mirBuilder->CreateStmtLabel(head));
+    BaseNode *cond = mirBuilder->CreateExprCompare(OP_lt, *u1Type, *i32Type, mirBuilder->CreateExprDread(*iv),
+                                                   mirBuilder->CreateIntConst(static_cast<uint64>(limit), PTY_i32));
+    body->AddStatement(mirBuilder->CreateStmtCondGoto(cond, OP_brfalse, done));
+    index = mirBuilder->CreateExprDread(*iv);
+    ArrayNode *elem = mirBuilder->CreateExprArray(*arrayType, mirBuilder->CreateAddrof(*array, PTY_a64), index);
+    MIRType *elemPtrType = GlobalTables::GetTypeTable().GetOrCreatePointerType(*i32Type);
+    store = mirBuilder->CreateStmtIassign(*elemPtrType, 0, elem, mirBuilder->CreateIntConst(0, PTY_i32));
+    body->AddStatement(store);
+    BaseNode *next = mirBuilder->CreateExprBinary(OP_add, *i32Type, mirBuilder->CreateExprDread(*iv),
+                                                  mirBuilder->CreateIntConst(1, PTY_i32));
+    body->AddStatement(mirBuilder->CreateStmtDassign(*iv, 0, next));
+    body->AddStatement(mirBuilder->CreateStmtGoto(OP_goto, head));
+    body->AddStatement(mirBuilder->CreateStmtLabel(done));
+    body->AddStatement(mirBuilder->CreateStmtReturn(nullptr));
+  }
+
+  // the range of the index of the store, and whether it is proven in bounds
+  bool Analyze(IndexRange &range) const {
+    BoundsRangeAnalysis rangeAnalysis(*func);
+    std::unordered_map<const StmtNode*, std::vector<const BaseNode*>> queries;
+    queries[store].push_back(index);
+    rangeAnalysis.Run(queries);
+    EXPECT_TRUE(rangeAnalysis.GetRange(*index, range));
+    return IsIndexRangeInBounds(range, sizeof(int32), kArraySize, sizeof(int32));
+  }
+
+ private:
+  MIRFunction *func = nullptr;
+  StmtNode *store = nullptr;
+  BaseNode *index = nullptr;
+};
+}
+
+TEST(UbsanBoundsOpt, IndexProvenInBounds) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("ubsan bounds opt test", false);
+  MIRModule *mirModule = memPool->New<MIRModule>();
+  BoundsLoop loop(*mirModule, "ubsan_in_bounds", kArraySize);
+  IndexRange range = IndexRange::Full();
+  ASSERT_TRUE(loop.Analyze(range));
+  ASSERT_EQ(range.lo, 0);
+  ASSERT_EQ(range.hi, kArraySize - 1);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
+
+TEST(UbsanBoundsOpt, IndexOutOfBoundsKeepsCheck) {
+  MemPool *memPool = memPoolCtrler.NewMemPool("ubsan bounds opt test", false);
+  MIRModule *mirModule = memPool->New<MIRModule>();
+  BoundsLoop loop(*mirModule, "ubsan_out_of_bounds", kArraySize + 1);
+  IndexRange range = IndexRange::Full();
+  ASSERT_FALSE(loop.Analyze(range));
+  ASSERT_EQ(range.lo, 0);
+  ASSERT_EQ(range.hi, kArraySize);
+  memPoolCtrler.DeleteMemPool(memPool);
+}
+
+TEST(UbsanBoundsOpt, RangeInBounds) {
+  ASSERT_TRUE(IsIndexRangeInBounds({ 0, 9 }, 4, 10, 4));
+  ASSERT_FALSE(IsIndexRangeInBounds({ 0, 10 }, 4, 10, 4));
+  ASSERT_FALSE(IsIndexRangeInBounds({ -1, 9 }, 4, 10, 4));
+  // an 8 byte access through an element of 4 needs one more element
+  ASSERT_TRUE(IsIndexRangeInBounds({ 0, 8 }, 4, 10, 8));
+  ASSERT_FALSE(IsIndexRangeInBounds({ 0, 9 }, 4, 10, 8));
+  ASSERT_FALSE(IsIndexRangeInBounds({ 0, 9 }, 0, 10, 4));
+}
+#endif  // ENABLE_MAPLE_SAN
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+ *
+ * OpenArkCompiler is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+ * FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "gtest/gtest.h"
+#include "me_value_range_prop.h"
+
+using namespace maple;
+
+namespace {
+// the value range of expr id is [id * 10, id * 10]
+std::unique_ptr<ValueRange> CreateVR(int32 exprID) {
+  return std::make_unique<ValueRange>(Bound(static_cast<int64>(exprID) * 10, PTY_i64), kEqual);
+}
+
+void Record(ValueRangeCache &cache, const std::vector<int32> &exprIDs) {
+  for (int32 exprID : exprIDs) {
+    ASSERT_TRUE(cache.Insert(exprID, CreateVR(exprID)));
+  }
+}
+
+// every id is found with its own value range, the ids are visited in ascending order
+void Verify(const ValueRangeCache &cache, std::vector<int32> exprIDs) {
+  ASSERT_EQ(cache.Size(), exprIDs.size());
+  for (int32 exprID : exprIDs) {
+    ValueRange *valueRange = nullptr;
+    ASSERT_TRUE(cache.Find(exprID, valueRange));
+    ASSERT_NE(valueRange, nullptr);
+    ASSERT_EQ(valueRange->GetBound().GetConstant(), static_cast<int64>(exprID) * 10);
+  }
+  std::sort(exprIDs.begin(), exprIDs.end());
+  std::vector<int32> visited;
+  cache.ForEach([&visited](int32 exprID, const ValueRange *valueRange) {
+    visited.push_back(exprID);
+    ASSERT_EQ(valueRange->GetBound().GetConstant(), static_cast<int64>(exprID) * 10);
+  });
+  ASSERT_EQ(visited, exprIDs);
+}
+
+std::vector<int32> Range(int32 begin, int32 end, int32 step = 1) {
+  std::vector<int32> exprIDs;
+  for (int32 exprID = begin; exprID < end; exprID += step) {
+    exprIDs.push_back(exprID);
+  }
+  return exprIDs;
+}
+}
+
+TEST(ValueRangeCache, SparseToDense) {
+  ValueRangeCache cache;
+  // a few ids apart from each other stay in the hash table
+  std::vector<int32> exprIDs = Range(100, 180, 10);
+  Record(cache, exprIDs);
+  Verify(cache, exprIDs);
+  ValueRange *valueRange = nullptr;
+  ASSERT_FALSE(cache.Find(105, valueRange));
+
+  // once enough close ids are recorded the entries move to the dense array, which then grows with the ids
+  for (auto &moreIDs : { Range(0, 100), Range(180, 400) }) {
+    Record(cache, moreIDs);
+    exprIDs.insert(exprIDs.end(), moreIDs.begin(), moreIDs.end());
+    Verify(cache, exprIDs);
+  }
+  ASSERT_FALSE(cache.Find(105, valueRange));
+  ASSERT_FALSE(cache.Find(400, valueRange));
+  ASSERT_FALSE(cache.Find(100000, valueRange));
+
+  // a recorded id keeps its value range on Insert and takes the new one on Set, nullptr included
+  ASSERT_FALSE(cache.Insert(5, CreateVR(6)));
+  cache.Set(5, nullptr);
+  ASSERT_TRUE(cache.Find(5, valueRange));
+  ASSERT_EQ(valueRange, nullptr);
+  ASSERT_EQ(cache.Size(), exprIDs.size());
+}
+
+TEST(ValueRangeCache, DenseToSparse) {
+  ValueRangeCache cache;
+  std::vector<int32> exprIDs = Range(0, 64);
+  Record(cache, exprIDs);
+  Verify(cache, exprIDs);
+
+  // an id beyond the largest dense array sends the entries back to the hash table
+  Record(cache, { 100000 });
+  exprIDs.push_back(100000);
+  Verify(cache, exprIDs);
+
+  // the hash table keeps growing, the dense array does not come back with such a large id recorded
+  std::vector<int32> sparseIDs = Range(64, 256);
+  Record(cache, sparseIDs);
+  exprIDs.insert(exprIDs.end(), sparseIDs.begin(), sparseIDs.end());
+  Verify(cache, exprIDs);
+  ValueRange *valueRange = nullptr;
+  ASSERT_FALSE(cache.Find(256, valueRange));
+  ASSERT_FALSE(cache.Find(99999, valueRange));
+
+  // the cache is usable again after Clear
+  cache.Clear();
+  ASSERT_EQ(cache.Size(), 0U);
+  ASSERT_FALSE(cache.Find(0, valueRange));
+  Record(cache, Range(0, 40));
+  Verify(cache, Range(0, 40));
+}
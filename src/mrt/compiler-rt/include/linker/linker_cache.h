@@ -120,7 +120,7 @@ class LinkerCache : public FeatureModel {
 
   void UpdateProperty(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex);
   LinkerCacheType GetLinkerCacheType(CacheIndex cacheIndex);
-  MplCacheMapT *GetCacheMap(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex);
+  MplCacheTable *GetCacheMap(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex);
 
   bool RemoveTable(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex);
   void FreeTable(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex);
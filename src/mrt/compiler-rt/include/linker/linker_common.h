@@ -142,18 +142,89 @@ class LinkerCacheTableItem {
   };
 };
 
-using MplCacheMapT = std::unordered_map<uint32_t, LinkerCacheTableItem>;
+// Cache table items keyed by the index in undef|def table.
+// The items loaded from a cache file are used in place, in the private mapping of the file, and found by the
+// minimal perfect hash saved with them. Only the items resolved at runtime are kept in the map.
+class MplCacheTable {
+ public:
+  MplCacheTable() = default;
+  ~MplCacheTable() {
+    Clear();
+  }
+  MplCacheTable(const MplCacheTable&) = delete;
+  MplCacheTable &operator=(const MplCacheTable&) = delete;
+
+  size_t Size() const {
+    return mappedSize + runtimeMap.size();
+  }
+  // Required: keys are unique. No key array and no displacement are saved if keys are exactly [0, count).
+  static bool IsDense(const std::vector<uint32_t> &keys);
+  // Builds the minimal perfect hash, slotKeys[slot] is the key placed in slot.
+  static bool BuildIndex(const std::vector<uint32_t> &keys, std::vector<int32_t> &disp,
+                         std::vector<uint32_t> &slotKeys);
+  // Uses the items saved in a cache file, in place.
+  void Attach(uint32_t count, uint32_t dispCount, const int32_t *dispData, const uint32_t *keyData,
+              LinkerCacheTableItem *itemData);
+  // Takes over the mapping of the cache file attached, released in Clear().
+  void Adopt(void *mapBase, size_t mapLen) {
+    mapping = mapBase;
+    mappingSize = mapLen;
+  }
+  LinkerCacheTableItem *Find(uint32_t key);
+  // Keeps the item if key is already cached.
+  void Insert(uint32_t key, const LinkerCacheTableItem &item) {
+    if (Find(key) == nullptr) {
+      (void)runtimeMap.insert(std::make_pair(key, item));
+    }
+  }
+  LinkerCacheTableItem &operator[](uint32_t key) {
+    LinkerCacheTableItem *item = Find(key);
+    return item != nullptr ? *item : runtimeMap[key];
+  }
+  template<typename F>
+  void ForEach(F const &func) {
+    for (uint32_t slot = 0; slot < mappedSize; ++slot) {
+      func(keys == nullptr ? slot : keys[slot], items[slot]);
+    }
+    for (auto &pair : runtimeMap) {
+      func(pair.first, pair.second);
+    }
+  }
+  void Clear();
+  // Copies the items used in place into the runtime map and releases the mapping, so the file can be rewritten.
+  void Own();
+
+ private:
+  static uint32_t Hash(uint32_t key, uint32_t seed) {
+    uint32_t h = key ^ (seed * 0x9e3779b9U);
+    h ^= h >> 16; // 16, 13, 16 and the factors are from murmur3 finalizer.
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+  }
+
+  void *mapping = nullptr;
+  size_t mappingSize = 0;
+  uint32_t mappedSize = 0;
+  uint32_t dispSize = 0;         // 0 for dense keys, or the bucket number.
+  const int32_t *disp = nullptr; // >0: hash seed of bucket, <0: -(slot + 1) of the only key in bucket.
+  const uint32_t *keys = nullptr;
+  LinkerCacheTableItem *items = nullptr;
+  std::unordered_map<uint32_t, LinkerCacheTableItem> runtimeMap;
+};
 
 struct LinkerCacheRep {
-  MplCacheMapT methodUndefCacheMap;
+  MplCacheTable methodUndefCacheMap;
   int64_t methodUndefCacheSize = -1;
-  MplCacheMapT methodDefCacheMap;
+  MplCacheTable methodDefCacheMap;
   int64_t methodDefCacheSize = -1;
   std::string methodUndefCachePath;
   std::string methodDefCachePath;
-  MplCacheMapT dataUndefCacheMap;
+  MplCacheTable dataUndefCacheMap;
   int64_t dataUndefCacheSize = -1;
-  MplCacheMapT dataDefCacheMap;
+  MplCacheTable dataDefCacheMap;
   int64_t dataDefCacheSize = -1;
   std::string dataUndefCachePath;
   std::string dataDefCachePath;
@@ -14,6 +14,7 @@
  */
 #include "linker/linker_cache.h"
 
+#include <algorithm>
 #include <fstream>
 #include <thread>
 #include <sys/mman.h>
@@ -29,11 +30,16 @@
 namespace maplert {
 #ifdef LINKER_RT_CACHE
 using namespace linkerutils;
-const uint64_t kCacheMagicNumber = 0xcac7e5272799710bull;
+// The table is saved with its minimal perfect hash since 0xcac7e5272799710c.
+const uint64_t kCacheMagicNumber = 0xcac7e5272799710cull;
 namespace {
   constexpr char kLinkerLazyInvalidSoName[] = "LAZY";
   constexpr char kLinkerInvalidName[] = "X";
+  // Seeds tried for a bucket before giving up saving the table, never reached in practice.
+  constexpr uint32_t kMaxHashSeed = 0x100000;
 }
+static_assert(sizeof(LinkerCacheTableItem) == 8 && std::is_standard_layout<LinkerCacheTableItem>::value,
+              "LinkerCacheTableItem is saved and used in place in cache file");
 static constexpr struct LinkerCache::CacheInfo methodUndef = {
     LinkerCache::kMethodUndefIndex,
     &LinkerInvoker::LookUpMethodSymbolAddress,
@@ -67,6 +73,118 @@ static constexpr struct LinkerCache::CacheInfo dataDef = {
     false
 };
 
+bool MplCacheTable::IsDense(const std::vector<uint32_t> &keys) {
+  uint32_t count = static_cast<uint32_t>(keys.size());
+  return std::all_of(keys.begin(), keys.end(), [count](uint32_t key) { return key < count; });
+}
+
+// Hash and displace: the keys are hashed into buckets firstly, then for the buckets from the largest one, a seed
+// is searched to place all the keys of bucket in free slots. The buckets of only one key take the free slots left.
+bool MplCacheTable::BuildIndex(const std::vector<uint32_t> &keys, std::vector<int32_t> &disp,
+                               std::vector<uint32_t> &slotKeys) {
+  uint32_t count = static_cast<uint32_t>(keys.size());
+  std::vector<std::vector<uint32_t>> buckets(count);
+  for (uint32_t key : keys) {
+    buckets[Hash(key, 0) % count].push_back(key);
+  }
+  std::vector<uint32_t> order(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t a, uint32_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+  disp.assign(count, 0);
+  slotKeys.assign(count, 0);
+  std::vector<bool> used(count, false);
+  std::vector<uint32_t> slots;
+  uint32_t i = 0;
+  for (; i < count && buckets[order[i]].size() > 1; ++i) {
+    const std::vector<uint32_t> &bucket = buckets[order[i]];
+    uint32_t seed = 1;
+    for (; seed < kMaxHashSeed; ++seed) {
+      slots.clear();
+      for (uint32_t key : bucket) {
+        uint32_t slot = Hash(key, seed) % count;
+        if (used[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+          break;
+        }
+        slots.push_back(slot);
+      }
+      if (slots.size() == bucket.size()) {
+        break;
+      }
+    }
+    if (seed == kMaxHashSeed) {
+      return false;
+    }
+    disp[order[i]] = static_cast<int32_t>(seed);
+    for (size_t j = 0; j < bucket.size(); ++j) {
+      used[slots[j]] = true;
+      slotKeys[slots[j]] = bucket[j];
+    }
+  }
+  uint32_t freeSlot = 0;
+  for (; i < count && buckets[order[i]].size() == 1; ++i) {
+    while (used[freeSlot]) {
+      ++freeSlot;
+    }
+    used[freeSlot] = true;
+    slotKeys[freeSlot] = buckets[order[i]].front();
+    disp[order[i]] = -static_cast<int32_t>(freeSlot) - 1;
+  }
+  return true;
+}
+
+void MplCacheTable::Attach(uint32_t count, uint32_t dispCount, const int32_t *dispData, const uint32_t *keyData,
+                           LinkerCacheTableItem *itemData) {
+  mappedSize = count;
+  dispSize = dispCount;
+  disp = dispData;
+  keys = keyData;
+  items = itemData;
+}
+
+LinkerCacheTableItem *MplCacheTable::Find(uint32_t key) {
+  if (mappedSize != 0) {
+    if (dispSize == 0) {
+      if (key < mappedSize) {
+        return &items[key];
+      }
+    } else {
+      int32_t d = disp[Hash(key, 0) % dispSize];
+      uint32_t slot = d < 0 ? static_cast<uint32_t>(-(d + 1)) : Hash(key, static_cast<uint32_t>(d)) % mappedSize;
+      if (keys[slot] == key) {
+        return &items[slot];
+      }
+    }
+  }
+  auto it = runtimeMap.find(key);
+  return it != runtimeMap.end() ? &it->second : nullptr;
+}
+
+void MplCacheTable::Clear() {
+  Attach(0, 0, nullptr, nullptr, nullptr);
+  if (mapping != nullptr) {
+    munmap(mapping, mappingSize);
+    Adopt(nullptr, 0);
+  }
+  runtimeMap.clear();
+  std::unordered_map<uint32_t, LinkerCacheTableItem>().swap(runtimeMap);
+}
+
+void MplCacheTable::Own() {
+  runtimeMap.reserve(runtimeMap.size() + mappedSize);
+  for (uint32_t slot = 0; slot < mappedSize; ++slot) {
+    (void)runtimeMap.insert(std::make_pair(keys == nullptr ? slot : keys[slot], items[slot]));
+  }
+  Attach(0, 0, nullptr, nullptr, nullptr);
+  if (mapping != nullptr) {
+    munmap(mapping, mappingSize);
+    Adopt(nullptr, 0);
+  }
+}
+
 const MUID LinkerCache::kInvalidHash = {{{ 0 }}};
 FeatureName LinkerCache::featureName = kFLinkerCache;
 void LinkerCache::SetPath(const std::string &path) {
@@ -233,13 +351,20 @@ bool LinkerCache::LoadTable(LinkerMFileInfo &mplInfo, const std::string &path, C
     res = false;
     goto END;
   }
-  LoadData(mplInfo, buf, cacheIndex);
+  if (!LoadData(mplInfo, buf, cacheIndex)) {
+    res = false;
+    goto END;
+  }
   if (buf.Size() != 0) {
     res = false;
     LINKER_LOG(ERROR) << "invalid format, still have cache dat to resolve:" << mplInfo.name  << maple::endl;
   }
 END:
-  if (content != MAP_FAILED) {
+  if (res) {
+    // The table items are used in place, keep the mapping until FreeTable().
+    GetCacheMap(mplInfo, cacheIndex)->Adopt(content, cacheSize);
+  } else if (content != nullptr) {
+    GetCacheMap(mplInfo, cacheIndex)->Clear();
     munmap(content, cacheSize);
   }
   if (!res) {
@@ -283,7 +408,8 @@ void *LinkerCache::LoadCache(const std::string &path, size_t &cacheSize) {
     close(fd);
     return nullptr;
   }
-  void *content = mmap(nullptr, cacheSize, PROT_READ, MAP_FILE | MAP_PRIVATE, fd, 0);
+  // Writable for the table items updated in place, the file is never written through the private mapping.
+  void *content = mmap(nullptr, cacheSize, PROT_READ | PROT_WRITE, MAP_FILE | MAP_PRIVATE, fd, 0);
   if (content == MAP_FAILED) {
     LINKER_LOG(ERROR) << "failed to mmap " << cacheSize << " (" << errno << ")for " << path << maple::endl;
     close(fd);
@@ -392,24 +518,30 @@ bool LinkerCache::LoadData(LinkerMFileInfo &mplInfo, BufferSlice &buf, CacheInde
   }
   // 2. Read So Name List Info.
   LoadNameList(buf, cacheIndex);
-  // 3. Read Bucket for resolving table.
-  uint32_t mapBucketCnt = *(reinterpret_cast<uint32_t*>(buf.Data()));
-  buf += sizeof(mapBucketCnt); // 4 bytes
-  auto &cacheMap = *GetCacheMap(mplInfo, cacheIndex);
-  cacheMap.rehash(mapBucketCnt);
-  for (uint32_t i = 0; i < mapSize; ++i) {
-    // 4. Read the undef index.
-    uint32_t undefIndex = *(reinterpret_cast<uint32_t*>(buf.Data()));
-    buf += sizeof(undefIndex);
-    // 5. Read the addr index.
-    uint32_t addrIndex = *(reinterpret_cast<uint32_t*>(buf.Data()));
-    buf += sizeof(addrIndex);
-    // 6. Read the soid
-    uint16_t soid = *(reinterpret_cast<uint16_t*>(buf.Data()));
-    buf += sizeof(soid);
-    LinkerCacheTableItem pItem(addrIndex, soid);
-    cacheMap.insert(std::make_pair(undefIndex, pItem));
+  // 3. Read the bucket number of perfect hash, 0 if the undef indexes are dense.
+  uint32_t dispCnt = *(reinterpret_cast<uint32_t*>(buf.Data()));
+  buf += sizeof(dispCnt); // 4 bytes
+  if (dispCnt != 0 && dispCnt != mapSize) {
+    LINKER_LOG(ERROR) << "invalid perfect hash, " << dispCnt << " buckets for " << mapSize << maple::endl;
+    return false;
   }
+  // 4. Skip the padding, the rest are all aligned with 4 bytes.
+  size_t padding = (alignof(uint32_t) - reinterpret_cast<uintptr_t>(buf.Data()) % alignof(uint32_t)) %
+      alignof(uint32_t);
+  size_t keysCnt = (dispCnt == 0) ? 0 : mapSize;
+  if (buf.Size() < padding + (dispCnt + keysCnt) * sizeof(uint32_t) + mapSize * sizeof(LinkerCacheTableItem)) {
+    LINKER_LOG(ERROR) << "invalid format, table is truncated:" << mplInfo.name << maple::endl;
+    return false;
+  }
+  buf += padding;
+  // 5. The displacements, the undef indexes by slot and the items by slot, used in place.
+  const int32_t *disp = reinterpret_cast<const int32_t*>(buf.Data());
+  buf += dispCnt * sizeof(int32_t);
+  const uint32_t *keys = reinterpret_cast<const uint32_t*>(buf.Data());
+  buf += keysCnt * sizeof(uint32_t);
+  LinkerCacheTableItem *items = reinterpret_cast<LinkerCacheTableItem*>(buf.Data());
+  buf += mapSize * sizeof(LinkerCacheTableItem);
+  GetCacheMap(mplInfo, cacheIndex)->Attach(mapSize, dispCnt, disp, keysCnt == 0 ? nullptr : keys, items);
   return true;
 }
 
@@ -433,7 +565,7 @@ bool LinkerCache::LoadNameList(BufferSlice &buf, CacheIndex cacheIndex) {
   return true;
 }
 
-MplCacheMapT *LinkerCache::GetCacheMap(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex) {
+MplCacheTable *LinkerCache::GetCacheMap(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex) {
   switch (cacheIndex) {
     case kMethodUndefIndex:
       return &(mplInfo.rep.methodUndefCacheMap);
@@ -462,6 +594,9 @@ bool LinkerCache::SaveTable(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex) {
     res = false;
     goto END;
   }
+  // The pages of a table loaded in place which were never written are read from the file, and fault once it is
+  // truncated.
+  GetCacheMap(mplInfo, cacheIndex)->Own();
   if (ftruncate(fd, 0) < 0) {
     LINKER_LOG(ERROR) << "failed to ftruncate zero(" << errno << ") path:" << path << maple::endl;
     res = false;
@@ -469,8 +604,7 @@ bool LinkerCache::SaveTable(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex) {
   }
   UpdateProperty(mplInfo, cacheIndex);
   SaveMeta(mplInfo, buffer, cacheIndex);
-  SaveData(mplInfo, buffer, cacheIndex);
-  if (!WriteTable(fd, buffer, cacheIndex)) {
+  if (!SaveData(mplInfo, buffer, cacheIndex) || !WriteTable(fd, buffer, cacheIndex)) {
     res = false;
   }
 END:
@@ -552,29 +686,45 @@ bool LinkerCache::SaveNameList(std::string &buffer, CacheIndex cacheIndex) {
 }
 
 bool LinkerCache::SaveData(LinkerMFileInfo &mplInfo, std::string &buffer, CacheIndex cacheIndex) {
-  const auto &cacheMap = *GetCacheMap(mplInfo, cacheIndex);
-  // 1. Write the size and nBucket of map.
-  uint32_t mapSize = static_cast<uint32_t>(cacheMap.size());
+  auto &cacheMap = *GetCacheMap(mplInfo, cacheIndex);
+  // 1. Write the size of map.
+  uint32_t mapSize = static_cast<uint32_t>(cacheMap.Size());
   buffer.append(reinterpret_cast<char*>(&mapSize), sizeof(mapSize));
   if (mapSize == 0) {
     return true;
   }
   // 2. Write the so name list info.
   SaveNameList(buffer, cacheIndex);
-  // 3. Write the bucket number.
-  uint32_t mapBucketCnt = static_cast<uint32_t>(cacheMap.bucket_count());
-  buffer.append(reinterpret_cast<char*>(&mapBucketCnt), sizeof(mapBucketCnt));
-  for (auto it = cacheMap.begin(); it != cacheMap.end(); ++it) {
-    const LinkerCacheTableItem &tableItem = it->second;
-    // 4. Write the undef index.
-    uint32_t undefIndex = it->first;
-    buffer.append(reinterpret_cast<char*>(&undefIndex), sizeof(undefIndex));
-    // 5. Write the addr index.
-    uint32_t addrIndex = tableItem.AddrId();
-    buffer.append(reinterpret_cast<char*>(&addrIndex), sizeof(addrIndex));
-    // 6. Write the so index.
-    uint16_t soid = tableItem.SoId();
-    buffer.append(reinterpret_cast<char*>(&soid), sizeof(soid));
+  // 3. Write the bucket number of perfect hash, or 0 if the undef indexes are dense.
+  std::vector<uint32_t> keys;
+  keys.reserve(mapSize);
+  cacheMap.ForEach([&keys](uint32_t key, const LinkerCacheTableItem&) { keys.push_back(key); });
+  std::vector<int32_t> disp;
+  std::vector<uint32_t> slotKeys;
+  bool isDense = MplCacheTable::IsDense(keys);
+  if (isDense) {
+    slotKeys.resize(mapSize);
+    for (uint32_t key : keys) {
+      slotKeys[key] = key;
+    }
+  } else if (!MplCacheTable::BuildIndex(keys, disp, slotKeys)) {
+    LINKER_LOG(ERROR) << "(" << cacheIndex << "), failed to build perfect hash for " << mplInfo.name << maple::endl;
+    return false;
+  }
+  uint32_t dispCnt = static_cast<uint32_t>(disp.size());
+  buffer.append(reinterpret_cast<char*>(&dispCnt), sizeof(dispCnt));
+  // 4. Pad for the rest to be aligned with 4 bytes in the mapping.
+  buffer.append((alignof(uint32_t) - buffer.size() % alignof(uint32_t)) % alignof(uint32_t), '\0');
+  // 5. Write the displacements and the undef indexes by slot.
+  buffer.append(reinterpret_cast<const char*>(disp.data()), disp.size() * sizeof(int32_t));
+  if (!isDense) {
+    buffer.append(reinterpret_cast<const char*>(slotKeys.data()), slotKeys.size() * sizeof(uint32_t));
+  }
+  // 6. Write the items by slot, with the addr index and so index only.
+  for (uint32_t key : slotKeys) {
+    const LinkerCacheTableItem &tableItem = cacheMap[key];
+    LinkerCacheTableItem item(tableItem.AddrId(), tableItem.SoId());
+    buffer.append(reinterpret_cast<const char*>(&item), sizeof(item));
   }
   return true;
 }
@@ -799,78 +949,61 @@ bool LinkerCache::DumpMetaCl(std::stringstream &ss, BufferSlice &buf, CacheIndex
 }
 
 bool LinkerCache::DumpData(std::stringstream &ss, BufferSlice &buf, size_t mapSize) {
-  std::vector<std::pair<std::string, MUID>> soList;
-  for (size_t i = 0; i < mapSize; ++i) {
-    MUID hash;
-    uint16_t arrayIndex = 0;
-    // 9. Read the undef index.
-    uint32_t undefIndex = *(reinterpret_cast<const uint32_t*>(buf.Data()));
-    ss << "\t*UNDEF_INX:\t" << undefIndex << "\n";
-    buf += sizeof(undefIndex);
-    // 10. Read the name length firstly.
-    uint16_t len = *(reinterpret_cast<const uint16_t*>(buf.Data()));
-    ss << "\tLEN_FLAG:\t" << len << "\n";
+  // 9. Read the so name list.
+  uint32_t listSize = *(reinterpret_cast<const uint32_t*>(buf.Data()));
+  buf += sizeof(listSize);
+  ss << "SO_LIST:\t" << listSize << "\n";
+  std::vector<std::string> soList;
+  for (uint32_t i = 0; i < listSize; ++i) {
+    uint32_t len = *(reinterpret_cast<const uint32_t*>(buf.Data()));
     if (len > PATH_MAX) {
       LINKER_LOG(ERROR) << "failed, length is too long:" << len << maple::endl;
       return false;
     }
     buf += sizeof(len);
-    // 11. Read the name by its length.
-    if (len == 0) { // Name index.
-      arrayIndex = *(reinterpret_cast<const uint16_t*>(buf.Data()));
-      buf += sizeof(arrayIndex);
-      std::pair<std::string, MUID> pair = soList[arrayIndex];
-      ss << "\tNAME:\t" << pair.first << "\n" << "\tHASH:\t" << pair.second.ToStr() << "\n";
-    } else { // Name string, including INVALID_NAME.
-      std::string text(buf.Data(), len);
-      buf += len;
-      if (len == kLinkerInvalidNameLen) {
-        LINKER_LOG(ERROR) << "has not resolved symbol" << maple::endl;
-        ss << "\tNAME:\tX" << "\n" << "\tHASH:\t(nul)" << "\n";
-      } else {
-        // 12. Read the hash code of .so
-        hash = *(reinterpret_cast<const MUID*>(buf.Data()));
-        buf += sizeof(hash);
-        ss << "\tNAME:\t" << text << "\n" << "\tHASH:\t" << hash.ToStr() << "\n";
-        auto soListIt = std::find_if (soList.begin(), soList.end(),
-            [&text](const std::pair<std::string, MUID> &item){ return item.first == text; });
-        if (soListIt == soList.end()) {
-          soList.push_back(std::make_pair(text, hash));
-        } else {
-          LINKER_LOG(ERROR) << "bad format, has multiple name string" << maple::endl;
-          ss << "\t[FAILED]" << "\n";
-          return false;
-        }
-      }
-    }
-    // 13. Read the index.
-    uint32_t idx = *(reinterpret_cast<const uint32_t*>(buf.Data()));
-    ss << "\t*INDEX:\t" << idx << "\n";
-    buf += sizeof(uint32_t);
+    soList.push_back(std::string(buf.Data(), len));
+    buf += len;
+    MUID hash = *(reinterpret_cast<const MUID*>(buf.Data()));
+    buf += sizeof(hash);
+    ss << "\t[" << i << "]\t" << soList.back() << "\t" << hash.ToStr() << "\n";
+  }
+  // 10. Read the bucket number of perfect hash, 0 if the undef indexes are dense.
+  uint32_t dispCnt = *(reinterpret_cast<const uint32_t*>(buf.Data()));
+  buf += sizeof(dispCnt);
+  ss << "nBUCKET:\t" << dispCnt << "\n";
+  size_t padding = (alignof(uint32_t) - reinterpret_cast<uintptr_t>(buf.Data()) % alignof(uint32_t)) %
+      alignof(uint32_t);
+  size_t keysCnt = (dispCnt == 0) ? 0 : mapSize;
+  if ((dispCnt != 0 && dispCnt != mapSize) ||
+      buf.Size() < padding + (dispCnt + keysCnt) * sizeof(uint32_t) + mapSize * sizeof(LinkerCacheTableItem)) {
+    LINKER_LOG(ERROR) << "bad format, invalid perfect hash" << maple::endl;
+    ss << "\t[FAILED]" << "\n";
+    return false;
+  }
+  buf += padding + dispCnt * sizeof(int32_t);
+  const uint32_t *keys = reinterpret_cast<const uint32_t*>(buf.Data());
+  buf += keysCnt * sizeof(uint32_t);
+  const LinkerCacheTableItem *items = reinterpret_cast<const LinkerCacheTableItem*>(buf.Data());
+  buf += mapSize * sizeof(LinkerCacheTableItem);
+  // 11. Read the items by slot.
+  for (size_t slot = 0; slot < mapSize; ++slot) {
+    const LinkerCacheTableItem &item = items[slot];
+    ss << "\t*UNDEF_INX:\t" << (keysCnt == 0 ? slot : keys[slot]) << "\n";
+    ss << "\tNAME:\t" << (item.SoId() < soList.size() ? soList[item.SoId()] : "X") << "\n";
+    ss << "\t*INDEX:\t" << item.AddrId() << "\n";
   }
   return true;
 }
 
 int LinkerCache::DumpMap(std::stringstream &ss, BufferSlice &buf) {
-  // 8. Read the map size and nBucket for resolving table.
+  // 8. Read the map size for resolving table.
   uint32_t mapSize = *(reinterpret_cast<const uint32_t*>(buf.Data()));
+  buf += sizeof(mapSize);
   ss << "MAP_SIZE:\t" << mapSize << "\n";
-  ss << "\t" << mapSize << " vs. 0" << "\n";
   if (mapSize == 0) {
     ss << "\t[SUCC]" << "\n";
-    return 0;
   }
-  buf += sizeof(mapSize);
-  uint32_t mapBucketCnt = *(reinterpret_cast<const uint32_t*>(buf.Data()));
-  ss << "nBUCKET:\t" << mapBucketCnt << "\n";
-  ss << "\t" << mapBucketCnt << " vs. 0" << "\n";
-  if (mapBucketCnt == 0) {
-    LINKER_LOG(ERROR) << "map nBucket is 0" << maple::endl;
-    ss << "\t[FAILED]" << "\n";
-    return -1;
-  }
-  buf += sizeof(mapBucketCnt);
-  return mapSize;
+  return static_cast<int>(mapSize);
 }
 
 bool LinkerCache::DumpFile(std::ofstream &out, std::stringstream &ss) {
@@ -907,23 +1040,19 @@ bool LinkerCache::RemoveTable(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex) {
 void LinkerCache::FreeTable(LinkerMFileInfo &mplInfo, CacheIndex cacheIndex) {
   switch (cacheIndex) {
     case kMethodUndefIndex:
-      mplInfo.rep.methodUndefCacheMap.clear();
-      MplCacheMapT().swap(mplInfo.rep.methodUndefCacheMap);
+      mplInfo.rep.methodUndefCacheMap.Clear();
       mplInfo.SetFlag(kIsMethodUndefCacheValid, false);
       break;
     case kMethodDefIndex:
-      mplInfo.rep.methodDefCacheMap.clear();
-      MplCacheMapT().swap(mplInfo.rep.methodDefCacheMap);
+      mplInfo.rep.methodDefCacheMap.Clear();
       mplInfo.SetFlag(kIsMethodCacheValid, false);
       break;
     case kDataUndefIndex:
-      mplInfo.rep.dataUndefCacheMap.clear();
-      MplCacheMapT().swap(mplInfo.rep.dataUndefCacheMap);
+      mplInfo.rep.dataUndefCacheMap.Clear();
       mplInfo.SetFlag(kIsDataUndefCacheValid, false);
       break;
     case kDataDefIndex:
-      mplInfo.rep.dataDefCacheMap.clear();
-      MplCacheMapT().swap(mplInfo.rep.dataDefCacheMap);
+      mplInfo.rep.dataDefCacheMap.Clear();
       mplInfo.SetFlag(kIsDataCacheValid, false);
       break;
   };
@@ -979,8 +1108,8 @@ void LinkerCache::ResolveMethodSymbol(LinkerMFileInfo &mplInfo, AddrSlice &addrS
   bool saveRtCache = false;
   if (mplInfo.rep.methodUndefCacheSize == -1) {
     mplInfo.SetFlag(kIsMethodUndefCacheValid, LoadTable(mplInfo, kMethodUndefIndex));
-    mplInfo.rep.methodUndefCacheSize = mplInfo.rep.methodUndefCacheMap.size();
-    if (mplInfo.rep.methodUndefCacheMap.size() < addrSlice.Size()) {
+    mplInfo.rep.methodUndefCacheSize = mplInfo.rep.methodUndefCacheMap.Size();
+    if (mplInfo.rep.methodUndefCacheMap.Size() < addrSlice.Size()) {
       mplInfo.SetFlag(kIsMethodUndefCacheValid, false);
     }
   }
@@ -1076,7 +1205,7 @@ void LinkerCache::RelocateMethodSymbol(LinkerMFileInfo &mplInfo, AddrSlice &addr
   bool saveRtCache = false;
   if (mplInfo.rep.methodDefCacheSize == -1) {
     mplInfo.SetFlag(kIsMethodCacheValid, LoadTable(mplInfo, kMethodDefIndex));
-    mplInfo.rep.methodDefCacheSize = mplInfo.rep.methodDefCacheMap.size();
+    mplInfo.rep.methodDefCacheSize = mplInfo.rep.methodDefCacheMap.Size();
   }
   if (mplInfo.IsFlag(kIsMethodCacheValid)) {
     saveRtCache = ProcessTable(mplInfo, addrSlice, muidSlice, methodDef);
@@ -1098,14 +1227,12 @@ bool LinkerCache::ProcessTable(LinkerMFileInfo &mplInfo, AddrSlice &addrSlice, M
   auto &store = pMplStore[cacheInfo.cacheIndex];
   bool saveRtCache = false;
   auto &cacheMap = *GetCacheMap(mplInfo, cacheInfo.cacheIndex);
-  for (auto it = cacheMap.begin(); it != cacheMap.end(); ++it) {
+  cacheMap.ForEach([&](uint32_t i, LinkerCacheTableItem &pItem) {
     bool noRtCache = false;
-    uint32_t i = it->first;
-    LinkerCacheTableItem &pItem = it->second;
     if (pItem.Filled()) { // Already done
-      continue;
+      return;
     } else if (pItem.LazyInvalidName() && cacheInfo.isUndef) {
-      continue; // Ignore the symbols not found from system(Boot class loader).
+      return; // Ignore the symbols not found from system(Boot class loader).
     } else if (pItem.Valid()) {
       LinkerMFileInfo *res = FindLinkerMFileInfo(pItem.SoId(), inf, store);
       if (res != nullptr) {
@@ -1141,7 +1268,7 @@ bool LinkerCache::ProcessTable(LinkerMFileInfo &mplInfo, AddrSlice &addrSlice, M
         saveRtCache = true;
       }
     }
-  }
+  });
   return saveRtCache;
 }
 
@@ -1185,7 +1312,7 @@ bool LinkerCache::UndefSymbolFailHandler(LinkerMFileInfo &mplInfo, uint32_t idx,
     pItem.SetInvalidSoId(soid);
   }
   auto &cacheMap = *GetCacheMap(mplInfo, cacheInfo.cacheIndex);
-  cacheMap.insert(std::make_pair(idx, pItem));
+  cacheMap.Insert(idx, pItem);
   if (!mplInfo.IsFlag(kIsLazy)) {
     mplInfo.SetFlag(cacheInfo.notResolved, true);
   }
@@ -1218,7 +1345,7 @@ bool LinkerCache::LookUpUndefSymbol(LinkerMFileInfo &mplInfo, AddrSlice &addrSli
         pItem.SetIds(index, soid).SetFilled();
       }
       auto &cacheMap = *GetCacheMap(mplInfo, cacheInfo.cacheIndex);
-      cacheMap.insert(std::make_pair(i, pItem));
+      cacheMap.Insert(static_cast<uint32_t>(i), pItem);
       saveRtCache = true;
     }
   }
@@ -1230,8 +1357,8 @@ void LinkerCache::ResolveDataSymbol(LinkerMFileInfo &mplInfo, AddrSlice &addrSli
   bool saveRtCache = false;
   if (mplInfo.rep.dataUndefCacheSize == -1) {
     mplInfo.SetFlag(kIsDataUndefCacheValid, LoadTable(mplInfo, kDataUndefIndex));
-    mplInfo.rep.dataUndefCacheSize = mplInfo.rep.dataUndefCacheMap.size();
-    if (mplInfo.rep.dataUndefCacheMap.size() < addrSlice.Size()) {
+    mplInfo.rep.dataUndefCacheSize = mplInfo.rep.dataUndefCacheMap.Size();
+    if (mplInfo.rep.dataUndefCacheMap.Size() < addrSlice.Size()) {
       mplInfo.SetFlag(kIsDataUndefCacheValid, false);
     }
   }
@@ -1253,7 +1380,7 @@ void LinkerCache::RelocateDataSymbol(LinkerMFileInfo &mplInfo, AddrSlice &addrSl
   bool saveRtCache = false;
   if (mplInfo.rep.dataDefCacheSize == -1) {
     mplInfo.SetFlag(kIsDataCacheValid, LoadTable(mplInfo, kDataDefIndex));
-    mplInfo.rep.dataDefCacheSize = mplInfo.rep.dataDefCacheMap.size();
+    mplInfo.rep.dataDefCacheSize = mplInfo.rep.dataDefCacheMap.Size();
   }
   if (mplInfo.IsFlag(kIsDataCacheValid)) {
     saveRtCache = ProcessTable(mplInfo, addrSlice, muidSlice, dataDef);
@@ -0,0 +1,34 @@
+#include <stdio.h>
+
+// tags 0..10 with two targets are tested with one mask per target instead of a jump table
+__attribute__((noinline)) int Classify(int c) {
+  // CHECK-LABEL: Classify:
+  // CHECK-NOT: {{^\s*br\s}}
+  // CHECK: lsl{{\s+}}w{{[0-9]+}}, w{{[0-9]+}}, w{{[0-9]+}}
+  // CHECK-NOT: {{^\s*br\s}}
+  // CHECK: ret
+  switch (c) {
+    case 0:
+    case 2:
+    case 4:
+    case 6:
+    case 8:
+    case 10:
+      return 1;
+    case 1:
+    case 3:
+    case 5:
+    case 9:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+int main() {
+  for (int c = -2; c <= 12; ++c) {
+    printf("%d", Classify(c));
+  }
+  printf("\n");
+  return 0;
+}
@@ -0,0 +1,29 @@
+#include <stdio.h>
+
+__attribute__((noinline)) int Weight(int v) {
+  return v * 3 + 1;
+}
+
+// the rejecting path returns before the frame is set up
+// CHECK-LABEL: Validate:
+// CHECK-NOT: pushq
+// CHECK: j{{[a-z]+}}
+// CHECK: pushq %rbp
+// CHECK: call
+// CHECK: ret
+__attribute__((noinline)) int Validate(const int *buf, int n) {
+  if (buf == NULL || n <= 0) {
+    return -1;
+  }
+  int sum = 0;
+  for (int i = 0; i < n; ++i) {
+    sum += Weight(buf[i]);
+  }
+  return sum;
+}
+
+int main() {
+  int buf[4] = { 1, 2, 3, 4 };
+  printf("%d %d %d\n", Validate(NULL, 4), Validate(buf, 0), Validate(buf, 4));
+  return 0;
+}
@@ -0,0 +1,15 @@
+#include <stdio.h>
+
+// a leaf using no stack and no callee saved register runs on the frame of its caller
+// CHECK-LABEL: MulAdd:
+// CHECK-NOT: %rbp
+// CHECK-NOT: %rsp
+// CHECK: ret
+__attribute__((noinline)) long MulAdd(long a, long b, long c) {
+  return a * b + c;
+}
+
+int main() {
+  printf("%ld\n", MulAdd(6, 7, -2));
+  return 0;
+}
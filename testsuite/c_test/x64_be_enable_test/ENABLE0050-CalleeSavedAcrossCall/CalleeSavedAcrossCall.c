@@ -0,0 +1,28 @@
+#include <stdio.h>
+
+__attribute__((noinline)) long Step(long x) {
+  return x * 2 + 1;
+}
+
+// the values live across the calls are kept in callee saved registers, saved before the loop and restored after
+// CHECK-LABEL: Accumulate:
+// CHECK: movq %[[REG:rbx|r12|r13|r14|r15]], {{-?[0-9]+}}(%rbp)
+// CHECK: call
+// CHECK: movq {{-?[0-9]+}}(%rbp), %[[REG]]
+// CHECK: ret
+__attribute__((noinline)) long Accumulate(long n, long bias) {
+  long sum = 0;
+  for (long i = 0; i < n; ++i) {
+    sum += Step(i) + bias;
+  }
+  return sum + bias;
+}
+
+int main() {
+  long a = 3;
+  long b = 5;
+  long r = Accumulate(4, 10);
+  // a and b are live across the call, a clobbered callee saved register shows up here
+  printf("%ld %ld %ld\n", r, Accumulate(a, b) + a, b * a);
+  return 0;
+}
@@ -0,0 +1,246 @@
+#!/usr/bin/python3
+# -*- coding:utf-8 -*-
+#
+# Copyright (c) [2023] Huawei Technologies Co.,Ltd.All rights reserved.
+#
+# OpenArkCompiler is licensed under Mulan PSL v2.
+# You can use this software according to the terms and conditions of the Mulan PSL v2.
+# You may obtain a copy of Mulan PSL v2 at:
+#
+#     http://license.coscl.org.cn/MulanPSL2
+#
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY OR
+# FIT FOR A PARTICULAR PURPOSE.
+# See the Mulan PSL v2 for more details.
+#
+"""Compile-time benchmark of the maple driver.
+
+Compiles the corpus in corpus.list at every opt level for every target, collects the wall time, the peak RSS
+and the per-phase time printed by -time-phases, and compares them with a stored baseline.
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import resource
+import subprocess
+import sys
+import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+BASE_DIR = Path(__file__).parent.absolute()
+DEFAULT_CORPUS = BASE_DIR / "corpus.list"
+DEFAULT_BASELINE_DIR = BASE_DIR / "baseline"
+TARGETS = ["aarch64", "x86_64"]
+OPT_LEVELS = ["O0", "O2", "O3"]
+# line printed by PhaseTimeHandler::DumpPhasesTime: "<phase>   <percent>%   <time>ms"
+PHASE_TIME_RE = re.compile(r"^(\S+)\s+[\d.]+%\s+(\d+)ms$")
+# phases faster than this in the baseline are too noisy to gate on
+PHASE_NOISE_FLOOR_MS = 50
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--maple-root", default=os.environ.get("MAPLE_ROOT", ""), help="root of the source tree")
+    parser.add_argument("--targets", default=",".join(TARGETS), help="comma separated targets")
+    parser.add_argument("--opt-levels", default=",".join(OPT_LEVELS), help="comma separated opt levels")
+    parser.add_argument("--corpus", default=str(DEFAULT_CORPUS), help="corpus list file")
+    parser.add_argument("--baseline-dir", default=str(DEFAULT_BASELINE_DIR), help="directory of <target>.json")
+    parser.add_argument("--output", default="", help="write the collected results to this json file")
+    parser.add_argument("--threshold", type=float, default=0.10, help="allowed relative slowdown, 0.10 means 10%%")
+    parser.add_argument("--update-baseline", action="store_true", help="store the results as the new baseline")
+    parser.add_argument("--repeat", type=int, default=1, help="compile every file n times and keep the fastest")
+    parser.add_argument("-j", "--jobs", type=int, default=1, help="parallel compilations, 1 gives stable numbers")
+    parser.add_argument("--exec", dest="exec_cmd", nargs=argparse.REMAINDER, help=argparse.SUPPRESS)
+    return parser.parse_args()
+
+
+def exec_and_report(cmd):
+    """Run cmd and report its peak RSS including all waited-for descendants (clang, hir2mpl, as...)."""
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    usage = resource.getrusage(resource.RUSAGE_CHILDREN)
+    sys.stdout.write(proc.stdout)
+    sys.stdout.write("\nCOMPILE_BENCH_MAXRSS_KB {}\n".format(usage.ru_maxrss))
+    return proc.returncode
+
+
+def gen_synthetic(path, funcs, stmts, globals_num):
+    """Generate a large translation unit with many globals, calls, branches and loops."""
+    with open(path, "w") as out:
+        out.write("/* generated by compile_bench.py */\n")
+        for i in range(globals_num):
+            out.write("int g{0}[4] = {{ {0}, {1}, {2}, {3} }};\n".format(i, i + 1, i + 2, i + 3))
+        for f in range(funcs):
+            out.write("int f{}(int *p, int n) {{\n  int s = 0;\n".format(f))
+            for s in range(stmts):
+                g = (f * stmts + s) % max(globals_num, 1)
+                kind = s % 4
+                if kind == 0:
+                    out.write("  s += p[{0} % (n + 1)] * g{1}[{2}];\n".format(s, g, s % 4))
+                elif kind == 1:
+                    out.write("  if (s > {0}) {{ s -= g{1}[1]; }} else {{ s ^= {0}; }}\n".format(s, g))
+                elif kind == 2:
+                    out.write("  for (int i = 0; i < n; ++i) {{ s += p[i] + {}; }}\n".format(s))
+                else:
+                    out.write("  switch (s & 7) {{ case 0: s += {0}; break; case 3: s *= 3; break; "
+                              "default: s--; }}\n".format(s))
+            if f > 0:
+                out.write("  s += f{}(p, n - 1);\n".format(f - 1))
+            out.write("  return s;\n}\n")
+
+
+def collect_corpus(maple_root, corpus_file, work_dir):
+    files = []
+    with open(corpus_file) as corpus:
+        for line in corpus:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            if line.startswith("synthetic:"):
+                _, name, funcs, stmts, globals_num = line.split(":")
+                path = os.path.join(work_dir, name + ".c")
+                gen_synthetic(path, int(funcs), int(stmts), int(globals_num))
+                files.append(path)
+                continue
+            matched = sorted(glob.glob(os.path.join(maple_root, line)))
+            if not matched:
+                print("compile-bench: skip {}, nothing matched".format(line))
+            files.extend(matched)
+    return files
+
+
+def maple_bin(maple_root, target):
+    return os.path.join(maple_root, "output", "{}-clang-release".format(target), "bin", "maple")
+
+
+def compile_one(maple, opt, src, work_dir, repeat):
+    obj = os.path.join(work_dir, "{}_{}.o".format(abs(hash(src)), opt))
+    cmd = [sys.executable, os.path.abspath(__file__), "--exec", maple, "-" + opt, "-c", src, "-o", obj,
+           "-time-phases"]
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        wall_ms = (time.perf_counter() - start) * 1000
+        result = {"ok": proc.returncode == 0, "wall_ms": wall_ms, "max_rss_kb": 0, "phases": {}}
+        for line in proc.stdout.splitlines():
+            line = line.strip()
+            if line.startswith("COMPILE_BENCH_MAXRSS_KB"):
+                result["max_rss_kb"] = int(line.split()[1])
+                continue
+            match = PHASE_TIME_RE.match(line)
+            if match and match.group(1) != "Total":
+                phases = result["phases"]
+                phases[match.group(1)] = phases.get(match.group(1), 0) + int(match.group(2))
+        if best is None or result["wall_ms"] < best["wall_ms"]:
+            best = result
+    return best
+
+
+def run_config(maple, opt, files, work_dir, args):
+    summary = {"files": 0, "failed": 0, "wall_ms": 0.0, "max_rss_kb": 0, "phases": {}}
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        results = pool.map(lambda src: compile_one(maple, opt, src, work_dir, args.repeat), files)
+        for result in results:
+            summary["files"] += 1
+            if not result["ok"]:
+                summary["failed"] += 1
+                continue
+            summary["wall_ms"] += result["wall_ms"]
+            summary["max_rss_kb"] = max(summary["max_rss_kb"], result["max_rss_kb"])
+            for phase, used in result["phases"].items():
+                summary["phases"][phase] = summary["phases"].get(phase, 0) + used
+    summary["wall_ms"] = round(summary["wall_ms"], 1)
+    return summary
+
+
+def compare(name, current, baseline, threshold):
+    """Return the list of regressions of current against baseline."""
+    regressions = []
+
+    def check(metric, cur, base, floor):
+        if base <= floor:
+            return
+        ratio = (cur - base) / base
+        if ratio > threshold:
+            regressions.append("{} {}: {} -> {} (+{:.1f}%)".format(name, metric, base, cur, ratio * 100))
+
+    check("wall_ms", current["wall_ms"], baseline.get("wall_ms", 0), 0)
+    check("max_rss_kb", current["max_rss_kb"], baseline.get("max_rss_kb", 0), 0)
+    for phase, base in baseline.get("phases", {}).items():
+        check("phase " + phase, current["phases"].get(phase, 0), base, PHASE_NOISE_FLOOR_MS)
+    if current["failed"] > baseline.get("failed", 0):
+        regressions.append("{} failed compilations: {} -> {}".format(name, baseline.get("failed", 0),
+                                                                   current["failed"]))
+    return regressions
+
+
+def main():
+    args = parse_args()
+    if args.exec_cmd:
+        return exec_and_report(args.exec_cmd)
+    if not args.maple_root:
+        print("compile-bench: MAPLE_ROOT not set. Please source build/envsetup.sh.")
+        return 1
+
+    all_results = {}
+    regressions = []
+    # a configuration without baseline is not gated, which must not pass for a clean run
+    missing = []
+    with tempfile.TemporaryDirectory(prefix="compile_bench_") as work_dir:
+        files = collect_corpus(args.maple_root, args.corpus, work_dir)
+        print("compile-bench: {} files in corpus".format(len(files)))
+        for target in args.targets.split(","):
+            maple = maple_bin(args.maple_root, target)
+            if not os.path.isfile(maple):
+                print("compile-bench: skip {}, {} not found".format(target, maple))
+                continue
+            target_results = {}
+            for opt in args.opt_levels.split(","):
+                summary = run_config(maple, opt, files, work_dir, args)
+                target_results[opt] = summary
+                print("compile-bench: {}/{}: {} ms, peak {} KB, {} of {} failed".format(
+                    target, opt, summary["wall_ms"], summary["max_rss_kb"], summary["failed"], summary["files"]))
+            all_results[target] = target_results
+
+            baseline_file = os.path.join(args.baseline_dir, target + ".json")
+            if args.update_baseline:
+                os.makedirs(args.baseline_dir, exist_ok=True)
+                with open(baseline_file, "w") as out:
+                    json.dump(target_results, out, indent=2, sort_keys=True)
+                print("compile-bench: baseline of {} updated: {}".format(target, baseline_file))
+            elif os.path.isfile(baseline_file):
+                with open(baseline_file) as base:
+                    baseline = json.load(base)
+                for opt, summary in target_results.items():
+                    if opt in baseline:
+                        regressions.extend(compare(target + "/" + opt, summary, baseline[opt], args.threshold))
+                    else:
+                        missing.append("{}/{} in {}".format(target, opt, baseline_file))
+            else:
+                missing.append("{} in {}".format(target, baseline_file))
+
+    if args.output:
+        with open(args.output, "w") as out:
+            json.dump(all_results, out, indent=2, sort_keys=True)
+    if missing:
+        print("compile-bench: no baseline, run with --update-baseline to create it:")
+        for config in missing:
+            print("  " + config)
+    if regressions:
+        print("compile-bench: regressions beyond {:.0f}%:".format(args.threshold * 100))
+        for regression in regressions:
+            print("  " + regression)
+    if missing or regressions:
+        return 1
+    print("compile-bench: no regression")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())